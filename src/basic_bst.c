@@ -9,11 +9,13 @@ typedef struct Node {
         struct Node *parent; 
         struct Node *left; 
         struct Node *right; 
+        uint32_t count;         /* occurrences of value, in a multiset */
 } Node; 
 
 struct bs_tree {
         Node *root; 
-        void *comparison_func; 
+        Compare compare; 
+        bool multiset; 
 };
 
 /*********************
@@ -21,18 +23,17 @@ struct bs_tree {
  *********************/
 
 void private_deallocate_all_tree_nodes(Node *n); 
-Node *private_insert_value(Node *root, Node *new_node, 
-                           void *comparison_func(void *val1, void *val2));
+Node *private_insert_value(Node *root, Node *new_node, Compare compare);
 Node *construct_node(void *value);
-Node *private_find_in_tree(BSTree_T tree, void *value, 
-                           void *comparison_func(void *val1, void *val2));
+Node *private_find_in_tree(BSTree_T tree, void *value, Compare compare);
+Node *private_bst_insert_unique(BSTree_T tree, void *value, bool *inserted);
 void bst_transplant(BSTree_T tree, Node *u, Node *v); 
 Node *private_bst_minimum(Node *x);
 Node *private_bst_maximum(Node *x); 
-void *private_bst_successor_of_value(BSTree_T tree, void *value, 
-                                 void *comparison_func(void *val1, void *val2));
-void *private_bst_predecessor_of_value(BSTree_T tree, void *value, 
-                                   void *comparison_func(void *val1, void *val2));
+Node *private_bst_lower_bound(BSTree_T tree, void *value, Compare compare);
+Node *private_bst_next_inorder(Node *n); 
+void *private_bst_successor_of_value(BSTree_T tree, void *value, Compare compare);
+void *private_bst_predecessor_of_value(BSTree_T tree, void *value, Compare compare);
 void private_bst_map_inorder(Node *root, 
                              int depth, 
                              void func_to_apply(void *value, int depth, void *cl), 
@@ -53,15 +54,31 @@ void private_bst_map_postorder(Node *root,
 
 BSTree_T bst_new(void *comparison_func)
 {
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return bst_new_r(compare.func, compare.ctx); 
+}
+
+BSTree_T bst_new_r(Comparator compare, void *ctx)
+{
+        assert(compare != NULL); 
+
         BSTree_T tree = malloc(sizeof(struct bs_tree)); 
 
         tree->root = NULL; 
 
-        if (comparison_func == NULL) {
-                tree->comparison_func = &strcmp; 
-        } else {
-                tree->comparison_func = comparison_func; 
-        }
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+        tree->multiset = false; 
+
+        return tree; 
+}
+
+BSTree_T bst_new_multiset(Comparator compare, void *ctx)
+{
+        BSTree_T tree = bst_new_r(compare, ctx); 
+
+        tree->multiset = true; 
 
         return tree; 
 }
@@ -99,8 +116,17 @@ int bst_insert_value(BSTree_T tree, void *value)
 {
         assert(tree != NULL && value != NULL); 
 
+        if (tree->multiset) {
+                bool inserted; 
+                Node *n = private_bst_insert_unique(tree, value, &inserted); 
+
+                if (!inserted)
+                        n->count++; 
+                return 0; 
+        }
+
         Node *new_node = construct_node(value); 
-        tree->root = private_insert_value(tree->root, new_node, tree->comparison_func); 
+        tree->root = private_insert_value(tree->root, new_node, tree->compare); 
 
         return 0; 
 }
@@ -113,31 +139,88 @@ Node *construct_node(void *value)
         new_node->left = NULL; 
         new_node->right = NULL; 
         new_node->value = value; 
+        new_node->count = 1; 
 
         return new_node; 
 }
 
-Node *private_insert_value(Node *root, Node *new_node, 
-                           void *comparison_func(void *val1, void *val2)) 
+Node *private_insert_value(Node *root, Node *new_node, Compare compare) 
 {
         if (root == NULL) { 
                 return new_node; 
         }
 
-        if ((int)(intptr_t) comparison_func(new_node->value, root->value) < 0) {
-                root->left = private_insert_value(root->left, new_node, comparison_func); 
+        if (compare.func(new_node->value, root->value, compare.ctx) < 0) {
+                root->left = private_insert_value(root->left, new_node, compare); 
                 root->left->parent = root; 
         } else {
-                root->right = private_insert_value(root->right, new_node, comparison_func); 
+                root->right = private_insert_value(root->right, new_node, compare); 
                 root->right->parent = root; 
         }
 
         return root; 
 }
 
+void *bst_insert_unique(BSTree_T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        bool inserted; 
+        Node *n = private_bst_insert_unique(tree, value, &inserted); 
+
+        return inserted ? NULL : n->value; 
+}
+
+void *bst_upsert(BSTree_T tree, void *value, 
+                 void *merge(void *stored, void *value, void *cl), void *cl)
+{
+        assert(tree != NULL && value != NULL && merge != NULL); 
+
+        bool inserted; 
+        Node *n = private_bst_insert_unique(tree, value, &inserted); 
+
+        if (!inserted)
+                n->value = merge(n->value, value, cl); 
+
+        return n->value; 
+}
+
+Node *private_bst_insert_unique(BSTree_T tree, void *value, bool *inserted)
+{
+        Node *parent = NULL; 
+        Node *curr = tree->root; 
+        int c = 0; 
+
+        while (curr != NULL) {
+                c = tree->compare.func(value, curr->value, tree->compare.ctx); 
+
+                if (c == 0) {
+                        *inserted = false; 
+                        return curr; 
+                }
+
+                parent = curr; 
+                curr = (c < 0) ? curr->left : curr->right; 
+        }
+
+        Node *new_node = construct_node(value); 
+        new_node->parent = parent; 
+
+        if (parent == NULL)
+                tree->root = new_node; 
+        else if (c < 0)
+                parent->left = new_node; 
+        else
+                parent->right = new_node; 
+
+        *inserted = true; 
+
+        return new_node; 
+}
+
 void *bst_search(BSTree_T tree, void *value)
 {
-        Node *result = private_find_in_tree(tree, value, tree->comparison_func); 
+        Node *result = private_find_in_tree(tree, value, tree->compare); 
 
         if (result != NULL) 
                 return (void *) result->value; 
@@ -145,15 +228,14 @@ void *bst_search(BSTree_T tree, void *value)
         return result; //AKA return NULL 
 }
 
-Node *private_find_in_tree(BSTree_T tree, void *value, 
-                           void *comparison_func(void *val1, void *val2))
+Node *private_find_in_tree(BSTree_T tree, void *value, Compare compare)
 {
         bool found = false; 
         Node *curr = tree->root; 
         int c = 0; 
 
         while (!found && curr != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr->value); 
+                c = compare.func(value, curr->value, compare.ctx); 
 
                 if (c == 0) {
                         found = true; 
@@ -169,11 +251,14 @@ Node *private_find_in_tree(BSTree_T tree, void *value,
 
 void bst_delete_value(BSTree_T tree, void *value)
 {
-        Node *z = private_find_in_tree(tree, value, tree->comparison_func);
+        Node *z = private_find_in_tree(tree, value, tree->compare);
 
         if (z == NULL)
                 return; 
 
+        if (--z->count > 0)
+                return; 
+
         if (z->left == NULL) {
                 bst_transplant(tree, z, z->right); 
         } else if (z->right == NULL) {
@@ -193,6 +278,49 @@ void bst_delete_value(BSTree_T tree, void *value)
         free(z); 
 }
 
+size_t bst_count(BSTree_T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *n = private_bst_lower_bound(tree, value, tree->compare); 
+        size_t count = 0; 
+
+        while (n != NULL && tree->compare.func(value, n->value, tree->compare.ctx) == 0) {
+                count += n->count; 
+                n = private_bst_next_inorder(n); 
+        }
+
+        return count; 
+}
+
+Node *private_bst_lower_bound(BSTree_T tree, void *value, Compare compare)
+{
+        Node *curr = tree->root; 
+        Node *bound = NULL; 
+
+        while (curr != NULL) {
+                if (compare.func(value, curr->value, compare.ctx) <= 0) {
+                        bound = curr; 
+                        curr = curr->left; 
+                } else {
+                        curr = curr->right; 
+                }
+        }
+
+        return bound; 
+}
+
+Node *private_bst_next_inorder(Node *n)
+{
+        if (n->right != NULL)
+                return private_bst_minimum(n->right); 
+
+        while (n->parent != NULL && n == n->parent->right)
+                n = n->parent; 
+
+        return n->parent; 
+}
+
 void bst_transplant(BSTree_T tree, Node *u, Node *v)
 {
         if (u->parent == NULL) {
@@ -247,23 +375,22 @@ Node *private_bst_maximum(Node *x)
 
 void *bst_successor_of_value(BSTree_T tree, void *value)
 {
-        return private_bst_successor_of_value(tree, value, tree->comparison_func); 
+        return private_bst_successor_of_value(tree, value, tree->compare); 
 }
 
 void *bst_predecessor_of_value(BSTree_T tree, void *value)
 {
-        return private_bst_predecessor_of_value(tree, value, tree->comparison_func); 
+        return private_bst_predecessor_of_value(tree, value, tree->compare); 
 } 
 
-void *private_bst_successor_of_value(BSTree_T tree, void *value, 
-                                 void *comparison_func(void *val1, void *val2))
+void *private_bst_successor_of_value(BSTree_T tree, void *value, Compare compare)
 {
         Node *curr_node = tree->root; 
         Node *successor = NULL; 
         int c; 
 
         while (curr_node != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr_node->value);
+                c = compare.func(value, curr_node->value, compare.ctx);
 
                 if (c < 0) {
                         successor = curr_node; 
@@ -279,15 +406,14 @@ void *private_bst_successor_of_value(BSTree_T tree, void *value,
                 return successor->value; 
 }
 
-void *private_bst_predecessor_of_value(BSTree_T tree, void *value, 
-                                   void *comparison_func(void *val1, void *val2))
+void *private_bst_predecessor_of_value(BSTree_T tree, void *value, Compare compare)
 {
         Node *curr_node = tree->root; 
         Node *successor = NULL; 
         int c; 
 
         while (curr_node != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr_node->value);
+                c = compare.func(value, curr_node->value, compare.ctx);
                 if (c > 0) {
                         successor = curr_node; 
                         curr_node = curr_node->right; 
@@ -367,3 +493,18 @@ void private_bst_map_postorder(Node *root,
 
         func_to_apply(root->value, depth, cl); 
 }
+
+void bst_map_range(BSTree_T tree, void *lo, void *hi, 
+                   bool func_to_apply(void *value, void *cl), void *cl)
+{
+        assert(tree != NULL && lo != NULL && hi != NULL && func_to_apply != NULL); 
+
+        Compare compare = tree->compare; 
+
+        for (Node *n = private_bst_lower_bound(tree, lo, compare); 
+             n != NULL && compare.func(hi, n->value, compare.ctx) >= 0; 
+             n = private_bst_next_inorder(n)) {
+                if (!func_to_apply(n->value, cl))
+                        return; 
+        }
+}
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "comparator.h"
 
 typedef struct bs_tree *BSTree_T;
 
@@ -36,6 +37,40 @@ typedef struct bs_tree *BSTree_T;
  */
 BSTree_T bst_new(void *comparison_func); 
 
+/*
+ * bst_new_r
+ * 
+ * same as bst_new, but takes a typed comparator and a context that is
+ * passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty bst_tree
+ */
+BSTree_T bst_new_r(Comparator compare, void *ctx); 
+
+/*
+ * bst_new_multiset
+ * 
+ * same as bst_new_r, but the tree keeps a single node per distinct value,
+ * with a count of its occurrences. inserting a value equal to one already
+ * in the tree bumps that node's count (the pointer stored first is the one
+ * kept), and deleting it takes one off the count, only unlinking the node
+ * once the count reaches zero. the maps visit each distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty bst_tree
+ */
+BSTree_T bst_new_multiset(Comparator compare, void *ctx); 
+
 /*
  * bst_tree_free
  * 
@@ -81,6 +116,52 @@ bool bst_is_empty(BSTree_T tree);
  */
 int bst_insert_value(BSTree_T tree, void *value);
 
+/*
+ * bst_insert_unique
+ * 
+ * given a tree and a value, inserts the value unless an equal value is 
+ * already stored, in which case the tree is left as it is and the stored
+ * value is returned. finds and inserts in a single descent, where calling
+ * bst_search and then bst_insert_value takes two. in a multiset, an 
+ * equal value's count is not changed
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         system out of memory
+ * 
+ * @param       BSTree_T - tree in which to insert value
+ * @param       void * - value to be inserted
+ * @return      void * - the equal value already stored, or NULL if value
+ *                      was inserted
+ */
+void *bst_insert_unique(BSTree_T tree, void *value); 
+
+/*
+ * bst_upsert
+ * 
+ * same as bst_insert_unique, but when an equal value is already stored
+ * it is replaced with what merge returns for it, in the same descent
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ *              merge == NULL
+ * UREs         system out of memory
+ *              merge returns a value that is not equal to value
+ * 
+ * @param       BSTree_T - tree in which to insert value
+ * @param       void * - value to be inserted
+ * @param       void * - function giving the value to store in place of an
+ *                      equal one
+ *              @param          the stored value
+ *              @param          the value being inserted
+ *              @param          the closure passed to bst_upsert
+ *              @return         the value to store
+ * @param       void * - closure passed to merge
+ * @return      void * - the value stored in the tree afterwards
+ */
+void *bst_upsert(BSTree_T tree, void *value, 
+                 void *merge(void *stored, void *value, void *cl), void *cl); 
+
 /*
  * bst_search
  * 
@@ -99,6 +180,8 @@ void *bst_search(BSTree_T tree, void *value);
  * 
  * given a value, deletes the first instance of it that is found in the tree
  * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its node instead, and only
+ * deletes the node when that reaches zero
  * 
  * CREs         tree == NULL
  * UREs         n/a
@@ -109,6 +192,23 @@ void *bst_search(BSTree_T tree, void *value);
  */
 void bst_delete_value(BSTree_T tree, void *value); 
 
+/*
+ * bst_count
+ * 
+ * given a tree and a value, returns how many times the value is stored:
+ * the count of its node in a multiset, or the number of equal nodes
+ * otherwise. returns 0 if the value is not in the tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       BSTree_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t bst_count(BSTree_T tree, void *value); 
+
 /*
  * bst_tree_minimum
  * 
@@ -256,4 +356,32 @@ void bst_map_postorder(BSTree_T tree,
                        void func_to_apply(void *value, int depth, void *cl), 
                        void *cl); 
 
+/*
+ * bst_map_range
+ * 
+ * given a tree, two bounds and a pointer to a function, applies the 
+ * function to the values stored between the bounds, both included, in 
+ * sorted order, for as long as it returns true. the walk descends 
+ * straight to lo and stops at the first value past hi, so visiting k 
+ * values costs O(h + k), h the height of the tree, rather than a walk 
+ * over the whole tree. in a multiset, each distinct value is visited once
+ * 
+ * CREs         tree == NULL
+ *              lo == NULL
+ *              hi == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure
+ * 
+ * @param       BSTree_T - tree to apply function to
+ * @param       void * - the lower bound
+ * @param       void * - the upper bound
+ * @param       void * - pointer to a function, returning false to stop 
+ *                      the walk
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void bst_map_range(BSTree_T tree, void *lo, void *hi, 
+                   bool func_to_apply(void *value, void *cl), void *cl); 
+
 #endif
@@ -0,0 +1,952 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "bplus_tree.h"
+#include "simd_search.h"
+#include <string.h>
+#include <stdint.h>
+
+/*** MACRO DEFINITIONS ***/
+
+#define BPT_HEADER_BYTES sizeof(void *)
+
+#define INTERNAL_KEYS ((BPT_NODE_BYTES - BPT_HEADER_BYTES - sizeof(void *)) \
+                       / (2 * sizeof(void *)))
+#define LEAF_VALUES ((BPT_NODE_BYTES - BPT_HEADER_BYTES - 3 * sizeof(void *)) \
+                     / sizeof(void *))
+
+#define INTERNAL_MIN_KEYS (INTERNAL_KEYS / 2)
+#define LEAF_MIN_VALUES (LEAF_VALUES / 2)
+
+typedef struct Node {
+        unsigned short is_leaf;
+        unsigned short count;   /* separators in an internal node, values in a leaf */
+        union {
+                struct {
+                        void *keys[INTERNAL_KEYS];
+                        struct Node *children[INTERNAL_KEYS + 1];
+                } internal;
+                struct {
+                        struct Node *prev;
+                        struct Node *next;
+                        uint32_t *counts;       /* occurrences of each value, in a multiset */
+                        void *values[LEAF_VALUES];
+                } leaf;
+        } u;
+} Node;
+
+struct bplus_tree {
+        Node *root;
+        Compare compare;
+        int height;             /* depth of the leaves; 0 when the root is a leaf */
+        bool integer_keys;      /* values are intptr_t; node searches use simd_search */
+        bool multiset;          /* leaves keep one slot per distinct value, with counts */
+};
+
+typedef BPlusTree_T T;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * bpt_construct_node
+ *
+ * allocates an empty node aligned to a cache line boundary
+ *
+ * CREs         n/a
+ * UREs         system out of memory
+ *
+ * @param       bool - true for a leaf, false for an internal node
+ * @return      Node * - the new node
+ */
+Node *bpt_construct_node(bool is_leaf);
+
+/*
+ * private_bpt_construct_leaf
+ *
+ * allocates an empty leaf, with room for its counts if tree is a multiset
+ *
+ * CREs         n/a
+ * UREs         system out of memory
+ *
+ * @param       T - tree the leaf is for
+ * @return      Node * - the new leaf
+ */
+Node *private_bpt_construct_leaf(T tree);
+void private_bpt_free_node(Node *n);
+
+/*
+ * private_bpt_move_values
+ *
+ * moves n values of the leaf src, starting at index from, to index to of
+ * the leaf dst, along with their counts if the leaves keep them. the two
+ * ranges may overlap
+ *
+ * @param       Node * - leaf to move the values to
+ * @param       int - index of the first destination slot
+ * @param       Node * - leaf to move the values from
+ * @param       int - index of the first value moved
+ * @param       int - number of values to move
+ * @return      n/a
+ */
+void private_bpt_move_values(Node *dst, int to, Node *src, int from, int n);
+
+/*
+ * private_bpt_find_equal
+ *
+ * returns the leaf holding the first value equal to value, with that
+ * value's index in *pos, or NULL if there is none
+ *
+ * CREs         tree is empty
+ *
+ * @param       T - tree to search
+ * @param       void * - value to search for
+ * @param       int * - where to store the index of the value in the leaf
+ * @return      Node * - the leaf, or NULL
+ */
+Node *private_bpt_find_equal(T tree, void *value, int *pos);
+
+/*
+ * private_bpt_compare_integers
+ *
+ * comparison function for trees made by bpt_new_integer; used wherever a 
+ * single pair of values is compared outside the node searches
+ */
+int private_bpt_compare_integers(const void *val1, const void *val2, void *ctx);
+
+void private_bpt_deallocate_all_tree_nodes(Node *n);
+
+/*
+ * private_bpt_lower_bound
+ *
+ * returns the index of the first of the count sorted keys that is not
+ * less than value (count if there is none). integer keyed trees hand the
+ * whole array to the vector kernels in simd_search.h
+ *
+ * @param       T - tree whose comparison function is used
+ * @param       void ** - sorted array of keys
+ * @param       int - number of keys in the array
+ * @param       void * - value to locate
+ * @return      int - index in [0, count]
+ */
+int private_bpt_lower_bound(T tree, void **keys, int count, void *value);
+
+/*
+ * private_bpt_upper_bound
+ *
+ * returns the index of the first of the count sorted keys that is greater
+ * than value (count if there is none)
+ *
+ * @param       T - tree whose comparison function is used
+ * @param       void ** - sorted array of keys
+ * @param       int - number of keys in the array
+ * @param       void * - value to locate
+ * @return      int - index in [0, count]
+ */
+int private_bpt_upper_bound(T tree, void **keys, int count, void *value);
+
+/*
+ * private_bpt_find_leaf
+ *
+ * descends from the root to a leaf. with upper == false the descent takes
+ * the first child that may hold value, so every leaf before the one
+ * returned holds only smaller values; with upper == true it takes the last
+ * such child, so every leaf after the one returned holds only greater
+ * values
+ *
+ * CREs         tree is empty
+ *
+ * @param       T - tree to descend
+ * @param       void * - value to descend towards
+ * @param       bool - which of the two descents to perform
+ * @return      Node * - the leaf reached
+ */
+Node *private_bpt_find_leaf(T tree, void *value, bool upper);
+
+/*
+ * private_bpt_insert
+ *
+ * inserts value into the subtree rooted at n, after any equal values. if
+ * n has to split, the new right sibling and the separator between the two
+ * are handed back for the caller to link into the parent
+ *
+ * @param       T - tree being modified
+ * @param       Node * - root of the subtree
+ * @param       void * - value to insert
+ * @param       void ** - set to the separator if n split
+ * @param       Node ** - set to n's new right sibling if n split
+ * @return      bool - true if n split
+ */
+bool private_bpt_insert(T tree, Node *n, void *value, void **separator,
+                        Node **sibling);
+bool private_bpt_insert_into_leaf(T tree, Node *leaf, void *value,
+                                  void **separator, Node **sibling);
+bool private_bpt_insert_into_internal(Node *n, int index, void *key,
+                                      Node *child, void **separator,
+                                      Node **sibling);
+
+/*
+ * private_bpt_delete
+ *
+ * removes the first instance of value from the subtree rooted at n,
+ * repairing any child that drops below its minimum occupancy on the way
+ * back up. n itself may be left underfull; that is its parent's job.
+ *
+ * every separator is the first value of the leftmost leaf to its right,
+ * so removing the first value of a leaf can leave one ancestor holding
+ * the caller's pointer to a value no longer in the tree. the removed
+ * value is handed back up in *stale, with the leaf's new first value
+ * (or, if the leaf emptied, the first value after it) in *replacement,
+ * and each level swaps it out of its keys before repairing its children
+ *
+ * @param       T - tree being modified
+ * @param       Node * - root of the subtree
+ * @param       void * - value to remove
+ * @param       void ** - set to the removed value if a separator may
+ *                      point to it; left alone otherwise
+ * @param       void ** - set to the value to put in its place
+ * @return      bool - true if a value was removed
+ */
+bool private_bpt_delete(T tree, Node *n, void *value, void **stale, 
+                        void **replacement);
+
+/*
+ * private_bpt_fix_underflow
+ *
+ * restores the minimum occupancy of n's index-th child by borrowing from
+ * or merging with a sibling. n may be left underfull by a merge
+ *
+ * @param       Node * - parent of the underfull child
+ * @param       int - index of the underfull child
+ * @return      n/a
+ */
+void private_bpt_fix_underflow(Node *n, int index);
+void private_bpt_remove_from_internal(Node *n, int key_index, int child_index);
+
+Node *private_bpt_leftmost_leaf(Node *n);
+Node *private_bpt_rightmost_leaf(Node *n);
+void private_bpt_map_leaves(T tree,
+                            void func_to_apply(void *value, int depth, void *cl),
+                            void *cl);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T bpt_new(void *comparison_func)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return bpt_new_r(compare.func, compare.ctx); 
+}
+
+T bpt_new_r(Comparator compare, void *ctx)
+{
+        assert(compare != NULL); 
+
+        T tree = malloc(sizeof(struct bplus_tree)); 
+
+        tree->root = NULL; 
+        tree->height = 0; 
+        tree->integer_keys = false; 
+        tree->multiset = false; 
+
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+
+        return tree; 
+}
+
+T bpt_new_multiset(Comparator compare, void *ctx)
+{
+        T tree = bpt_new_r(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+T bpt_new_integer(void)
+{
+        T tree = bpt_new_r(&private_bpt_compare_integers, NULL); 
+
+        tree->integer_keys = true; 
+
+        return tree; 
+}
+
+int private_bpt_compare_integers(const void *val1, const void *val2, void *ctx)
+{
+        intptr_t a = (intptr_t) val1; 
+        intptr_t b = (intptr_t) val2; 
+
+        (void) ctx; 
+
+        return (a > b) - (a < b); 
+}
+
+void bpt_tree_free(T tree)
+{
+        assert(tree != NULL); 
+
+        private_bpt_deallocate_all_tree_nodes(tree->root); 
+        free(tree); 
+}
+
+void private_bpt_deallocate_all_tree_nodes(Node *n)
+{
+        if (n == NULL)
+                return; 
+
+        if (!n->is_leaf) {
+                for (int i = 0; i <= n->count; i++)
+                        private_bpt_deallocate_all_tree_nodes(n->u.internal.children[i]); 
+        }
+
+        private_bpt_free_node(n); 
+}
+
+bool bpt_tree_is_empty(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->root == NULL; 
+}
+
+Node *bpt_construct_node(bool is_leaf)
+{
+        void *memory = NULL; 
+
+        assert(sizeof(Node) <= BPT_NODE_BYTES); 
+        if (posix_memalign(&memory, BPT_CACHE_LINE, BPT_NODE_BYTES) != 0)
+                return NULL; 
+
+        Node *new_node = memory; 
+        new_node->is_leaf = is_leaf; 
+        new_node->count = 0; 
+
+        if (is_leaf) {
+                new_node->u.leaf.prev = NULL; 
+                new_node->u.leaf.next = NULL; 
+                new_node->u.leaf.counts = NULL; 
+        }
+
+        return new_node; 
+}
+
+Node *private_bpt_construct_leaf(T tree)
+{
+        Node *leaf = bpt_construct_node(true); 
+
+        if (tree->multiset)
+                leaf->u.leaf.counts = malloc(LEAF_VALUES * sizeof(uint32_t)); 
+
+        return leaf; 
+}
+
+void private_bpt_free_node(Node *n)
+{
+        if (n->is_leaf)
+                free(n->u.leaf.counts); 
+
+        free(n); 
+}
+
+void private_bpt_move_values(Node *dst, int to, Node *src, int from, int n)
+{
+        memmove(&dst->u.leaf.values[to], &src->u.leaf.values[from], n * sizeof(void *)); 
+
+        /* the leaves of one tree either all keep counts or none do */
+        if (dst->u.leaf.counts != NULL)
+                memmove(&dst->u.leaf.counts[to], &src->u.leaf.counts[from],
+                        n * sizeof(uint32_t)); 
+}
+
+int private_bpt_lower_bound(T tree, void **keys, int count, void *value)
+{
+        if (tree->integer_keys)
+                return simd_lower_bound(keys, count, (intptr_t) value); 
+
+        Compare compare = tree->compare; 
+        int lo = 0; 
+        int hi = count; 
+
+        while (lo < hi) {
+                int mid = lo + (hi - lo) / 2; 
+
+                if (compare.func(keys[mid], value, compare.ctx) < 0)
+                        lo = mid + 1; 
+                else
+                        hi = mid; 
+        }
+
+        return lo; 
+}
+
+int private_bpt_upper_bound(T tree, void **keys, int count, void *value)
+{
+        if (tree->integer_keys)
+                return simd_upper_bound(keys, count, (intptr_t) value); 
+
+        Compare compare = tree->compare; 
+        int lo = 0; 
+        int hi = count; 
+
+        while (lo < hi) {
+                int mid = lo + (hi - lo) / 2; 
+
+                if (compare.func(keys[mid], value, compare.ctx) <= 0)
+                        lo = mid + 1; 
+                else
+                        hi = mid; 
+        }
+
+        return lo; 
+}
+
+Node *private_bpt_find_leaf(T tree, void *value, bool upper)
+{
+        Node *n = tree->root; 
+
+        while (!n->is_leaf) {
+                int i; 
+
+                if (upper)
+                        i = private_bpt_upper_bound(tree, n->u.internal.keys, n->count, value); 
+                else
+                        i = private_bpt_lower_bound(tree, n->u.internal.keys, n->count, value); 
+
+                n = n->u.internal.children[i]; 
+        }
+
+        return n; 
+}
+
+int bpt_insert_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        if (tree->root == NULL) {
+                tree->root = private_bpt_construct_leaf(tree); 
+                tree->height = 0; 
+        } else if (tree->multiset) {
+                int pos; 
+                Node *leaf = private_bpt_find_equal(tree, value, &pos); 
+
+                if (leaf != NULL) {
+                        leaf->u.leaf.counts[pos]++; 
+                        return 0; 
+                }
+        }
+
+        void *separator = NULL; 
+        Node *sibling = NULL; 
+
+        if (private_bpt_insert(tree, tree->root, value, &separator, &sibling)) {
+                Node *new_root = bpt_construct_node(false); 
+
+                new_root->count = 1; 
+                new_root->u.internal.keys[0] = separator; 
+                new_root->u.internal.children[0] = tree->root; 
+                new_root->u.internal.children[1] = sibling; 
+
+                tree->root = new_root; 
+                tree->height++; 
+        }
+
+        return 0; 
+}
+
+bool private_bpt_insert(T tree, Node *n, void *value, void **separator,
+                        Node **sibling)
+{
+        if (n->is_leaf)
+                return private_bpt_insert_into_leaf(tree, n, value, separator, sibling); 
+
+        int i = private_bpt_upper_bound(tree, n->u.internal.keys, n->count, value); 
+        void *child_separator = NULL; 
+        Node *child_sibling = NULL; 
+
+        if (!private_bpt_insert(tree, n->u.internal.children[i], value,
+                                &child_separator, &child_sibling))
+                return false; 
+
+        return private_bpt_insert_into_internal(n, i, child_separator,
+                                                child_sibling, separator, sibling); 
+}
+
+bool private_bpt_insert_into_leaf(T tree, Node *leaf, void *value,
+                                  void **separator, Node **sibling)
+{
+        void **values = leaf->u.leaf.values; 
+        int count = leaf->count; 
+        int pos = private_bpt_upper_bound(tree, values, count, value); 
+
+        uint32_t *counts = leaf->u.leaf.counts; 
+
+        if (count < (int) LEAF_VALUES) {
+                private_bpt_move_values(leaf, pos + 1, leaf, pos, count - pos); 
+                values[pos] = value; 
+                if (counts != NULL)
+                        counts[pos] = 1; 
+                leaf->count++; 
+                return false; 
+        }
+
+        /* full: lay out all LEAF_VALUES + 1 values, then split them in two */
+        void *all[LEAF_VALUES + 1]; 
+        uint32_t all_counts[LEAF_VALUES + 1]; 
+
+        memcpy(all, values, pos * sizeof(void *)); 
+        all[pos] = value; 
+        memcpy(&all[pos + 1], &values[pos], (count - pos) * sizeof(void *)); 
+
+        int left_count = (LEAF_VALUES + 1) / 2; 
+        int right_count = LEAF_VALUES + 1 - left_count; 
+        Node *right = private_bpt_construct_leaf(tree); 
+
+        memcpy(values, all, left_count * sizeof(void *)); 
+        memcpy(right->u.leaf.values, &all[left_count], right_count * sizeof(void *)); 
+        leaf->count = left_count; 
+        right->count = right_count; 
+
+        if (counts != NULL) {
+                memcpy(all_counts, counts, pos * sizeof(uint32_t)); 
+                all_counts[pos] = 1; 
+                memcpy(&all_counts[pos + 1], &counts[pos], (count - pos) * sizeof(uint32_t)); 
+                memcpy(counts, all_counts, left_count * sizeof(uint32_t)); 
+                memcpy(right->u.leaf.counts, &all_counts[left_count], 
+                       right_count * sizeof(uint32_t)); 
+        }
+
+        right->u.leaf.next = leaf->u.leaf.next; 
+        right->u.leaf.prev = leaf; 
+        if (leaf->u.leaf.next != NULL)
+                leaf->u.leaf.next->u.leaf.prev = right; 
+        leaf->u.leaf.next = right; 
+
+        *separator = right->u.leaf.values[0]; 
+        *sibling = right; 
+
+        return true; 
+}
+
+bool private_bpt_insert_into_internal(Node *n, int index, void *key,
+                                      Node *child, void **separator,
+                                      Node **sibling)
+{
+        void **keys = n->u.internal.keys; 
+        Node **children = n->u.internal.children; 
+        int count = n->count; 
+
+        if (count < (int) INTERNAL_KEYS) {
+                memmove(&keys[index + 1], &keys[index], (count - index) * sizeof(void *)); 
+                memmove(&children[index + 2], &children[index + 1],
+                        (count - index) * sizeof(Node *)); 
+                keys[index] = key; 
+                children[index + 1] = child; 
+                n->count++; 
+                return false; 
+        }
+
+        void *all_keys[INTERNAL_KEYS + 1]; 
+        Node *all_children[INTERNAL_KEYS + 2]; 
+
+        memcpy(all_keys, keys, index * sizeof(void *)); 
+        all_keys[index] = key; 
+        memcpy(&all_keys[index + 1], &keys[index], (count - index) * sizeof(void *)); 
+
+        memcpy(all_children, children, (index + 1) * sizeof(Node *)); 
+        all_children[index + 1] = child; 
+        memcpy(&all_children[index + 2], &children[index + 1],
+               (count - index) * sizeof(Node *)); 
+
+        /* the middle key moves up; the halves on either side stay behind */
+        int mid = (INTERNAL_KEYS + 1) / 2; 
+        int right_count = INTERNAL_KEYS - mid; 
+        Node *right = bpt_construct_node(false); 
+
+        memcpy(keys, all_keys, mid * sizeof(void *)); 
+        memcpy(children, all_children, (mid + 1) * sizeof(Node *)); 
+        n->count = mid; 
+
+        memcpy(right->u.internal.keys, &all_keys[mid + 1], right_count * sizeof(void *)); 
+        memcpy(right->u.internal.children, &all_children[mid + 1],
+               (right_count + 1) * sizeof(Node *)); 
+        right->count = right_count; 
+
+        *separator = all_keys[mid]; 
+        *sibling = right; 
+
+        return true; 
+}
+
+void *bpt_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        int pos; 
+        Node *leaf = private_bpt_find_equal(tree, value, &pos); 
+
+        return (leaf == NULL) ? NULL : leaf->u.leaf.values[pos]; 
+}
+
+Node *private_bpt_find_equal(T tree, void *value, int *pos)
+{
+        Node *leaf = private_bpt_find_leaf(tree, value, false); 
+        int i = private_bpt_lower_bound(tree, leaf->u.leaf.values, leaf->count, value); 
+
+        /* every leaf before this one is smaller, so the match can only be
+         * here or at the very front of the next leaf */
+        if (i == leaf->count) {
+                leaf = leaf->u.leaf.next; 
+                i = 0; 
+                if (leaf == NULL)
+                        return NULL; 
+        }
+
+        Compare compare = tree->compare; 
+
+        if (compare.func(value, leaf->u.leaf.values[i], compare.ctx) != 0)
+                return NULL; 
+
+        *pos = i; 
+
+        return leaf; 
+}
+
+void bpt_delete_value(T tree, void *value)
+{
+        assert(tree != NULL && (value != NULL || tree->integer_keys)); 
+
+        if (tree->root == NULL)
+                return; 
+
+        void *stale = NULL; 
+        void *replacement = NULL; 
+
+        if (!private_bpt_delete(tree, tree->root, value, &stale, &replacement))
+                return; 
+
+        Node *root = tree->root; 
+
+        if (root->is_leaf && root->count == 0) {
+                private_bpt_free_node(root); 
+                tree->root = NULL; 
+        } else if (!root->is_leaf && root->count == 0) {
+                tree->root = root->u.internal.children[0]; 
+                tree->height--; 
+                free(root); 
+        }
+}
+
+bool private_bpt_delete(T tree, Node *n, void *value, void **stale, 
+                        void **replacement)
+{
+        Compare compare = tree->compare; 
+
+        if (n->is_leaf) {
+                void **values = n->u.leaf.values; 
+                int pos = private_bpt_lower_bound(tree, values, n->count, value); 
+
+                if (pos == n->count ||
+                    compare.func(value, values[pos], compare.ctx) != 0)
+                        return false; 
+
+                /* one occurrence of a counted value goes, and the slot stays */
+                if (n->u.leaf.counts != NULL && --n->u.leaf.counts[pos] > 0)
+                        return true; 
+
+                /* integer keys are never dereferenced, so a stale one is harmless */
+                if (pos == 0 && !tree->integer_keys) {
+                        Node *next = n->u.leaf.next; 
+
+                        *stale = values[0]; 
+                        if (n->count > 1)
+                                *replacement = values[1]; 
+                        else
+                                *replacement = (next == NULL) ? NULL : next->u.leaf.values[0]; 
+                }
+
+                private_bpt_move_values(n, pos, n, pos + 1, n->count - pos - 1); 
+                n->count--; 
+
+                return true; 
+        }
+
+        void **keys = n->u.internal.keys; 
+        int i = private_bpt_lower_bound(tree, keys, n->count, value); 
+
+        /*
+         * children before i hold only smaller values. equal values can
+         * spill over into the next child only past a separator equal to
+         * value, so keep moving right for as long as that is the case
+         */
+        while (!private_bpt_delete(tree, n->u.internal.children[i], value, 
+                                   stale, replacement)) {
+                if (i == n->count ||
+                    compare.func(value, keys[i], compare.ctx) != 0)
+                        return false; 
+                i++; 
+        }
+
+        /*
+         * before any borrow or merge moves keys between levels. a NULL 
+         * replacement only reaches the parent of an emptied rightmost 
+         * leaf, whose repair below then drops or overwrites the key
+         */
+        if (*stale != NULL) {
+                for (int j = 0; j < n->count; j++) {
+                        if (keys[j] == *stale)
+                                keys[j] = *replacement; 
+                }
+        }
+
+        Node *child = n->u.internal.children[i]; 
+        int minimum = child->is_leaf ? (int) LEAF_MIN_VALUES : (int) INTERNAL_MIN_KEYS; 
+
+        if (child->count < minimum)
+                private_bpt_fix_underflow(n, i); 
+
+        return true; 
+}
+
+void private_bpt_fix_underflow(Node *n, int index)
+{
+        Node **children = n->u.internal.children; 
+        void **keys = n->u.internal.keys; 
+        Node *child = children[index]; 
+        Node *left = (index > 0) ? children[index - 1] : NULL; 
+        Node *right = (index < n->count) ? children[index + 1] : NULL; 
+
+        if (child->is_leaf) {
+                void **values = child->u.leaf.values; 
+
+                if (left != NULL && left->count > (int) LEAF_MIN_VALUES) {
+                        private_bpt_move_values(child, 1, child, 0, child->count); 
+                        private_bpt_move_values(child, 0, left, --left->count, 1); 
+                        child->count++; 
+                        keys[index - 1] = values[0]; 
+                } else if (right != NULL && right->count > (int) LEAF_MIN_VALUES) {
+                        private_bpt_move_values(child, child->count++, right, 0, 1); 
+                        private_bpt_move_values(right, 0, right, 1, --right->count); 
+                        keys[index] = right->u.leaf.values[0]; 
+                } else {
+                        /* merge the right one of the pair into the left one */
+                        if (left == NULL) {
+                                left = child; 
+                                index++; 
+                        }
+                        Node *victim = children[index]; 
+
+                        private_bpt_move_values(left, left->count, victim, 0, victim->count); 
+                        left->count += victim->count; 
+
+                        left->u.leaf.next = victim->u.leaf.next; 
+                        if (victim->u.leaf.next != NULL)
+                                victim->u.leaf.next->u.leaf.prev = left; 
+
+                        private_bpt_remove_from_internal(n, index - 1, index); 
+                        private_bpt_free_node(victim); 
+                }
+
+                return; 
+        }
+
+        void **child_keys = child->u.internal.keys; 
+        Node **child_children = child->u.internal.children; 
+
+        if (left != NULL && left->count > (int) INTERNAL_MIN_KEYS) {
+                /* rotate right through the separator */
+                memmove(&child_keys[1], &child_keys[0], child->count * sizeof(void *)); 
+                memmove(&child_children[1], &child_children[0],
+                        (child->count + 1) * sizeof(Node *)); 
+                child_keys[0] = keys[index - 1]; 
+                child_children[0] = left->u.internal.children[left->count]; 
+                child->count++; 
+
+                keys[index - 1] = left->u.internal.keys[left->count - 1]; 
+                left->count--; 
+        } else if (right != NULL && right->count > (int) INTERNAL_MIN_KEYS) {
+                /* rotate left through the separator */
+                child_keys[child->count] = keys[index]; 
+                child_children[child->count + 1] = right->u.internal.children[0]; 
+                child->count++; 
+
+                keys[index] = right->u.internal.keys[0]; 
+                memmove(&right->u.internal.keys[0], &right->u.internal.keys[1],
+                        (right->count - 1) * sizeof(void *)); 
+                memmove(&right->u.internal.children[0], &right->u.internal.children[1],
+                        right->count * sizeof(Node *)); 
+                right->count--; 
+        } else {
+                if (left == NULL) {
+                        left = child; 
+                        index++; 
+                }
+                Node *victim = children[index]; 
+
+                left->u.internal.keys[left->count] = keys[index - 1]; 
+                memcpy(&left->u.internal.keys[left->count + 1], victim->u.internal.keys,
+                       victim->count * sizeof(void *)); 
+                memcpy(&left->u.internal.children[left->count + 1],
+                       victim->u.internal.children,
+                       (victim->count + 1) * sizeof(Node *)); 
+                left->count += victim->count + 1; 
+
+                private_bpt_remove_from_internal(n, index - 1, index); 
+                free(victim); 
+        }
+}
+
+size_t bpt_count(T tree, void *value)
+{
+        assert(tree != NULL && (value != NULL || tree->integer_keys)); 
+
+        if (tree->root == NULL)
+                return 0; 
+
+        Compare compare = tree->compare; 
+        Node *leaf = private_bpt_find_leaf(tree, value, false); 
+        int pos = private_bpt_lower_bound(tree, leaf->u.leaf.values, leaf->count, value); 
+        size_t count = 0; 
+
+        /* equal values may run on across several leaves */
+        for (; leaf != NULL; leaf = leaf->u.leaf.next, pos = 0) {
+                for (; pos < leaf->count; pos++) {
+                        if (compare.func(value, leaf->u.leaf.values[pos], compare.ctx) != 0)
+                                return count; 
+                        count += (leaf->u.leaf.counts == NULL) ? 1 : leaf->u.leaf.counts[pos]; 
+                }
+        }
+
+        return count; 
+}
+
+void private_bpt_remove_from_internal(Node *n, int key_index, int child_index)
+{
+        void **keys = n->u.internal.keys; 
+        Node **children = n->u.internal.children; 
+
+        memmove(&keys[key_index], &keys[key_index + 1],
+                (n->count - key_index - 1) * sizeof(void *)); 
+        memmove(&children[child_index], &children[child_index + 1],
+                (n->count - child_index) * sizeof(Node *)); 
+        n->count--; 
+}
+
+Node *private_bpt_leftmost_leaf(Node *n)
+{
+        while (!n->is_leaf)
+                n = n->u.internal.children[0]; 
+
+        return n; 
+}
+
+Node *private_bpt_rightmost_leaf(Node *n)
+{
+        while (!n->is_leaf)
+                n = n->u.internal.children[n->count]; 
+
+        return n; 
+}
+
+void *bpt_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        return private_bpt_leftmost_leaf(tree->root)->u.leaf.values[0]; 
+}
+
+void *bpt_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        Node *leaf = private_bpt_rightmost_leaf(tree->root); 
+
+        return leaf->u.leaf.values[leaf->count - 1]; 
+}
+
+void *bpt_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && (value != NULL || tree->integer_keys)); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        Node *leaf = private_bpt_find_leaf(tree, value, true); 
+        int pos = private_bpt_upper_bound(tree, leaf->u.leaf.values, leaf->count, value); 
+
+        if (pos < leaf->count)
+                return leaf->u.leaf.values[pos]; 
+
+        /* every leaf after this one holds only greater values */
+        leaf = leaf->u.leaf.next; 
+
+        return (leaf == NULL) ? NULL : leaf->u.leaf.values[0]; 
+}
+
+void *bpt_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && (value != NULL || tree->integer_keys)); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        Node *leaf = private_bpt_find_leaf(tree, value, false); 
+        int pos = private_bpt_lower_bound(tree, leaf->u.leaf.values, leaf->count, value); 
+
+        if (pos > 0)
+                return leaf->u.leaf.values[pos - 1]; 
+
+        /* every leaf before this one holds only smaller values */
+        leaf = leaf->u.leaf.prev; 
+
+        return (leaf == NULL) ? NULL : leaf->u.leaf.values[leaf->count - 1]; 
+}
+
+void private_bpt_map_leaves(T tree,
+                            void func_to_apply(void *value, int depth, void *cl),
+                            void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        if (tree->root == NULL)
+                return; 
+
+        for (Node *leaf = private_bpt_leftmost_leaf(tree->root); leaf != NULL; 
+             leaf = leaf->u.leaf.next) {
+                for (int i = 0; i < leaf->count; i++)
+                        func_to_apply(leaf->u.leaf.values[i], tree->height, cl); 
+        }
+}
+
+void bpt_map_inorder(T tree,
+                     void func_to_apply(void *value, int depth, void *cl),
+                     void *cl)
+{
+        private_bpt_map_leaves(tree, func_to_apply, cl); 
+}
+
+void bpt_map_preorder(T tree,
+                      void func_to_apply(void *value, int depth, void *cl),
+                      void *cl)
+{
+        private_bpt_map_leaves(tree, func_to_apply, cl); 
+}
+
+void bpt_map_postorder(T tree,
+                       void func_to_apply(void *value, int depth, void *cl),
+                       void *cl)
+{
+        private_bpt_map_leaves(tree, func_to_apply, cl); 
+}
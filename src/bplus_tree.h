@@ -0,0 +1,372 @@
+/**********************************************************************
+ * bplus_tree.h                                                       *
+ *                                                                    *
+ * Interface for a polymorphic, cache-aware B+ tree. every node       *
+ * occupies a whole number of cache lines, values are kept only in    *
+ * the leaves, and the leaves are linked in both directions so that   *
+ * ordered walks run as sequential scans. it offers the same ordered  *
+ * set operations as rb_tree.h                                        *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef BPLUS_TREE_H
+#define BPLUS_TREE_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "comparator.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+/* 
+ * node geometry: each node is BPT_NODE_LINES cache lines long, and the 
+ * fanouts below are whatever fits in that space once the node header 
+ * (and, for leaves, the sibling links and the pointer to a multiset's 
+ * counts) are accounted for
+ */
+#define BPT_CACHE_LINE 64
+#define BPT_NODE_LINES 4
+#define BPT_NODE_BYTES (BPT_CACHE_LINE * BPT_NODE_LINES)
+
+typedef struct bplus_tree *BPlusTree_T;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * bpt_new
+ * 
+ * returns a pointer to a new, empty B+ tree
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ *              
+ * 
+ * @param       void * - pointer to a comparison function. if NULL is passed 
+ *                              as argument, strcmp is assumed. 
+ *              
+ *              comparison_function
+ *              @param          item being inserted (val1)
+ *              @param          item from tree which we are comparing (val2)
+ *              @return         int 
+ *                               - zero (0) if val1 == val2
+ *                               - positive value (n > 0) if val1 > val2
+ *                               - negative value (n < 0) if val1 < val2
+ *        
+ * @return      pointer to empty bplus_tree
+ */
+BPlusTree_T bpt_new(void *comparison_func); 
+
+/*
+ * bpt_new_r
+ * 
+ * same as bpt_new, but takes a typed comparator and a context that is
+ * passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty bplus_tree
+ */
+BPlusTree_T bpt_new_r(Comparator compare, void *ctx); 
+
+/*
+ * bpt_new_multiset
+ * 
+ * same as bpt_new_r, but the leaves keep a single slot per distinct 
+ * value, with a count of its occurrences. inserting a value equal to one
+ * already in the tree bumps that slot's count (the pointer stored first
+ * is the one kept), and deleting it takes one off the count, only 
+ * removing the value once the count reaches zero. the maps visit each 
+ * distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty bplus_tree
+ */
+BPlusTree_T bpt_new_multiset(Comparator compare, void *ctx); 
+
+/*
+ * bpt_new_integer
+ * 
+ * returns a pointer to a new, empty B+ tree whose values are integers 
+ * stored directly in the void * slots, ie inserted as (void *)(intptr_t) n 
+ * and read back with (intptr_t). values are ordered as signed integers, 
+ * and searches inside a node compare the probe against the whole key 
+ * array with the widest vector kernel the CPU supports (see 
+ * simd_search.h) rather than calling a comparison function per key
+ * 
+ * inserting 0 is still a CRE, since it is indistinguishable from NULL, 
+ * but 0 may be passed as the value to search, delete, successor and 
+ * predecessor lookups
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ * 
+ * @return      pointer to empty bplus_tree
+ */
+BPlusTree_T bpt_new_integer(void); 
+
+/*
+ * bpt_tree_free
+ * 
+ * given a pointer to a B+ tree, deallocates the tree and all nodes
+ * contained within it
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - the tree to be freed
+ * @return      n/a
+ */
+void bpt_tree_free(BPlusTree_T tree); 
+
+/*
+ * bpt_tree_is_empty
+ * 
+ * returns true if the tree is empty, and false otherwise
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - tree to be checked if empty
+ * @return      bool - true if empty, false otherwise
+ */ 
+bool bpt_tree_is_empty(BPlusTree_T tree); 
+
+/*
+ * bpt_insert_value
+ * 
+ * given a value (cast to void), inserts the value into the given tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * 
+ * UREs         system out of memory
+ *              attempting to pass in a value which cannot be compared with 
+ *                      your comparison function
+ * 
+ * @param       BPlusTree_T - tree in which to insert value
+ * @param       void * - a pointer to any item to be inserted
+ * @return      int - 0 on success
+ */
+int bpt_insert_value(BPlusTree_T tree, void *value);
+
+/*
+ * bpt_search
+ * 
+ * given a tree and a value to search for, returns a pointer to the stored 
+ * value, or NULL if the value is not found. If duplicates are in the tree, 
+ * returns the first one found
+ * 
+ * @param       BPlusTree_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *bpt_search(BPlusTree_T tree, void *value); 
+
+/*
+ * bpt_delete_value
+ * 
+ * given a value, deletes the first instance of it that is found in the tree
+ * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its slot instead, and only
+ * deletes the value when that reaches zero
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - tree to find the value in
+ * @param       void * - pointer to the value to be deleted
+ * @return      n/a
+ */
+void bpt_delete_value(BPlusTree_T tree, void *value); 
+
+/*
+ * bpt_count
+ * 
+ * given a tree and a value, returns how many times the value is stored:
+ * the count of its slot in a multiset, or the number of equal values 
+ * otherwise. returns 0 if the value is not in the tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL, unless the tree was made by bpt_new_integer
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t bpt_count(BPlusTree_T tree, void *value); 
+
+/*
+ * bpt_tree_minimum
+ * 
+ * given a tree, returns the minimum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - tree to be searched
+ * @return      void * - pointer to min value
+ */
+void *bpt_tree_minimum(BPlusTree_T tree); 
+
+/*
+ * bpt_tree_maximum
+ * 
+ * given a tree, returns the maximum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - tree to be searched
+ * @return      void * - pointer to max value
+ */
+void *bpt_tree_maximum(BPlusTree_T tree); 
+
+/*
+ * bpt_successor_of_value
+ * 
+ * given a tree and a value, returns the first successor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no successor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - tree to be searched
+ * @param       void * - value to find the successor of
+ * @return      void * - value of the successor
+ */
+void *bpt_successor_of_value(BPlusTree_T tree, void *value); 
+
+/*
+ * bpt_predecessor_of_value
+ * 
+ * given a tree and a value, returns the first predecessor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no predecessor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       BPlusTree_T - tree to be searched
+ * @param       void * - value to find the predecessor of
+ * @return      void * - value of the predecessor
+ */
+void *bpt_predecessor_of_value(BPlusTree_T tree, void *value); 
+
+/*
+ * bpt_map_inorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via an inorder walk. the walk follows the 
+ * linked leaves rather than recursing through the tree; depth is the depth
+ * of the leaf holding the value
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       BPlusTree_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void bpt_map_inorder(BPlusTree_T tree, 
+                     void func_to_apply(void *value, int depth, void *cl), 
+                     void *cl); 
+
+/*
+ * bpt_map_preorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a preorder walk. values live only in the 
+ * leaves of a B+ tree, so every walk reaches them in sorted order; depth is
+ * the depth of the leaf holding the value
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       BPlusTree_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void bpt_map_preorder(BPlusTree_T tree, 
+                      void func_to_apply(void *value, int depth, void *cl), 
+                      void *cl); 
+
+/*
+ * bpt_map_postorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a postorder walk. values live only in the 
+ * leaves of a B+ tree, so every walk reaches them in sorted order; depth is
+ * the depth of the leaf holding the value
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       BPlusTree_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void bpt_map_postorder(BPlusTree_T tree, 
+                       void func_to_apply(void *value, int depth, void *cl), 
+                       void *cl); 
+
+#endif
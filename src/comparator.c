@@ -0,0 +1,48 @@
+#include "comparator.h"
+#include <string.h>
+#include <stdint.h>
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_comparator_legacy
+ *
+ * calls the untyped comparison function held in ctx the way the engines
+ * always have, casting its result back to int
+ */
+int private_comparator_legacy(const void *val_one, const void *val_two, void *ctx);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+int comparator_strcmp(const void *val_one, const void *val_two, void *ctx)
+{
+        (void) ctx; 
+
+        return strcmp(val_one, val_two); 
+}
+
+Compare comparator_from_legacy(void *comparison_func)
+{
+        Compare compare; 
+
+        if (comparison_func == NULL) {
+                compare.func = &comparator_strcmp; 
+                compare.ctx = NULL; 
+        } else {
+                compare.func = &private_comparator_legacy; 
+                compare.ctx = comparison_func; 
+        }
+
+        return compare; 
+}
+
+int private_comparator_legacy(const void *val_one, const void *val_two, void *ctx)
+{
+        void *(*comparison_func)(void *, void *) = ctx; 
+
+        return (int)(intptr_t) comparison_func((void *) val_one, (void *) val_two); 
+}
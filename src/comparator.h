@@ -0,0 +1,77 @@
+/**********************************************************************
+ * comparator.h                                                       *
+ *                                                                    *
+ * The typed comparison function every engine stores, with the        *
+ * context it is called with, as for qsort_r. the engines' *_new      *
+ * constructors take an untyped function pointer instead, and wrap    *
+ * it with comparator_from_legacy                                     *
+ **********************************************************************/
+
+#ifndef COMPARATOR_H
+#define COMPARATOR_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+/*
+ * Comparator
+ *
+ * returns a negative int, zero or a positive int as val_one is less than,
+ * equal to or greater than val_two. ctx is whatever the tree was built
+ * with: a collation table, a key schema, or NULL
+ */
+typedef int (*Comparator)(const void *val_one, const void *val_two, void *ctx);
+
+/*
+ * Compare
+ *
+ * a comparator bound to its context. call sites read
+ * compare.func(a, b, compare.ctx)
+ */
+typedef struct Compare {
+        Comparator func;
+        void *ctx;
+} Compare;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * comparator_strcmp
+ *
+ * compares two nul terminated strings with strcmp, ignoring ctx. the
+ * default when a tree is built without a comparison function
+ *
+ * CREs         n/a
+ * UREs         either value is not a nul terminated string
+ *
+ * @param       const void * - first string
+ * @param       const void * - second string
+ * @param       void * - unused
+ * @return      int - the result of strcmp
+ */
+int comparator_strcmp(const void *val_one, const void *val_two, void *ctx);
+
+/*
+ * comparator_from_legacy
+ *
+ * adapts the untyped comparison function taken by the *_new constructors:
+ * a function of two void * that is called through a pointer returning
+ * void *, whose result is truncated to int. NULL gives comparator_strcmp.
+ * calls through the adapter cost one extra indirect call, so new code
+ * should use the *_new_r constructors
+ *
+ * CREs         n/a
+ * UREs         comparison_func does not follow the bst_new contract
+ *
+ * @param       void * - pointer to a comparison function, or NULL
+ * @return      Compare - the comparator to store in the tree
+ */
+Compare comparator_from_legacy(void *comparison_func);
+
+#endif
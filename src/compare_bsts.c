@@ -1,13 +1,781 @@
-#include "compare_bsts.h" 
+#include "compare_bsts.h"
+#include <string.h>
+#include <stdint.h>
+#include "prng.h"
+#include "wilber.h"
+#include "greedy_bst.h"
+#include "optimal_bst.h"
+#include "typed_trees.h"
+#include "intern_pool.h"
+#include "corpus.h"
+#include "ingest.h"
 
-int main()
+/*** MACRO DEFINITIONS ***/
+
+#define DEFAULT_CORPUS "txt/war_and_peace.txt"
+
+/*
+ * ENGINE_ADAPTERS
+ *
+ * defines thin wrappers that take and return void * in place of the
+ * engine's own handle type, so that all engines fit the Engine table.
+ * every engine follows the <prefix>_new / <prefix>_insert_value / ...
+ * naming scheme apart from its free function
+ */
+#define ENGINE_ADAPTERS(prefix, handle, free_func)                              \
+static void *prefix##_adapter_new(Comparator compare, void *ctx)                \
+{                                                                               \
+        return prefix##_new_r(compare, ctx);                                    \
+}                                                                               \
+static void prefix##_adapter_free(void *tree)                                   \
+{                                                                               \
+        free_func((handle) tree);                                               \
+}                                                                               \
+static int prefix##_adapter_insert_value(void *tree, void *value)               \
+{                                                                               \
+        return prefix##_insert_value((handle) tree, value);                     \
+}                                                                               \
+static void *prefix##_adapter_search(void *tree, void *value)                   \
+{                                                                               \
+        return prefix##_search((handle) tree, value);                           \
+}                                                                               \
+static void prefix##_adapter_delete_value(void *tree, void *value)              \
+{                                                                               \
+        prefix##_delete_value((handle) tree, value);                            \
+}                                                                               \
+static void *prefix##_adapter_tree_minimum(void *tree)                          \
+{                                                                               \
+        return prefix##_tree_minimum((handle) tree);                            \
+}                                                                               \
+static void *prefix##_adapter_successor_of_value(void *tree, void *value)       \
+{                                                                               \
+        return prefix##_successor_of_value((handle) tree, value);               \
+}
+
+/*
+ * TYPED_ENGINE_ADAPTERS
+ *
+ * the same wrappers for the int64_t trees of typed_trees.h, which only run
+ * on the integer workload. values from the workload point to int and are
+ * passed by value; the values these trees return point to their own
+ * int64_t keys, and those are what the successor walk passes back
+ */
+#define TYPED_ENGINE_ADAPTERS(prefix, handle)                                   \
+static void *prefix##_adapter_new(Comparator compare, void *ctx)                \
+{                                                                               \
+        (void) compare;                                                         \
+        (void) ctx;                                                             \
+        return prefix##_new();                                                  \
+}                                                                               \
+static void prefix##_adapter_free(void *tree)                                   \
+{                                                                               \
+        prefix##_free((handle) tree);                                           \
+}                                                                               \
+static int prefix##_adapter_insert_value(void *tree, void *value)               \
+{                                                                               \
+        return prefix##_insert_value((handle) tree, *(int *) value);            \
+}                                                                               \
+static void *prefix##_adapter_search(void *tree, void *value)                   \
+{                                                                               \
+        return (void *) prefix##_search((handle) tree, *(int *) value);         \
+}                                                                               \
+static void prefix##_adapter_delete_value(void *tree, void *value)              \
+{                                                                               \
+        prefix##_delete_value((handle) tree, *(int *) value);                   \
+}                                                                               \
+static void *prefix##_adapter_tree_minimum(void *tree)                          \
+{                                                                               \
+        return (void *) prefix##_tree_minimum((handle) tree);                   \
+}                                                                               \
+static void *prefix##_adapter_successor_of_value(void *tree, void *value)       \
+{                                                                               \
+        return (void *) prefix##_successor_of_value((handle) tree,              \
+                                                    *(int64_t *) value);        \
+}
+
+#define ENGINE_ENTRY(name, prefix)                                              \
+        { name, prefix##_adapter_new, prefix##_adapter_free,                    \
+          prefix##_adapter_insert_value, prefix##_adapter_search,               \
+          prefix##_adapter_delete_value, prefix##_adapter_tree_minimum,         \
+          prefix##_adapter_successor_of_value }
+
+ENGINE_ADAPTERS(bst, BSTree_T, bst_free)
+ENGINE_ADAPTERS(rb, RedBlack_T, rb_tree_free)
+ENGINE_ADAPTERS(splay, Splay_T, splay_free)
+ENGINE_ADAPTERS(treap, Treap_T, treap_free)
+ENGINE_ADAPTERS(zip, ZipTree_T, zip_free)
+ENGINE_ADAPTERS(scapegoat, Scapegoat_T, scapegoat_free)
+ENGINE_ADAPTERS(bpt, BPlusTree_T, bpt_tree_free)
+ENGINE_ADAPTERS(skip, SkipList_T, skip_free)
+ENGINE_ADAPTERS(multisplay, MultiSplay_T, multisplay_free)
+
+/*
+ * Hinted
+ *
+ * a red-black tree driven through rb_insert_hint and rb_search_hint, each
+ * call hinted with the position the one before it returned, so that runs
+ * of sorted keys skip the descent from the root
+ */
+typedef struct Hinted {
+        RedBlack_T tree;
+        RB_Cursor cursor;
+} Hinted;
+
+static void *rb_hint_adapter_new(Comparator compare, void *ctx)
 {
-        RedBlack_T rb = rb_new(NULL); 
+        Hinted *hinted = malloc(sizeof(Hinted)); 
 
-        Splay_T spl = splay_new(NULL); 
+        hinted->tree = rb_new_r(compare, ctx); 
+        hinted->cursor = NULL; 
+        return hinted; 
+}
 
-        (void) rb; 
-        (void) spl; 
+static void rb_hint_adapter_free(void *tree)
+{
+        rb_tree_free(((Hinted *) tree)->tree); 
+        free(tree); 
+}
+
+static int rb_hint_adapter_insert_value(void *tree, void *value)
+{
+        Hinted *hinted = tree; 
 
+        hinted->cursor = rb_insert_hint(hinted->tree, hinted->cursor, value); 
         return 0; 
 }
+
+static void *rb_hint_adapter_search(void *tree, void *value)
+{
+        Hinted *hinted = tree; 
+        RB_Cursor found = rb_search_hint(hinted->tree, hinted->cursor, value); 
+
+        if (found == NULL)
+                return NULL; 
+        hinted->cursor = found; 
+        return rb_cursor_value(found); 
+}
+
+static void rb_hint_adapter_delete_value(void *tree, void *value)
+{
+        Hinted *hinted = tree; 
+
+        /* the cursor may be the node deleted */
+        hinted->cursor = NULL; 
+        rb_delete_value(hinted->tree, value); 
+}
+
+static void *rb_hint_adapter_tree_minimum(void *tree)
+{
+        return rb_tree_minimum(((Hinted *) tree)->tree); 
+}
+
+static void *rb_hint_adapter_successor_of_value(void *tree, void *value)
+{
+        return rb_successor_of_value(((Hinted *) tree)->tree, value); 
+}
+
+/* the red-black tree searched from its finger */
+static void *rb_finger_adapter_search(void *tree, void *value)
+{
+        return rb_finger_search((RedBlack_T) tree, value); 
+}
+
+static const Engine engines[] = {
+        ENGINE_ENTRY("basic", bst),
+        ENGINE_ENTRY("rb", rb),
+        ENGINE_ENTRY("rb_hint", rb_hint),
+        { "rb_finger", rb_adapter_new, rb_adapter_free, rb_adapter_insert_value,
+          rb_finger_adapter_search, rb_adapter_delete_value, 
+          rb_adapter_tree_minimum, rb_adapter_successor_of_value },
+        ENGINE_ENTRY("splay", splay),
+        ENGINE_ENTRY("treap", treap),
+        ENGINE_ENTRY("zip", zip),
+        ENGINE_ENTRY("scapegoat", scapegoat),
+        ENGINE_ENTRY("bplus", bpt),
+        ENGINE_ENTRY("skip", skip),
+        ENGINE_ENTRY("multisplay", multisplay),
+};
+
+#define ENGINE_COUNT (sizeof(engines) / sizeof(engines[0]))
+
+TYPED_ENGINE_ADAPTERS(bst_i64, BSTree_i64_T)
+TYPED_ENGINE_ADAPTERS(rb_i64, RedBlack_i64_T)
+TYPED_ENGINE_ADAPTERS(splay_i64, Splay_i64_T)
+
+static const Engine typed_engines[] = {
+        ENGINE_ENTRY("basic_i64", bst_i64),
+        ENGINE_ENTRY("rb_i64", rb_i64),
+        ENGINE_ENTRY("splay_i64", splay_i64),
+};
+
+#define TYPED_ENGINE_COUNT (sizeof(typed_engines) / sizeof(typed_engines[0]))
+
+/*
+ * the red-black tree with cached key prefixes only orders strings, and
+ * ignores the comparator it is handed, so it runs on the word workload
+ * and not in the bounds mode
+ */
+static void *rb_prefix_adapter_new(Comparator compare, void *ctx)
+{
+        (void) compare; 
+        (void) ctx; 
+        return rb_new_prefixed(); 
+}
+
+static const Engine string_engines[] = {
+        { "rb_prefix", rb_prefix_adapter_new, rb_adapter_free,
+          rb_adapter_insert_value, rb_adapter_search,
+          rb_adapter_delete_value, rb_adapter_tree_minimum,
+          rb_adapter_successor_of_value },
+};
+
+#define STRING_ENGINE_COUNT (sizeof(string_engines) / sizeof(string_engines[0]))
+
+/*
+ * Counter
+ *
+ * the bounds mode hands every engine counting_comparison with a Counter as
+ * context, which counts the calls and forwards them to the workload's
+ * comparator. a lookup compares against each node on its search path once,
+ * so for the binary search trees the count is the BST model's cost of the
+ * access
+ */
+typedef struct Counter {
+        Compare inner;
+        size_t count;
+} Counter;
+
+/* qsort and bsearch take no context, so ranking reads the comparator here */
+static Compare rank_compare; 
+
+/*
+ * Workload
+ *
+ * the values fed to every engine, and the comparator they are all built
+ * with, with a NULL context
+ */
+typedef struct Workload {
+        void **values;
+        size_t count;
+        Comparator compare;
+        void *storage;          /* backing memory for the values */
+        Corpus_T corpus;        /* the mapped words, or NULL */
+        InternPool_T pool;      /* the interned words, or NULL */
+} Workload;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * load_words
+ *
+ * maps a whitespace separated corpus into memory. the words point into the
+ * mapping, which the workload owns, and are compared with strcmp. with
+ * split, words are cut at punctuation too and lowered, by word_split
+ *
+ * @param       const char * - path of the corpus
+ * @param       bool - true to split with word_split
+ * @param       Workload * - workload to fill
+ * @return      bool - false if the file could not be read
+ */
+bool load_words(const char *path, bool split, Workload *workload);
+
+/*
+ * make_integers
+ *
+ * builds a workload of the distinct integers 0..count - 1 in a shuffled
+ * order that is the same on every run
+ *
+ * @param       size_t - number of integers
+ * @param       Workload * - workload to fill
+ * @return      n/a
+ */
+void make_integers(size_t count, Workload *workload);
+
+/*
+ * intern_words
+ *
+ * replaces every word of the workload by its copy in an interning pool,
+ * numbered in sorted order, and compares the words by those numbers
+ *
+ * @param       Workload * - a workload of words
+ * @return      n/a
+ */
+void intern_words(Workload *workload);
+
+int integer_comparison(const void *val_one, const void *val_two, void *ctx);
+
+/*
+ * run_engine
+ *
+ * times one engine through four phases: inserting every value, searching
+ * for every value, walking the whole set with successor queries, and
+ * deleting every value. prints one row of nanoseconds per operation
+ *
+ * @param       const Engine * - engine to run
+ * @param       Workload * - values and comparator
+ * @return      n/a
+ */
+void run_engine(const Engine *engine, Workload *workload);
+
+/*
+ * run_bounds
+ *
+ * treats the workload as an access sequence over its distinct values.
+ * prints Wilber's interleave and funnel bounds for it, then loads each
+ * selected engine with the distinct values in a shuffled order, replays
+ * the sequence as lookups, and prints the comparisons made against both
+ * bounds. for reference, the "greedy" row is the number of nodes the
+ * offline Greedy algorithm touches, and the "optimal" row a static tree
+ * built from the access frequencies of the whole sequence
+ *
+ * @param       Workload * - the access sequence and comparator
+ * @param       const char * - comma separated engine names, or NULL for all
+ * @return      n/a
+ */
+void run_bounds(Workload *workload, const char *selection);
+
+/*
+ * run_ingest
+ *
+ * loads the corpus into each selected engine with ingest_corpus, once
+ * with every stage on this thread and once pipelined, and prints the wall
+ * clock time of both
+ *
+ * @param       const char * - path of the corpus
+ * @param       const char * - comma separated engine names, or NULL for all
+ * @return      bool - false if the corpus could not be read
+ */
+bool run_ingest(const char *path, const char *selection);
+
+int counting_comparison(const void *val_one, const void *val_two, void *ctx);
+int rank_comparison(const void *val_one, const void *val_two);
+
+bool engine_selected(const char *name, const char *selection);
+void usage(const char *program);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+int main(int argc, char *argv[])
+{
+        const char *selection = NULL; 
+        const char *path = DEFAULT_CORPUS; 
+        size_t integer_count = 0; 
+        bool bounds = false; 
+        bool intern = false; 
+        bool split = false; 
+        bool pipeline = false; 
+
+        for (int i = 1; i < argc; i++) {
+                if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+                        selection = argv[++i]; 
+                } else if (strcmp(argv[i], "-b") == 0) {
+                        bounds = true; 
+                } else if (strcmp(argv[i], "-i") == 0) {
+                        intern = true; 
+                } else if (strcmp(argv[i], "-w") == 0) {
+                        split = true; 
+                } else if (strcmp(argv[i], "-p") == 0) {
+                        pipeline = true; 
+                } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+                        integer_count = strtoul(argv[++i], NULL, 10); 
+                } else if (argv[i][0] == '-') {
+                        usage(argv[0]); 
+                        return EXIT_FAILURE; 
+                } else {
+                        path = argv[i]; 
+                }
+        }
+
+        if (pipeline) {
+                if (run_ingest(path, selection))
+                        return EXIT_SUCCESS; 
+
+                fprintf(stderr, "%s: no words to read in %s\n", argv[0], path); 
+                return EXIT_FAILURE; 
+        }
+
+        Workload workload; 
+
+        if (integer_count > 0) {
+                make_integers(integer_count, &workload); 
+                printf("workload: %zu shuffled integers\n", workload.count); 
+        } else if (load_words(path, split, &workload) && workload.count > 0) {
+                printf("workload: %zu words from %s\n", workload.count, path); 
+                if (intern) {
+                        intern_words(&workload); 
+                        printf("interned: %zu distinct words in %zu KB\n", 
+                               intern_count(workload.pool), 
+                               intern_bytes(workload.pool) / 1024); 
+                }
+        } else {
+                fprintf(stderr, "%s: no words to read in %s\n", argv[0], path); 
+                return EXIT_FAILURE; 
+        }
+
+        if (bounds) {
+                run_bounds(&workload, selection); 
+        } else {
+                printf("%-10s %12s %12s %12s %12s   (ns per operation)\n",
+                       "engine", "insert", "search", "successor", "delete"); 
+
+                for (size_t i = 0; i < ENGINE_COUNT; i++) {
+                        if (engine_selected(engines[i].name, selection))
+                                run_engine(&engines[i], &workload); 
+                }
+
+                for (size_t i = 0; i < TYPED_ENGINE_COUNT && integer_count > 0; i++) {
+                        if (engine_selected(typed_engines[i].name, selection))
+                                run_engine(&typed_engines[i], &workload); 
+                }
+
+                for (size_t i = 0; i < STRING_ENGINE_COUNT && integer_count == 0; i++) {
+                        if (engine_selected(string_engines[i].name, selection))
+                                run_engine(&string_engines[i], &workload); 
+                }
+        }
+
+        free(workload.values); 
+        free(workload.storage); 
+        if (workload.corpus != NULL)
+                corpus_close(workload.corpus); 
+        if (workload.pool != NULL)
+                intern_free(workload.pool); 
+
+        return EXIT_SUCCESS; 
+}
+
+void usage(const char *program)
+{
+        fprintf(stderr, "usage: %s [-b] [-e engine,engine,...] [-n count | [-i] [-w] [-p] corpus]\n",
+                program); 
+        fprintf(stderr, "  -b  compare lookup costs with Wilber's lower bounds and with\n"); 
+        fprintf(stderr, "      Greedy and the static optimal tree (engines greedy, optimal)\n"); 
+        fprintf(stderr, "  -i  intern the words and compare them by their sorted order\n"); 
+        fprintf(stderr, "  -w  split words at punctuation too, and lower them\n"); 
+        fprintf(stderr, "  -p  time loading the corpus, split and interned, with and\n"); 
+        fprintf(stderr, "      without the ingest pipeline\n"); 
+        fprintf(stderr, "engines:"); 
+        for (size_t i = 0; i < ENGINE_COUNT; i++)
+                fprintf(stderr, " %s", engines[i].name); 
+        fprintf(stderr, "\nwith -n also:"); 
+        for (size_t i = 0; i < TYPED_ENGINE_COUNT; i++)
+                fprintf(stderr, " %s", typed_engines[i].name); 
+        fprintf(stderr, "\nwithout -n also:"); 
+        for (size_t i = 0; i < STRING_ENGINE_COUNT; i++)
+                fprintf(stderr, " %s", string_engines[i].name); 
+        fprintf(stderr, "\n"); 
+}
+
+bool engine_selected(const char *name, const char *selection)
+{
+        if (selection == NULL)
+                return true; 
+
+        size_t length = strlen(name); 
+        const char *p = selection; 
+
+        while ((p = strstr(p, name)) != NULL) {
+                bool starts = (p == selection || p[-1] == ','); 
+                bool ends = (p[length] == '\0' || p[length] == ','); 
+
+                if (starts && ends)
+                        return true; 
+                p += length; 
+        }
+
+        return false; 
+}
+
+bool load_words(const char *path, bool split, Workload *workload)
+{
+        Corpus_T corpus = corpus_open(path, true); 
+
+        if (corpus == NULL)
+                return false; 
+
+        /* at most one word per two bytes */
+        size_t capacity = corpus_size(corpus) / 2 + 1; 
+        Word word; 
+
+        workload->values = malloc(capacity * sizeof(void *)); 
+        workload->count = 0; 
+
+        if (split) {
+                workload->count = corpus_split_words(corpus, (char **) workload->values); 
+        } else {
+                while (corpus_next(corpus, &word))
+                        workload->values[workload->count++] = (void *) word.start; 
+        }
+
+        workload->compare = &comparator_strcmp; 
+        workload->storage = NULL; 
+        workload->corpus = corpus; 
+        workload->pool = NULL; 
+
+        return true; 
+}
+
+void make_integers(size_t count, Workload *workload)
+{
+        int *integers = malloc(count * sizeof(int)); 
+        uint64_t state = PRNG_DEFAULT_SEED; 
+
+        for (size_t i = 0; i < count; i++)
+                integers[i] = (int) i; 
+
+        /* Fisher-Yates */
+        for (size_t i = count - 1; i > 0; i--) {
+                size_t j = prng_next(&state) % (i + 1); 
+                int tmp = integers[i]; 
+                integers[i] = integers[j]; 
+                integers[j] = tmp; 
+        }
+
+        workload->values = malloc(count * sizeof(void *)); 
+        for (size_t i = 0; i < count; i++)
+                workload->values[i] = &integers[i]; 
+
+        workload->count = count; 
+        workload->compare = &integer_comparison; 
+        workload->storage = integers; 
+        workload->corpus = NULL; 
+        workload->pool = NULL; 
+}
+
+void intern_words(Workload *workload)
+{
+        InternPool_T pool = intern_new(); 
+
+        for (size_t i = 0; i < workload->count; i++) {
+                char *word = workload->values[i]; 
+                workload->values[i] = (void *) intern_string(pool, word, strlen(word)); 
+        }
+        intern_assign_ids(pool); 
+
+        /* the words now live in the pool */
+        corpus_close(workload->corpus); 
+        workload->corpus = NULL; 
+        workload->compare = &intern_id_comparison; 
+        workload->pool = pool; 
+}
+
+int integer_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        (void) ctx; 
+
+        return (a > b) - (a < b); 
+}
+
+void run_engine(const Engine *engine, Workload *workload)
+{
+        CPUTime_T timer = CPUTime_New(); 
+        void *tree = engine->new_tree(workload->compare, NULL); 
+        size_t n = workload->count; 
+        double insert_time, search_time, successor_time, delete_time; 
+        size_t found = 0; 
+        size_t steps = 0; 
+
+        CPUTime_Start(timer); 
+        for (size_t i = 0; i < n; i++)
+                engine->insert_value(tree, workload->values[i]); 
+        insert_time = CPUTime_Stop(timer); 
+
+        CPUTime_Start(timer); 
+        for (size_t i = 0; i < n; i++)
+                found += engine->search(tree, workload->values[i]) != NULL; 
+        search_time = CPUTime_Stop(timer); 
+
+        CPUTime_Start(timer); 
+        for (void *v = engine->tree_minimum(tree); v != NULL; 
+             v = engine->successor_of_value(tree, v))
+                steps++; 
+        successor_time = CPUTime_Stop(timer); 
+
+        CPUTime_Start(timer); 
+        for (size_t i = 0; i < n; i++)
+                engine->delete_value(tree, workload->values[i]); 
+        delete_time = CPUTime_Stop(timer); 
+
+        assert(found == n); 
+
+        printf("%-10s %12.1f %12.1f %12.1f %12.1f\n", engine->name,
+               insert_time / n, search_time / n,
+               successor_time / (steps > 0 ? steps : 1), delete_time / n); 
+
+        engine->free_tree(tree); 
+        CPUTime_Free(&timer); 
+}
+
+int counting_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        Counter *counter = ctx; 
+
+        counter->count++; 
+
+        return counter->inner.func(val_one, val_two, counter->inner.ctx); 
+}
+
+int rank_comparison(const void *val_one, const void *val_two)
+{
+        return rank_compare.func(*(void * const *) val_one, *(void * const *) val_two, 
+                                 rank_compare.ctx); 
+}
+
+bool run_ingest(const char *path, const char *selection)
+{
+        Ingest_Mode modes[] = { INGEST_SEQUENTIAL, INGEST_PIPELINED }; 
+        bool header = false; 
+
+        for (size_t i = 0; i < ENGINE_COUNT; i++) {
+                if (!engine_selected(engines[i].name, selection))
+                        continue; 
+
+                double elapsed[2]; 
+                size_t count = 0; 
+
+                for (int m = 0; m < 2; m++) {
+                        InternPool_T pool = intern_new(); 
+                        void *tree = engines[i].new_tree(comparator_strcmp, NULL); 
+                        Ingest_Result result; 
+
+                        if (!ingest_corpus(path, pool, engines[i].insert_value, tree, 
+                                           modes[m], &result)) {
+                                engines[i].free_tree(tree); 
+                                intern_free(pool); 
+                                return false; 
+                        }
+
+                        elapsed[m] = result.elapsed; 
+                        count = result.count; 
+
+                        engines[i].free_tree(tree); 
+                        free(result.words); 
+                        intern_free(pool); 
+                }
+
+                if (!header) {
+                        printf("workload: %zu words from %s\n", count, path); 
+                        printf("%-10s %12s %12s   (ms to load the corpus)\n", 
+                               "engine", "sequential", "pipelined"); 
+                        header = true; 
+                }
+                printf("%-10s %12.1f %12.1f\n", engines[i].name, 
+                       elapsed[0] / 1e6, elapsed[1] / 1e6); 
+        }
+
+        return true; 
+}
+
+void run_bounds(Workload *workload, const char *selection)
+{
+        size_t m = workload->count; 
+        void **distinct = malloc(m * sizeof(void *)); 
+        size_t *keys = malloc(m * sizeof(size_t)); 
+        size_t n = 0; 
+
+        Counter counter = { { workload->compare, NULL }, 0 }; 
+
+        rank_compare = counter.inner; 
+
+        /* rank every access among the distinct values */
+        memcpy(distinct, workload->values, m * sizeof(void *)); 
+        qsort(distinct, m, sizeof(void *), rank_comparison); 
+
+        for (size_t i = 0; i < m; i++) {
+                if (n == 0 || rank_comparison(&distinct[n - 1], &distinct[i]) != 0)
+                        distinct[n++] = distinct[i]; 
+        }
+
+        for (size_t i = 0; i < m; i++) {
+                void **found = bsearch(&workload->values[i], distinct, n, 
+                                       sizeof(void *), rank_comparison); 
+                keys[i] = found - distinct; 
+        }
+
+        size_t interleave = wilber_interleave_bound(keys, m, n) + m; 
+        size_t funnel = wilber_funnel_bound(keys, m, n) + m; 
+
+        printf("%zu accesses to %zu keys\n", m, n); 
+        printf("interleave bound + m: %zu (%.2f per access)\n", 
+               interleave, (double) interleave / m); 
+        printf("funnel bound + m:     %zu (%.2f per access)\n", 
+               funnel, (double) funnel / m); 
+        printf("%-10s %14s %12s %12s %12s   (comparisons in lookups)\n",
+               "engine", "cost", "per access", "/ interleave", "/ funnel"); 
+
+        if (engine_selected("greedy", selection)) {
+                size_t greedy = greedy_bst_cost(keys, m, n); 
+
+                printf("%-10s %14zu %12.2f %12.2f %12.2f   (nodes touched)\n", "greedy", 
+                       greedy, (double) greedy / m, (double) greedy / interleave, 
+                       (double) greedy / funnel); 
+        }
+
+        /* the static optimum needs the values in order, before the shuffle */
+        OptimalBST_T optimal = NULL; 
+
+        if (engine_selected("optimal", selection)) {
+                double *weights = calloc(n, sizeof(double)); 
+
+                for (size_t i = 0; i < m; i++)
+                        weights[keys[i]] += 1; 
+
+                optimal = optimal_bst_new_r(distinct, weights, n, &counting_comparison, 
+                                            &counter, OPTIMAL_AUTO); 
+                free(weights); 
+        }
+
+        /* every engine is loaded in the same shuffled order */
+        uint64_t state = PRNG_DEFAULT_SEED; 
+
+        for (size_t i = n - 1; i > 0; i--) {
+                size_t j = prng_next(&state) % (i + 1); 
+                void *tmp = distinct[i]; 
+                distinct[i] = distinct[j]; 
+                distinct[j] = tmp; 
+        }
+
+        for (size_t e = 0; e < ENGINE_COUNT; e++) {
+                if (!engine_selected(engines[e].name, selection))
+                        continue; 
+
+                void *tree = engines[e].new_tree(&counting_comparison, &counter); 
+
+                for (size_t i = 0; i < n; i++)
+                        engines[e].insert_value(tree, distinct[i]); 
+
+                counter.count = 0; 
+                for (size_t i = 0; i < m; i++)
+                        engines[e].search(tree, workload->values[i]); 
+
+                printf("%-10s %14zu %12.2f %12.2f %12.2f\n", engines[e].name, 
+                       counter.count, (double) counter.count / m, 
+                       (double) counter.count / interleave, 
+                       (double) counter.count / funnel); 
+
+                engines[e].free_tree(tree); 
+        }
+
+        if (optimal != NULL) {
+                counter.count = 0; 
+                for (size_t i = 0; i < m; i++)
+                        optimal_bst_search(optimal, workload->values[i]); 
+
+                printf("%-10s %14zu %12.2f %12.2f %12.2f\n", "optimal", 
+                       counter.count, (double) counter.count / m, 
+                       (double) counter.count / interleave, 
+                       (double) counter.count / funnel); 
+
+                optimal_bst_free(optimal); 
+        }
+
+        free(keys); 
+        free(distinct); 
+}
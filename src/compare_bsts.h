@@ -6,9 +6,31 @@
 #include "rb_tree.h"
 #include "splay_tree.h"
 #include "basic_bst.h"
+#include "treap.h"
+#include "zip_tree.h"
+#include "scapegoat_tree.h"
+#include "bplus_tree.h"
+#include "skip_list.h"
+#include "multisplay_tree.h"
 #include "cputiming.h"
+#include "comparator.h"
 
-
-
+/*
+ * Engine
+ * 
+ * the operations the harness times, with the tree handle type erased so 
+ * that every engine can be driven by the same loop. each engine gets the 
+ * same comparison function and the same values, in the same order
+ */
+typedef struct Engine {
+        const char *name; 
+        void *(*new_tree)(Comparator compare, void *ctx); 
+        void (*free_tree)(void *tree); 
+        int (*insert_value)(void *tree, void *value); 
+        void *(*search)(void *tree, void *value); 
+        void (*delete_value)(void *tree, void *value); 
+        void *(*tree_minimum)(void *tree); 
+        void *(*successor_of_value)(void *tree, void *value); 
+} Engine; 
 
 #endif
@@ -0,0 +1,206 @@
+#include "corpus.h"
+#include "word_split.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*
+ * the file is mapped over the start of an anonymous, zero filled
+ * reservation at least one byte longer than it, so the text is always
+ * followed by a nul even when the file ends on a page boundary
+ */
+struct corpus {
+        char *text;
+        size_t size;
+        size_t mapped;          /* bytes reserved, whole pages */
+        size_t next;            /* offset where the next scan starts */
+        bool terminate;
+};
+
+typedef Corpus_T T;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_corpus_is_delimiter
+ *
+ * returns true if the byte separates words
+ */
+bool private_corpus_is_delimiter(unsigned char c);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T corpus_open(const char *path, bool terminate)
+{
+        assert(path != NULL); 
+
+        int fd = open(path, O_RDONLY); 
+        struct stat st; 
+
+        if (fd < 0)
+                return NULL; 
+
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+                close(fd); 
+                return NULL; 
+        }
+
+        size_t size = (size_t) st.st_size; 
+        size_t page = (size_t) sysconf(_SC_PAGESIZE); 
+        size_t mapped = (size / page + 1) * page; 
+        int prot = terminate ? PROT_READ | PROT_WRITE : PROT_READ; 
+
+        char *text = mmap(NULL, mapped, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0); 
+
+        if (text == MAP_FAILED) {
+                close(fd); 
+                return NULL; 
+        }
+
+        if (size > 0 && 
+            mmap(text, size, prot, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+                munmap(text, mapped); 
+                close(fd); 
+                return NULL; 
+        }
+
+        /* the mapping holds its own reference to the file */
+        close(fd); 
+
+        if (size > 0)
+                posix_madvise(text, size, POSIX_MADV_SEQUENTIAL); 
+
+        T corpus = malloc(sizeof(struct corpus)); 
+
+        corpus->text = text; 
+        corpus->size = size; 
+        corpus->mapped = mapped; 
+        corpus->next = 0; 
+        corpus->terminate = terminate; 
+
+        return corpus; 
+}
+
+void corpus_close(T corpus)
+{
+        assert(corpus != NULL); 
+
+        munmap(corpus->text, corpus->mapped); 
+        free(corpus); 
+}
+
+bool corpus_next(T corpus, Word *word)
+{
+        assert(corpus != NULL && word != NULL); 
+
+        const char *text = corpus->text; 
+        size_t size = corpus->size; 
+        size_t i = corpus->next; 
+
+        while (i < size && private_corpus_is_delimiter(text[i]))
+                i++; 
+
+        if (i == size) {
+                corpus->next = size; 
+                return false; 
+        }
+
+        size_t start = i; 
+
+        /* the nul after the text stops this scan */
+        while (!private_corpus_is_delimiter(text[i]))
+                i++; 
+
+        word->start = text + start; 
+        word->length = i - start; 
+
+        if (i < size) {
+                if (corpus->terminate)
+                        corpus->text[i] = '\0'; 
+                i++; 
+        }
+        corpus->next = i; 
+
+        return true; 
+}
+
+size_t corpus_split_words(T corpus, char **words)
+{
+        assert(corpus != NULL && words != NULL); 
+        assert(corpus->terminate); 
+
+        return word_split(corpus->text, corpus->size, words); 
+}
+
+bool corpus_split_chunk(T corpus, size_t max_bytes, char **words, size_t *count)
+{
+        assert(corpus != NULL && words != NULL && count != NULL); 
+        assert(max_bytes > 0 && corpus->terminate); 
+
+        char *text = corpus->text; 
+        size_t size = corpus->size; 
+        size_t start = corpus->next; 
+
+        if (start >= size) {
+                *count = 0; 
+                return false; 
+        }
+
+        size_t end = (size - start > max_bytes) ? start + max_bytes : size; 
+
+        while (end < size && word_split_is_word_byte((unsigned char) text[end]))
+                end++; 
+
+        /* text[end] is a delimiter, and this chunk's words may be read as soon as we return */
+        if (end < size)
+                text[end] = '\0'; 
+
+        *count = word_split(text + start, end - start, words); 
+
+        /* the next chunk starts past that NUL, which ends a word another thread may be reading */
+        corpus->next = (end < size) ? end + 1 : end; 
+
+        return true; 
+}
+
+void corpus_rewind(T corpus)
+{
+        assert(corpus != NULL); 
+
+        corpus->next = 0; 
+}
+
+size_t corpus_size(T corpus)
+{
+        assert(corpus != NULL); 
+
+        return corpus->size; 
+}
+
+const char *corpus_text(T corpus)
+{
+        assert(corpus != NULL); 
+
+        return corpus->text; 
+}
+
+bool private_corpus_is_delimiter(unsigned char c)
+{
+        switch (c) {
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+        case '\v':
+        case '\f':
+        case '\0':
+                return true; 
+        default:
+                return false; 
+        }
+}
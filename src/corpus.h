@@ -0,0 +1,178 @@
+/**********************************************************************
+ * corpus.h                                                           *
+ *                                                                    *
+ * Interface for a zero-copy corpus tokenizer: the text file is       *
+ * memory-mapped, and each word is handed out as a slice pointing     *
+ * into the mapping, with no allocation or copy per word. opened for  *
+ * terminating, the mapping is private and copy-on-write, and the     *
+ * delimiter after each word is overwritten with a nul, so the words  *
+ * can be stored in a tree and compared with strcmp                   *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef CORPUS_H
+#define CORPUS_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct corpus *Corpus_T;
+
+/*
+ * Word
+ *
+ * a word of the corpus: length bytes starting at start, inside the
+ * mapping. valid until the corpus is closed
+ */
+typedef struct Word {
+        const char *start;
+        size_t length;
+} Word;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * corpus_open
+ *
+ * maps the file at path and positions the tokenizer at its first word.
+ * the file is never written to: with terminate, the nuls go to private
+ * copies of the pages they land on. either way the mapping is followed
+ * by a nul, so the last word is terminated too
+ *
+ * CREs         path == NULL
+ * UREs         the file changes while it is open
+ *
+ * @param       const char * - path of the text file
+ * @param       bool - true to nul terminate every word in place
+ * @return      the new corpus, or NULL if the file cannot be opened or
+ *              mapped
+ */
+Corpus_T corpus_open(const char *path, bool terminate);
+
+/*
+ * corpus_close
+ *
+ * unmaps the file and deallocates the corpus. the words handed out are
+ * no longer valid
+ *
+ * CREs         corpus == NULL
+ * UREs         n/a
+ *
+ * @param       Corpus_T - the corpus to be closed
+ * @return      n/a
+ */
+void corpus_close(Corpus_T corpus);
+
+/*
+ * corpus_next
+ *
+ * stores the next word in *word and returns true, or returns false at the
+ * end of the corpus. words are the maximal runs of bytes other than
+ * space, tab, newline, carriage return, vertical tab, form feed and nul
+ *
+ * CREs         corpus == NULL
+ *              word == NULL
+ * UREs         n/a
+ *
+ * @param       Corpus_T - the corpus
+ * @param       Word * - where to store the word
+ * @return      bool - false if there are no words left
+ */
+bool corpus_next(Corpus_T corpus, Word *word);
+
+/*
+ * corpus_split_words
+ *
+ * splits the whole text at once with word_split: words are runs of
+ * letters and digits, lowered, and white space and punctuation become
+ * nuls. faster than calling corpus_next for every word, and afterwards
+ * corpus_next finds the same words
+ *
+ * CREs         corpus == NULL
+ *              words == NULL
+ *              the corpus was not opened with terminate
+ * UREs         words has room for fewer than corpus_size / 2 + 1 pointers
+ *
+ * @param       Corpus_T - the corpus
+ * @param       char ** - where to store the words, in text order
+ * @return      size_t - number of words
+ */
+size_t corpus_split_words(Corpus_T corpus, char **words);
+
+/*
+ * corpus_split_chunk
+ *
+ * splits the next chunk of the text with word_split, for callers that
+ * hand words on while later chunks are still being split. a chunk is
+ * max_bytes long, or runs on to the end of the word that crosses that
+ * point, so no word is cut. its last word is terminated before this
+ * returns, and later calls touch neither the chunk nor that terminator
+ *
+ * CREs         corpus == NULL
+ *              words == NULL
+ *              count == NULL
+ *              max_bytes == 0
+ *              the corpus was not opened with terminate
+ * UREs         words has room for fewer than max_bytes / 2 + 1 pointers
+ *
+ * @param       Corpus_T - the corpus
+ * @param       size_t - target size of the chunk in bytes
+ * @param       char ** - where to store the words of the chunk
+ * @param       size_t * - where to store how many there are
+ * @return      bool - false if the whole text was split already
+ */
+bool corpus_split_chunk(Corpus_T corpus, size_t max_bytes, char **words, size_t *count);
+
+/*
+ * corpus_rewind
+ *
+ * positions the tokenizer back at the first word. with terminate, the
+ * words already terminated stay terminated, and are found again
+ *
+ * CREs         corpus == NULL
+ * UREs         n/a
+ *
+ * @param       Corpus_T - the corpus
+ * @return      n/a
+ */
+void corpus_rewind(Corpus_T corpus);
+
+/*
+ * corpus_size
+ *
+ * returns the size of the mapped file in bytes
+ *
+ * CREs         corpus == NULL
+ * UREs         n/a
+ *
+ * @param       Corpus_T - the corpus
+ * @return      size_t - bytes in the file
+ */
+size_t corpus_size(Corpus_T corpus);
+
+/*
+ * corpus_text
+ *
+ * returns the mapped text of the file, followed by a nul
+ *
+ * CREs         corpus == NULL
+ * UREs         the text is written to
+ *
+ * @param       Corpus_T - the corpus
+ * @return      const char * - the first byte of the file
+ */
+const char *corpus_text(Corpus_T corpus);
+
+#endif
@@ -0,0 +1,35 @@
+#include "cpu_features.h"
+
+SIMD_Level cpu_simd_level(void)
+{
+        static bool detected = false; 
+        static SIMD_Level level = SIMD_SCALAR; 
+
+        if (detected)
+                return level; 
+
+#ifdef CPU_FEATURES_X86
+        __builtin_cpu_init(); 
+
+        /* SSE2 is part of the x86-64 baseline */
+        level = SIMD_SSE2; 
+        if (__builtin_cpu_supports("avx2"))
+                level = SIMD_AVX2; 
+#endif
+
+        detected = true; 
+
+        return level; 
+}
+
+const char *cpu_simd_level_name(SIMD_Level level)
+{
+        switch (level) {
+        case SIMD_SSE2:
+                return "sse2"; 
+        case SIMD_AVX2:
+                return "avx2"; 
+        default:
+                return "scalar"; 
+        }
+}
@@ -0,0 +1,65 @@
+/**********************************************************************
+ * cpu_features.h                                                     *
+ *                                                                    *
+ * Interface for runtime detection of the vector instruction sets     *
+ * that the SIMD kernels can use. kernels are compiled for every      *
+ * level the compiler supports, and callers pick one at run time      *
+ * from what the executing CPU actually offers                        *
+ **********************************************************************/
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdbool.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+/* 
+ * CPU_FEATURES_X86 is defined when the x86 kernels can be compiled at all, 
+ * ie on 64 bit x86 with a compiler that understands per-function target 
+ * attributes. everywhere else only the scalar level exists
+ */
+#if defined(__x86_64__) && defined(__GNUC__)
+#define CPU_FEATURES_X86 1
+#endif
+
+typedef enum {
+        SIMD_SCALAR = 0,
+        SIMD_SSE2,
+        SIMD_AVX2
+} SIMD_Level;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * cpu_simd_level
+ * 
+ * returns the widest vector instruction set supported by both this build 
+ * and the executing CPU. the CPU is only queried on the first call
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @return      SIMD_Level - best available level
+ */
+SIMD_Level cpu_simd_level(void);
+
+/*
+ * cpu_simd_level_name
+ * 
+ * returns a printable name for a level, for benchmark and test output
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       SIMD_Level - level to name
+ * @return      const char * - static string, e.g. "avx2"
+ */
+const char *cpu_simd_level_name(SIMD_Level level);
+
+#endif
@@ -0,0 +1,21 @@
+/****************************************************************
+ *
+ *                       cputiming_impl.h
+ *
+ *       Representation of type CPUTime_T, shared only with
+ *       cputiming.c. Clients use the opaque interface in 
+ *       cputiming.h.
+ *
+ *****************************************************************/
+
+#ifndef CPUTIMING_IMPL_H
+#define CPUTIMING_IMPL_H
+
+#include <time.h>
+#include "cputiming.h"
+
+struct CPU_Time {
+        struct timespec time;
+};
+
+#endif
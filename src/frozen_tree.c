@@ -0,0 +1,360 @@
+#define _POSIX_C_SOURCE 200112L
+
+#include "frozen_tree.h"
+#include <string.h>
+#include <stdint.h>
+
+/*** MACRO DEFINITIONS ***/
+
+#define FROZEN_CACHE_LINE 64
+#define FROZEN_MAX_HEIGHT 64
+
+/*
+ * the Eytzinger descendants of node k three levels down are nodes 8k to 
+ * 8k + 7, which is exactly one cache line of pointers when the array is 
+ * line aligned. prefetching that line while comparing at k hides most of 
+ * the latency of the next three steps
+ */
+#define FROZEN_PREFETCH_STRIDE (FROZEN_CACHE_LINE / sizeof(void *))
+
+#define FROZEN_NONE SIZE_MAX
+
+struct frozen_tree {
+        void **slots;           /* Eytzinger: slots[1..count]; vEB: complete tree, NULL padded */
+        size_t count; 
+        Compare compare; 
+        Frozen_Layout layout; 
+        void *minimum; 
+        void *maximum; 
+
+        /* 
+         * vEB position tables, indexed by depth. a node at depth d with 
+         * breadth first index i lives at 
+         *      pos[top_depth[d]] + top_size[d] + (i & top_size[d]) * bottom_size[d] 
+         * where pos[] holds the positions of its ancestors
+         */
+        int height; 
+        int top_depth[FROZEN_MAX_HEIGHT]; 
+        size_t top_size[FROZEN_MAX_HEIGHT]; 
+        size_t bottom_size[FROZEN_MAX_HEIGHT]; 
+};
+
+typedef Frozen_T T;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_frozen_eytzinger_fill
+ * 
+ * stores the sorted values into slots by an inorder walk of the implicit 
+ * tree rooted at k
+ * 
+ * @param       T - tree being built
+ * @param       size_t - implicit index of the subtree root
+ * @param       void ** - the sorted values
+ * @param       size_t * - index of the next sorted value to place
+ * @return      n/a
+ */
+void private_frozen_eytzinger_fill(T tree, size_t k, void **values, size_t *next); 
+
+/*
+ * private_frozen_veb_split
+ * 
+ * fills in the vEB position tables for a subtree of the given height whose 
+ * root is at the given depth, by cutting it at half its height into a top 
+ * tree and the bottom trees hanging from it
+ * 
+ * @param       T - tree being built
+ * @param       int - depth of the subtree root
+ * @param       int - height of the subtree
+ * @return      n/a
+ */
+void private_frozen_veb_split(T tree, int depth, int height); 
+
+/*
+ * private_frozen_veb_fill
+ * 
+ * vEB counterpart of private_frozen_eytzinger_fill. positions of the 
+ * ancestors of the current node are kept in pos, indexed by depth; slots 
+ * past the last value are left NULL, which searches treat as +infinity
+ */
+void private_frozen_veb_fill(T tree, size_t i, int depth, size_t *pos, 
+                             void **values, size_t *next); 
+
+/*
+ * private_frozen_eytzinger_descend / private_frozen_veb_descend
+ * 
+ * walk from the root to a leaf, going right at every node whose value v 
+ * satisfies comparison_func(v, value) < bias, ie v < value for bias 0 and 
+ * v <= value for bias 1. the step is computed rather than branched on.
+ * 
+ * the Eytzinger walk returns the final implicit index, from which the last 
+ * left or right turn is recovered with a bit scan. the vEB walk returns 
+ * the array position of the last node at which it went right (if 
+ * want_right) or left, or FROZEN_NONE if there was none
+ */
+size_t private_frozen_eytzinger_descend(T tree, void *value, int bias); 
+size_t private_frozen_veb_descend(T tree, void *value, int bias, bool want_right); 
+
+/*
+ * private_frozen_bound
+ * 
+ * returns the first value that is not less than value (bias 0), the first 
+ * value greater than value (bias 1), or with want_less the last value that 
+ * is less than value. NULL if there is none
+ */
+void *private_frozen_bound(T tree, void *value, int bias, bool want_less); 
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T frozen_new(void **values, size_t count, void *comparison_func, 
+             Frozen_Layout layout)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return frozen_new_r(values, count, compare.func, compare.ctx, layout); 
+}
+
+T frozen_new_r(void **values, size_t count, Comparator compare, void *ctx, 
+               Frozen_Layout layout)
+{
+        assert(compare != NULL); 
+        assert(values != NULL || count == 0); 
+        assert(layout == FROZEN_EYTZINGER || layout == FROZEN_VEB); 
+
+        T tree = malloc(sizeof(struct frozen_tree)); 
+        size_t slot_count; 
+
+        tree->count = count; 
+        tree->layout = layout; 
+        tree->height = 0; 
+        tree->minimum = (count > 0) ? values[0] : NULL; 
+        tree->maximum = (count > 0) ? values[count - 1] : NULL; 
+
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+
+        if (layout == FROZEN_EYTZINGER) {
+                slot_count = count + 1;         /* slot 0 is unused */
+        } else {
+                while (tree->height < FROZEN_MAX_HEIGHT - 1 && 
+                       ((size_t) 1 << tree->height) - 1 < count)
+                        tree->height++; 
+                slot_count = ((size_t) 1 << tree->height) - 1; 
+        }
+
+        void *memory = NULL; 
+        if (posix_memalign(&memory, FROZEN_CACHE_LINE, 
+                           (slot_count + 1) * sizeof(void *)) != 0) {
+                free(tree); 
+                return NULL; 
+        }
+        tree->slots = memory; 
+        memset(tree->slots, 0, (slot_count + 1) * sizeof(void *)); 
+
+        size_t next = 0; 
+
+        if (layout == FROZEN_EYTZINGER) {
+                private_frozen_eytzinger_fill(tree, 1, values, &next); 
+        } else if (tree->height > 0) {
+                size_t pos[FROZEN_MAX_HEIGHT]; 
+
+                private_frozen_veb_split(tree, 0, tree->height); 
+                private_frozen_veb_fill(tree, 1, 0, pos, values, &next); 
+        }
+
+        return tree; 
+}
+
+void frozen_free(T tree)
+{
+        assert(tree != NULL); 
+
+        free(tree->slots); 
+        free(tree); 
+}
+
+size_t frozen_size(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->count; 
+}
+
+Frozen_Layout frozen_layout(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->layout; 
+}
+
+void private_frozen_eytzinger_fill(T tree, size_t k, void **values, size_t *next)
+{
+        if (k > tree->count)
+                return; 
+
+        private_frozen_eytzinger_fill(tree, 2 * k, values, next); 
+        tree->slots[k] = values[(*next)++]; 
+        private_frozen_eytzinger_fill(tree, 2 * k + 1, values, next); 
+}
+
+void private_frozen_veb_split(T tree, int depth, int height)
+{
+        if (height <= 1)
+                return; 
+
+        int top = height / 2; 
+        int bottom = height - top; 
+        int bottom_depth = depth + top; 
+
+        tree->top_depth[bottom_depth] = depth; 
+        tree->top_size[bottom_depth] = ((size_t) 1 << top) - 1; 
+        tree->bottom_size[bottom_depth] = ((size_t) 1 << bottom) - 1; 
+
+        private_frozen_veb_split(tree, depth, top); 
+        private_frozen_veb_split(tree, bottom_depth, bottom); 
+}
+
+void private_frozen_veb_fill(T tree, size_t i, int depth, size_t *pos, 
+                             void **values, size_t *next)
+{
+        if (depth == tree->height)
+                return; 
+
+        if (depth == 0) {
+                pos[0] = 0; 
+        } else {
+                size_t t = tree->top_size[depth]; 
+
+                pos[depth] = pos[tree->top_depth[depth]] + t + 
+                             (i & t) * tree->bottom_size[depth]; 
+        }
+
+        size_t here = pos[depth]; 
+
+        private_frozen_veb_fill(tree, 2 * i, depth + 1, pos, values, next); 
+        if (*next < tree->count)
+                tree->slots[here] = values[(*next)++]; 
+        private_frozen_veb_fill(tree, 2 * i + 1, depth + 1, pos, values, next); 
+}
+
+size_t private_frozen_eytzinger_descend(T tree, void *value, int bias)
+{
+        Compare compare = tree->compare; 
+        void **slots = tree->slots; 
+        size_t count = tree->count; 
+        size_t k = 1; 
+
+        while (k <= count) {
+                /* address arithmetic only; the prefetch never faults */
+                __builtin_prefetch((void *) ((uintptr_t) slots + 
+                                   k * FROZEN_PREFETCH_STRIDE * sizeof(void *))); 
+
+                int c = compare.func(slots[k], value, compare.ctx); 
+                k = 2 * k + (c < bias); 
+        }
+
+        return k; 
+}
+
+size_t private_frozen_veb_descend(T tree, void *value, int bias, bool want_right)
+{
+        Compare compare = tree->compare; 
+        void **slots = tree->slots; 
+        size_t pos[FROZEN_MAX_HEIGHT]; 
+        size_t best = FROZEN_NONE; 
+        size_t i = 1; 
+
+        for (int d = 0; d < tree->height; d++) {
+                size_t p = 0; 
+
+                if (d > 0) {
+                        size_t t = tree->top_size[d]; 
+                        p = pos[tree->top_depth[d]] + t + (i & t) * tree->bottom_size[d]; 
+                }
+                pos[d] = p; 
+
+                void *slot = slots[p]; 
+                bool right = slot != NULL && 
+                             compare.func(slot, value, compare.ctx) < bias; 
+
+                best = (right == want_right) ? p : best; 
+                i = 2 * i + right; 
+        }
+
+        return best; 
+}
+
+void *private_frozen_bound(T tree, void *value, int bias, bool want_less)
+{
+        if (tree->count == 0)
+                return NULL; 
+
+        if (tree->layout == FROZEN_VEB) {
+                size_t p = private_frozen_veb_descend(tree, value, bias, want_less); 
+
+                return (p == FROZEN_NONE) ? NULL : tree->slots[p]; 
+        }
+
+        size_t k = private_frozen_eytzinger_descend(tree, value, bias); 
+
+        /* 
+         * the bits of k below its leading one spell out the path taken, 
+         * 1 for right. dropping the trailing ones and the zero above them 
+         * backs up to the last left turn; dropping the trailing zeros and 
+         * the one above them backs up to the last right turn. 0 means the 
+         * walk never turned that way
+         */
+        if (want_less)
+                k >>= __builtin_ffsll((long long) k); 
+        else
+                k >>= __builtin_ffsll((long long) ~k); 
+
+        return (k == 0) ? NULL : tree->slots[k]; 
+}
+
+void *frozen_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Compare compare = tree->compare; 
+        void *candidate = private_frozen_bound(tree, value, 0, false); 
+
+        if (candidate != NULL && 
+            compare.func(value, candidate, compare.ctx) == 0)
+                return candidate; 
+
+        return NULL; 
+}
+
+void *frozen_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->minimum; 
+}
+
+void *frozen_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->maximum; 
+}
+
+void *frozen_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        return private_frozen_bound(tree, value, 1, false); 
+}
+
+void *frozen_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        return private_frozen_bound(tree, value, 0, true); 
+}
@@ -0,0 +1,206 @@
+/**********************************************************************
+ * frozen_tree.h                                                      *
+ *                                                                    *
+ * Interface for an immutable, implicit search tree: a snapshot of    *
+ * an ordered set laid out in a single array, either in Eytzinger     *
+ * (breadth first) order or in van Emde Boas order. there are no      *
+ * child pointers to chase, lookups descend with branch free index    *
+ * arithmetic, and the Eytzinger descent prefetches the slots a few   *
+ * levels ahead. built by rb_freeze and splay_freeze for indexes      *
+ * that are read far more often than they are written                 *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef FROZEN_TREE_H
+#define FROZEN_TREE_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "comparator.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct frozen_tree *Frozen_T;
+
+/* 
+ * FROZEN_EYTZINGER     node k has children 2k and 2k + 1; the top levels 
+ *                      share cache lines and the descent can prefetch 
+ *                      the block holding a node's descendants 
+ * FROZEN_VEB           recursive van Emde Boas blocking: every subtree of 
+ *                      height h is stored contiguously, so a lookup 
+ *                      touches O(log_B n) blocks for any block size B
+ */
+typedef enum {
+        FROZEN_EYTZINGER = 0,
+        FROZEN_VEB
+} Frozen_Layout;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * frozen_new
+ * 
+ * builds a frozen tree from count values that are already in ascending 
+ * order according to comparison_func. the array is copied; the values it 
+ * points to are not, and must outlive the frozen tree
+ * 
+ * CREs         values == NULL && count > 0
+ * UREs         system out of memory
+ *              values not sorted
+ * 
+ * @param       void ** - the values, in ascending order
+ * @param       size_t - number of values
+ * @param       void * - pointer to a comparison function, with the same 
+ *                              contract as for rb_new. if NULL is passed 
+ *                              as argument, strcmp is assumed
+ * @param       Frozen_Layout - which array layout to build
+ * @return      pointer to the new frozen_tree
+ */
+Frozen_T frozen_new(void **values, size_t count, void *comparison_func, 
+                    Frozen_Layout layout); 
+
+/*
+ * frozen_new_r
+ * 
+ * same as frozen_new, but takes a typed comparator and a context that is
+ * passed to every call of it, as for qsort_r
+ * 
+ * CREs         values == NULL && count > 0
+ *              compare == NULL
+ * UREs         system out of memory
+ *              values not sorted
+ * 
+ * @param       void ** - the values, in ascending order
+ * @param       size_t - number of values
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @param       Frozen_Layout - which array layout to build
+ * @return      pointer to the new frozen_tree
+ */
+Frozen_T frozen_new_r(void **values, size_t count, Comparator compare, void *ctx, 
+                      Frozen_Layout layout); 
+
+/*
+ * frozen_free
+ * 
+ * deallocates a frozen tree. the stored values are not freed
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - the tree to be freed
+ * @return      n/a
+ */
+void frozen_free(Frozen_T tree); 
+
+/*
+ * frozen_size
+ * 
+ * returns the number of values in the tree
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - tree to be measured
+ * @return      size_t - number of values
+ */
+size_t frozen_size(Frozen_T tree); 
+
+/*
+ * frozen_layout
+ * 
+ * returns the layout the tree was built with
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - tree to be inspected
+ * @return      Frozen_Layout - the layout
+ */
+Frozen_Layout frozen_layout(Frozen_T tree); 
+
+/*
+ * frozen_search
+ * 
+ * given a tree and a value to search for, returns a pointer to the stored 
+ * value, or NULL if the value is not found. If duplicates are in the tree, 
+ * returns the first one in sorted order
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *frozen_search(Frozen_T tree, void *value); 
+
+/*
+ * frozen_tree_minimum
+ * 
+ * returns the minimum value stored in the tree, or NULL if it is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - tree to be searched
+ * @return      void * - pointer to min value
+ */
+void *frozen_tree_minimum(Frozen_T tree); 
+
+/*
+ * frozen_tree_maximum
+ * 
+ * returns the maximum value stored in the tree, or NULL if it is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - tree to be searched
+ * @return      void * - pointer to max value
+ */
+void *frozen_tree_maximum(Frozen_T tree); 
+
+/*
+ * frozen_successor_of_value
+ * 
+ * given a tree and a value, returns the smallest stored value greater than 
+ * it, or NULL if there is none. the value need not be in the tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - tree to be searched
+ * @param       void * - value to find the successor of
+ * @return      void * - value of the successor
+ */
+void *frozen_successor_of_value(Frozen_T tree, void *value); 
+
+/*
+ * frozen_predecessor_of_value
+ * 
+ * given a tree and a value, returns the largest stored value less than it, 
+ * or NULL if there is none. the value need not be in the tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       Frozen_T - tree to be searched
+ * @param       void * - value to find the predecessor of
+ * @return      void * - value of the predecessor
+ */
+void *frozen_predecessor_of_value(Frozen_T tree, void *value); 
+
+#endif
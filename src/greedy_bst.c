@@ -0,0 +1,153 @@
+#include "greedy_bst.h"
+#include <stdint.h>
+
+/*** MACRO DEFINITIONS ***/
+
+#define GREEDY_NIL SIZE_MAX
+
+/*
+ * Touch_Times
+ *
+ * the time each key was last touched, 0 for never, in the leaves of an
+ * implicit segment tree whose inner nodes hold the maximum of their range
+ */
+typedef struct Touch_Times {
+        size_t *max;
+        size_t leaves;
+} Touch_Times;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_greedy_first_after
+ *
+ * returns the least key y >= from, within the range [lo, hi) of node i,
+ * whose last touch is later than after, or GREEDY_NIL if there is none
+ */
+size_t private_greedy_first_after(Touch_Times *times, size_t i, size_t lo, size_t hi,
+                                  size_t from, size_t after);
+
+/*
+ * private_greedy_last_after
+ *
+ * returns the greatest key y < to, within the range [lo, hi) of node i,
+ * whose last touch is later than after, or GREEDY_NIL if there is none
+ */
+size_t private_greedy_last_after(Touch_Times *times, size_t i, size_t lo, size_t hi,
+                                 size_t to, size_t after);
+
+/*
+ * private_greedy_touch
+ *
+ * sets the last touch of key x to time t
+ */
+void private_greedy_touch(Touch_Times *times, size_t x, size_t t);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+size_t greedy_bst_cost(const size_t *keys, size_t m, size_t n)
+{
+        assert(keys != NULL || m == 0); 
+
+        Touch_Times times; 
+        size_t *touched = malloc((n > 0 ? n : 1) * sizeof(size_t)); 
+        size_t cost = 0; 
+
+        times.leaves = 1; 
+        while (times.leaves < n) 
+                times.leaves *= 2; 
+        times.max = calloc(2 * times.leaves, sizeof(size_t)); 
+
+        for (size_t i = 0; i < m; i++) {
+                size_t x = keys[i]; 
+                size_t t = i + 1; 
+                size_t count = 0; 
+
+                assert(x < n); 
+
+                /* the staircase to the right of x: each step is later than the last */
+                size_t after = times.max[times.leaves + x]; 
+                size_t y = x; 
+
+                while (y + 1 < n && 
+                       (y = private_greedy_first_after(&times, 1, 0, times.leaves, 
+                                                       y + 1, after)) != GREEDY_NIL) {
+                        touched[count++] = y; 
+                        after = times.max[times.leaves + y]; 
+                }
+
+                /* and to the left */
+                after = times.max[times.leaves + x]; 
+                y = x; 
+
+                while (y > 0 && 
+                       (y = private_greedy_last_after(&times, 1, 0, times.leaves, 
+                                                      y, after)) != GREEDY_NIL) {
+                        touched[count++] = y; 
+                        after = times.max[times.leaves + y]; 
+                }
+
+                /* the points of row t are added together, once both are found */
+                private_greedy_touch(&times, x, t); 
+                for (size_t j = 0; j < count; j++) 
+                        private_greedy_touch(&times, touched[j], t); 
+
+                cost += 1 + count; 
+        }
+
+        free(times.max); 
+        free(touched); 
+
+        return cost; 
+}
+
+size_t private_greedy_first_after(Touch_Times *times, size_t i, size_t lo, size_t hi,
+                                  size_t from, size_t after)
+{
+        if (hi <= from || times->max[i] <= after)
+                return GREEDY_NIL; 
+
+        if (hi - lo == 1)
+                return lo; 
+
+        size_t mid = lo + (hi - lo) / 2; 
+        size_t y = private_greedy_first_after(times, 2 * i, lo, mid, from, after); 
+
+        if (y != GREEDY_NIL)
+                return y; 
+
+        return private_greedy_first_after(times, 2 * i + 1, mid, hi, from, after); 
+}
+
+size_t private_greedy_last_after(Touch_Times *times, size_t i, size_t lo, size_t hi,
+                                 size_t to, size_t after)
+{
+        if (lo >= to || times->max[i] <= after)
+                return GREEDY_NIL; 
+
+        if (hi - lo == 1)
+                return lo; 
+
+        size_t mid = lo + (hi - lo) / 2; 
+        size_t y = private_greedy_last_after(times, 2 * i + 1, mid, hi, to, after); 
+
+        if (y != GREEDY_NIL)
+                return y; 
+
+        return private_greedy_last_after(times, 2 * i, lo, mid, to, after); 
+}
+
+void private_greedy_touch(Touch_Times *times, size_t x, size_t t)
+{
+        size_t i = times->leaves + x; 
+
+        times->max[i] = t; 
+
+        /* times only grow, so every ancestor's maximum becomes t */
+        for (i /= 2; i > 0; i /= 2) 
+                times->max[i] = t; 
+}
@@ -0,0 +1,55 @@
+/**********************************************************************
+ * greedy_bst.h                                                       *
+ *                                                                    *
+ * Offline simulator of Greedy (GreedyFuture), the conjectured        *
+ * dynamically optimal BST algorithm, in the geometric view: an       *
+ * access sequence is served by adding the fewest points per row      *
+ * that keep the point set arborally satisfied. keys are given as     *
+ * ranks 0..n - 1, as for the bounds in wilber.h                      *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef GREEDY_BST_H
+#define GREEDY_BST_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * greedy_bst_cost
+ *
+ * returns the number of nodes Greedy touches serving the access sequence,
+ * starting from no touched keys: the size of the arborally satisfied
+ * superset of the access points that Greedy builds row by row. at time t
+ * the accessed key x is touched, and so is every key y whose last touch
+ * is later than that of every key between x and y, x included (the
+ * staircases on either side of x). within a constant factor this is the
+ * cost of an online BST executing Greedy, and Wilber's bounds are lower
+ * bounds on it.
+ *
+ * each staircase key is found with a max segment tree over the last
+ * touch times, so this runs in O((m + cost) log n) time and O(n) space
+ *
+ * CREs         keys == NULL and m > 0
+ * UREs         a key is not less than n
+ *
+ * @param       const size_t * - the accessed keys, in access order
+ * @param       size_t - number of accesses m
+ * @param       size_t - number of keys n
+ * @return      size_t - the number of touched nodes, at least m
+ */
+size_t greedy_bst_cost(const size_t *keys, size_t m, size_t n);
+
+#endif
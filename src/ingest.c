@@ -0,0 +1,223 @@
+#include "ingest.h"
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "corpus.h"
+#include "spsc_ring.h"
+
+/*
+ * Batch
+ *
+ * the words of one chunk of the corpus. they point into the mapping until
+ * the interner replaces them by their interned copies
+ */
+typedef struct Batch {
+        char **words;
+        size_t count;
+} Batch;
+
+/*
+ * Pipeline
+ *
+ * what the splitter and interner threads share with the calling thread.
+ * a NULL batch on a ring marks the end of the corpus
+ */
+typedef struct Pipeline {
+        Corpus_T corpus;
+        InternPool_T pool;
+        SPSC_Ring_T split;      /* splitter to interner */
+        SPSC_Ring_T interned;   /* interner to inserter */
+} Pipeline;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_ingest_split
+ *
+ * splits the next chunk of the corpus into a new batch, or returns NULL
+ * when the whole corpus is split
+ */
+Batch *private_ingest_split(Corpus_T corpus);
+
+/*
+ * private_ingest_intern
+ *
+ * replaces every word of the batch by its interned copy
+ */
+void private_ingest_intern(InternPool_T pool, Batch *batch);
+
+/*
+ * private_ingest_insert
+ *
+ * inserts the words of the batch into the tree, appends them to the
+ * result, and frees the batch
+ */
+void private_ingest_insert(Batch *batch, Ingest_Insert insert, void *tree,
+                           Ingest_Result *result);
+
+/*
+ * private_ingest_push, private_ingest_pop
+ *
+ * push to or pop from a ring, yielding the processor while it is full or
+ * empty
+ */
+void private_ingest_push(SPSC_Ring_T ring, Batch *batch);
+Batch *private_ingest_pop(SPSC_Ring_T ring);
+
+/*
+ * private_ingest_splitter, private_ingest_interner
+ *
+ * the bodies of the first two pipeline stages. each takes the Pipeline
+ */
+void *private_ingest_splitter(void *pipeline);
+void *private_ingest_interner(void *pipeline);
+
+/*
+ * private_ingest_now
+ *
+ * returns a monotonic wall clock reading in nanoseconds
+ */
+double private_ingest_now(void);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+bool ingest_corpus(const char *path, InternPool_T pool, Ingest_Insert insert,
+                   void *tree, Ingest_Mode mode, Ingest_Result *result)
+{
+        assert(path != NULL && pool != NULL && insert != NULL && result != NULL); 
+
+        double start = private_ingest_now(); 
+        Corpus_T corpus = corpus_open(path, true); 
+
+        if (corpus == NULL)
+                return false; 
+
+        /* at most one word per two bytes */
+        result->words = malloc((corpus_size(corpus) / 2 + 1) * sizeof(void *)); 
+        result->count = 0; 
+        result->batches = 0; 
+
+        Batch *batch; 
+
+        if (mode == INGEST_PIPELINED) {
+                Pipeline pipeline = { corpus, pool, spsc_new(INGEST_RING_SIZE),
+                                      spsc_new(INGEST_RING_SIZE) }; 
+                pthread_t splitter, interner; 
+                int failed = 0; 
+
+                failed |= pthread_create(&splitter, NULL, private_ingest_splitter, &pipeline); 
+                failed |= pthread_create(&interner, NULL, private_ingest_interner, &pipeline); 
+                assert(failed == 0); 
+                (void) failed; 
+
+                while ((batch = private_ingest_pop(pipeline.interned)) != NULL)
+                        private_ingest_insert(batch, insert, tree, result); 
+
+                pthread_join(splitter, NULL); 
+                pthread_join(interner, NULL); 
+                spsc_free(pipeline.split); 
+                spsc_free(pipeline.interned); 
+        } else {
+                while ((batch = private_ingest_split(corpus)) != NULL) {
+                        private_ingest_intern(pool, batch); 
+                        private_ingest_insert(batch, insert, tree, result); 
+                }
+        }
+
+        corpus_close(corpus); 
+        result->elapsed = private_ingest_now() - start; 
+
+        return true; 
+}
+
+Batch *private_ingest_split(Corpus_T corpus)
+{
+        Batch *batch = malloc(sizeof(Batch)); 
+
+        batch->words = malloc((INGEST_CHUNK_SIZE / 2 + 1) * sizeof(char *)); 
+
+        if (!corpus_split_chunk(corpus, INGEST_CHUNK_SIZE, batch->words, &batch->count)) {
+                free(batch->words); 
+                free(batch); 
+                return NULL; 
+        }
+
+        return batch; 
+}
+
+void private_ingest_intern(InternPool_T pool, Batch *batch)
+{
+        for (size_t i = 0; i < batch->count; i++) {
+                char *word = batch->words[i]; 
+                batch->words[i] = (char *) intern_string(pool, word, strlen(word)); 
+        }
+}
+
+void private_ingest_insert(Batch *batch, Ingest_Insert insert, void *tree,
+                           Ingest_Result *result)
+{
+        for (size_t i = 0; i < batch->count; i++) {
+                insert(tree, batch->words[i]); 
+                result->words[result->count++] = batch->words[i]; 
+        }
+
+        result->batches++; 
+        free(batch->words); 
+        free(batch); 
+}
+
+void private_ingest_push(SPSC_Ring_T ring, Batch *batch)
+{
+        while (!spsc_push(ring, batch))
+                sched_yield(); 
+}
+
+Batch *private_ingest_pop(SPSC_Ring_T ring)
+{
+        void *batch; 
+
+        while (!spsc_pop(ring, &batch))
+                sched_yield(); 
+
+        return batch; 
+}
+
+void *private_ingest_splitter(void *pipeline)
+{
+        Pipeline *p = pipeline; 
+        Batch *batch; 
+
+        while ((batch = private_ingest_split(p->corpus)) != NULL)
+                private_ingest_push(p->split, batch); 
+        private_ingest_push(p->split, NULL); 
+
+        return NULL; 
+}
+
+void *private_ingest_interner(void *pipeline)
+{
+        Pipeline *p = pipeline; 
+        Batch *batch; 
+
+        while ((batch = private_ingest_pop(p->split)) != NULL) {
+                private_ingest_intern(p->pool, batch); 
+                private_ingest_push(p->interned, batch); 
+        }
+        private_ingest_push(p->interned, NULL); 
+
+        return NULL; 
+}
+
+double private_ingest_now(void)
+{
+        struct timespec now; 
+
+        clock_gettime(CLOCK_MONOTONIC, &now); 
+
+        return now.tv_sec * 1e9 + now.tv_nsec; 
+}
@@ -0,0 +1,97 @@
+/**********************************************************************
+ * ingest.h                                                           *
+ *                                                                    *
+ * Interface for loading a corpus into a tree in three stages: the    *
+ * text is mapped and split into words a chunk at a time, the words   *
+ * are interned, and then inserted. pipelined, the first two stages   *
+ * run on threads of their own and hand batches of words on through   *
+ * single-producer/single-consumer rings, so the inserts on the       *
+ * calling thread no longer wait on parsing. the tree itself is only  *
+ * ever touched by the calling thread                                 *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef INGEST_H
+#define INGEST_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "intern_pool.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+/* bytes of text split per batch */
+#define INGEST_CHUNK_SIZE (64 * 1024)
+
+/* batches in flight between two stages */
+#define INGEST_RING_SIZE 8
+
+/*
+ * INGEST_SEQUENTIAL    every stage runs on the calling thread, one batch
+ *                      after the other
+ * INGEST_PIPELINED     splitting and interning run on two more threads
+ */
+typedef enum {
+        INGEST_SEQUENTIAL = 0,
+        INGEST_PIPELINED
+} Ingest_Mode;
+
+/*
+ * Ingest_Insert
+ *
+ * inserts a value into a tree, like the engines' *_insert_value
+ */
+typedef int (*Ingest_Insert)(void *tree, void *value);
+
+/*
+ * Ingest_Result
+ *
+ * the interned words in corpus order, which the caller frees, and how
+ * long the whole ingest took in wall clock nanoseconds
+ */
+typedef struct Ingest_Result {
+        void **words;
+        size_t count;
+        size_t batches;
+        double elapsed;
+} Ingest_Result;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * ingest_corpus
+ *
+ * maps the corpus at path, splits it with word_split, interns every word
+ * in pool, and inserts the interned words into tree with insert, in
+ * corpus order. the words stored in the tree point into the pool; the
+ * mapping is closed before this returns
+ *
+ * CREs         path == NULL
+ *              pool == NULL
+ *              insert == NULL
+ *              result == NULL
+ * UREs         system out of memory, or out of threads when pipelined
+ *              pool or tree is used by another thread meanwhile
+ *
+ * @param       const char * - path of the corpus
+ * @param       InternPool_T - the pool to intern the words in
+ * @param       Ingest_Insert - the tree's insert function
+ * @param       void * - the tree
+ * @param       Ingest_Mode - sequential or pipelined
+ * @param       Ingest_Result * - where to store the words and timing
+ * @return      bool - false if the corpus could not be opened
+ */
+bool ingest_corpus(const char *path, InternPool_T pool, Ingest_Insert insert,
+                   void *tree, Ingest_Mode mode, Ingest_Result *result);
+
+#endif
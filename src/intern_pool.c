@@ -0,0 +1,316 @@
+#include "intern_pool.h"
+#include <string.h>
+#include <stddef.h>
+
+/*** MACRO DEFINITIONS ***/
+
+#define INTERN_BLOCK_SIZE (64 * 1024)
+#define INTERN_INITIAL_SLOTS 1024
+
+/*
+ * Entry
+ *
+ * the header stored in front of every interned string. intern_id finds
+ * it by stepping back from the string
+ */
+typedef struct Entry {
+        uint32_t id;
+        uint32_t length;
+        uint32_t hash;
+        char bytes[];
+} Entry;
+
+/*
+ * Block
+ *
+ * one of the blocks the entries are packed into. blocks are never moved
+ * or resized, which keeps interned pointers stable
+ */
+typedef struct Block {
+        struct Block *next;
+        size_t used;
+        size_t size;
+        char data[];
+} Block;
+
+/*
+ * the table is open addressed with linear probing, holds pointers to the
+ * entries, and is kept at most 3/4 full
+ */
+struct intern_pool {
+        Entry **slots;
+        size_t capacity;
+        size_t count;
+        Block *blocks;
+        size_t block_bytes;
+};
+
+typedef InternPool_T T;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_intern_hash
+ *
+ * returns the 32 bit FNV-1a hash of the bytes
+ */
+uint32_t private_intern_hash(const char *s, size_t length);
+
+/*
+ * private_intern_find_slot
+ *
+ * returns the slot holding the string, or the empty slot where it would
+ * be inserted
+ */
+Entry **private_intern_find_slot(T pool, const char *s, size_t length, uint32_t hash);
+
+/*
+ * private_intern_allocate
+ *
+ * returns room for an entry of the given size in the current block,
+ * starting a new block when it is full. entries larger than a block get
+ * a block of their own
+ */
+Entry *private_intern_allocate(T pool, size_t size);
+
+/*
+ * private_intern_grow
+ *
+ * doubles the table and reinserts every entry by its stored hash
+ */
+void private_intern_grow(T pool);
+
+/*
+ * private_intern_entry_comparison
+ *
+ * qsort comparison of two Entry * by their strings
+ */
+int private_intern_entry_comparison(const void *val_one, const void *val_two);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T intern_new(void)
+{
+        T pool = malloc(sizeof(struct intern_pool)); 
+
+        pool->capacity = INTERN_INITIAL_SLOTS; 
+        pool->slots = calloc(pool->capacity, sizeof(Entry *)); 
+        pool->count = 0; 
+        pool->blocks = NULL; 
+        pool->block_bytes = 0; 
+
+        return pool; 
+}
+
+void intern_free(T pool)
+{
+        assert(pool != NULL); 
+
+        Block *block = pool->blocks; 
+
+        while (block != NULL) {
+                Block *next = block->next; 
+                free(block); 
+                block = next; 
+        }
+
+        free(pool->slots); 
+        free(pool); 
+}
+
+const char *intern_string(T pool, const char *s, size_t length)
+{
+        assert(pool != NULL); 
+        assert(s != NULL || length == 0); 
+        assert(length < UINT32_MAX); 
+
+        uint32_t hash = private_intern_hash(s, length); 
+        Entry **slot = private_intern_find_slot(pool, s, length, hash); 
+
+        if (*slot != NULL)
+                return (*slot)->bytes; 
+
+        if (4 * (pool->count + 1) > 3 * pool->capacity) {
+                private_intern_grow(pool); 
+                slot = private_intern_find_slot(pool, s, length, hash); 
+        }
+
+        Entry *entry = private_intern_allocate(pool, sizeof(Entry) + length + 1); 
+
+        entry->id = INTERN_NO_ID; 
+        entry->length = (uint32_t) length; 
+        entry->hash = hash; 
+        if (length > 0)
+                memcpy(entry->bytes, s, length); 
+        entry->bytes[length] = '\0'; 
+
+        *slot = entry; 
+        pool->count++; 
+
+        return entry->bytes; 
+}
+
+const char *intern_lookup(T pool, const char *s, size_t length)
+{
+        assert(pool != NULL); 
+        assert(s != NULL || length == 0); 
+
+        if (length >= UINT32_MAX)
+                return NULL; 
+
+        uint32_t hash = private_intern_hash(s, length); 
+        Entry **slot = private_intern_find_slot(pool, s, length, hash); 
+
+        return (*slot != NULL) ? (*slot)->bytes : NULL; 
+}
+
+size_t intern_count(T pool)
+{
+        assert(pool != NULL); 
+
+        return pool->count; 
+}
+
+size_t intern_bytes(T pool)
+{
+        assert(pool != NULL); 
+
+        return pool->block_bytes + pool->capacity * sizeof(Entry *); 
+}
+
+void intern_assign_ids(T pool)
+{
+        assert(pool != NULL); 
+
+        Entry **sorted = malloc((pool->count > 0 ? pool->count : 1) * sizeof(Entry *)); 
+        size_t n = 0; 
+
+        for (size_t i = 0; i < pool->capacity; i++) {
+                if (pool->slots[i] != NULL)
+                        sorted[n++] = pool->slots[i]; 
+        }
+
+        qsort(sorted, n, sizeof(Entry *), private_intern_entry_comparison); 
+
+        for (size_t i = 0; i < n; i++)
+                sorted[i]->id = (uint32_t) i; 
+
+        free(sorted); 
+}
+
+uint32_t intern_id(const char *s)
+{
+        assert(s != NULL); 
+
+        const Entry *entry = (const Entry *) (s - offsetof(Entry, bytes)); 
+
+        return entry->id; 
+}
+
+int intern_id_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        uint32_t a = intern_id(val_one); 
+        uint32_t b = intern_id(val_two); 
+
+        (void) ctx; 
+
+        return (a > b) - (a < b); 
+}
+
+uint32_t private_intern_hash(const char *s, size_t length)
+{
+        uint32_t hash = 2166136261u; 
+
+        for (size_t i = 0; i < length; i++) {
+                hash ^= (unsigned char) s[i]; 
+                hash *= 16777619u; 
+        }
+
+        return hash; 
+}
+
+Entry **private_intern_find_slot(T pool, const char *s, size_t length, uint32_t hash)
+{
+        size_t mask = pool->capacity - 1; 
+        size_t i = hash & mask; 
+
+        while (pool->slots[i] != NULL) {
+                Entry *entry = pool->slots[i]; 
+
+                if (entry->hash == hash && entry->length == length &&
+                    (length == 0 || memcmp(entry->bytes, s, length) == 0))
+                        return &pool->slots[i]; 
+
+                i = (i + 1) & mask; 
+        }
+
+        return &pool->slots[i]; 
+}
+
+Entry *private_intern_allocate(T pool, size_t size)
+{
+        /* keep every header aligned for its uint32_t fields */
+        size = (size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1); 
+
+        Block *block = pool->blocks; 
+
+        if (block == NULL || block->size - block->used < size) {
+                size_t data_size = (size > INTERN_BLOCK_SIZE) ? size : INTERN_BLOCK_SIZE; 
+
+                block = malloc(sizeof(Block) + data_size); 
+                block->used = 0; 
+                block->size = data_size; 
+                pool->block_bytes += sizeof(Block) + data_size; 
+
+                /* an oversized entry leaves the current block in front */
+                if (size > INTERN_BLOCK_SIZE && pool->blocks != NULL) {
+                        block->next = pool->blocks->next; 
+                        pool->blocks->next = block; 
+                } else {
+                        block->next = pool->blocks; 
+                        pool->blocks = block; 
+                }
+        }
+
+        Entry *entry = (Entry *) (block->data + block->used); 
+        block->used += size; 
+
+        return entry; 
+}
+
+void private_intern_grow(T pool)
+{
+        Entry **old_slots = pool->slots; 
+        size_t old_capacity = pool->capacity; 
+
+        pool->capacity *= 2; 
+        pool->slots = calloc(pool->capacity, sizeof(Entry *)); 
+
+        size_t mask = pool->capacity - 1; 
+
+        for (size_t i = 0; i < old_capacity; i++) {
+                Entry *entry = old_slots[i]; 
+
+                if (entry == NULL)
+                        continue; 
+
+                size_t j = entry->hash & mask; 
+                while (pool->slots[j] != NULL)
+                        j = (j + 1) & mask; 
+                pool->slots[j] = entry; 
+        }
+
+        free(old_slots); 
+}
+
+int private_intern_entry_comparison(const void *val_one, const void *val_two)
+{
+        const Entry *a = *(Entry * const *) val_one; 
+        const Entry *b = *(Entry * const *) val_two; 
+
+        return strcmp(a->bytes, b->bytes); 
+}
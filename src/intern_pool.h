@@ -0,0 +1,180 @@
+/**********************************************************************
+ * intern_pool.h                                                      *
+ *                                                                    *
+ * Interface for a string interning pool: each distinct string is     *
+ * stored once, packed into large blocks, and every later intern of   *
+ * an equal string returns the same stable pointer. on request the    *
+ * pool numbers its strings in sorted order, so that trees of         *
+ * interned strings can compare two integers in place of strcmp       *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef INTERN_POOL_H
+#define INTERN_POOL_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct intern_pool *InternPool_T;
+
+/* the id of a string interned after the last intern_assign_ids */
+#define INTERN_NO_ID UINT32_MAX
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * intern_new
+ *
+ * returns a pointer to a new, empty pool
+ *
+ * CREs         n/a
+ * UREs         system out of memory
+ *
+ * @return      pointer to the new intern_pool
+ */
+InternPool_T intern_new(void);
+
+/*
+ * intern_free
+ *
+ * deallocates the pool and every string in it. pointers it handed out
+ * are no longer valid
+ *
+ * CREs         pool == NULL
+ * UREs         n/a
+ *
+ * @param       InternPool_T - the pool to be freed
+ * @return      n/a
+ */
+void intern_free(InternPool_T pool);
+
+/*
+ * intern_string
+ *
+ * returns the pool's copy of the length bytes at s, adding a nul
+ * terminated copy if the pool does not hold an equal string yet. s need
+ * not be nul terminated. the returned pointer stays valid, and is the
+ * same for equal strings, until the pool is freed; so interned strings
+ * are equal if and only if their pointers are
+ *
+ * CREs         pool == NULL
+ *              s == NULL && length > 0
+ *              length >= UINT32_MAX
+ * UREs         system out of memory
+ *              the bytes contain a nul
+ *
+ * @param       InternPool_T - the pool
+ * @param       const char * - the bytes of the string
+ * @param       size_t - number of bytes
+ * @return      const char * - the interned string
+ */
+const char *intern_string(InternPool_T pool, const char *s, size_t length);
+
+/*
+ * intern_lookup
+ *
+ * returns the pool's copy of the string at s, or NULL if it holds none.
+ * never adds to the pool
+ *
+ * CREs         pool == NULL
+ *              s == NULL && length > 0
+ * UREs         n/a
+ *
+ * @param       InternPool_T - the pool
+ * @param       const char * - the bytes of the string
+ * @param       size_t - number of bytes
+ * @return      const char * - the interned string, or NULL
+ */
+const char *intern_lookup(InternPool_T pool, const char *s, size_t length);
+
+/*
+ * intern_count
+ *
+ * returns the number of distinct strings in the pool
+ *
+ * CREs         pool == NULL
+ * UREs         n/a
+ *
+ * @param       InternPool_T - the pool
+ * @return      size_t - number of strings
+ */
+size_t intern_count(InternPool_T pool);
+
+/*
+ * intern_bytes
+ *
+ * returns the memory the pool holds for its strings and its table, in
+ * bytes
+ *
+ * CREs         pool == NULL
+ * UREs         n/a
+ *
+ * @param       InternPool_T - the pool
+ * @return      size_t - bytes allocated
+ */
+size_t intern_bytes(InternPool_T pool);
+
+/*
+ * intern_assign_ids
+ *
+ * numbers the strings in the pool 0..count - 1 in strcmp order, so that
+ * intern_id_comparison orders interned strings as strcmp would. strings
+ * interned afterwards have INTERN_NO_ID until this is called again,
+ * which renumbers every string. O(n log n)
+ *
+ * CREs         pool == NULL
+ * UREs         system out of memory
+ *
+ * @param       InternPool_T - the pool
+ * @return      n/a
+ */
+void intern_assign_ids(InternPool_T pool);
+
+/*
+ * intern_id
+ *
+ * returns the id of an interned string: its rank at the last call of
+ * intern_assign_ids, or INTERN_NO_ID. reads the id stored next to the
+ * string, so it needs no pool
+ *
+ * CREs         s == NULL
+ * UREs         s was not returned by intern_string
+ *
+ * @param       const char * - an interned string
+ * @return      uint32_t - its id
+ */
+uint32_t intern_id(const char *s);
+
+/*
+ * intern_id_comparison
+ *
+ * compares two interned strings by id, ignoring ctx. has the Comparator
+ * signature of comparator.h, so a tree built with it, eg
+ * rb_new_r(intern_id_comparison, NULL), orders interned strings as with
+ * strcmp at the cost of an integer compare
+ *
+ * CREs         n/a
+ * UREs         either value is not an interned string
+ *              either value has INTERN_NO_ID
+ *
+ * @param       const void * - first interned string
+ * @param       const void * - second interned string
+ * @param       void * - unused
+ * @return      int - negative, zero or positive as for strcmp
+ */
+int intern_id_comparison(const void *val_one, const void *val_two, void *ctx);
+
+#endif
@@ -0,0 +1,74 @@
+#include "monoid.h"
+#include <math.h>
+#include <assert.h>
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_monoid_add, private_monoid_least, private_monoid_greatest
+ *
+ * the combines of the ready made monoids. ctx is unused
+ */
+double private_monoid_add(double left, double right, void *ctx);
+double private_monoid_least(double left, double right, void *ctx);
+double private_monoid_greatest(double left, double right, void *ctx);
+
+/*
+ * private_monoid_make
+ *
+ * bundles a measure and its context with a combine and its identity
+ */
+Monoid private_monoid_make(Monoid_Measure measure, void *ctx, Monoid_Combine combine,
+                           double identity);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+Monoid monoid_sum(Monoid_Measure measure, void *ctx)
+{
+        return private_monoid_make(measure, ctx, private_monoid_add, 0.0); 
+}
+
+Monoid monoid_min(Monoid_Measure measure, void *ctx)
+{
+        return private_monoid_make(measure, ctx, private_monoid_least, INFINITY); 
+}
+
+Monoid monoid_max(Monoid_Measure measure, void *ctx)
+{
+        return private_monoid_make(measure, ctx, private_monoid_greatest, -INFINITY); 
+}
+
+Monoid private_monoid_make(Monoid_Measure measure, void *ctx, Monoid_Combine combine,
+                           double identity)
+{
+        assert(measure != NULL); 
+
+        Monoid monoid = { measure, combine, identity, ctx }; 
+
+        return monoid; 
+}
+
+double private_monoid_add(double left, double right, void *ctx)
+{
+        (void) ctx; 
+
+        return left + right; 
+}
+
+double private_monoid_least(double left, double right, void *ctx)
+{
+        (void) ctx; 
+
+        return (right < left) ? right : left; 
+}
+
+double private_monoid_greatest(double left, double right, void *ctx)
+{
+        (void) ctx; 
+
+        return (right > left) ? right : left; 
+}
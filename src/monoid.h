@@ -0,0 +1,72 @@
+/**********************************************************************
+ * monoid.h                                                           *
+ *                                                                    *
+ * The subtree aggregate an augmented engine keeps in every node: a   *
+ * measure of each value, folded over the values of a subtree in      *
+ * sorted order with an associative combine that has an identity.     *
+ * sums, minimums and maximums come ready made; any other monoid is   *
+ * a Monoid filled in by hand                                         *
+ **********************************************************************/
+
+#ifndef MONOID_H
+#define MONOID_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+/*
+ * Monoid_Measure
+ *
+ * returns the number a stored value contributes to the aggregate. ctx is
+ * the monoid's
+ */
+typedef double (*Monoid_Measure)(const void *value, void *ctx);
+
+/*
+ * Monoid_Combine
+ *
+ * folds the aggregate of a run of values, left, with that of the run that
+ * follows it, right. must be associative, but need not be commutative
+ */
+typedef double (*Monoid_Combine)(double left, double right, void *ctx);
+
+/*
+ * Monoid
+ *
+ * a measure and a combine, the identity of the combine (the aggregate of
+ * no values), and the context passed to both
+ */
+typedef struct Monoid {
+        Monoid_Measure measure;
+        Monoid_Combine combine;
+        double identity;
+        void *ctx;
+} Monoid;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * monoid_sum, monoid_min, monoid_max
+ *
+ * return the monoid that adds up the measures of the values, or keeps the
+ * least or greatest of them. the aggregate of no values is 0 for a sum,
+ * and INFINITY or -INFINITY for a minimum or maximum
+ *
+ * CREs         measure == NULL
+ * UREs         n/a
+ *
+ * @param       Monoid_Measure - the measure of a value
+ * @param       void * - context passed to it
+ * @return      Monoid - the monoid
+ */
+Monoid monoid_sum(Monoid_Measure measure, void *ctx);
+Monoid monoid_min(Monoid_Measure measure, void *ctx);
+Monoid monoid_max(Monoid_Measure measure, void *ctx);
+
+#endif
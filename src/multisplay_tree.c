@@ -0,0 +1,901 @@
+#include "multisplay_tree.h"
+#include "splay_tree_impl.h"
+#include <string.h>
+#include <stdint.h>
+
+/*
+ * the whole structure is one binary search tree, cut into auxiliary trees:
+ * each auxiliary tree holds the nodes of one preferred path of the
+ * reference tree P and is itself a splay tree, rooted at a node marked
+ * is_root. an auxiliary tree hangs below the auxiliary tree that holds
+ * the P-parent of its shallowest node. splaying never crosses an is_root
+ * boundary, and rotations are done by splay_tree.c's primitives, with a
+ * rotate hook keeping the bookkeeping below current.
+ *
+ * depths need only increase strictly from parent to child in P: a node
+ * removed from P lets its one child take its place without relabelling
+ * the child's subtree
+ */
+typedef struct MS_Node {
+        Node node;              /* must come first: the splay primitives see only this */
+        int depth;              /* depth label in the reference tree P */
+        int min_depth;          /* least depth in this node's auxiliary subtree */
+        bool is_root;           /* root of its auxiliary tree */
+} MS_Node;
+
+#define MS(n) ((MS_Node *) (n))
+
+struct multisplay_tree {
+        struct splay_tree base;         /* root, comparator, rotate hook */
+};
+
+typedef MultiSplay_T T;
+
+typedef enum Walk_Order { WALK_PREORDER, WALK_INORDER, WALK_POSTORDER } Walk_Order;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+Node *multisplay_construct_node(void *value, int depth);
+void private_multisplay_deallocate_all_tree_nodes(Node *n);
+
+/*
+ * private_multisplay_in_aux
+ *
+ * returns true if child is a node of the same auxiliary tree as its
+ * parent, that is, neither NULL nor the root of an auxiliary tree below
+ */
+bool private_multisplay_in_aux(Node *child);
+
+/*
+ * private_multisplay_update
+ *
+ * recomputes n's min_depth from its own depth and its children that lie in
+ * the same auxiliary tree
+ */
+void private_multisplay_update(Node *n);
+
+/*
+ * private_multisplay_rotate_hook
+ *
+ * installed as the splay tree's rotate hook. moves the is_root mark up
+ * when an auxiliary root is rotated down, and refreshes min_depth of the
+ * two nodes whose subtrees changed
+ */
+void private_multisplay_rotate_hook(Splay_T base, Node *down, Node *up);
+
+/*
+ * private_multisplay_splay
+ *
+ * splays x within its auxiliary tree until it is the auxiliary root, or
+ * until it is a child of stop if stop is not NULL (stop must then be an
+ * ancestor of x in the same auxiliary tree)
+ *
+ * CREs         n/a
+ * UREs         n/a
+ *
+ * @param       T - tree in which x lives
+ * @param       Node * - node to splay
+ * @param       Node * - ancestor to stop below, or NULL
+ * @return      n/a
+ */
+void private_multisplay_splay(T tree, Node *x, Node *stop);
+
+/*
+ * private_multisplay_switch
+ *
+ * makes the path through z's auxiliary tree the preferred path below p. p
+ * must be the root of its auxiliary tree and the P-parent of the
+ * shallowest node of z's auxiliary tree, whose root z hangs below p. the
+ * old preferred child of p, on the other side of p from z, is cut off as
+ * an auxiliary tree of its own, and z's auxiliary tree is joined with p's
+ *
+ * CREs         n/a
+ * UREs         n/a
+ *
+ * @param       T - tree in which p lives
+ * @param       Node * - root of the upper auxiliary tree
+ * @param       Node * - root of the auxiliary tree to join
+ * @return      n/a
+ */
+void private_multisplay_switch(T tree, Node *p, Node *z);
+
+/*
+ * private_multisplay_access
+ *
+ * walks up from x through every auxiliary tree between it and the root,
+ * switching preferred children so that the path from the root of P to x
+ * becomes one auxiliary tree, then splays x to the root of the whole tree
+ *
+ * CREs         n/a
+ * UREs         n/a
+ *
+ * @param       T - tree in which x lives
+ * @param       Node * - node being accessed
+ * @return      n/a
+ */
+void private_multisplay_access(T tree, Node *x);
+
+/*
+ * private_multisplay_bound
+ *
+ * returns the first node whose value is greater than or equal to value
+ * (strict == false), or greater than value (strict == true), or NULL if
+ * there is none. the last node visited is stored in *last
+ */
+Node *private_multisplay_bound(T tree, void *value, bool strict, Node **last);
+
+Node *private_multisplay_minimum(Node *n);
+Node *private_multisplay_maximum(Node *n);
+Node *private_multisplay_next_inorder(Node *n);
+Node *private_multisplay_prev_inorder(Node *n);
+
+/*
+ * private_multisplay_remove
+ *
+ * removes s, which has at most one child in P, from the tree and frees
+ * it. pred and succ are its neighbours in key order, or NULL
+ *
+ * CREs         n/a
+ * UREs         s has two children in P
+ *
+ * @param       T - tree in which s lives
+ * @param       Node * - node to remove
+ * @param       Node * - node before s in key order, or NULL
+ * @param       Node * - node after s in key order, or NULL
+ * @return      n/a
+ */
+void private_multisplay_remove(T tree, Node *s, Node *pred, Node *succ);
+
+/*
+ * private_multisplay_build
+ *
+ * builds a perfectly balanced tree over values[lo, hi), each with the 
+ * count at the same index of counts, in which the tree and P coincide 
+ * and every node is its own auxiliary tree
+ */
+Node *private_multisplay_build(void **values, uint32_t *counts, size_t lo, size_t hi, 
+                               int depth, Node *parent);
+
+/*
+ * private_multisplay_walk
+ *
+ * applies func_to_apply to every value in the given order, walking
+ * the tree through parent links so that deep trees do not recurse. depth
+ * is the depth in the tree, not in P
+ */
+void private_multisplay_walk(T tree, Walk_Order order,
+                             void func_to_apply(void *value, int depth, void *cl),
+                             void *cl);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T multisplay_new(void *comparison_func)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return multisplay_new_r(compare.func, compare.ctx); 
+}
+
+T multisplay_new_r(Comparator compare, void *ctx)
+{
+        assert(compare != NULL); 
+
+        T tree = malloc(sizeof(struct multisplay_tree)); 
+
+        tree->base.root = NULL; 
+        tree->base.rotate_hook = private_multisplay_rotate_hook; 
+        tree->base.multiset = false; 
+        tree->base.ranked = false; 
+        tree->base.aggregated = false; 
+
+        tree->base.compare.func = compare; 
+        tree->base.compare.ctx = ctx; 
+
+        return tree; 
+}
+
+T multisplay_new_multiset(Comparator compare, void *ctx)
+{
+        T tree = multisplay_new_r(compare, ctx); 
+
+        tree->base.multiset = true; 
+
+        return tree; 
+}
+
+void multisplay_free(T tree)
+{
+        assert(tree != NULL); 
+
+        private_multisplay_deallocate_all_tree_nodes(tree->base.root); 
+        free(tree); 
+}
+
+void private_multisplay_deallocate_all_tree_nodes(Node *n)
+{
+        /* rotate left children up until there are none, freeing as we go */
+        while (n != NULL) {
+                if (n->left != NULL) {
+                        Node *left = n->left; 
+
+                        n->left = left->right; 
+                        left->right = n; 
+                        n = left; 
+                } else {
+                        Node *right = n->right; 
+
+                        free(MS(n)); 
+                        n = right; 
+                }
+        }
+}
+
+bool multisplay_is_empty(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->base.root == NULL; 
+}
+
+Node *multisplay_construct_node(void *value, int depth)
+{
+        MS_Node *new_node = malloc(sizeof(MS_Node)); 
+
+        new_node->node.value = value; 
+        new_node->node.parent = NULL; 
+        new_node->node.left = NULL; 
+        new_node->node.right = NULL; 
+        new_node->node.count = 1; 
+        new_node->node.size = 1; 
+        new_node->node.aggregate = 0; 
+        new_node->depth = depth; 
+        new_node->min_depth = depth; 
+        new_node->is_root = true; 
+
+        return &new_node->node; 
+}
+
+bool private_multisplay_in_aux(Node *child)
+{
+        return child != NULL && !MS(child)->is_root; 
+}
+
+void private_multisplay_update(Node *n)
+{
+        int min_depth = MS(n)->depth; 
+
+        if (private_multisplay_in_aux(n->left) && MS(n->left)->min_depth < min_depth)
+                min_depth = MS(n->left)->min_depth; 
+
+        if (private_multisplay_in_aux(n->right) && MS(n->right)->min_depth < min_depth)
+                min_depth = MS(n->right)->min_depth; 
+
+        MS(n)->min_depth = min_depth; 
+}
+
+void private_multisplay_rotate_hook(Splay_T base, Node *down, Node *up)
+{
+        (void) base; 
+
+        if (MS(down)->is_root) {
+                MS(down)->is_root = false; 
+                MS(up)->is_root = true; 
+        }
+
+        private_multisplay_update(down); 
+        private_multisplay_update(up); 
+}
+
+void private_multisplay_splay(T tree, Node *x, Node *stop)
+{
+        while (!MS(x)->is_root && x->parent != stop) {
+                Node *p = x->parent; 
+
+                if (MS(p)->is_root || p->parent == stop) {
+                        single_rotate(&tree->base, x); 
+                } else {
+                        double_rotate(&tree->base, x); 
+                }
+        }
+}
+
+void private_multisplay_switch(T tree, Node *p, Node *z)
+{
+        int depth = MS(p)->depth; 
+        Node *c = z; 
+
+        while (c->parent != p)
+                c = c->parent; 
+
+        bool from_left = (c == p->left); 
+
+        /*
+         * the old preferred child's path lies on the far side of p, and is
+         * the run of nodes deeper than p next to it in key order. bound is
+         * the closest node on that side that is shallower than p
+         */
+        Node *bound = NULL; 
+        Node *n = from_left ? p->right : p->left; 
+
+        if (!private_multisplay_in_aux(n))
+                n = NULL; 
+
+        while (n != NULL) {
+                Node *near = from_left ? n->left : n->right; 
+                Node *far = from_left ? n->right : n->left; 
+
+                if (private_multisplay_in_aux(near) && MS(near)->min_depth < depth) {
+                        n = near; 
+                } else if (MS(n)->depth < depth) {
+                        bound = n; 
+                        n = NULL; 
+                } else if (private_multisplay_in_aux(far) && MS(far)->min_depth < depth) {
+                        n = far; 
+                } else {
+                        n = NULL; 
+                }
+        }
+
+        Node *deep; 
+
+        if (bound != NULL) {
+                private_multisplay_splay(tree, bound, p); 
+                deep = from_left ? bound->left : bound->right; 
+        } else {
+                deep = from_left ? p->right : p->left; 
+        }
+
+        if (private_multisplay_in_aux(deep))
+                MS(deep)->is_root = true; 
+
+        if (bound != NULL)
+                private_multisplay_update(bound); 
+
+        /*
+         * on z's side every node of p's auxiliary tree is shallower than p,
+         * and z hangs between p and the closest of them
+         */
+        Node *neighbour = from_left ? p->left : p->right; 
+
+        if (private_multisplay_in_aux(neighbour)) {
+                Node *next = from_left ? neighbour->right : neighbour->left; 
+
+                while (private_multisplay_in_aux(next)) {
+                        neighbour = next; 
+                        next = from_left ? neighbour->right : neighbour->left; 
+                }
+
+                private_multisplay_splay(tree, neighbour, p); 
+                assert((from_left ? neighbour->right : neighbour->left) == z); 
+        } else {
+                neighbour = NULL; 
+                assert((from_left ? p->left : p->right) == z); 
+        }
+
+        MS(z)->is_root = false; 
+
+        if (neighbour != NULL)
+                private_multisplay_update(neighbour); 
+
+        private_multisplay_update(p); 
+}
+
+void private_multisplay_access(T tree, Node *x)
+{
+        Node *z = x; 
+
+        private_multisplay_splay(tree, z, NULL); 
+
+        while (z->parent != NULL) {
+                Node *y = z->parent; 
+
+                private_multisplay_splay(tree, y, NULL); 
+
+                /*
+                 * z's auxiliary tree hangs between two adjacent nodes of y's:
+                 * y and its neighbour on z's side. the deeper of the two is
+                 * the P-parent of its shallowest node, the other an ancestor
+                 */
+                Node *p = y; 
+                Node *c = z; 
+
+                while (c->parent != y)
+                        c = c->parent; 
+
+                bool from_left = (c == y->left); 
+
+                if (private_multisplay_in_aux(c)) {
+                        Node *neighbour = c; 
+                        Node *next = from_left ? c->right : c->left; 
+
+                        while (private_multisplay_in_aux(next)) {
+                                neighbour = next; 
+                                next = from_left ? neighbour->right : neighbour->left; 
+                        }
+
+                        if (MS(neighbour)->depth > MS(y)->depth) {
+                                p = neighbour; 
+                                private_multisplay_splay(tree, p, NULL); 
+                        }
+                }
+
+                private_multisplay_switch(tree, p, z); 
+                z = p; 
+        }
+
+        private_multisplay_splay(tree, x, NULL); 
+}
+
+int multisplay_insert_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->base.compare; 
+        Node *pred = NULL; 
+        Node *succ = NULL; 
+        Node *n = tree->base.root; 
+
+        if (tree->base.multiset) {
+                Node *last; 
+                Node *x = private_multisplay_bound(tree, value, false, &last); 
+
+                if (x != NULL && compare.func(value, x->value, compare.ctx) == 0) {
+                        x->count++; 
+                        private_multisplay_access(tree, x); 
+                        return 0; 
+                }
+        }
+
+        /* equal values go to the right, as in the other trees */
+        while (n != NULL) {
+                if (compare.func(value, n->value, compare.ctx) < 0) {
+                        succ = n; 
+                        n = n->left; 
+                } else {
+                        pred = n; 
+                        n = n->right; 
+                }
+        }
+
+        if (pred == NULL && succ == NULL) {
+                tree->base.root = multisplay_construct_node(value, 0); 
+
+                return 0; 
+        }
+
+        /*
+         * in P the new value is a leaf below the deeper of its neighbours.
+         * accessing that neighbour first brings both neighbours into the
+         * top auxiliary tree, so the new node hangs from the auxiliary tree
+         * of its P-parent
+         */
+        Node *p_parent; 
+
+        if (pred == NULL || (succ != NULL && MS(succ)->depth > MS(pred)->depth)) {
+                p_parent = succ; 
+        } else {
+                p_parent = pred; 
+        }
+
+        private_multisplay_access(tree, p_parent); 
+
+        Node *new_node = multisplay_construct_node(value, MS(p_parent)->depth + 1); 
+        Node *parent = NULL; 
+
+        n = tree->base.root; 
+
+        while (n != NULL) {
+                parent = n; 
+
+                if (compare.func(value, n->value, compare.ctx) < 0) {
+                        n = n->left; 
+                } else {
+                        n = n->right; 
+                }
+        }
+
+        new_node->parent = parent; 
+
+        if (compare.func(value, parent->value, compare.ctx) < 0) {
+                parent->left = new_node; 
+        } else {
+                parent->right = new_node; 
+        }
+
+        private_multisplay_access(tree, new_node); 
+
+        return 0; 
+}
+
+Node *private_multisplay_bound(T tree, void *value, bool strict, Node **last)
+{
+        Compare compare = tree->base.compare; 
+        Node *bound = NULL; 
+        Node *n = tree->base.root; 
+
+        *last = NULL; 
+
+        while (n != NULL) {
+                int c = compare.func(value, n->value, compare.ctx); 
+
+                *last = n; 
+
+                if (c < 0 || (c == 0 && !strict)) {
+                        bound = n; 
+                        n = n->left; 
+                } else {
+                        n = n->right; 
+                }
+        }
+
+        return bound; 
+}
+
+void *multisplay_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Compare compare = tree->base.compare; 
+        Node *last = NULL; 
+        Node *n = tree->base.root; 
+
+        /* any equal value will do, so the search stops at the first one */
+        while (n != NULL) {
+                int c = compare.func(value, n->value, compare.ctx); 
+
+                last = n; 
+
+                if (c == 0)
+                        break; 
+
+                n = (c < 0) ? n->left : n->right; 
+        }
+
+        if (n == NULL) {
+                if (last != NULL)
+                        private_multisplay_access(tree, last); 
+                return NULL; 
+        }
+
+        private_multisplay_access(tree, n); 
+
+        return n->value; 
+}
+
+void multisplay_delete_value(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Compare compare = tree->base.compare; 
+        Node *last; 
+        Node *x = private_multisplay_bound(tree, value, false, &last); 
+
+        if (x == NULL || compare.func(value, x->value, compare.ctx) != 0) {
+                if (last != NULL)
+                        private_multisplay_access(tree, last); 
+                return; 
+        }
+
+        if (--x->count > 0) {
+                private_multisplay_access(tree, x); 
+                return; 
+        }
+
+        /*
+         * a neighbour in key order that is deeper in P than x lies in x's 
+         * subtree on that side, so x has a child in P on that side
+         */
+        Node *pred = private_multisplay_prev_inorder(x); 
+        Node *succ = private_multisplay_next_inorder(x); 
+
+        if (pred != NULL && MS(pred)->depth > MS(x)->depth &&
+            succ != NULL && MS(succ)->depth > MS(x)->depth) {
+                /* x takes its successor's value and count, and the successor goes */
+                x->value = succ->value; 
+                x->count = succ->count; 
+                pred = x; 
+                x = succ; 
+                succ = private_multisplay_next_inorder(x); 
+        }
+
+        private_multisplay_remove(tree, x, pred, succ); 
+}
+
+size_t multisplay_count(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->base.compare; 
+        Node *last; 
+        Node *x = private_multisplay_bound(tree, value, false, &last); 
+        size_t count = 0; 
+
+        if (x == NULL || compare.func(value, x->value, compare.ctx) != 0) {
+                if (last != NULL)
+                        private_multisplay_access(tree, last); 
+                return 0; 
+        }
+
+        private_multisplay_access(tree, x); 
+
+        while (x != NULL && compare.func(value, x->value, compare.ctx) == 0) {
+                count += x->count; 
+                x = private_multisplay_next_inorder(x); 
+        }
+
+        return count; 
+}
+
+void private_multisplay_remove(T tree, Node *s, Node *pred, Node *succ)
+{
+        /*
+         * accessing the deepest of s and its neighbours puts all three on
+         * the top auxiliary tree; s's child in P, if any, is then on it too,
+         * and takes s's place on the path when s leaves
+         */
+        Node *deepest = s; 
+
+        if (pred != NULL && MS(pred)->depth > MS(deepest)->depth)
+                deepest = pred; 
+        if (succ != NULL && MS(succ)->depth > MS(deepest)->depth)
+                deepest = succ; 
+
+        private_multisplay_access(tree, deepest); 
+        private_multisplay_splay(tree, s, NULL); 
+
+        Node *left = s->left; 
+        Node *right = s->right; 
+        Node *root = right; 
+
+        if (left != NULL) {
+                /* pred is the largest node of the top tree left of s */
+                assert(private_multisplay_in_aux(left)); 
+
+                private_multisplay_splay(tree, pred, s); 
+                assert(pred->right == NULL); 
+
+                pred->right = right; 
+                if (right != NULL)
+                        right->parent = pred; 
+
+                root = pred; 
+        }
+
+        if (root != NULL) {
+                root->parent = NULL; 
+                MS(root)->is_root = true; 
+                private_multisplay_update(root); 
+        }
+
+        tree->base.root = root; 
+        free(MS(s)); 
+}
+
+void *multisplay_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->base.root == NULL)
+                return NULL; 
+
+        Node *n = private_multisplay_minimum(tree->base.root); 
+
+        private_multisplay_access(tree, n); 
+
+        return n->value; 
+}
+
+void *multisplay_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->base.root == NULL)
+                return NULL; 
+
+        Node *n = private_multisplay_maximum(tree->base.root); 
+
+        private_multisplay_access(tree, n); 
+
+        return n->value; 
+}
+
+void *multisplay_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *last; 
+        Node *n = private_multisplay_bound(tree, value, true, &last); 
+
+        if (n == NULL) {
+                if (last != NULL)
+                        private_multisplay_access(tree, last); 
+                return NULL; 
+        }
+
+        private_multisplay_access(tree, n); 
+
+        return n->value; 
+}
+
+void *multisplay_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *last; 
+        Node *n = private_multisplay_bound(tree, value, false, &last); 
+
+        /* the predecessor sits just before the first node not less than value */
+        if (n != NULL) {
+                n = private_multisplay_prev_inorder(n); 
+        } else if (tree->base.root != NULL) {
+                n = private_multisplay_maximum(tree->base.root); 
+        }
+
+        if (n == NULL) {
+                if (last != NULL)
+                        private_multisplay_access(tree, last); 
+                return NULL; 
+        }
+
+        private_multisplay_access(tree, n); 
+
+        return n->value; 
+}
+
+Node *private_multisplay_minimum(Node *n)
+{
+        while (n->left != NULL)
+                n = n->left; 
+
+        return n; 
+}
+
+Node *private_multisplay_maximum(Node *n)
+{
+        while (n->right != NULL)
+                n = n->right; 
+
+        return n; 
+}
+
+Node *private_multisplay_next_inorder(Node *n)
+{
+        if (n->right != NULL)
+                return private_multisplay_minimum(n->right); 
+
+        while (n->parent != NULL && n == n->parent->right)
+                n = n->parent; 
+
+        return n->parent; 
+}
+
+Node *private_multisplay_prev_inorder(Node *n)
+{
+        if (n->left != NULL)
+                return private_multisplay_maximum(n->left); 
+
+        while (n->parent != NULL && n == n->parent->left)
+                n = n->parent; 
+
+        return n->parent; 
+}
+
+void multisplay_rebalance(T tree)
+{
+        assert(tree != NULL); 
+
+        size_t count = 0; 
+        Node *n; 
+
+        for (n = (tree->base.root == NULL) ? NULL : private_multisplay_minimum(tree->base.root); 
+             n != NULL; n = private_multisplay_next_inorder(n))
+                count++; 
+
+        void **values = malloc((count > 0 ? count : 1) * sizeof(void *)); 
+        uint32_t *counts = malloc((count > 0 ? count : 1) * sizeof(uint32_t)); 
+        size_t i = 0; 
+
+        for (n = (tree->base.root == NULL) ? NULL : private_multisplay_minimum(tree->base.root); 
+             n != NULL; n = private_multisplay_next_inorder(n)) {
+                values[i] = n->value; 
+                counts[i++] = n->count; 
+        }
+
+        private_multisplay_deallocate_all_tree_nodes(tree->base.root); 
+        tree->base.root = private_multisplay_build(values, counts, 0, count, 0, NULL); 
+
+        free(values); 
+        free(counts); 
+}
+
+Node *private_multisplay_build(void **values, uint32_t *counts, size_t lo, size_t hi, 
+                               int depth, Node *parent)
+{
+        if (lo >= hi)
+                return NULL; 
+
+        size_t mid = lo + (hi - lo) / 2; 
+        Node *n = multisplay_construct_node(values[mid], depth); 
+
+        n->count = counts[mid]; 
+        n->parent = parent; 
+        n->left = private_multisplay_build(values, counts, lo, mid, depth + 1, n); 
+        n->right = private_multisplay_build(values, counts, mid + 1, hi, depth + 1, n); 
+
+        return n; 
+}
+
+void private_multisplay_walk(T tree, Walk_Order order,
+                             void func_to_apply(void *value, int depth, void *cl),
+                             void *cl)
+{
+        Node *prev = NULL; 
+        Node *n = tree->base.root; 
+        int depth = 0; 
+
+        while (n != NULL) {
+                Node *next; 
+
+                if (prev == n->parent) {
+                        /* arrived from above */
+                        if (order == WALK_PREORDER)
+                                func_to_apply(n->value, depth, cl); 
+
+                        if (n->left != NULL) {
+                                next = n->left; 
+                        } else {
+                                if (order == WALK_INORDER)
+                                        func_to_apply(n->value, depth, cl); 
+                                next = (n->right != NULL) ? n->right : n->parent; 
+                        }
+                } else if (prev == n->left) {
+                        if (order == WALK_INORDER)
+                                func_to_apply(n->value, depth, cl); 
+                        next = (n->right != NULL) ? n->right : n->parent; 
+                } else {
+                        next = n->parent; 
+                }
+
+                if (next == n->parent) {
+                        if (order == WALK_POSTORDER)
+                                func_to_apply(n->value, depth, cl); 
+                        depth--; 
+                } else {
+                        depth++; 
+                }
+
+                prev = n; 
+                n = next; 
+        }
+}
+
+void multisplay_map_inorder(T tree,
+                            void func_to_apply(void *value, int depth, void *cl),
+                            void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_multisplay_walk(tree, WALK_INORDER, func_to_apply, cl); 
+}
+
+void multisplay_map_preorder(T tree,
+                             void func_to_apply(void *value, int depth, void *cl),
+                             void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_multisplay_walk(tree, WALK_PREORDER, func_to_apply, cl); 
+}
+
+void multisplay_map_postorder(T tree,
+                              void func_to_apply(void *value, int depth, void *cl),
+                              void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_multisplay_walk(tree, WALK_POSTORDER, func_to_apply, cl); 
+}
@@ -0,0 +1,348 @@
+/**********************************************************************
+ * multisplay_tree.h                                                  *
+ *                                                                    *
+ * Interface for a polymorphic multi-splay tree (Wang, Derryberry and *
+ * Sleator): a tree of splay trees, one per preferred path through a  *
+ * reference BST. it is O(log log n)-competitive with the best        *
+ * dynamic BST on any access sequence, and O(log n) amortized         *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef MULTISPLAY_TREE_H
+#define MULTISPLAY_TREE_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "comparator.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct multisplay_tree *MultiSplay_T;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * multisplay_new
+ * 
+ * returns a pointer to a new, empty multi-splay tree
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ *              
+ * 
+ * @param       void * - pointer to a comparison function. if NULL is passed 
+ *                              as argument, strcmp is assumed. 
+ *              
+ *              comparison_function
+ *              @param          item being inserted (val1)
+ *              @param          item from tree which we are comparing (val2)
+ *              @return         int 
+ *                               - zero (0) if val1 == val2
+ *                               - positive value (n > 0) if val1 > val2
+ *                               - negative value (n < 0) if val1 < val2
+ *        
+ * @return      pointer to empty multisplay_tree
+ */
+MultiSplay_T multisplay_new(void *comparison_func); 
+
+/*
+ * multisplay_new_r
+ * 
+ * same as multisplay_new, but takes a typed comparator and a context that is
+ * passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty multisplay_tree
+ */
+MultiSplay_T multisplay_new_r(Comparator compare, void *ctx); 
+
+/*
+ * multisplay_new_multiset
+ * 
+ * same as multisplay_new_r, but the tree keeps a single node per distinct 
+ * value, with a count of its occurrences. inserting a value equal to one
+ * already in the tree bumps that node's count (the pointer stored first
+ * is the one kept), and deleting it takes one off the count, only 
+ * unlinking the node once the count reaches zero. the maps visit each 
+ * distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty multisplay_tree
+ */
+MultiSplay_T multisplay_new_multiset(Comparator compare, void *ctx); 
+
+/*
+ * multisplay_free
+ * 
+ * given a pointer to a multi-splay tree, deallocates the tree and all nodes
+ * contained within it
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - the tree to be freed
+ * @return      n/a
+ */
+void multisplay_free(MultiSplay_T tree); 
+
+/*
+ * multisplay_is_empty
+ * 
+ * returns true if the tree is empty, and false otherwise
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - tree to be checked if empty
+ * @return      bool - true if empty, false otherwise
+ */ 
+bool multisplay_is_empty(MultiSplay_T tree); 
+
+/*
+ * multisplay_insert_value
+ * 
+ * given a value (cast to void), inserts the value into the given tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * 
+ * UREs         system out of memory
+ *              attempting to pass in a value which cannot be compared with 
+ *                      your comparison function
+ * 
+ * @param       MultiSplay_T - tree in which to insert value
+ * @param       void * - a pointer to any item to be inserted
+ * @return      int - 0 on success
+ */
+int multisplay_insert_value(MultiSplay_T tree, void *value);
+
+/*
+ * multisplay_search
+ * 
+ * given a tree and a value to search for, returns a pointer to the stored 
+ * value, or NULL if the value is not found. If duplicates are in the tree, 
+ * returns the first one found
+ * 
+ * @param       MultiSplay_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *multisplay_search(MultiSplay_T tree, void *value); 
+
+/*
+ * multisplay_delete_value
+ * 
+ * given a value, deletes the first instance of it that is found in the tree
+ * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its node instead, and only
+ * deletes the node when that reaches zero
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - tree to find the value in
+ * @param       void * - pointer to the value to be deleted
+ * @return      n/a
+ */
+void multisplay_delete_value(MultiSplay_T tree, void *value); 
+
+/*
+ * multisplay_count
+ * 
+ * given a tree and a value, returns how many times the value is stored:
+ * the count of its node in a multiset, or the number of equal nodes 
+ * otherwise. returns 0 if the value is not in the tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t multisplay_count(MultiSplay_T tree, void *value); 
+
+/*
+ * multisplay_tree_minimum
+ * 
+ * given a tree, returns the minimum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - tree to be searched
+ * @return      void * - pointer to min value
+ */
+void *multisplay_tree_minimum(MultiSplay_T tree); 
+
+/*
+ * multisplay_tree_maximum
+ * 
+ * given a tree, returns the maximum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - tree to be searched
+ * @return      void * - pointer to max value
+ */
+void *multisplay_tree_maximum(MultiSplay_T tree); 
+
+/*
+ * multisplay_successor_of_value
+ * 
+ * given a tree and a value, returns the first successor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no successor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - tree to be searched
+ * @param       void * - value to find the successor of
+ * @return      void * - value of the successor
+ */
+void *multisplay_successor_of_value(MultiSplay_T tree, void *value); 
+
+/*
+ * multisplay_predecessor_of_value
+ * 
+ * given a tree and a value, returns the first predecessor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no predecessor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       MultiSplay_T - tree to be searched
+ * @param       void * - value to find the predecessor of
+ * @return      void * - value of the predecessor
+ */
+void *multisplay_predecessor_of_value(MultiSplay_T tree, void *value); 
+
+/*
+ * multisplay_map_inorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via an inorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       MultiSplay_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void multisplay_map_inorder(MultiSplay_T tree, 
+                            void func_to_apply(void *value, int depth, void *cl), 
+                            void *cl); 
+
+/*
+ * multisplay_map_preorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a preorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       MultiSplay_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void multisplay_map_preorder(MultiSplay_T tree, 
+                             void func_to_apply(void *value, int depth, void *cl), 
+                             void *cl); 
+
+/*
+ * multisplay_map_postorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a postorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       MultiSplay_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void multisplay_map_postorder(MultiSplay_T tree, 
+                              void func_to_apply(void *value, int depth, void *cl), 
+                              void *cl); 
+/*
+ * multisplay_rebalance
+ * 
+ * rebuilds the tree so that its reference tree is perfectly balanced over 
+ * the values currently stored, with every node as its own preferred path. 
+ * the reference tree is otherwise shaped by insertion order, so this is 
+ * worth calling once after loading values in sorted order
+ * 
+ * CREs         tree == NULL
+ * UREs         system out of memory
+ * 
+ * @param       MultiSplay_T - tree to rebuild
+ * @return      n/a
+ */
+void multisplay_rebalance(MultiSplay_T tree); 
+#endif
@@ -0,0 +1,419 @@
+#include "optimal_bst.h"
+#include <string.h>
+#include <stdint.h>
+
+/*
+ * Slot
+ *
+ * one node of the preorder array. a node's left child, if any, is the
+ * next slot; both children are recorded anyway so that a descent reads
+ * one slot per level. 0 means no child, since the root is never a child
+ */
+typedef struct Slot {
+        void *value;
+        uint32_t left;
+        uint32_t right;
+} Slot;
+
+struct optimal_bst {
+        Slot *slots;
+        size_t count;
+        Compare compare;
+        double cost;
+};
+
+typedef OptimalBST_T T;
+
+typedef enum Walk_Order { WALK_PREORDER, WALK_INORDER, WALK_POSTORDER } Walk_Order;
+
+/*
+ * Frame
+ *
+ * a pending subtree of the build: the values [lo, hi), to be stored below
+ * the slot parent on the given side
+ */
+typedef struct Frame {
+        size_t lo;
+        size_t hi;
+        size_t parent;
+        bool right;
+        int depth;
+} Frame;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_optimal_knuth_roots
+ *
+ * runs Knuth's dynamic program over the prefix sums of the weights and
+ * returns the table of optimal roots, where the root of [i, j) is at
+ * index i * (n + 1) + j. the root of [i, j) lies between the roots of
+ * [i, j - 1) and [i + 1, j), which brings the time down to O(n^2)
+ *
+ * CREs         n/a
+ * UREs         system out of memory
+ *
+ * @param       const double * - prefix sums of the n weights
+ * @param       size_t - number of values n
+ * @return      uint32_t * - the (n + 1) * (n + 1) table of roots
+ */
+uint32_t *private_optimal_knuth_roots(const double *prefix, size_t n);
+
+/*
+ * private_optimal_mehlhorn_root
+ *
+ * returns the index in [lo, hi) that splits the weight of the range most
+ * evenly between its two sides, by binary search on the prefix sums.
+ * ranges of zero weight are split in the middle
+ */
+size_t private_optimal_mehlhorn_root(const double *prefix, size_t lo, size_t hi);
+
+void private_optimal_map(T tree, uint32_t i, int depth, Walk_Order order,
+                         void func_to_apply(void *value, int depth, void *cl),
+                         void *cl);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T optimal_bst_new(void **values, const double *weights, size_t count,
+                  void *comparison_func, Optimal_Method method)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return optimal_bst_new_r(values, weights, count, compare.func, compare.ctx, 
+                                 method); 
+}
+
+T optimal_bst_new_r(void **values, const double *weights, size_t count,
+                    Comparator compare, void *ctx, Optimal_Method method)
+{
+        assert(compare != NULL); 
+        assert((values != NULL && weights != NULL) || count == 0); 
+        assert(count < UINT32_MAX); 
+
+        T tree = malloc(sizeof(struct optimal_bst)); 
+
+        tree->count = count; 
+        tree->cost = 0; 
+        tree->slots = malloc((count > 0 ? count : 1) * sizeof(Slot)); 
+
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+
+        if (count == 0)
+                return tree; 
+
+        double *prefix = malloc((count + 1) * sizeof(double)); 
+
+        prefix[0] = 0; 
+        for (size_t i = 0; i < count; i++)
+                prefix[i + 1] = prefix[i] + weights[i]; 
+
+        if (method == OPTIMAL_AUTO)
+                method = (count <= OPTIMAL_KNUTH_MAX) ? OPTIMAL_KNUTH : OPTIMAL_MEHLHORN; 
+
+        uint32_t *roots = (method == OPTIMAL_KNUTH) ?
+                          private_optimal_knuth_roots(prefix, count) : NULL; 
+
+        /*
+         * lay the tree out in preorder. an explicit stack, since a tree
+         * built for very skewed weights can be as deep as it is large
+         */
+        Frame *stack = malloc((count + 1) * sizeof(Frame)); 
+        size_t top = 0; 
+        size_t next = 0; 
+        double weighted_depth = 0; 
+
+        stack[top++] = (Frame) { 0, count, 0, false, 0 }; 
+
+        while (top > 0) {
+                Frame f = stack[--top]; 
+
+                if (f.lo >= f.hi)
+                        continue; 
+
+                size_t r = (roots != NULL) ? roots[f.lo * (count + 1) + f.hi] :
+                           private_optimal_mehlhorn_root(prefix, f.lo, f.hi); 
+                size_t here = next++; 
+
+                tree->slots[here].value = values[r]; 
+                tree->slots[here].left = 0; 
+                tree->slots[here].right = 0; 
+
+                if (here > 0) {
+                        if (f.right) {
+                                tree->slots[f.parent].right = (uint32_t) here; 
+                        } else {
+                                tree->slots[f.parent].left = (uint32_t) here; 
+                        }
+                }
+
+                weighted_depth += weights[r] * (f.depth + 1); 
+
+                /* the right subtree is pushed first so the left is laid out next */
+                stack[top++] = (Frame) { r + 1, f.hi, here, true, f.depth + 1 }; 
+                stack[top++] = (Frame) { f.lo, r, here, false, f.depth + 1 }; 
+        }
+
+        if (prefix[count] > 0)
+                tree->cost = weighted_depth / prefix[count]; 
+
+        free(stack); 
+        free(roots); 
+        free(prefix); 
+
+        return tree; 
+}
+
+void optimal_bst_free(T tree)
+{
+        assert(tree != NULL); 
+
+        free(tree->slots); 
+        free(tree); 
+}
+
+size_t optimal_bst_size(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->count; 
+}
+
+double optimal_bst_cost(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->cost; 
+}
+
+uint32_t *private_optimal_knuth_roots(const double *prefix, size_t n)
+{
+        size_t width = n + 1; 
+        double *cost = malloc(width * width * sizeof(double)); 
+        uint32_t *roots = malloc(width * width * sizeof(uint32_t)); 
+
+        for (size_t i = 0; i <= n; i++)
+                cost[i * width + i] = 0; 
+
+        for (size_t length = 1; length <= n; length++) {
+                for (size_t i = 0; i + length <= n; i++) {
+                        size_t j = i + length; 
+                        size_t first = (length == 1) ? i : roots[i * width + j - 1]; 
+                        size_t last = (length == 1) ? i : roots[(i + 1) * width + j]; 
+                        size_t best_root = first; 
+                        double best = cost[i * width + first] + cost[(first + 1) * width + j]; 
+
+                        for (size_t r = first + 1; r <= last; r++) {
+                                double c = cost[i * width + r] + cost[(r + 1) * width + j]; 
+
+                                if (c < best) {
+                                        best = c; 
+                                        best_root = r; 
+                                }
+                        }
+
+                        cost[i * width + j] = best + (prefix[j] - prefix[i]); 
+                        roots[i * width + j] = (uint32_t) best_root; 
+                }
+        }
+
+        free(cost); 
+
+        return roots; 
+}
+
+size_t private_optimal_mehlhorn_root(const double *prefix, size_t lo, size_t hi)
+{
+        double total = prefix[hi] - prefix[lo]; 
+
+        if (total <= 0)
+                return lo + (hi - lo) / 2; 
+
+        /*
+         * the weight left of r minus the weight right of r is
+         * prefix[r] + prefix[r + 1] - prefix[lo] - prefix[hi], which never
+         * decreases with r. find where it turns non-negative, then take
+         * whichever of that r and the one before is closer to zero
+         */
+        double base = prefix[lo] + prefix[hi]; 
+        size_t a = lo; 
+        size_t b = hi - 1; 
+
+        while (a < b) {
+                size_t mid = a + (b - a) / 2; 
+
+                if (prefix[mid] + prefix[mid + 1] - base < 0) {
+                        a = mid + 1; 
+                } else {
+                        b = mid; 
+                }
+        }
+
+        if (a > lo) {
+                double here = prefix[a] + prefix[a + 1] - base; 
+                double before = prefix[a - 1] + prefix[a] - base; 
+
+                if (-before < here)
+                        return a - 1; 
+        }
+
+        return a; 
+}
+
+void *optimal_bst_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Compare compare = tree->compare; 
+        Slot *slots = tree->slots; 
+        uint32_t i = 0; 
+
+        if (tree->count == 0)
+                return NULL; 
+
+        for (;;) {
+                int c = compare.func(value, slots[i].value, compare.ctx); 
+
+                if (c == 0)
+                        return slots[i].value; 
+
+                i = (c < 0) ? slots[i].left : slots[i].right; 
+
+                if (i == 0)
+                        return NULL; 
+        }
+}
+
+void *optimal_bst_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->count == 0)
+                return NULL; 
+
+        uint32_t i = 0; 
+
+        while (tree->slots[i].left != 0)
+                i = tree->slots[i].left; 
+
+        return tree->slots[i].value; 
+}
+
+void *optimal_bst_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->count == 0)
+                return NULL; 
+
+        uint32_t i = 0; 
+
+        while (tree->slots[i].right != 0)
+                i = tree->slots[i].right; 
+
+        return tree->slots[i].value; 
+}
+
+void *optimal_bst_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        void *successor = NULL; 
+        uint32_t i = 0; 
+
+        if (tree->count == 0)
+                return NULL; 
+
+        for (;;) {
+                int c = compare.func(value, tree->slots[i].value, compare.ctx); 
+
+                if (c < 0) {
+                        successor = tree->slots[i].value; 
+                        i = tree->slots[i].left; 
+                } else {
+                        i = tree->slots[i].right; 
+                }
+
+                if (i == 0)
+                        return successor; 
+        }
+}
+
+void *optimal_bst_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        void *predecessor = NULL; 
+        uint32_t i = 0; 
+
+        if (tree->count == 0)
+                return NULL; 
+
+        for (;;) {
+                int c = compare.func(value, tree->slots[i].value, compare.ctx); 
+
+                if (c > 0) {
+                        predecessor = tree->slots[i].value; 
+                        i = tree->slots[i].right; 
+                } else {
+                        i = tree->slots[i].left; 
+                }
+
+                if (i == 0)
+                        return predecessor; 
+        }
+}
+
+void private_optimal_map(T tree, uint32_t i, int depth, Walk_Order order,
+                         void func_to_apply(void *value, int depth, void *cl),
+                         void *cl)
+{
+        Slot *slot = &tree->slots[i]; 
+
+        if (order == WALK_PREORDER)
+                func_to_apply(slot->value, depth, cl); 
+        if (slot->left != 0)
+                private_optimal_map(tree, slot->left, depth + 1, order, func_to_apply, cl); 
+        if (order == WALK_INORDER)
+                func_to_apply(slot->value, depth, cl); 
+        if (slot->right != 0)
+                private_optimal_map(tree, slot->right, depth + 1, order, func_to_apply, cl); 
+        if (order == WALK_POSTORDER)
+                func_to_apply(slot->value, depth, cl); 
+}
+
+void optimal_bst_map_preorder(T tree,
+                              void func_to_apply(void *value, int depth, void *cl),
+                              void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        if (tree->count > 0)
+                private_optimal_map(tree, 0, 0, WALK_PREORDER, func_to_apply, cl); 
+}
+
+void optimal_bst_map_inorder(T tree,
+                             void func_to_apply(void *value, int depth, void *cl),
+                             void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        if (tree->count > 0)
+                private_optimal_map(tree, 0, 0, WALK_INORDER, func_to_apply, cl); 
+}
+
+void optimal_bst_map_postorder(T tree,
+                               void func_to_apply(void *value, int depth, void *cl),
+                               void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        if (tree->count > 0)
+                private_optimal_map(tree, 0, 0, WALK_POSTORDER, func_to_apply, cl); 
+}
@@ -0,0 +1,239 @@
+/**********************************************************************
+ * optimal_bst.h                                                      *
+ *                                                                    *
+ * Interface for an immutable, statically optimal binary search       *
+ * tree: built once from values and their access frequencies, so      *
+ * that the expected number of comparisons per search is minimal      *
+ * (Knuth) or close to it (Mehlhorn). nodes are packed into one       *
+ * array in preorder, so the heavy keys near the root share the       *
+ * first few cache lines                                              *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef OPTIMAL_BST_H
+#define OPTIMAL_BST_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "comparator.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct optimal_bst *OptimalBST_T;
+
+/*
+ * OPTIMAL_KNUTH        exact optimum by Knuth's dynamic program. O(n^2)
+ *                      time and memory, for up to a few thousand keys
+ * OPTIMAL_MEHLHORN     weight balancing: each root splits the weight of
+ *                      its range as evenly as possible. O(n log n) time;
+ *                      a search costs at most H + 2 comparisons, where H
+ *                      is the entropy of the weights in bits
+ * OPTIMAL_AUTO         Knuth up to OPTIMAL_KNUTH_MAX keys, else Mehlhorn
+ */
+typedef enum {
+        OPTIMAL_AUTO = 0,
+        OPTIMAL_KNUTH,
+        OPTIMAL_MEHLHORN
+} Optimal_Method;
+
+#define OPTIMAL_KNUTH_MAX 1024
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * optimal_bst_new
+ *
+ * builds the tree over count distinct values in ascending order, where
+ * weights[i] is the access frequency of values[i]. the arrays are copied;
+ * the values they point to are not, and must outlive the tree
+ *
+ * CREs         (values == NULL || weights == NULL) && count > 0
+ * UREs         system out of memory
+ *              values not sorted, or not distinct
+ *              negative weights
+ *
+ * @param       void ** - the values, in ascending order
+ * @param       const double * - the weight of each value
+ * @param       size_t - number of values
+ * @param       void * - pointer to a comparison function, with the same
+ *                              contract as for bst_new. if NULL is passed
+ *                              as argument, strcmp is assumed
+ * @param       Optimal_Method - how to choose the roots
+ * @return      pointer to the new optimal_bst
+ */
+OptimalBST_T optimal_bst_new(void **values, const double *weights, size_t count,
+                             void *comparison_func, Optimal_Method method); 
+
+/*
+ * optimal_bst_new_r
+ *
+ * same as optimal_bst_new, but takes a typed comparator and a context that
+ * is passed to every call of it, as for qsort_r
+ *
+ * CREs         (values == NULL || weights == NULL) && count > 0
+ *              compare == NULL
+ * UREs         as for optimal_bst_new
+ *
+ * @param       void ** - the values, in ascending order
+ * @param       const double * - the weight of each value
+ * @param       size_t - number of values
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @param       Optimal_Method - how to choose the roots
+ * @return      pointer to the new optimal_bst
+ */
+OptimalBST_T optimal_bst_new_r(void **values, const double *weights, size_t count,
+                               Comparator compare, void *ctx, Optimal_Method method); 
+
+/*
+ * optimal_bst_free
+ *
+ * deallocates the tree. the stored values are not freed
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - the tree to be freed
+ * @return      n/a
+ */
+void optimal_bst_free(OptimalBST_T tree); 
+
+/*
+ * optimal_bst_size
+ *
+ * returns the number of values in the tree
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - tree to be measured
+ * @return      size_t - number of values
+ */
+size_t optimal_bst_size(OptimalBST_T tree); 
+
+/*
+ * optimal_bst_cost
+ *
+ * returns the expected number of comparisons of a successful search when
+ * values are looked up with the frequencies the tree was built from: the
+ * weighted mean of depth + 1. 0 for an empty tree or zero total weight
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - tree to be measured
+ * @return      double - comparisons per search
+ */
+double optimal_bst_cost(OptimalBST_T tree); 
+
+/*
+ * optimal_bst_search
+ *
+ * given a tree and a value to search for, returns a pointer to the stored
+ * value, or NULL if the value is not found
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *optimal_bst_search(OptimalBST_T tree, void *value); 
+
+/*
+ * optimal_bst_tree_minimum
+ *
+ * returns the minimum value stored in the tree, or NULL if it is empty
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - tree to be searched
+ * @return      void * - pointer to min value
+ */
+void *optimal_bst_tree_minimum(OptimalBST_T tree); 
+
+/*
+ * optimal_bst_tree_maximum
+ *
+ * returns the maximum value stored in the tree, or NULL if it is empty
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - tree to be searched
+ * @return      void * - pointer to max value
+ */
+void *optimal_bst_tree_maximum(OptimalBST_T tree); 
+
+/*
+ * optimal_bst_successor_of_value
+ *
+ * given a tree and a value, returns the smallest stored value greater than
+ * it, or NULL if there is none. the value need not be in the tree
+ *
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - tree to be searched
+ * @param       void * - value to find the successor of
+ * @return      void * - value of the successor
+ */
+void *optimal_bst_successor_of_value(OptimalBST_T tree, void *value); 
+
+/*
+ * optimal_bst_predecessor_of_value
+ *
+ * given a tree and a value, returns the largest stored value less than it,
+ * or NULL if there is none. the value need not be in the tree
+ *
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ *
+ * @param       OptimalBST_T - tree to be searched
+ * @param       void * - value to find the predecessor of
+ * @return      void * - value of the predecessor
+ */
+void *optimal_bst_predecessor_of_value(OptimalBST_T tree, void *value); 
+
+/*
+ * optimal_bst_map_inorder, optimal_bst_map_preorder,
+ * optimal_bst_map_postorder
+ *
+ * given a tree and a pointer to a function, applies the function to every
+ * value stored in the tree, with its depth, in the given walk order
+ *
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply changes the order of the stored values
+ *
+ * @param       OptimalBST_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void optimal_bst_map_inorder(OptimalBST_T tree,
+                             void func_to_apply(void *value, int depth, void *cl),
+                             void *cl); 
+void optimal_bst_map_preorder(OptimalBST_T tree,
+                              void func_to_apply(void *value, int depth, void *cl),
+                              void *cl); 
+void optimal_bst_map_postorder(OptimalBST_T tree,
+                               void func_to_apply(void *value, int depth, void *cl),
+                               void *cl); 
+
+#endif
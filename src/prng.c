@@ -0,0 +1,28 @@
+#include "prng.h"
+#include <stdlib.h>
+#include <assert.h>
+
+uint64_t prng_next(uint64_t *state)
+{
+        assert(state != NULL); 
+
+        uint64_t z = (*state += 0x9E3779B97F4A7C15ULL); 
+
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL; 
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL; 
+
+        return z ^ (z >> 31); 
+}
+
+unsigned prng_geometric(uint64_t *state)
+{
+        uint64_t bits = prng_next(state); 
+        unsigned count = 0; 
+
+        while ((bits & 1) && count < 63) {
+                bits >>= 1; 
+                count++; 
+        }
+
+        return count; 
+}
@@ -0,0 +1,54 @@
+/**********************************************************************
+ * prng.h                                                             *
+ *                                                                    *
+ * Interface for a small, fast, seedable pseudo random number         *
+ * generator (splitmix64). Used by the randomized engines so that     *
+ * benchmark runs are reproducible from a seed                        *
+ **********************************************************************/
+
+#ifndef PRNG_H
+#define PRNG_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdint.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+#define PRNG_DEFAULT_SEED 0x2545F4914F6CDD1DULL
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * prng_next
+ * 
+ * advances the generator state and returns the next 64 bit pseudo random 
+ * number. any state value (including zero) is a valid seed
+ * 
+ * CREs         state == NULL
+ * UREs         n/a
+ * 
+ * @param       uint64_t * - pointer to the generator state
+ * @return      uint64_t - the next pseudo random number
+ */
+uint64_t prng_next(uint64_t *state);
+
+/*
+ * prng_geometric
+ * 
+ * returns a geometrically distributed value with success probability 1/2, 
+ * ie the number of consecutive heads before the first tails. used for zip 
+ * tree ranks and skip list levels
+ * 
+ * CREs         state == NULL
+ * UREs         n/a
+ * 
+ * @param       uint64_t * - pointer to the generator state
+ * @return      unsigned - a value in [0, 63]
+ */
+unsigned prng_geometric(uint64_t *state);
+
+#endif
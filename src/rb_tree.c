@@ -2,23 +2,34 @@
 #include <assert.h>
 #include <string.h>
 #include <stdint.h>
+#include <stddef.h>
 
 /*** MACRO DEFINITIONS ***/
 
 #define BLACK 'b'
 #define RED 'r'
 
-typedef struct Node {
+typedef struct rb_node {
         void *value;
-        struct Node *parent;
-        struct Node *left; 
-        struct Node *right; 
+        struct rb_node *parent;
+        struct rb_node *left; 
+        struct rb_node *right; 
+        uint64_t prefix; 
+        size_t size;            /* sum of the counts in the subtree, if ranked */
+        double aggregate;       /* monoid over the subtree, if aggregated */
+        uint32_t count;         /* occurrences of value, in a multiset */
         char color; 
 } Node;
 
 struct rb_tree {
         Node *root; 
-        void *comparison_func; 
+        Compare compare; 
+        bool prefixed; 
+        bool multiset; 
+        bool ranked; 
+        bool aggregated; 
+        Monoid monoid; 
+        Node *finger;           /* where the last finger search ended */
 };
 
 typedef RedBlack_T T; 
@@ -71,6 +82,87 @@ void rb_rotate_left(T tree, Node *n);
  */
 void rb_rotate_right(T tree, Node *n); 
 
+/*
+ * private_rb_size
+ * 
+ * returns the size of the subtree rooted at n, 0 for an empty one
+ */
+size_t private_rb_size(Node *n);
+
+/*
+ * private_rb_aggregate_of
+ * 
+ * returns the aggregate of the subtree rooted at n, the monoid's identity
+ * for an empty one
+ */
+double private_rb_aggregate_of(T tree, Node *n);
+
+/*
+ * private_rb_update
+ * 
+ * recomputes the size and aggregate of n, as the tree keeps them, from 
+ * its own value and count and from its children, after a rotation or an
+ * insert or delete has changed them
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - the tree n is in
+ * @param       Node * - node to update
+ * @return      n/a
+ */
+void private_rb_update(T tree, Node *n);
+
+/*
+ * private_rb_update_path
+ * 
+ * updates n and then every ancestor of n, after n was linked in as a new
+ * leaf, a node was unlinked from below it, or n's own count or value 
+ * changed. does nothing unless the tree is ranked or aggregated
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - the tree n is in
+ * @param       Node * - lowest node to update, or NULL
+ * @return      n/a
+ */
+void private_rb_update_path(T tree, Node *n);
+
+/*
+ * private_rb_aggregate_from, private_rb_aggregate_upto
+ * 
+ * helpers for rb_aggregate_range. return the aggregate of the values in 
+ * the subtree rooted at n that are not less than lo, or not greater than
+ * hi, folding in whole subtrees along a single descent
+ * 
+ * CREs         n/a
+ * UREs         the tree is not aggregated
+ * 
+ * @param       T - the tree n is in
+ * @param       Node * - root of the subtree, or NULL
+ * @param       void * - the bound
+ * @return      double - the aggregate of the values on the bound's side
+ */
+double private_rb_aggregate_from(T tree, Node *n, void *lo);
+double private_rb_aggregate_upto(T tree, Node *n, void *hi);
+
+/*
+ * private_rb_rank
+ * 
+ * returns how many values in the tree are less than value, or with 
+ * inclusive, less than or equal to it
+ * 
+ * CREs         n/a
+ * UREs         the tree is not ranked
+ * 
+ * @param       T - tree in which to count
+ * @param       void * - the bound
+ * @param       bool - true to count values equal to the bound too
+ * @return      size_t - number of values below the bound
+ */
+size_t private_rb_rank(T tree, void *value, bool inclusive);
+
 /*
  * rb_construct_node
  * 
@@ -98,12 +190,66 @@ Node *rb_construct_node(void *value);
  * @param       Node * - the root of the current subtree (rb_insert_value 
  *                      passes in tree->root)
  * @param       Node * - a pointer to the node with the value to be deleted
- * @param       void * - a pointer to the comparison function for the current
- *                      root
+ * @param       T - the tree, for its comparator
  * @return      a pointer to the most recently touched node 
  */
-Node *private_rb_insert_value(Node *root, Node *new_node, 
-                           void *comparison_func(void *val1, void *val2));
+Node *private_rb_insert_value(Node *root, Node *new_node, T tree);
+
+/*
+ * private_rb_insert_unique
+ * 
+ * descends once from the root looking for value. if an equal value is 
+ * stored, returns its node and leaves the tree alone; otherwise links a 
+ * new node for value where the descent ended, rebalances, and returns it
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ * 
+ * @param       T - tree in which to insert
+ * @param       void * - value to be inserted
+ * @param       bool * - set to true if a new node was linked
+ * @return      Node * - the node holding a value equal to value
+ */
+Node *private_rb_insert_unique(T tree, void *value, bool *inserted);
+
+/*
+ * private_rb_insert_node
+ * 
+ * does the work of rb_insert_value, descending from the root, and returns
+ * the node now holding value: the new node, or in a multiset the node 
+ * whose count went up
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ * 
+ * @param       T - tree in which to insert
+ * @param       void * - value to be inserted
+ * @return      Node * - the node holding value
+ */
+Node *private_rb_insert_node(T tree, void *value);
+
+/*
+ * private_rb_hint_position
+ * 
+ * checks whether value belongs right next to hint, between it and its 
+ * predecessor or successor, with at most two comparisons. if it does, 
+ * returns the node to link value under and sets *side to -1 or 1 for its
+ * left or right child, which is always empty. in a multiset, a neighbour
+ * equal to value is returned instead, with *side set to 0. returns NULL
+ * if value lies further away, and the caller must descend from the root
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - the tree hint is in
+ * @param       Node * - the hint
+ * @param       void * - value to be placed
+ * @param       uint64_t - its prefix, from private_rb_key_prefix
+ * @param       int * - where to store the side
+ * @return      Node * - the parent for value, or NULL
+ */
+Node *private_rb_hint_position(T tree, Node *hint, void *value, uint64_t prefix, 
+                               int *side);
 
 /*
  * fix_insertion_violation
@@ -116,27 +262,44 @@ Node *private_rb_insert_value(Node *root, Node *new_node,
  * 
  * @param       T - tree in which we are fixing violations
  * @param       Node * - pointer to the most recently inserted node
- * @return      n/a
+ * @return      bool - true if the root ended up red and was blackened, 
+ *                      which raises the black height of the tree by one
  */
-void fix_insertion_violation(T tree, Node *inserted);
+bool fix_insertion_violation(T tree, Node *inserted);
 
 /*
  * private_find_in_tree
  * 
  * private helper function for rb_search and rb_delete_value. 
- * given a tree, a value, and a comparison function, returns the first 
- * located node with the value we are looking for
+ * given a tree and a value, returns the first located node with the 
+ * value we are looking for
  * 
  * CREs         n/a
  * UREs         n/a
  * 
  * @param       T - tree in which we are searching
  * @param       void * - pointer to the value we are searching for
- * @param       void * - pointer to the comparison function for that tree
  * @return      Node * - pointer to the node containing value
  */
-Node *private_rb_find_in_tree(T tree, void *value, 
-                           void *comparison_func(void *val1, void *val2));
+Node *private_rb_find_in_tree(T tree, void *value);
+
+/*
+ * private_rb_finger_find
+ * 
+ * helper function for rb_finger_search. climbs from the finger until an
+ * ancestor lies past value, comparing only against the ancestors it 
+ * reaches from a child on the side away from value, and then descends 
+ * from the last node it passed. the node the search ends at, found or 
+ * not, becomes the finger
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - tree in which we are searching, with a finger
+ * @param       void * - pointer to the value we are searching for
+ * @return      Node * - pointer to the node containing value, or NULL
+ */
+Node *private_rb_finger_find(T tree, void *value);
 
 /* 
  * rb_transplant
@@ -160,16 +323,112 @@ void rb_transplant(T tree, Node *u, Node *v);
  * given a tree and a pointer to the former subtree of the deleted node, 
  * restores the red black tree properties. all deleted nodes have at most one 
  * child; two child nodes are replaced by their successor, which by definition
- * has at most one child. that child is the second parameter to this function
+ * has at most one child. that child is the second parameter to this function.
+ * leaves are NULL rather than a sentinel, so the child may be NULL and its 
+ * parent is passed separately
  * 
  * CREs         n/a
  * UREs         n/a
  * 
  * @param       T - tree where a value was deleted
- * @param       Node * - former child of the deleted node
+ * @param       Node * - former child of the deleted node (may be NULL)
+ * @param       Node * - parent of that child after the deletion
+ * @return      n/a
+ */
+void rb_delete_fixup(T tree, Node *x, Node *x_parent);
+
+/*
+ * private_rb_unlink
+ * 
+ * removes node n from tree whatever its count, and restores the red black
+ * properties, but leaves n allocated. the body of rb_delete_value
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - tree n is in
+ * @param       Node * - node to unlink
+ * @return      n/a
+ */
+void private_rb_unlink(T tree, Node *n);
+
+/*
+ * private_rb_black_height
+ * 
+ * returns the number of black nodes on any path from n down to a leaf,
+ * n included, 0 for an empty subtree
+ */
+int private_rb_black_height(Node *n);
+
+/*
+ * private_rb_detach
+ * 
+ * cuts the subtree rooted at n loose from its parent and blackens its 
+ * root, which leaves it a red black tree in its own right. returns n
+ */
+Node *private_rb_detach(Node *n);
+
+/*
+ * private_rb_join
+ * 
+ * given the roots of two red black trees, with their black heights, whose
+ * values all lie below and above the value of a loose node k, links them
+ * into one through k and returns its root. k is hung, red, from the 
+ * taller tree's spine where the black height matches the shorter one, 
+ * and insertion's fix up then runs from k. only k and the spine nodes 
+ * above it gain values, so the sizes and aggregates refreshed, like the 
+ * spine walked, cost O(1 + the difference in black height). tree supplies
+ * the modes and is the scratch tree for the rotations; its root is 
+ * overwritten
+ * 
+ * CREs         n/a
+ * UREs         left or right is not ordered against k, or has a red root
+ *              a black height given is not the tree's
+ * 
+ * @param       T - the tree the nodes belong to
+ * @param       Node * - root of the lesser tree, or NULL
+ * @param       int - its black height
+ * @param       Node * - the joining node
+ * @param       Node * - root of the greater tree, or NULL
+ * @param       int - its black height
+ * @param       int * - where to store the black height of the joined tree
+ * @return      Node * - root of the joined tree
+ */
+Node *private_rb_join(T tree, Node *left, int left_height, Node *k, 
+                      Node *right, int right_height, int *height);
+
+/*
+ * private_rb_split
+ * 
+ * splits the subtree rooted at n into the red black trees of its values 
+ * less than key and not less than key, taking n apart along the search 
+ * path for key and joining the pieces on the way back up. the black 
+ * heights are carried down and back up rather than measured, so the 
+ * joins' spine walks add up to O(log n) over the whole split
+ * 
+ * CREs         n/a
+ * UREs         n is red
+ * 
+ * @param       T - the tree n belongs to; its root is overwritten
+ * @param       Node * - root of the subtree to split
+ * @param       int - its black height
+ * @param       void * - the key
+ * @param       uint64_t - its prefix, from private_rb_key_prefix
+ * @param       Node ** - where to store the root of the lesser tree
+ * @param       int * - where to store its black height
+ * @param       Node ** - where to store the root of the greater tree
+ * @param       int * - where to store its black height
  * @return      n/a
  */
-void rb_delete_fixup(T tree, Node *x);
+void private_rb_split(T tree, Node *n, int height, void *key, uint64_t prefix, 
+                      Node **left, int *left_height, Node **right, int *right_height);
+
+/*
+ * private_rb_is_black
+ * 
+ * returns true if n is black. NULL leaves count as black
+ */
+bool private_rb_is_black(Node *n);
 
 /*
  * private_rb_successor_of_value
@@ -181,12 +440,46 @@ void rb_delete_fixup(T tree, Node *x);
  * 
  * @param       T - tree in which to search
  * @param       void * - pointer to the value we want the successor of
- * @param       void * - pointer to the comparison function associated with tree
  * @return      void * - pointer to the successor's value (or NULL if no 
  *                      successor exists)
  */
-void *private_rb_successor_of_value(T tree, void *value, 
-                                 void *comparison_func(void *val1, void *val2));
+void *private_rb_successor_of_value(T tree, void *value);
+
+/*
+ * private_rb_key_prefix
+ * 
+ * returns the first 8 bytes of a string key packed big-endian into an
+ * integer, zero-padded after the terminator, so that comparing two 
+ * prefixes as unsigned integers orders them as strcmp would. returns 0 if
+ * the tree does not cache prefixes
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - the tree the key belongs to
+ * @param       void * - the key
+ * @return      uint64_t - the packed prefix
+ */
+uint64_t private_rb_key_prefix(T tree, void *value);
+
+/*
+ * private_rb_compare
+ * 
+ * compares a key against the value of a node. when the tree caches 
+ * prefixes, the packed prefixes decide unless they are equal; then the 
+ * strings are equal if they ended within the prefix, and strcmp is run
+ * on the remaining bytes otherwise
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - the tree, for its comparator
+ * @param       void * - the key
+ * @param       uint64_t - the key's prefix, from private_rb_key_prefix
+ * @param       Node * - the node to compare against
+ * @return      int - as for the comparison function
+ */
+int private_rb_compare(T tree, void *value, uint64_t prefix, Node *n);
 
 /*
  * private_rb_predecessor_of_value
@@ -198,12 +491,25 @@ void *private_rb_successor_of_value(T tree, void *value,
  * 
  * @param       T - tree in which to search
  * @param       void * - pointer to the value we want the predecessor of
- * @param       void * - pointer to the comparison function associated with tree
  * @return      void * - pointer to the predecessor's value (or NULL if no 
  *                      predecessor exists)
  */
-void *private_rb_predecessor_of_value(T tree, void *value, 
-                                   void *comparison_func(void *val1, void *val2)); 
+void *private_rb_predecessor_of_value(T tree, void *value); 
+
+/*
+ * private_rb_lower_bound
+ * 
+ * given a tree and a value, returns the first node in sorted order whose 
+ * value is not less than value, or NULL if there is none
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       T - tree in which to search
+ * @param       void * - pointer to the value to bound
+ * @return      Node * - the leftmost node not less than value
+ */
+Node *private_rb_lower_bound(T tree, void *value);
 
 /*
  * private_rb_find_successor
@@ -233,6 +539,34 @@ Node *private_rb_find_successor(Node *n);
  */
 Node *private_rb_find_predecessor(Node *n); 
 
+/*
+ * private_rb_next_inorder
+ * 
+ * given a node, returns the node that follows it in an inorder walk, or 
+ * NULL if it is the last. uses parent links, so a full walk needs no stack
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       Node * - current node
+ * @return      Node * - next node in sorted order
+ */
+Node *private_rb_next_inorder(Node *n);
+
+/*
+ * private_rb_prev_inorder
+ * 
+ * given a node, returns the node that precedes it in an inorder walk, or 
+ * NULL if it is the first
+ * 
+ * CREs         n/a
+ * UREs         n/a
+ * 
+ * @param       Node * - current node
+ * @return      Node * - previous node in sorted order
+ */
+Node *private_rb_prev_inorder(Node *n);
+
 /*
  * private_subrb_tree_minimum
  * 
@@ -337,15 +671,74 @@ void rb_private_postorder_map(Node *root,
 
 T rb_new(void *comparison_func)
 {
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return rb_new_r(compare.func, compare.ctx); 
+}
+
+T rb_new_r(Comparator compare, void *ctx)
+{
+        assert(compare != NULL); 
+
         T tree = malloc(sizeof(struct rb_tree)); 
 
         tree->root = NULL; 
 
-        if (comparison_func == NULL) {
-                tree->comparison_func = &strcmp; 
-        } else {
-                tree->comparison_func = comparison_func; 
-        }
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+        tree->prefixed = false; 
+        tree->multiset = false; 
+        tree->ranked = false; 
+        tree->aggregated = false; 
+        tree->finger = NULL; 
+
+        return tree; 
+}
+
+T rb_new_multiset(Comparator compare, void *ctx)
+{
+        T tree = rb_new_r(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+T rb_new_ranked(Comparator compare, void *ctx)
+{
+        T tree = rb_new_r(compare, ctx); 
+
+        tree->ranked = true; 
+
+        return tree; 
+}
+
+T rb_new_ranked_multiset(Comparator compare, void *ctx)
+{
+        T tree = rb_new_ranked(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+T rb_new_aggregated(Comparator compare, void *ctx, Monoid monoid)
+{
+        assert(monoid.measure != NULL && monoid.combine != NULL); 
+
+        T tree = rb_new_r(compare, ctx); 
+
+        tree->aggregated = true; 
+        tree->monoid = monoid; 
+
+        return tree; 
+}
+
+T rb_new_prefixed(void)
+{
+        T tree = rb_new_r(comparator_strcmp, NULL); 
+
+        tree->prefixed = true; 
 
         return tree; 
 }
@@ -405,6 +798,11 @@ void rb_rotate_left(T tree, Node *n)
 
         right_child->left = n; 
         n->parent = right_child; 
+
+        if (tree->ranked || tree->aggregated) {
+                private_rb_update(tree, n); 
+                private_rb_update(tree, right_child); 
+        }
 }
 
 void rb_rotate_right(T tree, Node *n)
@@ -430,92 +828,312 @@ void rb_rotate_right(T tree, Node *n)
 
         left_child->right = n; 
         n->parent = left_child; 
+
+        if (tree->ranked || tree->aggregated) {
+                private_rb_update(tree, n); 
+                private_rb_update(tree, left_child); 
+        }
 }
 
 int rb_insert_value(T tree, void *value)
 {
         assert(tree != NULL && value != NULL); 
 
-        Node *new_node = rb_construct_node(value); 
-        tree->root = private_rb_insert_value(tree->root, new_node, tree->comparison_func); 
-
-        fix_insertion_violation(tree, new_node);  
+        private_rb_insert_node(tree, value); 
 
         return 0;
 }
 
-Node *rb_construct_node(void *value)
+Node *private_rb_insert_node(T tree, void *value)
 {
-        Node *new_node = (Node *) malloc(sizeof(Node)); 
+        if (tree->multiset) {
+                bool inserted; 
+                Node *n = private_rb_insert_unique(tree, value, &inserted); 
 
-        new_node->parent = NULL;
-        new_node->left = NULL; 
-        new_node->right = NULL; 
-        new_node->value = value; 
+                if (!inserted) {
+                        n->count++; 
+                        private_rb_update_path(tree, n); 
+                }
+                return n; 
+        }
 
-        new_node->color = RED; 
+        Node *new_node = rb_construct_node(value); 
+        new_node->prefix = private_rb_key_prefix(tree, value); 
+        tree->root = private_rb_insert_value(tree->root, new_node, tree); 
+
+        private_rb_update_path(tree, new_node); 
+        fix_insertion_violation(tree, new_node);  
 
         return new_node; 
 }
 
-Node *private_rb_insert_value(Node *root, Node *new_node, 
-                           void *comparison_func(void *val1, void *val2)) 
+RB_Cursor rb_insert_hint(T tree, RB_Cursor hint, void *value)
 {
-        if (root == NULL) { 
-                return new_node; 
-        }
+        assert(tree != NULL && value != NULL); 
 
-        if ((int)(intptr_t) comparison_func(new_node->value, root->value) < 0) {
-                root->left = private_rb_insert_value(root->left, new_node, comparison_func); 
-                root->left->parent = root; 
-        } else {
-                root->right = private_rb_insert_value(root->right, new_node, comparison_func); 
-                root->right->parent = root; 
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
+        int side = 0; 
+        Node *parent = NULL; 
+
+        if (hint != NULL)
+                parent = private_rb_hint_position(tree, hint, value, prefix, &side); 
+
+        if (parent == NULL)
+                return private_rb_insert_node(tree, value); 
+
+        if (side == 0) {
+                parent->count++; 
+                private_rb_update_path(tree, parent); 
+                return parent; 
         }
 
-        return root; 
+        Node *new_node = rb_construct_node(value); 
+        new_node->prefix = prefix; 
+        new_node->parent = parent; 
+
+        if (side < 0)
+                parent->left = new_node; 
+        else
+                parent->right = new_node; 
+
+        private_rb_update_path(tree, new_node); 
+        fix_insertion_violation(tree, new_node); 
+
+        return new_node; 
 }
 
-void fix_insertion_violation(T tree, Node *culprit)
+RB_Cursor rb_search_hint(T tree, RB_Cursor hint, void *value)
 {
-        Node *parent_node = NULL; 
-        Node *grand_parent_node = NULL; 
+        assert(tree != NULL && value != NULL); 
 
-        while ((culprit != tree->root) && (culprit->color != BLACK) && (culprit->parent->color == RED)) {
-                
-                parent_node = culprit->parent; 
-                grand_parent_node = culprit->parent->parent; 
+        if (hint == NULL)
+                return private_rb_find_in_tree(tree, value); 
 
-                if (parent_node == grand_parent_node->left){
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
+        int c = private_rb_compare(tree, value, prefix, hint); 
 
-                        Node *uncle = grand_parent_node->right; 
+        if (c == 0)
+                return hint; 
 
-                        if (uncle != NULL && uncle->color == RED) {
+        Node *neighbour = (c > 0) ? private_rb_next_inorder(hint) 
+                                  : private_rb_prev_inorder(hint); 
 
-                                grand_parent_node->color = RED; 
-                                parent_node->color = BLACK; 
-                                uncle->color = BLACK; 
-                                culprit = grand_parent_node; 
+        /* beyond the first or last value */
+        if (neighbour == NULL)
+                return NULL; 
 
-                        } else {
+        int d = private_rb_compare(tree, value, prefix, neighbour); 
 
-                                if (culprit == parent_node->right) {
-                                        rb_rotate_left(tree, parent_node); 
-                                        culprit = parent_node; 
-                                        parent_node = culprit->parent; 
-                                }
+        if (d == 0)
+                return neighbour; 
 
-                                rb_rotate_right(tree, grand_parent_node); 
+        /* strictly between the hint and its neighbour */
+        if ((c > 0) == (d < 0))
+                return NULL; 
 
-                                char temp = parent_node->color; 
-                                parent_node->color = grand_parent_node->color; 
-                                grand_parent_node->color = temp; 
+        return private_rb_find_in_tree(tree, value); 
+}
 
-                                culprit = parent_node; 
+void *rb_cursor_value(RB_Cursor cursor)
+{
+        assert(cursor != NULL); 
 
-                        }
-                } else { // parent_node == grand_parent_node->right
-                        Node *uncle = grand_parent_node->left; 
+        return cursor->value; 
+}
+
+Node *private_rb_hint_position(T tree, Node *hint, void *value, uint64_t prefix, 
+                               int *side)
+{
+        int c = private_rb_compare(tree, value, prefix, hint); 
+
+        if (c == 0 && tree->multiset) {
+                *side = 0; 
+                return hint; 
+        }
+
+        if (c >= 0) {
+                Node *next = private_rb_next_inorder(hint); 
+
+                if (next != NULL) {
+                        int d = private_rb_compare(tree, value, prefix, next); 
+
+                        if (d > 0)
+                                return NULL; 
+                        if (d == 0 && tree->multiset) {
+                                *side = 0; 
+                                return next; 
+                        }
+                }
+
+                /* next, if hint has a right subtree, is its leftmost node */
+                if (hint->right == NULL) {
+                        *side = 1; 
+                        return hint; 
+                }
+                *side = -1; 
+                return next; 
+        }
+
+        Node *prev = private_rb_prev_inorder(hint); 
+
+        if (prev != NULL) {
+                int d = private_rb_compare(tree, value, prefix, prev); 
+
+                if (d < 0)
+                        return NULL; 
+                if (d == 0 && tree->multiset) {
+                        *side = 0; 
+                        return prev; 
+                }
+        }
+
+        /* prev, if hint has a left subtree, is its rightmost node */
+        if (hint->left == NULL) {
+                *side = -1; 
+                return hint; 
+        }
+        *side = 1; 
+        return prev; 
+}
+
+Node *rb_construct_node(void *value)
+{
+        Node *new_node = (Node *) malloc(sizeof(Node)); 
+
+        new_node->parent = NULL;
+        new_node->left = NULL; 
+        new_node->right = NULL; 
+        new_node->value = value; 
+        new_node->prefix = 0; 
+        new_node->count = 1; 
+        new_node->size = 1; 
+        new_node->aggregate = 0; 
+
+        new_node->color = RED; 
+
+        return new_node; 
+}
+
+Node *private_rb_insert_value(Node *root, Node *new_node, T tree) 
+{
+        if (root == NULL) { 
+                return new_node; 
+        }
+
+        if (private_rb_compare(tree, new_node->value, new_node->prefix, root) < 0) {
+                root->left = private_rb_insert_value(root->left, new_node, tree); 
+                root->left->parent = root; 
+        } else {
+                root->right = private_rb_insert_value(root->right, new_node, tree); 
+                root->right->parent = root; 
+        }
+
+        return root; 
+}
+
+void *rb_insert_unique(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        bool inserted; 
+        Node *n = private_rb_insert_unique(tree, value, &inserted); 
+
+        return inserted ? NULL : n->value; 
+}
+
+void *rb_upsert(T tree, void *value, 
+                void *merge(void *stored, void *value, void *cl), void *cl)
+{
+        assert(tree != NULL && value != NULL && merge != NULL); 
+
+        bool inserted; 
+        Node *n = private_rb_insert_unique(tree, value, &inserted); 
+
+        if (!inserted) {
+                n->value = merge(n->value, value, cl); 
+                private_rb_update_path(tree, n); 
+        }
+
+        return n->value; 
+}
+
+Node *private_rb_insert_unique(T tree, void *value, bool *inserted)
+{
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
+        Node *parent = NULL; 
+        Node *curr = tree->root; 
+        int c = 0; 
+
+        while (curr != NULL) {
+                c = private_rb_compare(tree, value, prefix, curr); 
+
+                if (c == 0) {
+                        *inserted = false; 
+                        return curr; 
+                }
+
+                parent = curr; 
+                curr = (c < 0) ? curr->left : curr->right; 
+        }
+
+        Node *new_node = rb_construct_node(value); 
+        new_node->prefix = prefix; 
+        new_node->parent = parent; 
+
+        if (parent == NULL)
+                tree->root = new_node; 
+        else if (c < 0)
+                parent->left = new_node; 
+        else
+                parent->right = new_node; 
+
+        private_rb_update_path(tree, new_node); 
+        fix_insertion_violation(tree, new_node); 
+        *inserted = true; 
+
+        return new_node; 
+}
+
+bool fix_insertion_violation(T tree, Node *culprit)
+{
+        Node *parent_node = NULL; 
+        Node *grand_parent_node = NULL; 
+
+        while ((culprit != tree->root) && (culprit->color != BLACK) && (culprit->parent->color == RED)) {
+                
+                parent_node = culprit->parent; 
+                grand_parent_node = culprit->parent->parent; 
+
+                if (parent_node == grand_parent_node->left){
+
+                        Node *uncle = grand_parent_node->right; 
+
+                        if (uncle != NULL && uncle->color == RED) {
+
+                                grand_parent_node->color = RED; 
+                                parent_node->color = BLACK; 
+                                uncle->color = BLACK; 
+                                culprit = grand_parent_node; 
+
+                        } else {
+
+                                if (culprit == parent_node->right) {
+                                        rb_rotate_left(tree, parent_node); 
+                                        culprit = parent_node; 
+                                        parent_node = culprit->parent; 
+                                }
+
+                                rb_rotate_right(tree, grand_parent_node); 
+
+                                char temp = parent_node->color; 
+                                parent_node->color = grand_parent_node->color; 
+                                grand_parent_node->color = temp; 
+
+                                culprit = parent_node; 
+
+                        }
+                } else { // parent_node == grand_parent_node->right
+                        Node *uncle = grand_parent_node->left; 
 
                         if ((uncle != NULL) && (uncle->color == RED)) {
                                 grand_parent_node->color = RED; 
@@ -540,12 +1158,16 @@ void fix_insertion_violation(T tree, Node *culprit)
                 }
         }
 
+        bool raised = (tree->root->color == RED); 
+
         tree->root->color = BLACK; 
+
+        return raised; 
 }
 
 void *rb_search(T tree, void *value)
 {
-        Node *result = private_rb_find_in_tree(tree, value, tree->comparison_func); 
+        Node *result = private_rb_find_in_tree(tree, value); 
 
         if (result != NULL) 
                 return (void *) result->value; 
@@ -553,15 +1175,84 @@ void *rb_search(T tree, void *value)
         return result; //AKA return NULL 
 }
 
-Node *private_rb_find_in_tree(T tree, void *value, 
-                           void *comparison_func(void *val1, void *val2))
+void *rb_finger_search(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        /* from the root, the climb stops at once and the descent is plain */
+        if (tree->finger == NULL)
+                tree->finger = tree->root; 
+
+        Node *result = private_rb_finger_find(tree, value); 
+
+        return (result == NULL) ? NULL : result->value; 
+}
+
+Node *private_rb_finger_find(T tree, void *value)
+{
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
+        Node *curr = tree->finger; 
+        int c = private_rb_compare(tree, value, prefix, curr); 
+
+        if (c == 0)
+                return curr; 
+
+        /* 
+         * value lies past low, on the side c points to. climbing out of a
+         * subtree on that side of its parent reaches a node behind low, 
+         * which needs no comparison. the first ancestor found past value 
+         * bounds the subtree of low to descend into 
+         */
+        Node *low = curr; 
+
+        while (curr->parent != NULL) {
+                Node *parent = curr->parent; 
+
+                if ((c > 0) == (curr == parent->right)) {
+                        curr = parent; 
+                        continue; 
+                }
+
+                int d = private_rb_compare(tree, value, prefix, parent); 
+
+                if (d == 0) {
+                        tree->finger = parent; 
+                        return parent; 
+                }
+                if ((d > 0) != (c > 0))
+                        break; 
+                curr = low = parent; 
+        }
+
+        Node *last = low; 
+        curr = (c > 0) ? low->right : low->left; 
+
+        while (curr != NULL) {
+                last = curr; 
+                c = private_rb_compare(tree, value, prefix, curr); 
+
+                if (c == 0)
+                        break; 
+                curr = (c < 0) ? curr->left : curr->right; 
+        }
+
+        tree->finger = last; 
+
+        return curr; 
+}
+
+Node *private_rb_find_in_tree(T tree, void *value)
 {
         bool found = false; 
         Node *curr = tree->root; 
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
         int c = 0; 
 
         while (!found && curr != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr->value); 
+                c = private_rb_compare(tree, value, prefix, curr); 
 
                 if (c == 0) {
                         found = true; 
@@ -579,21 +1270,38 @@ void rb_delete_value(T tree, void *value)
 {
         assert(tree != NULL && value != NULL); 
 
-        Node *subtree_of_deleted = NULL; 
-
-        Node *delete_me = private_rb_find_in_tree(tree, value, tree->comparison_func); 
+        Node *delete_me = private_rb_find_in_tree(tree, value); 
 
         if (delete_me == NULL) 
                 return;
 
+        if (--delete_me->count > 0) {
+                private_rb_update_path(tree, delete_me); 
+                return; 
+        }
+
+        private_rb_unlink(tree, delete_me); 
+        free(delete_me); 
+}
+
+void private_rb_unlink(T tree, Node *delete_me)
+{
+        Node *subtree_of_deleted = NULL; 
+        Node *subtree_parent = NULL; 
+
+        if (tree->finger == delete_me)
+                tree->finger = NULL; 
+
         Node *y = delete_me; 
         char y_original_color = y->color; 
 
         if (delete_me->left == NULL) {
                 subtree_of_deleted = delete_me->right; 
+                subtree_parent = delete_me->parent; 
                 rb_transplant(tree, delete_me, delete_me->right); 
         } else if (delete_me->right == NULL) {
                 subtree_of_deleted = delete_me->left; 
+                subtree_parent = delete_me->parent; 
                 rb_transplant(tree, delete_me, delete_me->left);
         } else {
                 y = private_rb_find_successor(delete_me); 
@@ -601,13 +1309,13 @@ void rb_delete_value(T tree, void *value)
 
                 subtree_of_deleted = y->right; 
 
-                if (y->parent == delete_me && subtree_of_deleted != NULL) {
-                        subtree_of_deleted->parent = y; 
+                if (y->parent == delete_me) {
+                        subtree_parent = y; 
                 } else {
+                        subtree_parent = y->parent; 
                         rb_transplant(tree, y, y->right); 
                         y->right = delete_me->right; 
-                        if (y->right != NULL)
-                                y->right->parent = y; 
+                        y->right->parent = y; 
                 }
 
                 rb_transplant(tree, delete_me, y); 
@@ -616,10 +1324,356 @@ void rb_delete_value(T tree, void *value)
                 y->color = delete_me->color; 
         }
 
-        free(delete_me); 
+        /* the lowest node whose children changed */
+        private_rb_update_path(tree, subtree_parent); 
 
         if (y_original_color == BLACK) 
-                rb_delete_fixup(tree, subtree_of_deleted); 
+                rb_delete_fixup(tree, subtree_of_deleted, subtree_parent); 
+}
+
+T rb_split(T tree, void *key)
+{
+        assert(tree != NULL && key != NULL); 
+
+        T right = malloc(sizeof(struct rb_tree)); 
+        Node *left_root, *right_root; 
+        int left_height, right_height; 
+
+        *right = *tree; 
+        private_rb_split(tree, tree->root, private_rb_black_height(tree->root), key, 
+                         private_rb_key_prefix(tree, key), &left_root, &left_height, 
+                         &right_root, &right_height); 
+
+        tree->root = left_root; 
+        right->root = right_root; 
+        tree->finger = NULL; 
+        right->finger = NULL; 
+
+        return right; 
+}
+
+void rb_join(T left, T right)
+{
+        assert(left != NULL && right != NULL && left != right); 
+
+        left->finger = NULL; 
+        right->finger = NULL; 
+
+        if (right->root == NULL)
+                return; 
+
+        if (left->root == NULL) {
+                left->root = right->root; 
+                right->root = NULL; 
+                return; 
+        }
+
+        Node *k = private_subrb_tree_minimum(right->root); 
+        int height; 
+
+        private_rb_unlink(right, k); 
+        left->root = private_rb_join(left, left->root, private_rb_black_height(left->root), 
+                                     k, right->root, private_rb_black_height(right->root), 
+                                     &height); 
+        right->root = NULL; 
+}
+
+void private_rb_split(T tree, Node *n, int height, void *key, uint64_t prefix, 
+                      Node **left, int *left_height, Node **right, int *right_height)
+{
+        if (n == NULL) {
+                *left = NULL; 
+                *right = NULL; 
+                *left_height = 0; 
+                *right_height = 0; 
+                return; 
+        }
+
+        /* below black n, a black child is one lower, and a red one, once blackened, as high */
+        int lesser_height = (n->left == NULL) ? 0 : height - (n->left->color == BLACK); 
+        int greater_height = (n->right == NULL) ? 0 : height - (n->right->color == BLACK); 
+        Node *lesser = private_rb_detach(n->left); 
+        Node *greater = private_rb_detach(n->right); 
+
+        if (private_rb_compare(tree, key, prefix, n) <= 0) {
+                private_rb_split(tree, lesser, lesser_height, key, prefix, 
+                                 left, left_height, right, right_height); 
+                *right = private_rb_join(tree, *right, *right_height, n, 
+                                         greater, greater_height, right_height); 
+        } else {
+                private_rb_split(tree, greater, greater_height, key, prefix, 
+                                 left, left_height, right, right_height); 
+                *left = private_rb_join(tree, lesser, lesser_height, n, 
+                                        *left, *left_height, left_height); 
+        }
+}
+
+Node *private_rb_join(T tree, Node *left, int left_height, Node *k, 
+                      Node *right, int right_height, int *height)
+{
+        Node *parent = NULL; 
+
+        if (left_height == right_height) {
+                k->left = left; 
+                k->right = right; 
+                k->color = BLACK; 
+                *height = left_height + 1; 
+        } else if (left_height > right_height) {
+                /* down left's right spine to a black node as high as right */
+                Node *curr = left; 
+                int level = left_height; 
+
+                while (curr != NULL && (curr->color == RED || level > right_height)) {
+                        if (curr->color == BLACK)
+                                level--; 
+                        parent = curr; 
+                        curr = curr->right; 
+                }
+
+                tree->root = left; 
+                parent->right = k; 
+                k->left = curr; 
+                k->right = right; 
+                k->color = RED; 
+                *height = left_height; 
+        } else {
+                Node *curr = right; 
+                int level = right_height; 
+
+                while (curr != NULL && (curr->color == RED || level > left_height)) {
+                        if (curr->color == BLACK)
+                                level--; 
+                        parent = curr; 
+                        curr = curr->left; 
+                }
+
+                tree->root = right; 
+                parent->left = k; 
+                k->left = left; 
+                k->right = curr; 
+                k->color = RED; 
+                *height = right_height; 
+        }
+
+        k->parent = parent; 
+        if (k->left != NULL)
+                k->left->parent = k; 
+        if (k->right != NULL)
+                k->right->parent = k; 
+
+        if (parent == NULL)
+                tree->root = k; 
+
+        /* k and the spine above it, no higher than the walk down came from */
+        private_rb_update_path(tree, k); 
+        if (fix_insertion_violation(tree, k))
+                (*height)++; 
+
+        return tree->root; 
+}
+
+int private_rb_black_height(Node *n)
+{
+        int height = 0; 
+
+        for (; n != NULL; n = n->left) {
+                if (n->color == BLACK)
+                        height++; 
+        }
+
+        return height; 
+}
+
+Node *private_rb_detach(Node *n)
+{
+        if (n != NULL) {
+                n->parent = NULL; 
+                n->color = BLACK; 
+        }
+
+        return n; 
+}
+
+size_t rb_count(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
+        Node *n = private_rb_lower_bound(tree, value); 
+        size_t count = 0; 
+
+        while (n != NULL && private_rb_compare(tree, value, prefix, n) == 0) {
+                count += n->count; 
+                n = private_rb_next_inorder(n); 
+        }
+
+        return count; 
+}
+
+size_t rb_rank(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL && tree->ranked); 
+
+        return private_rb_rank(tree, value, false); 
+}
+
+void *rb_select(T tree, size_t k)
+{
+        assert(tree != NULL && tree->ranked); 
+
+        Node *curr = tree->root; 
+
+        while (curr != NULL) {
+                size_t left = private_rb_size(curr->left); 
+
+                if (k < left) {
+                        curr = curr->left; 
+                } else if (k < left + curr->count) {
+                        return curr->value; 
+                } else {
+                        k -= left + curr->count; 
+                        curr = curr->right; 
+                }
+        }
+
+        return NULL; 
+}
+
+size_t rb_count_range(T tree, void *lo, void *hi)
+{
+        assert(tree != NULL && lo != NULL && hi != NULL && tree->ranked); 
+
+        if (tree->compare.func(lo, hi, tree->compare.ctx) > 0)
+                return 0; 
+
+        return private_rb_rank(tree, hi, true) - private_rb_rank(tree, lo, false); 
+}
+
+size_t private_rb_rank(T tree, void *value, bool inclusive)
+{
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
+        Node *curr = tree->root; 
+        size_t rank = 0; 
+
+        while (curr != NULL) {
+                int c = private_rb_compare(tree, value, prefix, curr); 
+
+                if (c < 0 || (c == 0 && !inclusive)) {
+                        curr = curr->left; 
+                } else {
+                        rank += private_rb_size(curr->left) + curr->count; 
+                        curr = curr->right; 
+                }
+        }
+
+        return rank; 
+}
+
+size_t private_rb_size(Node *n)
+{
+        return (n == NULL) ? 0 : n->size; 
+}
+
+double private_rb_aggregate_of(T tree, Node *n)
+{
+        return (n == NULL) ? tree->monoid.identity : n->aggregate; 
+}
+
+void private_rb_update(T tree, Node *n)
+{
+        if (tree->ranked)
+                n->size = n->count + private_rb_size(n->left) + private_rb_size(n->right); 
+
+        if (tree->aggregated) {
+                Monoid *m = &tree->monoid; 
+                double middle = m->measure(n->value, m->ctx); 
+
+                n->aggregate = m->combine(m->combine(private_rb_aggregate_of(tree, n->left), 
+                                                     middle, m->ctx), 
+                                          private_rb_aggregate_of(tree, n->right), m->ctx); 
+        }
+}
+
+void private_rb_update_path(T tree, Node *n)
+{
+        if (!tree->ranked && !tree->aggregated)
+                return; 
+
+        for (; n != NULL; n = n->parent)
+                private_rb_update(tree, n); 
+}
+
+double rb_aggregate_range(T tree, void *lo, void *hi)
+{
+        assert(tree != NULL && lo != NULL && hi != NULL && tree->aggregated); 
+
+        Monoid *m = &tree->monoid; 
+        uint64_t lo_prefix = private_rb_key_prefix(tree, lo); 
+        uint64_t hi_prefix = private_rb_key_prefix(tree, hi); 
+        Node *curr = tree->root; 
+
+        /* down to the first node inside the range, where lo and hi part */
+        while (curr != NULL) {
+                if (private_rb_compare(tree, lo, lo_prefix, curr) > 0)
+                        curr = curr->right; 
+                else if (private_rb_compare(tree, hi, hi_prefix, curr) < 0)
+                        curr = curr->left; 
+                else
+                        break; 
+        }
+
+        if (curr == NULL)
+                return m->identity; 
+
+        double left = private_rb_aggregate_from(tree, curr->left, lo); 
+        double right = private_rb_aggregate_upto(tree, curr->right, hi); 
+
+        return m->combine(m->combine(left, m->measure(curr->value, m->ctx), m->ctx), 
+                          right, m->ctx); 
+}
+
+double private_rb_aggregate_from(T tree, Node *n, void *lo)
+{
+        Monoid *m = &tree->monoid; 
+        uint64_t prefix = private_rb_key_prefix(tree, lo); 
+        double result = m->identity; 
+
+        /* each node kept, with its right subtree, comes before those found later */
+        while (n != NULL) {
+                if (private_rb_compare(tree, lo, prefix, n) <= 0) {
+                        double kept = m->combine(m->measure(n->value, m->ctx), 
+                                                 private_rb_aggregate_of(tree, n->right), m->ctx); 
+
+                        result = m->combine(kept, result, m->ctx); 
+                        n = n->left; 
+                } else {
+                        n = n->right; 
+                }
+        }
+
+        return result; 
+}
+
+double private_rb_aggregate_upto(T tree, Node *n, void *hi)
+{
+        Monoid *m = &tree->monoid; 
+        uint64_t prefix = private_rb_key_prefix(tree, hi); 
+        double result = m->identity; 
+
+        /* each node kept, with its left subtree, comes after those found earlier */
+        while (n != NULL) {
+                if (private_rb_compare(tree, hi, prefix, n) >= 0) {
+                        double kept = m->combine(private_rb_aggregate_of(tree, n->left), 
+                                                 m->measure(n->value, m->ctx), m->ctx); 
+
+                        result = m->combine(result, kept, m->ctx); 
+                        n = n->right; 
+                } else {
+                        n = n->left; 
+                }
+        }
+
+        return result; 
 }
 
 void rb_transplant(T tree, Node *u, Node *v) 
@@ -636,70 +1690,78 @@ void rb_transplant(T tree, Node *u, Node *v)
                 v->parent = u->parent; 
 }
 
-void rb_delete_fixup(T tree, Node *culprit)
+bool private_rb_is_black(Node *n)
 {
-        if (culprit == NULL)
-                return; 
+        return n == NULL || n->color == BLACK; 
+}
 
+void rb_delete_fixup(T tree, Node *culprit, Node *parent)
+{
         Node *sibling = NULL; 
 
-        while (culprit != tree->root && culprit->color == BLACK) {
-                if (culprit == culprit->parent->left) {
-                        sibling = culprit->parent->right; 
+        while (culprit != tree->root && private_rb_is_black(culprit)) {
+                if (culprit == parent->left) {
+                        sibling = parent->right; 
 
                         if (sibling->color == RED) {
                                 sibling->color = BLACK; 
-                                culprit->parent->color = RED; 
-                                rb_rotate_left(tree, culprit->parent); 
-                                sibling = culprit->parent->right; 
+                                parent->color = RED; 
+                                rb_rotate_left(tree, parent); 
+                                sibling = parent->right; 
                         }
 
-                        if (sibling->left->color == BLACK && sibling->right->color == BLACK) {
+                        if (private_rb_is_black(sibling->left) && 
+                            private_rb_is_black(sibling->right)) {
                                 sibling->color = RED; 
-                                culprit = culprit->parent; 
+                                culprit = parent; 
+                                parent = culprit->parent; 
                         } else {
-                                if (sibling->right->color == BLACK) {
+                                if (private_rb_is_black(sibling->right)) {
                                         sibling->left->color = BLACK; 
                                         sibling->color = RED; 
                                         rb_rotate_right(tree, sibling); 
-                                        sibling = culprit->parent->right; 
+                                        sibling = parent->right; 
                                 }
-                                sibling->color = culprit->parent->color; 
-                                culprit->parent->color = BLACK; 
+                                sibling->color = parent->color; 
+                                parent->color = BLACK; 
                                 sibling->right->color = BLACK; 
-                                rb_rotate_left(tree, culprit->parent); 
+                                rb_rotate_left(tree, parent); 
                                 culprit = tree->root; 
                         }
-                } else { //culprit == culprit->parent->right
-                        sibling = culprit->parent->left; 
+                } else { //culprit == parent->right
+                        sibling = parent->left; 
 
                         if (sibling->color == RED) {
                                 sibling->color = BLACK; 
-                                culprit->parent->color = RED; 
-                                rb_rotate_left(tree, culprit->parent); 
-                                sibling = culprit->parent->left; 
+                                parent->color = RED; 
+                                rb_rotate_right(tree, parent); 
+                                sibling = parent->left; 
                         }
 
-                        if (sibling->right->color == BLACK && sibling->left->color == BLACK) {
+                        if (private_rb_is_black(sibling->right) && 
+                            private_rb_is_black(sibling->left)) {
                                 sibling->color = RED; 
-                                culprit = culprit->parent; 
+                                culprit = parent; 
+                                parent = culprit->parent; 
                         } else {
-                                if (sibling->left->color == BLACK) {
+                                if (private_rb_is_black(sibling->left)) {
                                         sibling->right->color = BLACK; 
                                         sibling->color = RED; 
                                         rb_rotate_left(tree, sibling); 
-                                        sibling = culprit->parent->left; 
+                                        sibling = parent->left; 
                                 }
-                                sibling->color = culprit->parent->color; 
-                                culprit->parent->color = BLACK; 
+                                sibling->color = parent->color; 
+                                parent->color = BLACK; 
                                 sibling->left->color = BLACK; 
-                                rb_rotate_right(tree, culprit->parent); 
+                                rb_rotate_right(tree, parent); 
                                 culprit = tree->root; 
                         }
                 }
 
         }
-        culprit->color = BLACK; 
+
+        if (culprit != NULL)
+                culprit->color = BLACK; 
 }
 
 void *rb_tree_maximum(T tree)
@@ -716,23 +1778,23 @@ void *rb_tree_minimum(T tree)
 
 void *rb_successor_of_value(T tree, void *value)
 {
-        return private_rb_successor_of_value(tree, value, tree->comparison_func); 
+        return private_rb_successor_of_value(tree, value); 
 }
 
 void *rb_predecessor_of_value(T tree, void *value)
 {
-        return private_rb_predecessor_of_value(tree, value, tree->comparison_func); 
+        return private_rb_predecessor_of_value(tree, value); 
 } 
 
-void *private_rb_successor_of_value(T tree, void *value, 
-                                 void *comparison_func(void *val1, void *val2))
+void *private_rb_successor_of_value(T tree, void *value)
 {
         Node *curr_node = tree->root; 
         Node *successor = NULL; 
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
         int c; 
 
         while (curr_node != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr_node->value);
+                c = private_rb_compare(tree, value, prefix, curr_node);
 
                 if (c < 0) {
                         successor = curr_node; 
@@ -748,15 +1810,15 @@ void *private_rb_successor_of_value(T tree, void *value,
                 return successor->value; 
 }
 
-void *private_rb_predecessor_of_value(T tree, void *value, 
-                                   void *comparison_func(void *val1, void *val2))
+void *private_rb_predecessor_of_value(T tree, void *value)
 {
         Node *curr_node = tree->root; 
         Node *successor = NULL; 
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
         int c; 
 
         while (curr_node != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr_node->value);
+                c = private_rb_compare(tree, value, prefix, curr_node);
                 if (c > 0) {
                         successor = curr_node; 
                         curr_node = curr_node->right; 
@@ -771,6 +1833,56 @@ void *private_rb_predecessor_of_value(T tree, void *value,
                 return successor->value; 
 }
 
+uint64_t private_rb_key_prefix(T tree, void *value)
+{
+        const unsigned char *s = value; 
+        uint64_t prefix = 0; 
+
+        if (!tree->prefixed) 
+                return 0; 
+
+        for (int i = 0; i < 8; i++) {
+                prefix <<= 8; 
+                if (*s != '\0') 
+                        prefix |= *s++; 
+        }
+
+        return prefix; 
+}
+
+int private_rb_compare(T tree, void *value, uint64_t prefix, Node *n)
+{
+        if (!tree->prefixed) 
+                return tree->compare.func(value, n->value, tree->compare.ctx); 
+
+        if (prefix != n->prefix) 
+                return (prefix < n->prefix) ? -1 : 1; 
+
+        /* the last byte is zero iff both strings ended within the prefix */
+        if ((prefix & 0xFF) == 0) 
+                return 0; 
+
+        return strcmp((char *) value + 8, (char *) n->value + 8); 
+}
+
+Node *private_rb_lower_bound(T tree, void *value)
+{
+        Node *curr = tree->root; 
+        Node *bound = NULL; 
+        uint64_t prefix = private_rb_key_prefix(tree, value); 
+
+        while (curr != NULL) {
+                if (private_rb_compare(tree, value, prefix, curr) <= 0) {
+                        bound = curr; 
+                        curr = curr->left; 
+                } else {
+                        curr = curr->right; 
+                }
+        }
+
+        return bound; 
+}
+
 Node *private_rb_find_successor(Node *n)
 {
         return private_subrb_tree_minimum(n->right);  
@@ -863,3 +1975,65 @@ void rb_private_postorder_map(Node *root,
 
         func_to_apply(root->value, depth, cl); 
 }
+
+void rb_map_range(T tree, void *lo, void *hi, 
+                  bool func_to_apply(void *value, void *cl), void *cl)
+{
+        assert(tree != NULL && lo != NULL && hi != NULL && func_to_apply != NULL); 
+
+        uint64_t prefix = private_rb_key_prefix(tree, hi); 
+
+        for (Node *n = private_rb_lower_bound(tree, lo); 
+             n != NULL && private_rb_compare(tree, hi, prefix, n) >= 0; 
+             n = private_rb_next_inorder(n)) {
+                if (!func_to_apply(n->value, cl))
+                        return; 
+        }
+}
+
+Frozen_T rb_freeze(T tree, Frozen_Layout layout)
+{
+        assert(tree != NULL); 
+
+        size_t count = 0; 
+        Node *n; 
+
+        for (n = (tree->root == NULL) ? NULL : private_subrb_tree_minimum(tree->root); 
+             n != NULL; n = private_rb_next_inorder(n))
+                count++; 
+
+        void **values = malloc((count > 0 ? count : 1) * sizeof(void *)); 
+        size_t i = 0; 
+
+        for (n = (tree->root == NULL) ? NULL : private_subrb_tree_minimum(tree->root); 
+             n != NULL; n = private_rb_next_inorder(n))
+                values[i++] = n->value; 
+
+        Frozen_T frozen = frozen_new_r(values, count, tree->compare.func, 
+                                       tree->compare.ctx, layout); 
+        free(values); 
+
+        return frozen; 
+}
+
+Node *private_rb_next_inorder(Node *n)
+{
+        if (n->right != NULL)
+                return private_subrb_tree_minimum(n->right); 
+
+        while (n->parent != NULL && n == n->parent->right)
+                n = n->parent; 
+
+        return n->parent; 
+}
+
+Node *private_rb_prev_inorder(Node *n)
+{
+        if (n->left != NULL)
+                return private_subrb_tree_maximum(n->left); 
+
+        while (n->parent != NULL && n == n->parent->left)
+                n = n->parent; 
+
+        return n->parent; 
+}
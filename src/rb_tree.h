@@ -17,11 +17,23 @@
 #include <stdio.h>
 #include <assert.h>
 #include <stdbool.h>
+#include "comparator.h"
+#include "frozen_tree.h"
+#include "monoid.h"
 
 /*** DEFINITIONS AND TYPEDEFS ***/
 
 typedef struct rb_tree *RedBlack_T;
 
+/*
+ * RB_Cursor
+ *
+ * a position in a tree: the node holding one value. it stays valid while
+ * other values are inserted and deleted, until its own value is deleted
+ * or the tree is freed
+ */
+typedef struct rb_node *RB_Cursor;
+
 /**********************
  * FUNCTION CONTRACTS *
  * AND DECLARATIONS   *
@@ -51,6 +63,114 @@ typedef struct rb_tree *RedBlack_T;
  */
 RedBlack_T rb_new(void *comparison_func); 
 
+/*
+ * rb_new_r
+ * 
+ * same as rb_new, but takes a typed comparator and a context that is
+ * passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty rb_tree
+ */
+RedBlack_T rb_new_r(Comparator compare, void *ctx); 
+
+/*
+ * rb_new_multiset
+ * 
+ * same as rb_new_r, but the tree keeps a single node per distinct value,
+ * with a count of its occurrences. inserting a value equal to one already
+ * in the tree bumps that node's count (the pointer stored first is the one
+ * kept), and deleting it takes one off the count, only unlinking the node
+ * once the count reaches zero. the maps visit each distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty rb_tree
+ */
+RedBlack_T rb_new_multiset(Comparator compare, void *ctx); 
+
+/*
+ * rb_new_ranked
+ * 
+ * same as rb_new_r, but every node also keeps the size of its subtree,
+ * kept current through rotations, inserts and deletes, so that 
+ * rb_rank, rb_select and rb_count_range answer in O(log n) 
+ * instead of a walk over the whole tree. inserts and deletes update the
+ * sizes along their path
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty rb_tree
+ */
+RedBlack_T rb_new_ranked(Comparator compare, void *ctx); 
+
+/*
+ * rb_new_ranked_multiset
+ * 
+ * a multiset (see rb_new_multiset) whose nodes also keep the size of 
+ * their subtree (see rb_new_ranked). sizes count occurrences, so a value
+ * held three times takes three positions in rb_rank, rb_select and 
+ * rb_count_range, as it would in a ranked tree of three separate nodes
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty rb_tree
+ */
+RedBlack_T rb_new_ranked_multiset(Comparator compare, void *ctx); 
+
+/*
+ * rb_new_aggregated
+ * 
+ * same as rb_new_r, but every node also keeps the monoid's aggregate of 
+ * the values in its subtree, kept current through rotations, inserts and
+ * deletes, so that rb_aggregate_range folds any range in O(log n). the 
+ * tree is not a multiset
+ * 
+ * CREs         compare == NULL
+ *              monoid.measure == NULL
+ *              monoid.combine == NULL
+ * UREs         system out of memory
+ *              the measure of a stored value changes while it is stored
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @param       Monoid - the aggregate to keep (see monoid.h)
+ * @return      pointer to empty rb_tree
+ */
+RedBlack_T rb_new_aggregated(Comparator compare, void *ctx, Monoid monoid); 
+
+/*
+ * rb_new_prefixed
+ * 
+ * returns a new, empty red black tree of NUL-terminated strings, ordered
+ * as by strcmp. each node caches the first 8 bytes of its key packed into
+ * an integer, so most comparisons are one integer compare and strcmp only
+ * runs, from the ninth byte on, when two keys share their first 8 bytes.
+ * nodes are 8 bytes larger than those of rb_new
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ *              a value stored or searched for is not a string
+ * 
+ * @return      pointer to empty rb_tree
+ */
+RedBlack_T rb_new_prefixed(void); 
+
 /*
  * rb_tree_free
  * 
@@ -96,6 +216,108 @@ bool rb_tree_is_empty(RedBlack_T tree);
  */
 int rb_insert_value(RedBlack_T tree, void *value);
 
+/*
+ * rb_insert_hint
+ * 
+ * same as rb_insert_value, but first tries the position next to hint: if 
+ * value falls between hint and its predecessor or successor, it is linked
+ * there with at most two comparisons and no descent from the root, and 
+ * the insert costs amortized O(1) rebalancing. otherwise, or if hint is 
+ * NULL, it is inserted from the root. passing the cursor returned by one
+ * insert to the next makes loading sorted or nearly sorted keys cheap, as
+ * with std::map::insert(hint, value)
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         system out of memory
+ *              hint is not a valid cursor into tree
+ * 
+ * @param       RedBlack_T - tree in which to insert value
+ * @param       RB_Cursor - a position near value, or NULL
+ * @param       void * - a pointer to any item to be inserted
+ * @return      RB_Cursor - the position of value, to hint the next insert
+ */
+RB_Cursor rb_insert_hint(RedBlack_T tree, RB_Cursor hint, void *value); 
+
+/*
+ * rb_search_hint
+ * 
+ * same as rb_search, but returns a cursor, and first checks hint and its 
+ * neighbour towards value: if value is one of them, or lies strictly 
+ * between them, the answer needs at most two comparisons. otherwise, or 
+ * if hint is NULL, it searches from the root
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         hint is not a valid cursor into tree
+ * 
+ * @param       RedBlack_T - tree in which to search
+ * @param       RB_Cursor - a position near value, or NULL
+ * @param       void * - value to search for
+ * @return      RB_Cursor - the position of an equal value, or NULL if 
+ *                      there is none
+ */
+RB_Cursor rb_search_hint(RedBlack_T tree, RB_Cursor hint, void *value); 
+
+/*
+ * rb_cursor_value
+ * 
+ * returns the value stored at a position
+ * 
+ * CREs         cursor == NULL
+ * UREs         cursor is no longer valid
+ * 
+ * @param       RB_Cursor - the position
+ * @return      void * - the value stored there
+ */
+void *rb_cursor_value(RB_Cursor cursor); 
+
+/*
+ * rb_insert_unique
+ * 
+ * given a tree and a value, inserts the value unless an equal value is 
+ * already stored, in which case the tree is left as it is and the stored
+ * value is returned. finds and inserts in a single descent, where calling
+ * rb_search and then rb_insert_value takes two. in a multiset, an 
+ * equal value's count is not changed
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         system out of memory
+ * 
+ * @param       RedBlack_T - tree in which to insert value
+ * @param       void * - value to be inserted
+ * @return      void * - the equal value already stored, or NULL if value
+ *                      was inserted
+ */
+void *rb_insert_unique(RedBlack_T tree, void *value); 
+
+/*
+ * rb_upsert
+ * 
+ * same as rb_insert_unique, but when an equal value is already stored
+ * it is replaced with what merge returns for it, in the same descent
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ *              merge == NULL
+ * UREs         system out of memory
+ *              merge returns a value that is not equal to value
+ * 
+ * @param       RedBlack_T - tree in which to insert value
+ * @param       void * - value to be inserted
+ * @param       void * - function giving the value to store in place of an
+ *                      equal one
+ *              @param          the stored value
+ *              @param          the value being inserted
+ *              @param          the closure passed to rb_upsert
+ *              @return         the value to store
+ * @param       void * - closure passed to merge
+ * @return      void * - the value stored in the tree afterwards
+ */
+void *rb_upsert(RedBlack_T tree, void *value, 
+                void *merge(void *stored, void *value, void *cl), void *cl); 
+
 /*
  * rb_search
  * 
@@ -109,11 +331,36 @@ int rb_insert_value(RedBlack_T tree, void *value);
  */
 void *rb_search(RedBlack_T tree, void *value); 
 
+/*
+ * rb_finger_search
+ * 
+ * same as rb_search, but starts from the finger, the node the previous 
+ * finger search ended at, instead of the root: it climbs until an 
+ * ancestor lies past value and descends from there, so a lookup near the
+ * previous one takes few comparisons, typically O(log d) for a rank 
+ * distance d. it can still climb to the root when the two lie on either
+ * side of a high node. unlike splay_search, the tree is not restructured;
+ * only the finger moves, to the node the search ends at whether it found
+ * value or not. the first search, and the first after the finger's node
+ * is deleted, starts from the root
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       RedBlack_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *rb_finger_search(RedBlack_T tree, void *value); 
+
 /*
  * rb_delete_value
  * 
  * given a value, deletes the first instance of it that is found in the tree
  * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its node instead, and only
+ * deletes the node when that reaches zero
  * 
  * CREs         tree == NULL
  * UREs         n/a
@@ -124,6 +371,141 @@ void *rb_search(RedBlack_T tree, void *value);
  */
 void rb_delete_value(RedBlack_T tree, void *value); 
 
+/*
+ * rb_split
+ * 
+ * given a tree and a key, moves every value not less than key into a new
+ * tree, built like the first (same comparator, context and modes), and 
+ * returns it; the values less than key stay. the nodes move as they are,
+ * joined back up along the search path for key by black height, so this 
+ * takes O(log n) however many values move
+ * 
+ * CREs         tree == NULL
+ *              key == NULL
+ * UREs         system out of memory
+ * 
+ * @param       RedBlack_T - tree to split
+ * @param       void * - the key to split at
+ * @return      RedBlack_T - new tree of the values not less than key, to 
+ *                      be freed with rb_tree_free
+ */
+RedBlack_T rb_split(RedBlack_T tree, void *key); 
+
+/*
+ * rb_join
+ * 
+ * given two trees built alike, where every value in left is less than 
+ * every value in right, moves every value of right into left in 
+ * O(log n), leaving right empty. the minimum of right is unlinked and 
+ * becomes the node that joins the two, hung from left's right spine (or
+ * right's left spine) at the depth where the black heights match
+ * 
+ * CREs         left == NULL
+ *              right == NULL
+ *              left == right
+ * UREs         a value in left is not less than a value in right
+ *              the trees were built with different comparators or modes
+ * 
+ * @param       RedBlack_T - tree to receive the values
+ * @param       RedBlack_T - tree to take them from, left empty
+ * @return      n/a
+ */
+void rb_join(RedBlack_T left, RedBlack_T right); 
+
+/*
+ * rb_count
+ * 
+ * given a tree and a value, returns how many times the value is stored:
+ * the count of its node in a multiset, or the number of equal nodes
+ * otherwise. returns 0 if the value is not in the tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       RedBlack_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t rb_count(RedBlack_T tree, void *value); 
+
+/*
+ * rb_rank
+ * 
+ * given a ranked tree and a value, returns how many values stored in the
+ * tree are less than it: the position value has, or would have, in 
+ * sorted order, counting from 0
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ *              the tree was not built with rb_new_ranked
+ * UREs         n/a
+ * 
+ * @param       RedBlack_T - tree to be searched
+ * @param       void * - value to rank
+ * @return      size_t - number of smaller values
+ */
+size_t rb_rank(RedBlack_T tree, void *value); 
+
+/*
+ * rb_select
+ * 
+ * given a ranked tree and a position k, returns the value at position k
+ * in sorted order, counting from 0, so that rb_select(tree, 0) is the
+ * minimum. equal values take one position each
+ * 
+ * CREs         tree == NULL
+ *              the tree was not built with rb_new_ranked
+ * UREs         n/a
+ * 
+ * @param       RedBlack_T - tree to be searched
+ * @param       size_t - position of the value
+ * @return      void * - the value, or NULL if k is not less than the 
+ *                      number of values
+ */
+void *rb_select(RedBlack_T tree, size_t k); 
+
+/*
+ * rb_count_range
+ * 
+ * given a ranked tree and two bounds, returns how many values stored in
+ * the tree lie between them, both included
+ * 
+ * CREs         tree == NULL
+ *              lo == NULL
+ *              hi == NULL
+ *              the tree was not built with rb_new_ranked
+ * UREs         n/a
+ * 
+ * @param       RedBlack_T - tree to be searched
+ * @param       void * - the lower bound
+ * @param       void * - the upper bound
+ * @return      size_t - number of values v with lo <= v <= hi, 0 if 
+ *                      lo > hi
+ */
+size_t rb_count_range(RedBlack_T tree, void *lo, void *hi); 
+
+/*
+ * rb_aggregate_range
+ * 
+ * given an aggregated tree and two bounds, returns the tree's monoid 
+ * folded over the values stored between them, both included, in sorted
+ * order
+ * 
+ * CREs         tree == NULL
+ *              lo == NULL
+ *              hi == NULL
+ *              the tree was not built with rb_new_aggregated
+ * UREs         n/a
+ * 
+ * @param       RedBlack_T - tree to be searched
+ * @param       void * - the lower bound
+ * @param       void * - the upper bound
+ * @return      double - the aggregate of the values v with lo <= v <= hi,
+ *                      the monoid's identity if there are none
+ */
+double rb_aggregate_range(RedBlack_T tree, void *lo, void *hi); 
+
 /*
  * rb_tree_minimum
  * 
@@ -271,4 +653,50 @@ void rb_map_postorder(RedBlack_T tree,
                       void func_to_apply(void *value, int depth, void *cl), 
                       void *cl); 
 
-#endif
\ No newline at end of file
+/*
+ * rb_map_range
+ * 
+ * given a tree, two bounds and a pointer to a function, applies the 
+ * function to the values stored between the bounds, both included, in 
+ * sorted order, for as long as it returns true. the walk descends 
+ * straight to lo and stops at the first value past hi, so visiting k 
+ * values costs O(log n + k) rather than a walk over the whole tree. in a 
+ * multiset, each distinct value is visited once
+ * 
+ * CREs         tree == NULL
+ *              lo == NULL
+ *              hi == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure
+ * 
+ * @param       RedBlack_T - tree to apply function to
+ * @param       void * - the lower bound
+ * @param       void * - the upper bound
+ * @param       void * - pointer to a function, returning false to stop 
+ *                      the walk
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void rb_map_range(RedBlack_T tree, void *lo, void *hi, 
+                  bool func_to_apply(void *value, void *cl), void *cl); 
+
+/*
+ * rb_freeze
+ * 
+ * given a tree, returns an immutable snapshot of its values laid out as an 
+ * implicit array (see frozen_tree.h). lookups on the snapshot return the 
+ * same void * values that rb_search would. the tree itself is left 
+ * unchanged and may keep being modified; the snapshot does not follow
+ * 
+ * CREs         tree == NULL
+ * UREs         system out of memory
+ *              the stored values are freed while the snapshot is in use
+ * 
+ * @param       RedBlack_T - tree to snapshot
+ * @param       Frozen_Layout - FROZEN_EYTZINGER or FROZEN_VEB
+ * @return      Frozen_T - the snapshot, to be released with frozen_free
+ */
+Frozen_T rb_freeze(RedBlack_T tree, Frozen_Layout layout); 
+
+#endif
@@ -0,0 +1,616 @@
+#include "scapegoat_tree.h"
+#include <string.h>
+#include <stdint.h>
+
+/* same layout as basic_bst's Node: balance is tracked per tree, not per node */
+typedef struct Node {
+        void *value; 
+        struct Node *parent; 
+        struct Node *left; 
+        struct Node *right; 
+        uint32_t count;         /* occurrences of value, in a multiset */
+} Node; 
+
+/* size and max_size count nodes, not occurrences, as balance depends on nodes */
+struct scapegoat_tree {
+        Node *root; 
+        Compare compare; 
+        size_t size; 
+        size_t max_size; 
+        double alpha; 
+        bool multiset; 
+};
+
+typedef Scapegoat_T T; 
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/ 
+
+void private_scapegoat_deallocate_all_tree_nodes(Node *n); 
+Node *scapegoat_construct_node(void *value);
+Node *private_scapegoat_find_in_tree(T tree, void *value, Compare compare);
+void private_scapegoat_transplant(T tree, Node *u, Node *v); 
+Node *private_scapegoat_minimum(Node *x);
+Node *private_scapegoat_maximum(Node *x); 
+Node *private_scapegoat_lower_bound(T tree, void *value, Compare compare);
+Node *private_scapegoat_next_inorder(Node *n); 
+
+/*
+ * private_scapegoat_depth_limit
+ * 
+ * returns floor(log base 1/alpha of n), the deepest an insertion may land 
+ * in a tree of n nodes before a rebuild is required
+ * 
+ * @param       size_t - number of nodes in the tree
+ * @param       double - the tree's alpha
+ * @return      int - the depth limit
+ */
+int private_scapegoat_depth_limit(size_t n, double alpha); 
+
+/*
+ * private_scapegoat_subtree_size
+ * 
+ * counts the nodes of the subtree rooted at n. sizes are not stored in the 
+ * nodes, so this is linear in the size of the subtree; it is only called 
+ * while looking for a scapegoat, whose subtree gets rebuilt (also in linear
+ * time) right after
+ * 
+ * @param       Node * - root of the subtree
+ * @return      size_t - number of nodes in the subtree
+ */
+size_t private_scapegoat_subtree_size(Node *n); 
+
+/*
+ * private_scapegoat_rebuild
+ * 
+ * rebuilds the subtree of n nodes rooted at root into a perfectly balanced 
+ * subtree in place, and hangs it back where root was
+ * 
+ * @param       T - tree containing the subtree
+ * @param       Node * - root of the subtree to rebuild
+ * @param       size_t - number of nodes in the subtree
+ * @return      n/a
+ */
+void private_scapegoat_rebuild(T tree, Node *root, size_t n); 
+
+/*
+ * private_scapegoat_flatten
+ * 
+ * threads the subtree rooted at n onto the front of the list *head, in 
+ * order, through the nodes' right pointers. no memory is allocated
+ * 
+ * @param       Node * - root of the subtree to flatten
+ * @param       Node ** - head of the list built so far
+ * @return      n/a
+ */
+void private_scapegoat_flatten(Node *n, Node **head); 
+
+/*
+ * private_scapegoat_build
+ * 
+ * consumes the first n nodes of the list *head (linked through right 
+ * pointers) and returns them arranged as a perfectly balanced subtree, 
+ * with parent pointers set below the returned root
+ * 
+ * @param       Node ** - head of the list; advanced past the consumed nodes
+ * @param       size_t - number of nodes to consume
+ * @return      Node * - root of the new subtree
+ */
+Node *private_scapegoat_build(Node **head, size_t n); 
+
+void private_scapegoat_map_inorder(Node *root, 
+                                   int depth, 
+                                   void func_to_apply(void *value, int depth, void *cl), 
+                                   void *cl);
+void private_scapegoat_map_preorder(Node *root, 
+                                    int depth, 
+                                    void func_to_apply(void *value, int depth, void *cl), 
+                                    void *cl);
+void private_scapegoat_map_postorder(Node *root, 
+                                     int depth, 
+                                     void func_to_apply(void *value, int depth, void *cl), 
+                                     void *cl);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/ 
+
+T scapegoat_new(void *comparison_func)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return scapegoat_new_r(compare.func, compare.ctx); 
+}
+
+T scapegoat_new_r(Comparator compare, void *ctx)
+{
+        assert(compare != NULL); 
+
+        T tree = malloc(sizeof(struct scapegoat_tree)); 
+
+        tree->root = NULL; 
+        tree->size = 0; 
+        tree->max_size = 0; 
+        tree->alpha = SCAPEGOAT_DEFAULT_ALPHA; 
+
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+        tree->multiset = false; 
+
+        return tree; 
+}
+
+T scapegoat_new_multiset(Comparator compare, void *ctx)
+{
+        T tree = scapegoat_new_r(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+void scapegoat_set_alpha(T tree, double alpha)
+{
+        assert(tree != NULL); 
+        assert(alpha > 0.5 && alpha < 1.0); 
+
+        tree->alpha = alpha; 
+}
+
+double scapegoat_get_alpha(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->alpha; 
+}
+
+void scapegoat_free(T tree)
+{
+        assert(tree != NULL);
+
+        private_scapegoat_deallocate_all_tree_nodes(tree->root); 
+        free(tree); 
+}
+
+void private_scapegoat_deallocate_all_tree_nodes(Node *n) 
+{
+        if (n == NULL)
+                return; 
+
+        private_scapegoat_deallocate_all_tree_nodes(n->left);
+        private_scapegoat_deallocate_all_tree_nodes(n->right); 
+
+        free(n); 
+}
+
+bool scapegoat_is_empty(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->root == NULL;
+}
+
+Node *scapegoat_construct_node(void *value)
+{
+        Node *new_node = (Node *) malloc(sizeof(Node)); 
+
+        new_node->parent = NULL;
+        new_node->left = NULL; 
+        new_node->right = NULL; 
+        new_node->value = value; 
+        new_node->count = 1; 
+
+        return new_node; 
+}
+
+int scapegoat_insert_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        if (tree->multiset) {
+                Node *n = private_scapegoat_find_in_tree(tree, value, tree->compare); 
+
+                if (n != NULL) {
+                        n->count++; 
+                        return 0; 
+                }
+        }
+
+        Compare compare = tree->compare; 
+        Node *new_node = scapegoat_construct_node(value); 
+        Node *parent = NULL; 
+        Node *curr = tree->root; 
+        int depth = 0; 
+        int c = 0; 
+
+        while (curr != NULL) {
+                parent = curr; 
+                c = compare.func(value, curr->value, compare.ctx); 
+                curr = (c < 0) ? curr->left : curr->right; 
+                depth++; 
+        }
+
+        new_node->parent = parent; 
+        if (parent == NULL) 
+                tree->root = new_node; 
+        else if (c < 0) 
+                parent->left = new_node; 
+        else 
+                parent->right = new_node; 
+
+        tree->size++; 
+        if (tree->size > tree->max_size)
+                tree->max_size = tree->size; 
+
+        if (depth <= private_scapegoat_depth_limit(tree->size, tree->alpha))
+                return 0; 
+
+        /* 
+         * the new node is too deep, so some ancestor has a child holding 
+         * more than alpha of its nodes: climb until we find it
+         */
+        Node *child = new_node; 
+        size_t child_size = 1; 
+
+        for (Node *p = new_node->parent; p != NULL; p = p->parent) {
+                Node *sibling = (p->left == child) ? p->right : p->left; 
+                size_t p_size = child_size + 1 + private_scapegoat_subtree_size(sibling); 
+
+                if ((double) child_size > tree->alpha * (double) p_size) {
+                        private_scapegoat_rebuild(tree, p, p_size); 
+                        break; 
+                }
+
+                child = p; 
+                child_size = p_size; 
+        }
+
+        return 0; 
+}
+
+int private_scapegoat_depth_limit(size_t n, double alpha)
+{
+        double growth = 1.0 / alpha; 
+        double reach = growth; 
+        int limit = 0; 
+
+        while (reach <= (double) n) {
+                reach *= growth; 
+                limit++; 
+        }
+
+        return limit; 
+}
+
+size_t private_scapegoat_subtree_size(Node *n)
+{
+        if (n == NULL)
+                return 0; 
+
+        return 1 + private_scapegoat_subtree_size(n->left) 
+                 + private_scapegoat_subtree_size(n->right); 
+}
+
+void private_scapegoat_rebuild(T tree, Node *root, size_t n)
+{
+        Node *parent = root->parent; 
+        bool was_left = (parent != NULL && parent->left == root); 
+        Node *list = NULL; 
+
+        private_scapegoat_flatten(root, &list); 
+        Node *new_root = private_scapegoat_build(&list, n); 
+
+        new_root->parent = parent; 
+        if (parent == NULL) 
+                tree->root = new_root; 
+        else if (was_left) 
+                parent->left = new_root; 
+        else 
+                parent->right = new_root; 
+}
+
+void private_scapegoat_flatten(Node *n, Node **head)
+{
+        if (n == NULL)
+                return; 
+
+        private_scapegoat_flatten(n->right, head); 
+        n->right = *head; 
+        *head = n; 
+        private_scapegoat_flatten(n->left, head); 
+}
+
+Node *private_scapegoat_build(Node **head, size_t n)
+{
+        if (n == 0)
+                return NULL; 
+
+        Node *left = private_scapegoat_build(head, n / 2); 
+        Node *root = *head; 
+        *head = root->right; 
+
+        root->left = left; 
+        if (left != NULL)
+                left->parent = root; 
+
+        root->right = private_scapegoat_build(head, n - n / 2 - 1); 
+        if (root->right != NULL)
+                root->right->parent = root; 
+
+        return root; 
+}
+
+void *scapegoat_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Node *result = private_scapegoat_find_in_tree(tree, value, tree->compare); 
+
+        if (result != NULL) 
+                return result->value; 
+
+        return NULL; 
+}
+
+Node *private_scapegoat_find_in_tree(T tree, void *value, Compare compare)
+{
+        Node *curr = tree->root; 
+        int c; 
+
+        while (curr != NULL) {
+                c = compare.func(value, curr->value, compare.ctx); 
+
+                if (c == 0) 
+                        return curr; 
+                else if (c < 0) 
+                        curr = curr->left; 
+                else 
+                        curr = curr->right; 
+        }
+
+        return NULL; 
+}
+
+void scapegoat_delete_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *z = private_scapegoat_find_in_tree(tree, value, tree->compare);
+
+        if (z == NULL)
+                return; 
+
+        if (--z->count > 0)
+                return; 
+
+        if (z->left == NULL) {
+                private_scapegoat_transplant(tree, z, z->right); 
+        } else if (z->right == NULL) {
+                private_scapegoat_transplant(tree, z, z->left);
+        } else {
+                Node *y = private_scapegoat_minimum(z->right); 
+                if (y->parent != z) {
+                        private_scapegoat_transplant(tree, y, y->right); 
+                        y->right = z->right; 
+                        y->right->parent = y; 
+                }
+                private_scapegoat_transplant(tree, z, y); 
+                y->left = z->left; 
+                y->left->parent = y; 
+        }
+        
+        free(z); 
+        tree->size--; 
+
+        if ((double) tree->size < tree->alpha * (double) tree->max_size) {
+                if (tree->root != NULL)
+                        private_scapegoat_rebuild(tree, tree->root, tree->size); 
+                tree->max_size = tree->size; 
+        }
+}
+
+size_t scapegoat_count(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *n = private_scapegoat_lower_bound(tree, value, tree->compare); 
+        size_t count = 0; 
+
+        while (n != NULL && tree->compare.func(value, n->value, tree->compare.ctx) == 0) {
+                count += n->count; 
+                n = private_scapegoat_next_inorder(n); 
+        }
+
+        return count; 
+}
+
+Node *private_scapegoat_lower_bound(T tree, void *value, Compare compare)
+{
+        Node *curr = tree->root; 
+        Node *bound = NULL; 
+
+        while (curr != NULL) {
+                if (compare.func(value, curr->value, compare.ctx) <= 0) {
+                        bound = curr; 
+                        curr = curr->left; 
+                } else {
+                        curr = curr->right; 
+                }
+        }
+
+        return bound; 
+}
+
+Node *private_scapegoat_next_inorder(Node *n)
+{
+        if (n->right != NULL)
+                return private_scapegoat_minimum(n->right); 
+
+        while (n->parent != NULL && n == n->parent->right)
+                n = n->parent; 
+
+        return n->parent; 
+}
+
+void private_scapegoat_transplant(T tree, Node *u, Node *v)
+{
+        if (u->parent == NULL) {
+                tree->root = v; 
+        } else if (u == u->parent->left) {
+                u->parent->left = v; 
+        } else {
+                u->parent->right = v; 
+        }
+
+        if (v != NULL)
+                v->parent = u->parent; 
+}
+
+void *scapegoat_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        return private_scapegoat_minimum(tree->root)->value; 
+}
+
+void *scapegoat_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        return private_scapegoat_maximum(tree->root)->value; 
+}
+
+Node *private_scapegoat_minimum(Node *x) 
+{
+        while (x->left != NULL) 
+                x = x->left; 
+
+        return x; 
+}
+
+Node *private_scapegoat_maximum(Node *x) 
+{
+        while (x->right != NULL) 
+                x = x->right; 
+
+        return x; 
+}
+
+void *scapegoat_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *curr_node = tree->root; 
+        Node *successor = NULL; 
+
+        while (curr_node != NULL) {
+                if (compare.func(value, curr_node->value, compare.ctx) < 0) {
+                        successor = curr_node; 
+                        curr_node = curr_node->left; 
+                } else {
+                        curr_node = curr_node->right; 
+                }
+        }
+
+        if (successor == NULL) 
+                return NULL; 
+        else
+                return successor->value; 
+}
+
+void *scapegoat_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *curr_node = tree->root; 
+        Node *predecessor = NULL; 
+
+        while (curr_node != NULL) {
+                if (compare.func(value, curr_node->value, compare.ctx) > 0) {
+                        predecessor = curr_node; 
+                        curr_node = curr_node->right; 
+                } else {
+                        curr_node = curr_node->left; 
+                }
+        }
+
+        if (predecessor == NULL) 
+                return NULL; 
+        else
+                return predecessor->value; 
+}
+
+void scapegoat_map_inorder(T tree, 
+                           void func_to_apply(void *value, int depth, void *cl), 
+                           void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_scapegoat_map_inorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_scapegoat_map_inorder(Node *root, 
+                                   int depth, 
+                                   void func_to_apply(void *value, int depth, void *cl), 
+                                   void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        private_scapegoat_map_inorder(root->left, depth + 1, func_to_apply, cl); 
+        func_to_apply(root->value, depth, cl); 
+        private_scapegoat_map_inorder(root->right, depth + 1, func_to_apply, cl); 
+}
+
+void scapegoat_map_preorder(T tree, 
+                            void func_to_apply(void *value, int depth, void *cl), 
+                            void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_scapegoat_map_preorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_scapegoat_map_preorder(Node *root, 
+                                    int depth, 
+                                    void func_to_apply(void *value, int depth, void *cl), 
+                                    void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        func_to_apply(root->value, depth, cl); 
+        private_scapegoat_map_preorder(root->left, depth + 1, func_to_apply, cl); 
+        private_scapegoat_map_preorder(root->right, depth + 1, func_to_apply, cl); 
+}
+
+void scapegoat_map_postorder(T tree, 
+                             void func_to_apply(void *value, int depth, void *cl), 
+                             void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_scapegoat_map_postorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_scapegoat_map_postorder(Node *root, 
+                                     int depth, 
+                                     void func_to_apply(void *value, int depth, void *cl), 
+                                     void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        private_scapegoat_map_postorder(root->left, depth + 1, func_to_apply, cl); 
+        private_scapegoat_map_postorder(root->right, depth + 1, func_to_apply, cl); 
+        func_to_apply(root->value, depth, cl); 
+}
@@ -0,0 +1,373 @@
+/**********************************************************************
+ * scapegoat_tree.h                                                   *
+ *                                                                    *
+ * Interface for a polymorphic scapegoat tree (Galperin and Rivest).  *
+ * nodes have exactly the layout of basic_bst's, with no color,       *
+ * priority or size field: balance is restored by rebuilding whole    *
+ * subtrees into perfectly balanced shape in linear time, which       *
+ * amortizes to O(log n) per update                                   *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef SCAPEGOAT_TREE_H
+#define SCAPEGOAT_TREE_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include "comparator.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+#define SCAPEGOAT_DEFAULT_ALPHA 0.7
+
+typedef struct scapegoat_tree *Scapegoat_T;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * scapegoat_new
+ * 
+ * returns a pointer to a new, empty scapegoat tree
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ *              
+ * 
+ * @param       void * - pointer to a comparison function. if NULL is passed 
+ *                              as argument, strcmp is assumed. 
+ *              
+ *              comparison_function
+ *              @param          item being inserted (val1)
+ *              @param          item from tree which we are comparing (val2)
+ *              @return         int 
+ *                               - zero (0) if val1 == val2
+ *                               - positive value (n > 0) if val1 > val2
+ *                               - negative value (n < 0) if val1 < val2
+ *        
+ * @return      pointer to empty scapegoat_tree
+ */
+Scapegoat_T scapegoat_new(void *comparison_func); 
+
+/*
+ * scapegoat_new_r
+ * 
+ * same as scapegoat_new, but takes a typed comparator and a context that is
+ * passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty scapegoat_tree
+ */
+Scapegoat_T scapegoat_new_r(Comparator compare, void *ctx); 
+
+/*
+ * scapegoat_new_multiset
+ * 
+ * same as scapegoat_new_r, but the tree keeps a single node per distinct 
+ * value, with a count of its occurrences. inserting a value equal to one
+ * already in the tree bumps that node's count (the pointer stored first
+ * is the one kept), and deleting it takes one off the count, only 
+ * unlinking the node once the count reaches zero. the maps visit each 
+ * distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty scapegoat_tree
+ */
+Scapegoat_T scapegoat_new_multiset(Comparator compare, void *ctx); 
+
+/*
+ * scapegoat_set_alpha
+ * 
+ * sets the balance parameter alpha of the tree. a subtree is considered 
+ * unbalanced when one of its children holds more than alpha of its nodes; 
+ * an insertion deeper than log base 1/alpha of the tree size triggers the 
+ * rebuild of the lowest such subtree on the insertion path (the first one
+ * found climbing from the new leaf), and the whole tree is rebuilt once deletions shrink it below alpha of its size since 
+ * the last full rebuild. values close to 0.5 keep the tree nearly perfectly
+ * balanced at the cost of frequent rebuilds; values close to 1 rebuild 
+ * rarely but allow deeper searches. the default is 
+ * SCAPEGOAT_DEFAULT_ALPHA. the new value applies to subsequent operations
+ * 
+ * CREs         tree == NULL
+ *              alpha <= 0.5 or alpha >= 1
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to configure
+ * @param       double - the new alpha, strictly between 0.5 and 1
+ * @return      n/a
+ */
+void scapegoat_set_alpha(Scapegoat_T tree, double alpha); 
+
+/*
+ * scapegoat_get_alpha
+ * 
+ * returns the balance parameter alpha currently used by the tree
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to query
+ * @return      double - alpha
+ */
+double scapegoat_get_alpha(Scapegoat_T tree); 
+
+/*
+ * scapegoat_free
+ * 
+ * given a pointer to a scapegoat tree, deallocates the tree and all nodes
+ * contained within it
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - the tree to be freed
+ * @return      n/a
+ */
+void scapegoat_free(Scapegoat_T tree); 
+
+/*
+ * scapegoat_is_empty
+ * 
+ * returns true if the tree is empty, and false otherwise
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to be checked if empty
+ * @return      bool - true if empty, false otherwise
+ */ 
+bool scapegoat_is_empty(Scapegoat_T tree); 
+
+/*
+ * scapegoat_insert_value
+ * 
+ * given a value (cast to void), inserts the value into the given tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * 
+ * UREs         system out of memory
+ *              attempting to pass in a value which cannot be compared with 
+ *                      your comparison function
+ * 
+ * @param       Scapegoat_T - tree in which to insert value
+ * @param       void * - a pointer to any item to be inserted
+ * @return      int - 0 on success
+ */
+int scapegoat_insert_value(Scapegoat_T tree, void *value);
+
+/*
+ * scapegoat_search
+ * 
+ * given a tree and a value to search for, returns a pointer to the stored 
+ * value, or NULL if the value is not found. If duplicates are in the tree, 
+ * returns the first one found
+ * 
+ * @param       Scapegoat_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *scapegoat_search(Scapegoat_T tree, void *value); 
+
+/*
+ * scapegoat_delete_value
+ * 
+ * given a value, deletes the first instance of it that is found in the tree
+ * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its node instead, and only
+ * deletes the node when that reaches zero
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to find the value in
+ * @param       void * - pointer to the value to be deleted
+ * @return      n/a
+ */
+void scapegoat_delete_value(Scapegoat_T tree, void *value); 
+
+/*
+ * scapegoat_count
+ * 
+ * given a tree and a value, returns how many times the value is stored:
+ * the count of its node in a multiset, or the number of equal nodes 
+ * otherwise. returns 0 if the value is not in the tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t scapegoat_count(Scapegoat_T tree, void *value); 
+
+/*
+ * scapegoat_tree_minimum
+ * 
+ * given a tree, returns the minimum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to be searched
+ * @return      void * - pointer to min value
+ */
+void *scapegoat_tree_minimum(Scapegoat_T tree); 
+
+/*
+ * scapegoat_tree_maximum
+ * 
+ * given a tree, returns the maximum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to be searched
+ * @return      void * - pointer to max value
+ */
+void *scapegoat_tree_maximum(Scapegoat_T tree); 
+
+/*
+ * scapegoat_successor_of_value
+ * 
+ * given a tree and a value, returns the first successor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no successor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to be searched
+ * @param       void * - value to find the successor of
+ * @return      void * - value of the successor
+ */
+void *scapegoat_successor_of_value(Scapegoat_T tree, void *value); 
+
+/*
+ * scapegoat_predecessor_of_value
+ * 
+ * given a tree and a value, returns the first predecessor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no predecessor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       Scapegoat_T - tree to be searched
+ * @param       void * - value to find the predecessor of
+ * @return      void * - value of the predecessor
+ */
+void *scapegoat_predecessor_of_value(Scapegoat_T tree, void *value); 
+
+/*
+ * scapegoat_map_inorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via an inorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       Scapegoat_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void scapegoat_map_inorder(Scapegoat_T tree, 
+                           void func_to_apply(void *value, int depth, void *cl), 
+                           void *cl); 
+
+/*
+ * scapegoat_map_preorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a preorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       Scapegoat_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void scapegoat_map_preorder(Scapegoat_T tree, 
+                            void func_to_apply(void *value, int depth, void *cl), 
+                            void *cl); 
+
+/*
+ * scapegoat_map_postorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a postorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       Scapegoat_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void scapegoat_map_postorder(Scapegoat_T tree, 
+                             void func_to_apply(void *value, int depth, void *cl), 
+                             void *cl); 
+
+#endif
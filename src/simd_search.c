@@ -0,0 +1,234 @@
+#include "simd_search.h"
+#include <stdlib.h>
+#include <assert.h>
+
+/*
+ * the vector kernels reinterpret each pointer sized key slot as a 64 bit 
+ * lane, so they are only built where pointers are 64 bits wide
+ */
+#if defined(CPU_FEATURES_X86) && UINTPTR_MAX == UINT64_MAX
+#define SIMD_SEARCH_X86 1
+#include <immintrin.h>
+#endif
+
+typedef int (*Bound_Func)(void *const *keys, int count, intptr_t probe); 
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_simd_count_less_* / private_simd_count_less_equal_*
+ * 
+ * count the keys that are less than (or less than or equal to) probe. on 
+ * a sorted array that count is exactly the lower (or upper) bound. every 
+ * key is visited, which for node sized arrays is cheaper than the branch 
+ * mispredictions of a binary search
+ */
+int private_simd_count_less_scalar(void *const *keys, int count, intptr_t probe);
+int private_simd_count_less_equal_scalar(void *const *keys, int count, 
+                                         intptr_t probe);
+
+#ifdef SIMD_SEARCH_X86
+int private_simd_count_less_sse2(void *const *keys, int count, intptr_t probe);
+int private_simd_count_less_equal_sse2(void *const *keys, int count, 
+                                       intptr_t probe);
+int private_simd_count_less_avx2(void *const *keys, int count, intptr_t probe);
+int private_simd_count_less_equal_avx2(void *const *keys, int count, 
+                                       intptr_t probe);
+#endif
+
+void private_simd_search_resolve(void);
+
+/*** DISPATCH STATE ***/
+
+static SIMD_Level current_level = SIMD_SCALAR; 
+static Bound_Func lower_bound_func = NULL; 
+static Bound_Func upper_bound_func = NULL; 
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+int simd_lower_bound(void *const *keys, int count, intptr_t probe)
+{
+        assert(keys != NULL || count == 0); 
+
+        if (lower_bound_func == NULL)
+                private_simd_search_resolve(); 
+
+        return lower_bound_func(keys, count, probe); 
+}
+
+int simd_upper_bound(void *const *keys, int count, intptr_t probe)
+{
+        assert(keys != NULL || count == 0); 
+
+        if (upper_bound_func == NULL)
+                private_simd_search_resolve(); 
+
+        return upper_bound_func(keys, count, probe); 
+}
+
+SIMD_Level simd_search_level(void)
+{
+        if (lower_bound_func == NULL)
+                private_simd_search_resolve(); 
+
+        return current_level; 
+}
+
+SIMD_Level simd_search_set_level(SIMD_Level level)
+{
+        SIMD_Level supported = cpu_simd_level(); 
+
+        if (level > supported)
+                level = supported; 
+
+        switch (level) {
+#ifdef SIMD_SEARCH_X86
+        case SIMD_AVX2:
+                lower_bound_func = &private_simd_count_less_avx2; 
+                upper_bound_func = &private_simd_count_less_equal_avx2; 
+                break; 
+        case SIMD_SSE2:
+                lower_bound_func = &private_simd_count_less_sse2; 
+                upper_bound_func = &private_simd_count_less_equal_sse2; 
+                break; 
+#endif
+        default:
+                level = SIMD_SCALAR; 
+                lower_bound_func = &private_simd_count_less_scalar; 
+                upper_bound_func = &private_simd_count_less_equal_scalar; 
+                break; 
+        }
+
+        current_level = level; 
+
+        return level; 
+}
+
+void private_simd_search_resolve(void)
+{
+        simd_search_set_level(cpu_simd_level()); 
+}
+
+int private_simd_count_less_scalar(void *const *keys, int count, intptr_t probe)
+{
+        int n = 0; 
+
+        for (int i = 0; i < count; i++)
+                n += (intptr_t) keys[i] < probe; 
+
+        return n; 
+}
+
+int private_simd_count_less_equal_scalar(void *const *keys, int count, 
+                                         intptr_t probe)
+{
+        int n = 0; 
+
+        for (int i = 0; i < count; i++)
+                n += (intptr_t) keys[i] <= probe; 
+
+        return n; 
+}
+
+#ifdef SIMD_SEARCH_X86
+
+/*
+ * SSE2 has no 64 bit compare, so a > b is assembled from 32 bit pieces: the 
+ * high halves decide unless they are equal, in which case the sign of the 
+ * 64 bit difference b - a does. only bit 63 of each lane is meaningful, 
+ * which is all that movemask_pd reads
+ */
+static inline __m128i private_simd_cmpgt_epi64_sse2(__m128i a, __m128i b)
+{
+        __m128i high_greater = _mm_cmpgt_epi32(a, b); 
+        __m128i high_equal = _mm_cmpeq_epi32(a, b); 
+        __m128i difference = _mm_sub_epi64(b, a); 
+
+        return _mm_or_si128(high_greater, _mm_and_si128(high_equal, difference)); 
+}
+
+int private_simd_count_less_sse2(void *const *keys, int count, intptr_t probe)
+{
+        __m128i p = _mm_set1_epi64x(probe); 
+        int n = 0; 
+        int i = 0; 
+
+        for (; i + 2 <= count; i += 2) {
+                __m128i k = _mm_loadu_si128((const __m128i *) &keys[i]); 
+                __m128i less = private_simd_cmpgt_epi64_sse2(p, k); 
+
+                n += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(less))); 
+        }
+
+        for (; i < count; i++)
+                n += (intptr_t) keys[i] < probe; 
+
+        return n; 
+}
+
+int private_simd_count_less_equal_sse2(void *const *keys, int count, 
+                                       intptr_t probe)
+{
+        __m128i p = _mm_set1_epi64x(probe); 
+        int n = 0; 
+        int i = 0; 
+
+        for (; i + 2 <= count; i += 2) {
+                __m128i k = _mm_loadu_si128((const __m128i *) &keys[i]); 
+                __m128i greater = private_simd_cmpgt_epi64_sse2(k, p); 
+
+                n += 2 - __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(greater))); 
+        }
+
+        for (; i < count; i++)
+                n += (intptr_t) keys[i] <= probe; 
+
+        return n; 
+}
+
+__attribute__((target("avx2")))
+int private_simd_count_less_avx2(void *const *keys, int count, intptr_t probe)
+{
+        __m256i p = _mm256_set1_epi64x(probe); 
+        int n = 0; 
+        int i = 0; 
+
+        for (; i + 4 <= count; i += 4) {
+                __m256i k = _mm256_loadu_si256((const __m256i *) &keys[i]); 
+                __m256i less = _mm256_cmpgt_epi64(p, k); 
+
+                n += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(less))); 
+        }
+
+        for (; i < count; i++)
+                n += (intptr_t) keys[i] < probe; 
+
+        return n; 
+}
+
+__attribute__((target("avx2")))
+int private_simd_count_less_equal_avx2(void *const *keys, int count, 
+                                       intptr_t probe)
+{
+        __m256i p = _mm256_set1_epi64x(probe); 
+        int n = 0; 
+        int i = 0; 
+
+        for (; i + 4 <= count; i += 4) {
+                __m256i k = _mm256_loadu_si256((const __m256i *) &keys[i]); 
+                __m256i greater = _mm256_cmpgt_epi64(k, p); 
+
+                n += 4 - __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(greater))); 
+        }
+
+        for (; i < count; i++)
+                n += (intptr_t) keys[i] <= probe; 
+
+        return n; 
+}
+
+#endif
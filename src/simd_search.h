@@ -0,0 +1,83 @@
+/**********************************************************************
+ * simd_search.h                                                      *
+ *                                                                    *
+ * Interface for vectorized searches over short sorted arrays of      *
+ * integer keys, such as the key array of a single B+ tree node.      *
+ * the probe is compared against several keys per instruction and    *
+ * the comparison masks are counted, so the search has no data        *
+ * dependent branches. the kernel (AVX2, SSE2 or scalar) is chosen    *
+ * at run time from cpu_features.h                                    *
+ **********************************************************************/
+
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdint.h>
+#include "cpu_features.h"
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * simd_lower_bound
+ * 
+ * given count keys sorted in ascending order, each an integer stored in a 
+ * pointer sized slot, returns the index of the first key that is not less 
+ * than probe (count if there is none)
+ * 
+ * CREs         keys == NULL && count > 0
+ * UREs         keys not sorted
+ * 
+ * @param       void *const * - the keys, read as intptr_t
+ * @param       int - number of keys
+ * @param       intptr_t - value to locate
+ * @return      int - index in [0, count]
+ */
+int simd_lower_bound(void *const *keys, int count, intptr_t probe);
+
+/*
+ * simd_upper_bound
+ * 
+ * same as simd_lower_bound, but returns the index of the first key that is 
+ * greater than probe
+ * 
+ * CREs         keys == NULL && count > 0
+ * UREs         keys not sorted
+ * 
+ * @param       void *const * - the keys, read as intptr_t
+ * @param       int - number of keys
+ * @param       intptr_t - value to locate
+ * @return      int - index in [0, count]
+ */
+int simd_upper_bound(void *const *keys, int count, intptr_t probe);
+
+/*
+ * simd_search_level
+ * 
+ * returns the kernel level the searches above currently dispatch to. 
+ * defaults to cpu_simd_level()
+ * 
+ * @return      SIMD_Level - level in use
+ */
+SIMD_Level simd_search_level(void);
+
+/*
+ * simd_search_set_level
+ * 
+ * switches the searches to a narrower kernel, so that tests and benchmarks 
+ * can exercise and compare every level on one machine. requests beyond 
+ * what the CPU supports are clamped to cpu_simd_level()
+ * 
+ * CREs         n/a
+ * UREs         called while another thread is searching
+ * 
+ * @param       SIMD_Level - requested level
+ * @return      SIMD_Level - level actually in use afterwards
+ */
+SIMD_Level simd_search_set_level(SIMD_Level level);
+
+#endif
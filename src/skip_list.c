@@ -0,0 +1,319 @@
+#include "skip_list.h"
+#include "prng.h"
+#include <string.h>
+#include <stdint.h>
+
+/*** MACRO DEFINITIONS ***/
+
+/* enough lanes for 2^32 values at p = 1/2 */
+#define SKIP_MAX_LEVEL 32
+
+typedef struct Node {
+        void *value;
+        int height;             /* number of lanes this node is linked into */
+        uint32_t count;         /* occurrences of value, in a multiset */
+        struct Node *next[];    /* next[i] is the following node on lane i */
+} Node;
+
+struct skip_list {
+        Node *head;             /* sentinel with SKIP_MAX_LEVEL lanes and no value */
+        Compare compare;
+        int level;              /* lanes currently in use */
+        uint64_t prng_state;
+        bool multiset;
+};
+
+typedef SkipList_T T;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+Node *skip_construct_node(void *value, int height);
+
+/*
+ * private_skip_find_before
+ *
+ * walks down from the top lane to the bottom, stopping on each lane at the
+ * last node whose value is less than value (strict == true) or less than
+ * or equal to it (strict == false). those nodes are recorded in update,
+ * one per lane, if update is not NULL
+ *
+ * CREs         n/a
+ * UREs         n/a
+ *
+ * @param       T - list to search
+ * @param       void * - value to search for
+ * @param       bool - whether equal values count as before
+ * @param       Node ** - array of SKIP_MAX_LEVEL nodes to fill, or NULL
+ * @return      Node * - the node reached on the bottom lane (may be head)
+ */
+Node *private_skip_find_before(T tree, void *value, bool strict, Node **update);
+void private_skip_map_all(T tree,
+                          void func_to_apply(void *value, int depth, void *cl),
+                          void *cl);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T skip_new(void *comparison_func)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return skip_new_seeded_r(compare.func, compare.ctx, PRNG_DEFAULT_SEED); 
+}
+
+T skip_new_seeded(void *comparison_func, uint64_t seed)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return skip_new_seeded_r(compare.func, compare.ctx, seed); 
+}
+
+T skip_new_r(Comparator compare, void *ctx)
+{
+        return skip_new_seeded_r(compare, ctx, PRNG_DEFAULT_SEED); 
+}
+
+T skip_new_seeded_r(Comparator compare, void *ctx, uint64_t seed)
+{
+        assert(compare != NULL); 
+
+        T tree = malloc(sizeof(struct skip_list)); 
+
+        tree->head = skip_construct_node(NULL, SKIP_MAX_LEVEL); 
+        tree->level = 1; 
+        tree->prng_state = seed; 
+
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+        tree->multiset = false; 
+
+        return tree; 
+}
+
+T skip_new_multiset(Comparator compare, void *ctx)
+{
+        T tree = skip_new_r(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+void skip_free(T tree)
+{
+        assert(tree != NULL); 
+
+        Node *n = tree->head; 
+
+        while (n != NULL) {
+                Node *next = n->next[0]; 
+                free(n); 
+                n = next; 
+        }
+
+        free(tree); 
+}
+
+bool skip_is_empty(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->head->next[0] == NULL; 
+}
+
+Node *skip_construct_node(void *value, int height)
+{
+        Node *new_node = malloc(sizeof(Node) + height * sizeof(Node *)); 
+
+        new_node->value = value; 
+        new_node->height = height; 
+        new_node->count = 1; 
+
+        for (int i = 0; i < height; i++)
+                new_node->next[i] = NULL; 
+
+        return new_node; 
+}
+
+Node *private_skip_find_before(T tree, void *value, bool strict, Node **update)
+{
+        Compare compare = tree->compare; 
+        Node *curr_node = tree->head; 
+        int c; 
+
+        for (int i = tree->level - 1; i >= 0; i--) {
+                while (curr_node->next[i] != NULL) {
+                        c = compare.func(curr_node->next[i]->value, value, compare.ctx); 
+
+                        if (c > 0 || (strict && c == 0))
+                                break; 
+
+                        curr_node = curr_node->next[i]; 
+                }
+
+                if (update != NULL)
+                        update[i] = curr_node; 
+        }
+
+        return curr_node; 
+}
+
+int skip_insert_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *update[SKIP_MAX_LEVEL]; 
+
+        /* equal values go after the ones already present, as in the trees */
+        Node *last = private_skip_find_before(tree, value, false, update); 
+
+        if (tree->multiset && last != tree->head &&
+            tree->compare.func(value, last->value, tree->compare.ctx) == 0) {
+                last->count++; 
+                return 0; 
+        }
+
+        int height = 1 + (int) prng_geometric(&tree->prng_state); 
+        if (height > SKIP_MAX_LEVEL)
+                height = SKIP_MAX_LEVEL; 
+
+        while (tree->level < height)
+                update[tree->level++] = tree->head; 
+
+        Node *new_node = skip_construct_node(value, height); 
+
+        for (int i = 0; i < height; i++) {
+                new_node->next[i] = update[i]->next[i]; 
+                update[i]->next[i] = new_node; 
+        }
+
+        return 0; 
+}
+
+void *skip_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *n = private_skip_find_before(tree, value, true, NULL)->next[0]; 
+
+        if (n != NULL && compare.func(value, n->value, compare.ctx) == 0)
+                return n->value; 
+
+        return NULL; 
+}
+
+void skip_delete_value(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *update[SKIP_MAX_LEVEL]; 
+        Node *delete_me = private_skip_find_before(tree, value, true, update)->next[0]; 
+
+        if (delete_me == NULL ||
+            compare.func(value, delete_me->value, compare.ctx) != 0)
+                return; 
+
+        if (--delete_me->count > 0)
+                return; 
+
+        for (int i = 0; i < delete_me->height; i++)
+                update[i]->next[i] = delete_me->next[i]; 
+
+        free(delete_me); 
+
+        while (tree->level > 1 && tree->head->next[tree->level - 1] == NULL)
+                tree->level--; 
+}
+
+size_t skip_count(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *n = private_skip_find_before(tree, value, true, NULL)->next[0]; 
+        size_t count = 0; 
+
+        while (n != NULL && compare.func(value, n->value, compare.ctx) == 0) {
+                count += n->count; 
+                n = n->next[0]; 
+        }
+
+        return count; 
+}
+
+void *skip_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        Node *first = tree->head->next[0]; 
+
+        return (first == NULL) ? NULL : first->value; 
+}
+
+void *skip_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        Node *curr_node = tree->head; 
+
+        for (int i = tree->level - 1; i >= 0; i--) {
+                while (curr_node->next[i] != NULL)
+                        curr_node = curr_node->next[i]; 
+        }
+
+        return (curr_node == tree->head) ? NULL : curr_node->value; 
+}
+
+void *skip_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *n = private_skip_find_before(tree, value, false, NULL)->next[0]; 
+
+        return (n == NULL) ? NULL : n->value; 
+}
+
+void *skip_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *n = private_skip_find_before(tree, value, true, NULL); 
+
+        return (n == tree->head) ? NULL : n->value; 
+}
+
+void private_skip_map_all(T tree,
+                          void func_to_apply(void *value, int depth, void *cl),
+                          void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        for (Node *n = tree->head->next[0]; n != NULL; n = n->next[0])
+                func_to_apply(n->value, n->height - 1, cl); 
+}
+
+void skip_map_inorder(T tree,
+                      void func_to_apply(void *value, int depth, void *cl),
+                      void *cl)
+{
+        private_skip_map_all(tree, func_to_apply, cl); 
+}
+
+void skip_map_preorder(T tree,
+                       void func_to_apply(void *value, int depth, void *cl),
+                       void *cl)
+{
+        private_skip_map_all(tree, func_to_apply, cl); 
+}
+
+void skip_map_postorder(T tree,
+                        void func_to_apply(void *value, int depth, void *cl),
+                        void *cl)
+{
+        private_skip_map_all(tree, func_to_apply, cl); 
+}
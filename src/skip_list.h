@@ -0,0 +1,362 @@
+/**********************************************************************
+ * skip_list.h                                                        *
+ *                                                                    *
+ * Interface for a polymorphic skip list: a sorted linked list with   *
+ * randomly chosen express lanes, giving expected O(log n) search     *
+ * with no rebalancing. it offers the same ordered set operations as  *
+ * rb_tree.h and serves as the non-tree baseline in compare_bsts      *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "comparator.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct skip_list *SkipList_T;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * skip_new
+ * 
+ * returns a pointer to a new, empty skip list
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ *              
+ * 
+ * @param       void * - pointer to a comparison function. if NULL is passed 
+ *                              as argument, strcmp is assumed. 
+ *              
+ *              comparison_function
+ *              @param          item being inserted (val1)
+ *              @param          item from tree which we are comparing (val2)
+ *              @return         int 
+ *                               - zero (0) if val1 == val2
+ *                               - positive value (n > 0) if val1 > val2
+ *                               - negative value (n < 0) if val1 < val2
+ *        
+ * @return      pointer to empty skip_list
+ */
+SkipList_T skip_new(void *comparison_func); 
+
+/*
+ * skip_new_seeded
+ * 
+ * same as skip_new, but seeds the level generator explicitly. two skip 
+ * lists created with the same seed and fed the same operations have the 
+ * same shape, which keeps benchmark runs reproducible. skip_new uses 
+ * PRNG_DEFAULT_SEED
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ * 
+ * @param       void * - pointer to a comparison function (see skip_new)
+ * @param       uint64_t - seed for the level generator
+ * @return      pointer to empty skip list
+ */
+SkipList_T skip_new_seeded(void *comparison_func, uint64_t seed); 
+
+/*
+ * skip_new_r, skip_new_seeded_r
+ * 
+ * same as skip_new and skip_new_seeded, but take a typed comparator and a
+ * context that is passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @param       uint64_t - seed for the level generator (_seeded_r only)
+ * @return      pointer to empty skip_list
+ */
+SkipList_T skip_new_r(Comparator compare, void *ctx); 
+SkipList_T skip_new_seeded_r(Comparator compare, void *ctx, uint64_t seed); 
+
+/*
+ * skip_new_multiset
+ * 
+ * same as skip_new_r, but the skip list keeps a single node per distinct 
+ * value, with a count of its occurrences. inserting a value equal to one
+ * already in the skip list bumps that node's count (the pointer stored first
+ * is the one kept), and deleting it takes one off the count, only 
+ * unlinking the node once the count reaches zero. the maps visit each 
+ * distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty skip_list
+ */
+SkipList_T skip_new_multiset(Comparator compare, void *ctx); 
+
+/*
+ * skip_free
+ * 
+ * given a pointer to a skip list, deallocates the tree and all nodes
+ * contained within it
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - the tree to be freed
+ * @return      n/a
+ */
+void skip_free(SkipList_T tree); 
+
+/*
+ * skip_is_empty
+ * 
+ * returns true if the tree is empty, and false otherwise
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - tree to be checked if empty
+ * @return      bool - true if empty, false otherwise
+ */ 
+bool skip_is_empty(SkipList_T tree); 
+
+/*
+ * skip_insert_value
+ * 
+ * given a value (cast to void), inserts the value into the given tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * 
+ * UREs         system out of memory
+ *              attempting to pass in a value which cannot be compared with 
+ *                      your comparison function
+ * 
+ * @param       SkipList_T - tree in which to insert value
+ * @param       void * - a pointer to any item to be inserted
+ * @return      int - 0 on success
+ */
+int skip_insert_value(SkipList_T tree, void *value);
+
+/*
+ * skip_search
+ * 
+ * given a tree and a value to search for, returns a pointer to the stored 
+ * value, or NULL if the value is not found. If duplicates are in the tree, 
+ * returns the first one found
+ * 
+ * @param       SkipList_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *skip_search(SkipList_T tree, void *value); 
+
+/*
+ * skip_delete_value
+ * 
+ * given a value, deletes the first instance of it that is found in the tree
+ * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its node instead, and only
+ * deletes the node when that reaches zero
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - tree to find the value in
+ * @param       void * - pointer to the value to be deleted
+ * @return      n/a
+ */
+void skip_delete_value(SkipList_T tree, void *value); 
+
+/*
+ * skip_count
+ * 
+ * given a skip list and a value, returns how many times the value is stored:
+ * the count of its node in a multiset, or the number of equal nodes 
+ * otherwise. returns 0 if the value is not in the skip list
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t skip_count(SkipList_T tree, void *value); 
+
+/*
+ * skip_tree_minimum
+ * 
+ * given a tree, returns the minimum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - tree to be searched
+ * @return      void * - pointer to min value
+ */
+void *skip_tree_minimum(SkipList_T tree); 
+
+/*
+ * skip_tree_maximum
+ * 
+ * given a tree, returns the maximum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - tree to be searched
+ * @return      void * - pointer to max value
+ */
+void *skip_tree_maximum(SkipList_T tree); 
+
+/*
+ * skip_successor_of_value
+ * 
+ * given a tree and a value, returns the first successor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no successor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - tree to be searched
+ * @param       void * - value to find the successor of
+ * @return      void * - value of the successor
+ */
+void *skip_successor_of_value(SkipList_T tree, void *value); 
+
+/*
+ * skip_predecessor_of_value
+ * 
+ * given a tree and a value, returns the first predecessor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no predecessor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       SkipList_T - tree to be searched
+ * @param       void * - value to find the predecessor of
+ * @return      void * - value of the predecessor
+ */
+void *skip_predecessor_of_value(SkipList_T tree, void *value); 
+
+/*
+ * skip_map_inorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via an inorder walk
+ * depth is the highest express lane the value is linked into (0 for 
+ * values only on the bottom list)
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       SkipList_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void skip_map_inorder(SkipList_T tree, 
+                      void func_to_apply(void *value, int depth, void *cl), 
+                      void *cl); 
+
+/*
+ * skip_map_preorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a preorder walk
+ * a skip list has no tree shape to walk, so this visits values in sorted 
+ * order exactly like skip_map_inorder; it exists so the skip list can 
+ * stand in for the tree engines
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       SkipList_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void skip_map_preorder(SkipList_T tree, 
+                       void func_to_apply(void *value, int depth, void *cl), 
+                       void *cl); 
+
+/*
+ * skip_map_postorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a postorder walk
+ * a skip list has no tree shape to walk, so this visits values in sorted 
+ * order exactly like skip_map_inorder; it exists so the skip list can 
+ * stand in for the tree engines
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       SkipList_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void skip_map_postorder(SkipList_T tree, 
+                        void func_to_apply(void *value, int depth, void *cl), 
+                        void *cl); 
+
+#endif
@@ -1,78 +1,34 @@
-#include "splay_tree.h"
+#include "splay_tree_impl.h"
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
 #include <stdint.h>
 
-typedef struct Node {
-        void *value; 
-        struct Node *parent; 
-        struct Node *left; 
-        struct Node *right; 
-} Node; 
-
-struct splay_tree {
-        Node *root; 
-        void *comparison_func; 
-};
-
 /*********************
  * Private functions *
  *********************/
 
 void private_splay_deallocate_all_tree_nodes(Node *n); 
-Node *private_splay_insert_value(Node *root, Node *new_node, 
-                                 void *comparison_func(void *val1, void *val2));
+Node *private_splay_insert_value(Node *root, Node *new_node, Compare compare);
 Node *splay_construct_node(void *value);
-Node *private_splay_find_in_tree(Splay_T tree, void *value, 
-                                 void *comparison_func(void *val1, void *val2));
+Node *private_splay_find_in_tree(Splay_T tree, void *value, Compare compare);
+Node *private_splay_insert_unique(Splay_T tree, void *value, bool *inserted);
 void private_splay_transplant(Splay_T tree, Node *u, Node *v); 
 Node *private_splay_minimum(Node *x);
 Node *private_splay_maximum(Node *x); 
-Node *private_splay_successor_of_value(Splay_T tree, void *value, 
-                                 void *comparison_func(void *val1, void *val2));
-Node *private_splay_predecessor_of_value(Splay_T tree, void *value, 
-                                   void *comparison_func(void *val1, void *val2));
-
-/* 
- * rotate_left
- * 
- * given a tree and a node n, moves n's right child to be the child of n's 
- * parent, and makes n the child of its right child
- * 
- * CREs         n/a
- * UREs         n/a
- * 
- * @param       T - tree in which rotation is occuring
- * @param       Node * - pointer to the node to be rotated
- * @return      n/a
- */
-void splay_helper_rotate_left(Splay_T tree, Node *n); 
-
-/* 
- * splay_helper_rotate_right
- * 
- * given a tree and a node n, moves n's left child to be the child of n's 
- * parent, and makes n the child of its left child
- * 
- * CREs         n/a
- * UREs         n/a
- * 
- * @param       T - tree in which rotation is occuring
- * @param       Node * - pointer to the node to be rotated
- * @return      n/a
- */
-void splay_helper_rotate_right(Splay_T tree, Node *n); 
-
-void splay_to_root(Splay_T tree, Node *n); 
-void single_rotate(Splay_T tree, Node *n); 
-void double_rotate(Splay_T tree, Node *n); 
-void zig_left(Splay_T tree, Node *n); 
-void zig_right(Splay_T tree, Node *n); 
-void zig_zig_left(Splay_T tree, Node *n); 
-void zig_zag_left(Splay_T tree, Node *n); 
-void zig_zig_right(Splay_T tree, Node *n); 
-void zig_zag_right(Splay_T tree, Node *n); 
+Node *private_splay_next_inorder(Node *n); 
+Node *private_splay_successor_of_value(Splay_T tree, void *value, Compare compare);
+Node *private_splay_predecessor_of_value(Splay_T tree, void *value, Compare compare);
+Node *private_splay_lower_bound(Splay_T tree, void *value, Compare compare);
+size_t private_splay_rank(Splay_T tree, void *value, bool inclusive);
+size_t private_splay_size(Node *n);
+double private_splay_aggregate_of(Splay_T tree, Node *n);
+void private_splay_update(Splay_T tree, Node *n);
+void private_splay_augment_hook(Splay_T tree, Node *down, Node *up);
+double private_splay_aggregate_from(Splay_T tree, Node *n, void *lo, Node **last, 
+                                    size_t *depth);
+double private_splay_aggregate_upto(Splay_T tree, Node *n, void *hi, Node **last, 
+                                    size_t *depth);
 
 void splay_private_inorder_map(Node *root, 
                                int depth, 
@@ -95,15 +51,73 @@ void splay_private_postorder_map(Node *root,
 
 Splay_T splay_new(void *comparison_func)
 {
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return splay_new_r(compare.func, compare.ctx); 
+}
+
+Splay_T splay_new_r(Comparator compare, void *ctx)
+{
+        assert(compare != NULL); 
+
         Splay_T tree = malloc(sizeof(struct splay_tree)); 
 
         tree->root = NULL; 
+        tree->rotate_hook = NULL; 
+        tree->multiset = false; 
+        tree->ranked = false; 
+        tree->aggregated = false; 
 
-        if (comparison_func == NULL) {
-                tree->comparison_func = &strcmp; 
-        } else {
-                tree->comparison_func = comparison_func; 
-        }
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+
+        return tree; 
+}
+
+Splay_T splay_new_multiset(Comparator compare, void *ctx)
+{
+        Splay_T tree = splay_new_r(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+/*
+ * the sizes are kept by the rotate hook. a node linked as a new leaf 
+ * leaves the sizes of its ancestors one short, but every insert splays 
+ * the new node to the root, and each rotation on the way recomputes the 
+ * node it moves down from subtrees off that path, so all are right again
+ * once it gets there. aggregates are kept the same way
+ */
+Splay_T splay_new_ranked(Comparator compare, void *ctx)
+{
+        Splay_T tree = splay_new_r(compare, ctx); 
+
+        tree->ranked = true; 
+        tree->rotate_hook = private_splay_augment_hook; 
+
+        return tree; 
+}
+
+Splay_T splay_new_ranked_multiset(Comparator compare, void *ctx)
+{
+        Splay_T tree = splay_new_ranked(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+Splay_T splay_new_aggregated(Comparator compare, void *ctx, Monoid monoid)
+{
+        assert(monoid.measure != NULL && monoid.combine != NULL); 
+
+        Splay_T tree = splay_new_r(compare, ctx); 
+
+        tree->aggregated = true; 
+        tree->monoid = monoid; 
+        tree->rotate_hook = private_splay_augment_hook; 
 
         return tree; 
 }
@@ -151,6 +165,8 @@ void splay_helper_rotate_left(Splay_T tree, Node *n)
 
         right_child->left = n; 
         n->parent = right_child; 
+        if (tree->rotate_hook != NULL)
+                tree->rotate_hook(tree, n, right_child); 
 }
 
 void splay_helper_rotate_right(Splay_T tree, Node *n)
@@ -176,6 +192,8 @@ void splay_helper_rotate_right(Splay_T tree, Node *n)
 
         left_child->right = n; 
         n->parent = left_child; 
+        if (tree->rotate_hook != NULL)
+                tree->rotate_hook(tree, n, left_child); 
 }
 
 void splay_to_root(Splay_T tree, Node *n)
@@ -295,10 +313,23 @@ int splay_insert_value(Splay_T tree, void *value)
 {
         assert(tree != NULL && value != NULL); 
 
+        if (tree->multiset) {
+                bool inserted; 
+                Node *n = private_splay_insert_unique(tree, value, &inserted); 
+
+                /* n is the root now */
+                if (!inserted) {
+                        n->count++; 
+                        private_splay_update(tree, n); 
+                }
+                return 0; 
+        }
+
         Node *new_node = splay_construct_node(value); 
-        tree->root = private_splay_insert_value(tree->root, new_node, tree->comparison_func); 
+        tree->root = private_splay_insert_value(tree->root, new_node, tree->compare); 
 
         splay_to_root(tree, new_node); 
+        private_splay_update(tree, new_node); 
 
         return 0; 
 }
@@ -311,31 +342,95 @@ Node *splay_construct_node(void *value)
         new_node->left = NULL; 
         new_node->right = NULL; 
         new_node->value = value; 
+        new_node->count = 1; 
+        new_node->size = 1; 
+        new_node->aggregate = 0; 
 
         return new_node; 
 }
 
-Node *private_splay_insert_value(Node *root, Node *new_node, 
-                           void *comparison_func(void *val1, void *val2)) 
+Node *private_splay_insert_value(Node *root, Node *new_node, Compare compare) 
 {
         if (root == NULL) { 
                 return new_node; 
         }
 
-        if ((int)(intptr_t) comparison_func(new_node->value, root->value) < 0) {
-                root->left = private_splay_insert_value(root->left, new_node, comparison_func); 
+        if (compare.func(new_node->value, root->value, compare.ctx) < 0) {
+                root->left = private_splay_insert_value(root->left, new_node, compare); 
                 root->left->parent = root; 
         } else {
-                root->right = private_splay_insert_value(root->right, new_node, comparison_func); 
+                root->right = private_splay_insert_value(root->right, new_node, compare); 
                 root->right->parent = root; 
         }
 
         return root; 
 }
 
+void *splay_insert_unique(Splay_T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        bool inserted; 
+        Node *n = private_splay_insert_unique(tree, value, &inserted); 
+
+        return inserted ? NULL : n->value; 
+}
+
+void *splay_upsert(Splay_T tree, void *value, 
+                   void *merge(void *stored, void *value, void *cl), void *cl)
+{
+        assert(tree != NULL && value != NULL && merge != NULL); 
+
+        bool inserted; 
+        Node *n = private_splay_insert_unique(tree, value, &inserted); 
+
+        if (!inserted) {
+                n->value = merge(n->value, value, cl); 
+                private_splay_update(tree, n); 
+        }
+
+        return n->value; 
+}
+
+Node *private_splay_insert_unique(Splay_T tree, void *value, bool *inserted)
+{
+        Node *parent = NULL; 
+        Node *curr = tree->root; 
+        int c = 0; 
+
+        while (curr != NULL) {
+                c = tree->compare.func(value, curr->value, tree->compare.ctx); 
+
+                if (c == 0)
+                        break; 
+
+                parent = curr; 
+                curr = (c < 0) ? curr->left : curr->right; 
+        }
+
+        *inserted = (curr == NULL); 
+
+        if (curr == NULL) {
+                curr = splay_construct_node(value); 
+                curr->parent = parent; 
+
+                if (parent == NULL)
+                        tree->root = curr; 
+                else if (c < 0)
+                        parent->left = curr; 
+                else
+                        parent->right = curr; 
+        }
+
+        splay_to_root(tree, curr); 
+        private_splay_update(tree, curr); 
+
+        return curr; 
+}
+
 void *splay_search(Splay_T tree, void *value)
 {
-        Node *result = private_splay_find_in_tree(tree, value, tree->comparison_func); 
+        Node *result = private_splay_find_in_tree(tree, value, tree->compare); 
 
         if (result != NULL) {
                 splay_to_root(tree, result); 
@@ -345,15 +440,14 @@ void *splay_search(Splay_T tree, void *value)
         return result; //AKA return NULL 
 }
 
-Node *private_splay_find_in_tree(Splay_T tree, void *value, 
-                           void *comparison_func(void *val1, void *val2))
+Node *private_splay_find_in_tree(Splay_T tree, void *value, Compare compare)
 {
         bool found = false; 
         Node *curr = tree->root; 
         int c = 0; 
 
         while (!found && curr != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr->value); 
+                c = compare.func(value, curr->value, compare.ctx); 
 
                 if (c == 0) {
                         found = true; 
@@ -369,19 +463,26 @@ Node *private_splay_find_in_tree(Splay_T tree, void *value,
 
 void splay_delete_value(Splay_T tree, void *value)
 {
-        Node *z = private_splay_find_in_tree(tree, value, tree->comparison_func);
+        Node *z = private_splay_find_in_tree(tree, value, tree->compare);
 
         if (z == NULL)
                 return; 
         
         splay_to_root(tree, z); 
 
+        if (--z->count > 0) {
+                private_splay_update(tree, z); 
+                return; 
+        }
+
         if (z->left == NULL) {
                 private_splay_transplant(tree, z, z->right); 
         } else if (z->right == NULL) {
                 private_splay_transplant(tree, z, z->left);
         } else {
                 Node *y = private_splay_minimum(z->right); 
+                Node *changed = (y->parent == z) ? y : y->parent; 
+
                 if (y->parent != z) {
                         private_splay_transplant(tree, y, y->right); 
                         y->right = z->right; 
@@ -390,11 +491,310 @@ void splay_delete_value(Splay_T tree, void *value)
                 private_splay_transplant(tree, z, y); 
                 y->left = z->left; 
                 y->left->parent = y; 
+
+                /* y left a gap below z's old place, and took that place */
+                if (tree->ranked || tree->aggregated) {
+                        for (Node *n = changed; n != NULL; n = n->parent)
+                                private_splay_update(tree, n); 
+                }
         }
         
         free(z); 
 }
 
+Splay_T splay_split(Splay_T tree, void *key)
+{
+        assert(tree != NULL && key != NULL); 
+
+        Splay_T right = malloc(sizeof(struct splay_tree)); 
+        Compare compare = tree->compare; 
+        Node *curr = tree->root; 
+        Node *bound = NULL; 
+        Node *last = NULL; 
+
+        *right = *tree; 
+        right->root = NULL; 
+
+        while (curr != NULL) {
+                last = curr; 
+                if (compare.func(key, curr->value, compare.ctx) <= 0) {
+                        bound = curr; 
+                        curr = curr->left; 
+                } else {
+                        curr = curr->right; 
+                }
+        }
+
+        /* every value is less than key */
+        if (bound == NULL) {
+                if (last != NULL)
+                        splay_to_root(tree, last); 
+                return right; 
+        }
+
+        /* at the root, only bound's left subtree is less than key */
+        splay_to_root(tree, bound); 
+        tree->root = bound->left; 
+        if (tree->root != NULL)
+                tree->root->parent = NULL; 
+
+        bound->left = NULL; 
+        right->root = bound; 
+        private_splay_update(right, bound); 
+
+        return right; 
+}
+
+void splay_join(Splay_T left, Splay_T right)
+{
+        assert(left != NULL && right != NULL && left != right); 
+
+        if (right->root == NULL)
+                return; 
+
+        if (left->root == NULL) {
+                left->root = right->root; 
+                right->root = NULL; 
+                return; 
+        }
+
+        /* at the root, the maximum has no right subtree */
+        Node *max = private_splay_maximum(left->root); 
+
+        splay_to_root(left, max); 
+        max->right = right->root; 
+        max->right->parent = max; 
+        right->root = NULL; 
+        private_splay_update(left, max); 
+}
+
+size_t splay_count(Splay_T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Node *n = private_splay_lower_bound(tree, value, tree->compare); 
+        size_t count = 0; 
+
+        if (n == NULL || tree->compare.func(value, n->value, tree->compare.ctx) != 0)
+                return 0; 
+
+        splay_to_root(tree, n); 
+
+        while (n != NULL && tree->compare.func(value, n->value, tree->compare.ctx) == 0) {
+                count += n->count; 
+                n = private_splay_next_inorder(n); 
+        }
+
+        return count; 
+}
+
+Node *private_splay_lower_bound(Splay_T tree, void *value, Compare compare)
+{
+        Node *curr = tree->root; 
+        Node *bound = NULL; 
+
+        while (curr != NULL) {
+                if (compare.func(value, curr->value, compare.ctx) <= 0) {
+                        bound = curr; 
+                        curr = curr->left; 
+                } else {
+                        curr = curr->right; 
+                }
+        }
+
+        return bound; 
+}
+
+size_t splay_rank(Splay_T tree, void *value)
+{
+        assert(tree != NULL && value != NULL && tree->ranked); 
+
+        return private_splay_rank(tree, value, false); 
+}
+
+void *splay_select(Splay_T tree, size_t k)
+{
+        assert(tree != NULL && tree->ranked); 
+
+        Node *curr = tree->root; 
+        Node *last = NULL; 
+
+        while (curr != NULL) {
+                size_t left = private_splay_size(curr->left); 
+
+                last = curr; 
+                if (k < left) {
+                        curr = curr->left; 
+                } else if (k < left + curr->count) {
+                        break; 
+                } else {
+                        k -= left + curr->count; 
+                        curr = curr->right; 
+                }
+        }
+
+        if (last != NULL)
+                splay_to_root(tree, last); 
+
+        return (curr == NULL) ? NULL : curr->value; 
+}
+
+size_t splay_count_range(Splay_T tree, void *lo, void *hi)
+{
+        assert(tree != NULL && lo != NULL && hi != NULL && tree->ranked); 
+
+        if (tree->compare.func(lo, hi, tree->compare.ctx) > 0)
+                return 0; 
+
+        return private_splay_rank(tree, hi, true) - private_splay_rank(tree, lo, false); 
+}
+
+size_t private_splay_rank(Splay_T tree, void *value, bool inclusive)
+{
+        Node *curr = tree->root; 
+        Node *last = NULL; 
+        size_t rank = 0; 
+
+        while (curr != NULL) {
+                int c = tree->compare.func(value, curr->value, tree->compare.ctx); 
+
+                last = curr; 
+                if (c < 0 || (c == 0 && !inclusive)) {
+                        curr = curr->left; 
+                } else {
+                        rank += private_splay_size(curr->left) + curr->count; 
+                        curr = curr->right; 
+                }
+        }
+
+        /* splaying moves nodes around, but not their ranks */
+        if (last != NULL)
+                splay_to_root(tree, last); 
+
+        return rank; 
+}
+
+size_t private_splay_size(Node *n)
+{
+        return (n == NULL) ? 0 : n->size; 
+}
+
+double private_splay_aggregate_of(Splay_T tree, Node *n)
+{
+        return (n == NULL) ? tree->monoid.identity : n->aggregate; 
+}
+
+void private_splay_update(Splay_T tree, Node *n)
+{
+        if (tree->ranked)
+                n->size = n->count + private_splay_size(n->left) + private_splay_size(n->right); 
+
+        if (tree->aggregated) {
+                Monoid *m = &tree->monoid; 
+                double middle = m->measure(n->value, m->ctx); 
+
+                n->aggregate = m->combine(m->combine(private_splay_aggregate_of(tree, n->left), 
+                                                     middle, m->ctx), 
+                                          private_splay_aggregate_of(tree, n->right), m->ctx); 
+        }
+}
+
+void private_splay_augment_hook(Splay_T tree, Node *down, Node *up)
+{
+        private_splay_update(tree, down); 
+        private_splay_update(tree, up); 
+}
+
+double splay_aggregate_range(Splay_T tree, void *lo, void *hi)
+{
+        assert(tree != NULL && lo != NULL && hi != NULL && tree->aggregated); 
+
+        Monoid *m = &tree->monoid; 
+        Compare compare = tree->compare; 
+        Node *curr = tree->root; 
+        Node *last = NULL; 
+
+        /* down to the first node inside the range, where lo and hi part */
+        while (curr != NULL) {
+                last = curr; 
+                if (compare.func(lo, curr->value, compare.ctx) > 0)
+                        curr = curr->right; 
+                else if (compare.func(hi, curr->value, compare.ctx) < 0)
+                        curr = curr->left; 
+                else
+                        break; 
+        }
+
+        if (curr == NULL) {
+                if (last != NULL)
+                        splay_to_root(tree, last); 
+                return m->identity; 
+        }
+
+        Node *left_last = curr, *right_last = curr; 
+        size_t left_depth = 0, right_depth = 0; 
+        double left = private_splay_aggregate_from(tree, curr->left, lo, 
+                                                   &left_last, &left_depth); 
+        double right = private_splay_aggregate_upto(tree, curr->right, hi, 
+                                                    &right_last, &right_depth); 
+        double result = m->combine(m->combine(left, m->measure(curr->value, m->ctx), m->ctx), 
+                                   right, m->ctx); 
+
+        /* splaying moves nodes around, but leaves every aggregate right */
+        splay_to_root(tree, (left_depth > right_depth) ? left_last : right_last); 
+
+        return result; 
+}
+
+double private_splay_aggregate_from(Splay_T tree, Node *n, void *lo, Node **last, 
+                                    size_t *depth)
+{
+        Monoid *m = &tree->monoid; 
+        double result = m->identity; 
+
+        /* each node kept, with its right subtree, comes before those found later */
+        while (n != NULL) {
+                *last = n; 
+                (*depth)++; 
+                if (tree->compare.func(lo, n->value, tree->compare.ctx) <= 0) {
+                        double kept = m->combine(m->measure(n->value, m->ctx), 
+                                                 private_splay_aggregate_of(tree, n->right), 
+                                                 m->ctx); 
+
+                        result = m->combine(kept, result, m->ctx); 
+                        n = n->left; 
+                } else {
+                        n = n->right; 
+                }
+        }
+
+        return result; 
+}
+
+double private_splay_aggregate_upto(Splay_T tree, Node *n, void *hi, Node **last, 
+                                    size_t *depth)
+{
+        Monoid *m = &tree->monoid; 
+        double result = m->identity; 
+
+        /* each node kept, with its left subtree, comes after those found earlier */
+        while (n != NULL) {
+                *last = n; 
+                (*depth)++; 
+                if (tree->compare.func(hi, n->value, tree->compare.ctx) >= 0) {
+                        double kept = m->combine(private_splay_aggregate_of(tree, n->left), 
+                                                 m->measure(n->value, m->ctx), m->ctx); 
+
+                        result = m->combine(result, kept, m->ctx); 
+                        n = n->right; 
+                } else {
+                        n = n->left; 
+                }
+        }
+
+        return result; 
+}
+
 void private_splay_transplant(Splay_T tree, Node *u, Node *v)
 {
         if (u->parent == NULL) {
@@ -453,7 +853,7 @@ Node *private_splay_maximum(Node *x)
 
 void *splay_successor_of_value(Splay_T tree, void *value)
 {
-        Node *n = private_splay_successor_of_value(tree, value, tree->comparison_func); 
+        Node *n = private_splay_successor_of_value(tree, value, tree->compare); 
 
         if (n == NULL) {
                 return NULL; 
@@ -465,7 +865,7 @@ void *splay_successor_of_value(Splay_T tree, void *value)
 
 void *splay_predecessor_of_value(Splay_T tree, void *value)
 {
-        Node *n =  private_splay_predecessor_of_value(tree, value, tree->comparison_func); 
+        Node *n =  private_splay_predecessor_of_value(tree, value, tree->compare); 
         if (n == NULL) {
                 return NULL; 
         } else {
@@ -474,15 +874,14 @@ void *splay_predecessor_of_value(Splay_T tree, void *value)
         }
 } 
 
-Node *private_splay_successor_of_value(Splay_T tree, void *value, 
-                                 void *comparison_func(void *val1, void *val2))
+Node *private_splay_successor_of_value(Splay_T tree, void *value, Compare compare)
 {
         Node *curr_node = tree->root; 
         Node *successor = NULL; 
         int c; 
 
         while (curr_node != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr_node->value);
+                c = compare.func(value, curr_node->value, compare.ctx);
 
                 if (c < 0) {
                         successor = curr_node; 
@@ -495,15 +894,14 @@ Node *private_splay_successor_of_value(Splay_T tree, void *value,
         return successor; 
 }
 
-Node *private_splay_predecessor_of_value(Splay_T tree, void *value, 
-                                   void *comparison_func(void *val1, void *val2))
+Node *private_splay_predecessor_of_value(Splay_T tree, void *value, Compare compare)
 {
         Node *curr_node = tree->root; 
         Node *successor = NULL; 
         int c; 
 
         while (curr_node != NULL) {
-                c = (int)(intptr_t) comparison_func(value, curr_node->value);
+                c = compare.func(value, curr_node->value, compare.ctx);
                 if (c > 0) {
                         successor = curr_node; 
                         curr_node = curr_node->right; 
@@ -580,3 +978,68 @@ void splay_private_postorder_map(Node *root,
 
         func_to_apply(root->value, depth, cl); 
 }
+
+void splay_map_range(Splay_T tree, void *lo, void *hi, 
+                     bool func_to_apply(void *value, void *cl), void *cl)
+{
+        assert(tree != NULL && lo != NULL && hi != NULL && func_to_apply != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *n = private_splay_lower_bound(tree, lo, compare); 
+        Node *last = n; 
+
+        if (n == NULL)
+                return; 
+
+        /* the successor walk then starts from the root's right subtree */
+        splay_to_root(tree, n); 
+
+        while (n != NULL && compare.func(hi, n->value, compare.ctx) >= 0) {
+                last = n; 
+                if (!func_to_apply(n->value, cl))
+                        break; 
+                n = private_splay_next_inorder(n); 
+        }
+
+        splay_to_root(tree, last); 
+}
+
+Frozen_T splay_freeze(Splay_T tree, Frozen_Layout layout)
+{
+        assert(tree != NULL); 
+
+        size_t count = 0; 
+        Node *n; 
+
+        /* 
+         * walked through parent links rather than recursively: a splay tree 
+         * can be a path of length n, and freezing must not splay
+         */
+        for (n = (tree->root == NULL) ? NULL : private_splay_minimum(tree->root); 
+             n != NULL; n = private_splay_next_inorder(n))
+                count++; 
+
+        void **values = malloc((count > 0 ? count : 1) * sizeof(void *)); 
+        size_t i = 0; 
+
+        for (n = (tree->root == NULL) ? NULL : private_splay_minimum(tree->root); 
+             n != NULL; n = private_splay_next_inorder(n))
+                values[i++] = n->value; 
+
+        Frozen_T frozen = frozen_new_r(values, count, tree->compare.func, 
+                                       tree->compare.ctx, layout); 
+        free(values); 
+
+        return frozen; 
+}
+
+Node *private_splay_next_inorder(Node *n)
+{
+        if (n->right != NULL)
+                return private_splay_minimum(n->right); 
+
+        while (n->parent != NULL && n == n->parent->right)
+                n = n->parent; 
+
+        return n->parent; 
+}
@@ -4,6 +4,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include "comparator.h"
+#include "frozen_tree.h"
+#include "monoid.h"
 
 typedef struct splay_tree *Splay_T;
 
@@ -36,6 +39,97 @@ typedef struct splay_tree *Splay_T;
  */
 Splay_T splay_new(void *comparison_func); 
 
+/*
+ * splay_new_r
+ * 
+ * same as splay_new, but takes a typed comparator and a context that is
+ * passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty splay_tree
+ */
+Splay_T splay_new_r(Comparator compare, void *ctx); 
+
+/*
+ * splay_new_multiset
+ * 
+ * same as splay_new_r, but the tree keeps a single node per distinct value,
+ * with a count of its occurrences. inserting a value equal to one already
+ * in the tree bumps that node's count (the pointer stored first is the one
+ * kept), and deleting it takes one off the count, only unlinking the node
+ * once the count reaches zero. the maps visit each distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty splay_tree
+ */
+Splay_T splay_new_multiset(Comparator compare, void *ctx); 
+
+/*
+ * splay_new_ranked
+ * 
+ * same as splay_new_r, but every node also keeps the size of its subtree,
+ * recomputed on every rotation, so that splay_rank, splay_select and 
+ * splay_count_range answer in amortized O(log n) instead of a walk over 
+ * the whole tree. like searches, these queries splay the last node they
+ * reach
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty splay_tree
+ */
+Splay_T splay_new_ranked(Comparator compare, void *ctx); 
+
+/*
+ * splay_new_ranked_multiset
+ * 
+ * a multiset (see splay_new_multiset) whose nodes also keep the size of 
+ * their subtree (see splay_new_ranked). sizes count occurrences, so a value
+ * held three times takes three positions in splay_rank, splay_select and 
+ * splay_count_range, as it would in a ranked tree of three separate nodes
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty splay_tree
+ */
+Splay_T splay_new_ranked_multiset(Comparator compare, void *ctx); 
+
+/*
+ * splay_new_aggregated
+ * 
+ * same as splay_new_r, but every node also keeps the monoid's aggregate 
+ * of the values in its subtree, recomputed on every rotation, so that 
+ * splay_aggregate_range folds any range in amortized O(log n). the tree 
+ * is not a multiset
+ * 
+ * CREs         compare == NULL
+ *              monoid.measure == NULL
+ *              monoid.combine == NULL
+ * UREs         system out of memory
+ *              the measure of a stored value changes while it is stored
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @param       Monoid - the aggregate to keep (see monoid.h)
+ * @return      pointer to empty splay_tree
+ */
+Splay_T splay_new_aggregated(Comparator compare, void *ctx, Monoid monoid); 
+
 /*
  * splay_tree_free
  * 
@@ -86,6 +180,52 @@ void *splay_get_value_at_root(Splay_T tree);
  */
 int splay_insert_value(Splay_T tree, void *value);
 
+/*
+ * splay_insert_unique
+ * 
+ * given a tree and a value, inserts the value unless an equal value is 
+ * already stored, in which case that value is returned instead. finds 
+ * and inserts in a single descent, where calling splay_search and then 
+ * splay_insert_value takes two, and splays the equal or new node to the 
+ * root once. in a multiset, an equal value's count is not changed
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Splay_T - tree in which to insert value
+ * @param       void * - value to be inserted
+ * @return      void * - the equal value already stored, or NULL if value
+ *                      was inserted
+ */
+void *splay_insert_unique(Splay_T tree, void *value); 
+
+/*
+ * splay_upsert
+ * 
+ * same as splay_insert_unique, but when an equal value is already stored
+ * it is replaced with what merge returns for it, in the same descent
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ *              merge == NULL
+ * UREs         system out of memory
+ *              merge returns a value that is not equal to value
+ * 
+ * @param       Splay_T - tree in which to insert value
+ * @param       void * - value to be inserted
+ * @param       void * - function giving the value to store in place of an
+ *                      equal one
+ *              @param          the stored value
+ *              @param          the value being inserted
+ *              @param          the closure passed to splay_upsert
+ *              @return         the value to store
+ * @param       void * - closure passed to merge
+ * @return      void * - the value stored in the tree afterwards
+ */
+void *splay_upsert(Splay_T tree, void *value, 
+                   void *merge(void *stored, void *value, void *cl), void *cl); 
+
 /*
  * splay_search
  * 
@@ -104,6 +244,8 @@ void *splay_search(Splay_T tree, void *value);
  * 
  * given a value, deletes the first instance of it that is found in the tree
  * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its node instead, and only
+ * deletes the node when that reaches zero
  * 
  * CREs         tree == NULL
  * UREs         n/a
@@ -114,6 +256,141 @@ void *splay_search(Splay_T tree, void *value);
  */
 void splay_delete_value(Splay_T tree, void *value); 
 
+/*
+ * splay_split
+ * 
+ * given a tree and a key, moves every value not less than key into a new
+ * tree, built like the first (same comparator, context and modes), and 
+ * returns it; the values less than key stay. the least value not less 
+ * than key is splayed to the root, and it and its right subtree move, 
+ * in amortized O(log n)
+ * 
+ * CREs         tree == NULL
+ *              key == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Splay_T - tree to split
+ * @param       void * - the key to split at
+ * @return      Splay_T - new tree of the values not less than key, to be
+ *                      freed with splay_free
+ */
+Splay_T splay_split(Splay_T tree, void *key); 
+
+/*
+ * splay_join
+ * 
+ * given two trees built alike, where every value in left is less than 
+ * every value in right, moves every value of right into left in 
+ * amortized O(log n), leaving right empty. the maximum of left is 
+ * splayed to the root, and right becomes its right subtree
+ * 
+ * CREs         left == NULL
+ *              right == NULL
+ *              left == right
+ * UREs         a value in left is not less than a value in right
+ *              the trees were built with different comparators or modes
+ * 
+ * @param       Splay_T - tree to receive the values
+ * @param       Splay_T - tree to take them from, left empty
+ * @return      n/a
+ */
+void splay_join(Splay_T left, Splay_T right); 
+
+/*
+ * splay_count
+ * 
+ * given a tree and a value, returns how many times the value is stored:
+ * the count of its node in a multiset, or the number of equal nodes
+ * otherwise. returns 0 if the value is not in the tree. the first node
+ * holding the value is splayed to the root
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       Splay_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t splay_count(Splay_T tree, void *value); 
+
+/*
+ * splay_rank
+ * 
+ * given a ranked tree and a value, returns how many values stored in the
+ * tree are less than it: the position value has, or would have, in 
+ * sorted order, counting from 0
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ *              the tree was not built with splay_new_ranked
+ * UREs         n/a
+ * 
+ * @param       Splay_T - tree to be searched
+ * @param       void * - value to rank
+ * @return      size_t - number of smaller values
+ */
+size_t splay_rank(Splay_T tree, void *value); 
+
+/*
+ * splay_select
+ * 
+ * given a ranked tree and a position k, returns the value at position k
+ * in sorted order, counting from 0, so that splay_select(tree, 0) is the
+ * minimum. equal values take one position each
+ * 
+ * CREs         tree == NULL
+ *              the tree was not built with splay_new_ranked
+ * UREs         n/a
+ * 
+ * @param       Splay_T - tree to be searched
+ * @param       size_t - position of the value
+ * @return      void * - the value, or NULL if k is not less than the 
+ *                      number of values
+ */
+void *splay_select(Splay_T tree, size_t k); 
+
+/*
+ * splay_count_range
+ * 
+ * given a ranked tree and two bounds, returns how many values stored in
+ * the tree lie between them, both included
+ * 
+ * CREs         tree == NULL
+ *              lo == NULL
+ *              hi == NULL
+ *              the tree was not built with splay_new_ranked
+ * UREs         n/a
+ * 
+ * @param       Splay_T - tree to be searched
+ * @param       void * - the lower bound
+ * @param       void * - the upper bound
+ * @return      size_t - number of values v with lo <= v <= hi, 0 if 
+ *                      lo > hi
+ */
+size_t splay_count_range(Splay_T tree, void *lo, void *hi); 
+
+/*
+ * splay_aggregate_range
+ * 
+ * given an aggregated tree and two bounds, returns the tree's monoid 
+ * folded over the values stored between them, both included, in sorted
+ * order. splays the deepest node the query reaches
+ * 
+ * CREs         tree == NULL
+ *              lo == NULL
+ *              hi == NULL
+ *              the tree was not built with splay_new_aggregated
+ * UREs         n/a
+ * 
+ * @param       Splay_T - tree to be searched
+ * @param       void * - the lower bound
+ * @param       void * - the upper bound
+ * @return      double - the aggregate of the values v with lo <= v <= hi,
+ *                      the monoid's identity if there are none
+ */
+double splay_aggregate_range(Splay_T tree, void *lo, void *hi); 
+
 /*
  * splay_tree_minimum
  * 
@@ -261,4 +538,51 @@ void splay_map_postorder(Splay_T tree,
                       void func_to_apply(void *value, int depth, void *cl), 
                       void *cl); 
 
+/*
+ * splay_map_range
+ * 
+ * given a tree, two bounds and a pointer to a function, applies the 
+ * function to the values stored between the bounds, both included, in 
+ * sorted order, for as long as it returns true. the walk descends 
+ * straight to lo and stops at the first value past hi, so visiting k 
+ * values costs amortized O(log n + k) rather than a walk over the whole 
+ * tree. splays the first and the last value visited. in a multiset, each 
+ * distinct value is visited once
+ * 
+ * CREs         tree == NULL
+ *              lo == NULL
+ *              hi == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure
+ * 
+ * @param       Splay_T - tree to apply function to
+ * @param       void * - the lower bound
+ * @param       void * - the upper bound
+ * @param       void * - pointer to a function, returning false to stop 
+ *                      the walk
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void splay_map_range(Splay_T tree, void *lo, void *hi, 
+                     bool func_to_apply(void *value, void *cl), void *cl); 
+
+/*
+ * splay_freeze
+ * 
+ * given a tree, returns an immutable snapshot of its values laid out as an 
+ * implicit array (see frozen_tree.h). lookups on the snapshot return the 
+ * same void * values that splay_search would. the tree itself is left 
+ * unchanged and may keep being modified; the snapshot does not follow
+ * 
+ * CREs         tree == NULL
+ * UREs         system out of memory
+ *              the stored values are freed while the snapshot is in use
+ * 
+ * @param       Splay_T - tree to snapshot
+ * @param       Frozen_Layout - FROZEN_EYTZINGER or FROZEN_VEB
+ * @return      Frozen_T - the snapshot, to be released with frozen_free
+ */
+Frozen_T splay_freeze(Splay_T tree, Frozen_Layout layout); 
+
 #endif
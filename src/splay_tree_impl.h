@@ -0,0 +1,91 @@
+/****************************************************************
+ *
+ *                       splay_tree_impl.h
+ *
+ *       Representation of type Splay_T and its rotation
+ *       primitives, shared with engines that splay within
+ *       parts of a larger tree (multisplay_tree.c). Clients
+ *       use the opaque interface in splay_tree.h.
+ *
+ *****************************************************************/
+
+#ifndef SPLAY_TREE_IMPL_H
+#define SPLAY_TREE_IMPL_H
+
+#include <stdint.h>
+#include "splay_tree.h"
+
+typedef struct Node {
+        void *value;
+        struct Node *parent;
+        struct Node *left;
+        struct Node *right;
+        size_t size;            /* sum of the counts in the subtree, if ranked */
+        double aggregate;       /* monoid over the subtree, if aggregated */
+        uint32_t count;         /* occurrences of value, in a multiset */
+} Node;
+
+struct splay_tree {
+        Node *root;
+        Compare compare;
+        bool multiset;
+        bool ranked;
+        bool aggregated;
+        Monoid monoid;
+
+        /*
+         * called after every rotation with the node that moved down and the
+         * node that moved up, so that an embedding engine can keep per-node
+         * metadata current. NULL for a plain splay tree
+         */
+        void (*rotate_hook)(Splay_T tree, Node *down, Node *up);
+};
+
+/*
+ * splay_helper_rotate_left
+ *
+ * given a tree and a node n, moves n's right child to be the child of n's
+ * parent, and makes n the child of its right child
+ *
+ * CREs         n/a
+ * UREs         n/a
+ *
+ * @param       T - tree in which rotation is occuring
+ * @param       Node * - pointer to the node to be rotated
+ * @return      n/a
+ */
+void splay_helper_rotate_left(Splay_T tree, Node *n);
+
+/*
+ * splay_helper_rotate_right
+ *
+ * given a tree and a node n, moves n's left child to be the child of n's
+ * parent, and makes n the child of its left child
+ *
+ * CREs         n/a
+ * UREs         n/a
+ *
+ * @param       T - tree in which rotation is occuring
+ * @param       Node * - pointer to the node to be rotated
+ * @return      n/a
+ */
+void splay_helper_rotate_right(Splay_T tree, Node *n);
+
+/*
+ * single_rotate, double_rotate
+ *
+ * one zig, or one zig-zig / zig-zag step, moving n up past its parent, or
+ * past its parent and grandparent. n must have a parent (and a grandparent
+ * for double_rotate)
+ */
+void splay_to_root(Splay_T tree, Node *n);
+void single_rotate(Splay_T tree, Node *n);
+void double_rotate(Splay_T tree, Node *n);
+void zig_left(Splay_T tree, Node *n);
+void zig_right(Splay_T tree, Node *n);
+void zig_zig_left(Splay_T tree, Node *n);
+void zig_zag_left(Splay_T tree, Node *n);
+void zig_zig_right(Splay_T tree, Node *n);
+void zig_zag_right(Splay_T tree, Node *n);
+
+#endif
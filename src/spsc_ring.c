@@ -0,0 +1,101 @@
+#include "spsc_ring.h"
+
+/*** MACRO DEFINITIONS ***/
+
+#define SPSC_CACHE_LINE 64
+
+/*
+ * head counts the pops and tail the pushes, both running freely, so the
+ * ring holds tail - head items and slot i & mask is the next one. each
+ * index sits on its own cache line, as do the copies each side keeps of
+ * the other's index, so the threads only share a line when one of them
+ * has to refresh its copy
+ */
+struct spsc_ring {
+        size_t head;
+        size_t cached_tail;     /* consumer's copy of tail */
+        char pad_consumer[SPSC_CACHE_LINE - 2 * sizeof(size_t)];
+        size_t tail;
+        size_t cached_head;     /* producer's copy of head */
+        char pad_producer[SPSC_CACHE_LINE - 2 * sizeof(size_t)];
+        size_t mask;
+        void **slots;
+};
+
+typedef SPSC_Ring_T T;
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+T spsc_new(size_t capacity)
+{
+        assert(capacity > 0); 
+
+        size_t size = 1; 
+
+        while (size < capacity) 
+                size *= 2; 
+
+        T ring = malloc(sizeof(struct spsc_ring)); 
+
+        ring->head = 0; 
+        ring->cached_tail = 0; 
+        ring->tail = 0; 
+        ring->cached_head = 0; 
+        ring->mask = size - 1; 
+        ring->slots = malloc(size * sizeof(void *)); 
+
+        return ring; 
+}
+
+void spsc_free(T ring)
+{
+        assert(ring != NULL); 
+
+        free(ring->slots); 
+        free(ring); 
+}
+
+bool spsc_push(T ring, void *item)
+{
+        assert(ring != NULL); 
+
+        size_t tail = ring->tail; 
+
+        if (tail - ring->cached_head > ring->mask) {
+                ring->cached_head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE); 
+                if (tail - ring->cached_head > ring->mask)
+                        return false; 
+        }
+
+        ring->slots[tail & ring->mask] = item; 
+        __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE); 
+
+        return true; 
+}
+
+bool spsc_pop(T ring, void **item)
+{
+        assert(ring != NULL && item != NULL); 
+
+        size_t head = ring->head; 
+
+        if (head == ring->cached_tail) {
+                ring->cached_tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE); 
+                if (head == ring->cached_tail)
+                        return false; 
+        }
+
+        *item = ring->slots[head & ring->mask]; 
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE); 
+
+        return true; 
+}
+
+size_t spsc_capacity(T ring)
+{
+        assert(ring != NULL); 
+
+        return ring->mask + 1; 
+}
@@ -0,0 +1,106 @@
+/**********************************************************************
+ * spsc_ring.h                                                        *
+ *                                                                    *
+ * Interface for a bounded, lock-free ring buffer of pointers between *
+ * exactly one producer thread and one consumer thread. each side     *
+ * owns one index and only reads the other's, so a push or a pop is   *
+ * a plain store published with release ordering, with no locks and   *
+ * no read-modify-write instructions. built on the GCC/Clang          *
+ * __atomic builtins, as C99 has no atomics                           *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct spsc_ring *SPSC_Ring_T;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * spsc_new
+ *
+ * returns a pointer to a new, empty ring that holds up to capacity
+ * items, rounded up to a power of two
+ *
+ * CREs         capacity == 0
+ * UREs         system out of memory
+ *
+ * @param       size_t - minimum number of items the ring can hold
+ * @return      pointer to the new spsc_ring
+ */
+SPSC_Ring_T spsc_new(size_t capacity);
+
+/*
+ * spsc_free
+ *
+ * deallocates the ring. items still in it are not freed
+ *
+ * CREs         ring == NULL
+ * UREs         either thread still uses the ring
+ *
+ * @param       SPSC_Ring_T - the ring to be freed
+ * @return      n/a
+ */
+void spsc_free(SPSC_Ring_T ring);
+
+/*
+ * spsc_push
+ *
+ * appends an item if the ring is not full. never blocks. called by the
+ * producer only
+ *
+ * CREs         ring == NULL
+ * UREs         called from more than one thread
+ *
+ * @param       SPSC_Ring_T - the ring
+ * @param       void * - the item, which may be NULL
+ * @return      bool - false if the ring was full and nothing was pushed
+ */
+bool spsc_push(SPSC_Ring_T ring, void *item);
+
+/*
+ * spsc_pop
+ *
+ * removes the oldest item into *item if the ring is not empty. never
+ * blocks. called by the consumer only
+ *
+ * CREs         ring == NULL
+ *              item == NULL
+ * UREs         called from more than one thread
+ *
+ * @param       SPSC_Ring_T - the ring
+ * @param       void ** - where to store the item
+ * @return      bool - false if the ring was empty
+ */
+bool spsc_pop(SPSC_Ring_T ring, void **item);
+
+/*
+ * spsc_capacity
+ *
+ * returns the number of items the ring can hold
+ *
+ * CREs         ring == NULL
+ * UREs         n/a
+ *
+ * @param       SPSC_Ring_T - the ring
+ * @return      size_t - capacity, a power of two
+ */
+size_t spsc_capacity(SPSC_Ring_T ring);
+
+#endif
@@ -0,0 +1,510 @@
+#include "treap.h"
+#include "prng.h"
+#include <string.h>
+#include <stdint.h>
+
+typedef struct Node {
+        void *value; 
+        struct Node *left; 
+        struct Node *right; 
+        uint64_t priority; 
+        uint32_t count;         /* occurrences of value, in a multiset */
+} Node; 
+
+struct treap {
+        Node *root; 
+        Compare compare; 
+        uint64_t prng_state; 
+        bool multiset; 
+};
+
+typedef Treap_T T; 
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/ 
+
+void private_treap_deallocate_all_tree_nodes(Node *n); 
+Node *treap_construct_node(T tree, void *value); 
+
+/*
+ * treap_rotate_left
+ * 
+ * given the root n of a subtree, makes n's right child the root of the 
+ * subtree and n its left child. treap nodes keep no parent pointers, so 
+ * the new subtree root is returned for the caller to relink
+ * 
+ * @param       Node * - root of the subtree to rotate
+ * @return      Node * - new root of the subtree
+ */
+Node *treap_rotate_left(Node *n); 
+
+/*
+ * treap_rotate_right
+ * 
+ * mirror image of treap_rotate_left
+ * 
+ * @param       Node * - root of the subtree to rotate
+ * @return      Node * - new root of the subtree
+ */
+Node *treap_rotate_right(Node *n); 
+
+/*
+ * private_treap_insert_value
+ * 
+ * inserts new_node as a leaf below root (equal values go right, as in the 
+ * other engines), then rotates it up on the way back out of the recursion 
+ * for as long as its priority beats its parent's
+ * 
+ * @param       Node * - root of the current subtree
+ * @param       Node * - node to insert
+ * @param       Compare - comparator of the tree
+ * @return      Node * - new root of the subtree
+ */
+Node *private_treap_insert_value(Node *root, Node *new_node, Compare compare);
+
+/*
+ * private_treap_delete_value
+ * 
+ * removes the first node found holding value from the subtree rooted at 
+ * root, rotating it down towards a leaf by its children's priorities
+ * 
+ * @param       Node * - root of the current subtree
+ * @param       void * - value to delete
+ * @param       Compare - comparator of the tree
+ * @return      Node * - new root of the subtree
+ */
+Node *private_treap_delete_value(Node *root, void *value, Compare compare);
+Node *private_treap_remove_root(Node *root); 
+Node *private_treap_find_in_tree(T tree, void *value, Compare compare);
+
+/*
+ * private_treap_count
+ * 
+ * sums the counts of the nodes equal to value in the subtree rooted at 
+ * root. rotations can leave equal values on both sides of one another, 
+ * so both children of an equal node are searched
+ * 
+ * @param       Node * - root of the current subtree
+ * @param       void * - value to count
+ * @param       Compare - comparator of the tree
+ * @return      size_t - number of occurrences of value
+ */
+size_t private_treap_count(Node *root, void *value, Compare compare);
+Node *private_treap_minimum(Node *x);
+Node *private_treap_maximum(Node *x); 
+void private_treap_map_inorder(Node *root, 
+                               int depth, 
+                               void func_to_apply(void *value, int depth, void *cl), 
+                               void *cl);
+void private_treap_map_preorder(Node *root, 
+                                int depth, 
+                                void func_to_apply(void *value, int depth, void *cl), 
+                                void *cl);
+void private_treap_map_postorder(Node *root, 
+                                 int depth, 
+                                 void func_to_apply(void *value, int depth, void *cl), 
+                                 void *cl);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/ 
+
+T treap_new(void *comparison_func)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return treap_new_seeded_r(compare.func, compare.ctx, PRNG_DEFAULT_SEED); 
+}
+
+T treap_new_seeded(void *comparison_func, uint64_t seed)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return treap_new_seeded_r(compare.func, compare.ctx, seed); 
+}
+
+T treap_new_r(Comparator compare, void *ctx)
+{
+        return treap_new_seeded_r(compare, ctx, PRNG_DEFAULT_SEED); 
+}
+
+T treap_new_seeded_r(Comparator compare, void *ctx, uint64_t seed)
+{
+        assert(compare != NULL); 
+
+        T tree = malloc(sizeof(struct treap)); 
+
+        tree->root = NULL; 
+        tree->prng_state = seed; 
+
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+        tree->multiset = false; 
+
+        return tree; 
+}
+
+T treap_new_multiset(Comparator compare, void *ctx)
+{
+        T tree = treap_new_r(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+void treap_free(T tree)
+{
+        assert(tree != NULL);
+
+        private_treap_deallocate_all_tree_nodes(tree->root); 
+        free(tree); 
+}
+
+void private_treap_deallocate_all_tree_nodes(Node *n) 
+{
+        if (n == NULL)
+                return; 
+
+        private_treap_deallocate_all_tree_nodes(n->left);
+        private_treap_deallocate_all_tree_nodes(n->right); 
+
+        free(n); 
+}
+
+bool treap_is_empty(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->root == NULL;
+}
+
+Node *treap_rotate_left(Node *n)
+{
+        Node *right_child = n->right; 
+
+        n->right = right_child->left; 
+        right_child->left = n; 
+
+        return right_child; 
+}
+
+Node *treap_rotate_right(Node *n)
+{
+        Node *left_child = n->left; 
+
+        n->left = left_child->right; 
+        left_child->right = n; 
+
+        return left_child; 
+}
+
+int treap_insert_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        if (tree->multiset) {
+                Node *n = private_treap_find_in_tree(tree, value, tree->compare); 
+
+                if (n != NULL) {
+                        n->count++; 
+                        return 0; 
+                }
+        }
+
+        Node *new_node = treap_construct_node(tree, value); 
+        tree->root = private_treap_insert_value(tree->root, new_node, 
+                                                tree->compare); 
+
+        return 0; 
+}
+
+Node *treap_construct_node(T tree, void *value)
+{
+        Node *new_node = (Node *) malloc(sizeof(Node)); 
+
+        new_node->left = NULL; 
+        new_node->right = NULL; 
+        new_node->value = value; 
+        new_node->priority = prng_next(&tree->prng_state); 
+        new_node->count = 1; 
+
+        return new_node; 
+}
+
+Node *private_treap_insert_value(Node *root, Node *new_node, Compare compare) 
+{
+        if (root == NULL) 
+                return new_node; 
+
+        if (compare.func(new_node->value, root->value, compare.ctx) < 0) {
+                root->left = private_treap_insert_value(root->left, new_node, 
+                                                        compare); 
+                if (root->left->priority > root->priority)
+                        root = treap_rotate_right(root); 
+        } else {
+                root->right = private_treap_insert_value(root->right, new_node, 
+                                                         compare); 
+                if (root->right->priority > root->priority)
+                        root = treap_rotate_left(root); 
+        }
+
+        return root; 
+}
+
+void *treap_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Node *result = private_treap_find_in_tree(tree, value, tree->compare); 
+
+        if (result != NULL) 
+                return result->value; 
+
+        return NULL; 
+}
+
+Node *private_treap_find_in_tree(T tree, void *value, Compare compare)
+{
+        Node *curr = tree->root; 
+        int c; 
+
+        while (curr != NULL) {
+                c = compare.func(value, curr->value, compare.ctx); 
+
+                if (c == 0) 
+                        return curr; 
+                else if (c < 0) 
+                        curr = curr->left; 
+                else 
+                        curr = curr->right; 
+        }
+
+        return NULL; 
+}
+
+void treap_delete_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        tree->root = private_treap_delete_value(tree->root, value, 
+                                                tree->compare); 
+}
+
+Node *private_treap_delete_value(Node *root, void *value, Compare compare)
+{
+        if (root == NULL)
+                return NULL; 
+
+        int c = compare.func(value, root->value, compare.ctx); 
+
+        if (c < 0) 
+                root->left = private_treap_delete_value(root->left, value, 
+                                                        compare); 
+        else if (c > 0) 
+                root->right = private_treap_delete_value(root->right, value, 
+                                                         compare); 
+        else if (--root->count == 0) 
+                root = private_treap_remove_root(root); 
+
+        return root; 
+}
+
+size_t treap_count(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        return private_treap_count(tree->root, value, tree->compare); 
+}
+
+size_t private_treap_count(Node *root, void *value, Compare compare)
+{
+        if (root == NULL)
+                return 0; 
+
+        int c = compare.func(value, root->value, compare.ctx); 
+
+        if (c < 0) 
+                return private_treap_count(root->left, value, compare); 
+        else if (c > 0) 
+                return private_treap_count(root->right, value, compare); 
+
+        return root->count + private_treap_count(root->left, value, compare) 
+                           + private_treap_count(root->right, value, compare); 
+}
+
+Node *private_treap_remove_root(Node *root)
+{
+        Node *new_root; 
+
+        if (root->left == NULL) {
+                new_root = root->right; 
+                free(root); 
+                return new_root; 
+        }
+
+        if (root->right == NULL) {
+                new_root = root->left; 
+                free(root); 
+                return new_root; 
+        }
+
+        if (root->left->priority > root->right->priority) {
+                new_root = treap_rotate_right(root); 
+                new_root->right = private_treap_remove_root(root); 
+        } else {
+                new_root = treap_rotate_left(root); 
+                new_root->left = private_treap_remove_root(root); 
+        }
+
+        return new_root; 
+}
+
+void *treap_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        return private_treap_minimum(tree->root)->value; 
+}
+
+void *treap_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        return private_treap_maximum(tree->root)->value; 
+}
+
+Node *private_treap_minimum(Node *x) 
+{
+        while (x->left != NULL) 
+                x = x->left; 
+
+        return x; 
+}
+
+Node *private_treap_maximum(Node *x) 
+{
+        while (x->right != NULL) 
+                x = x->right; 
+
+        return x; 
+}
+
+void *treap_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *curr_node = tree->root; 
+        Node *successor = NULL; 
+
+        while (curr_node != NULL) {
+                if (compare.func(value, curr_node->value, compare.ctx) < 0) {
+                        successor = curr_node; 
+                        curr_node = curr_node->left; 
+                } else {
+                        curr_node = curr_node->right; 
+                }
+        }
+
+        if (successor == NULL) 
+                return NULL; 
+        else
+                return successor->value; 
+}
+
+void *treap_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *curr_node = tree->root; 
+        Node *predecessor = NULL; 
+
+        while (curr_node != NULL) {
+                if (compare.func(value, curr_node->value, compare.ctx) > 0) {
+                        predecessor = curr_node; 
+                        curr_node = curr_node->right; 
+                } else {
+                        curr_node = curr_node->left; 
+                }
+        }
+
+        if (predecessor == NULL) 
+                return NULL; 
+        else
+                return predecessor->value; 
+}
+
+void treap_map_inorder(T tree, 
+                       void func_to_apply(void *value, int depth, void *cl), 
+                       void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_treap_map_inorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_treap_map_inorder(Node *root, 
+                               int depth, 
+                               void func_to_apply(void *value, int depth, void *cl), 
+                               void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        private_treap_map_inorder(root->left, depth + 1, func_to_apply, cl); 
+        func_to_apply(root->value, depth, cl); 
+        private_treap_map_inorder(root->right, depth + 1, func_to_apply, cl); 
+}
+
+void treap_map_preorder(T tree, 
+                        void func_to_apply(void *value, int depth, void *cl), 
+                        void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_treap_map_preorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_treap_map_preorder(Node *root, 
+                                int depth, 
+                                void func_to_apply(void *value, int depth, void *cl), 
+                                void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        func_to_apply(root->value, depth, cl); 
+        private_treap_map_preorder(root->left, depth + 1, func_to_apply, cl); 
+        private_treap_map_preorder(root->right, depth + 1, func_to_apply, cl); 
+}
+
+void treap_map_postorder(T tree, 
+                         void func_to_apply(void *value, int depth, void *cl), 
+                         void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_treap_map_postorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_treap_map_postorder(Node *root, 
+                                 int depth, 
+                                 void func_to_apply(void *value, int depth, void *cl), 
+                                 void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        private_treap_map_postorder(root->left, depth + 1, func_to_apply, cl); 
+        private_treap_map_postorder(root->right, depth + 1, func_to_apply, cl); 
+        func_to_apply(root->value, depth, cl); 
+}
@@ -0,0 +1,776 @@
+/**********************************************************************
+ * typed_tree.h                                                       *
+ *                                                                    *
+ * Macro templates that generate basic, splay and red-black trees     *
+ * specialized for one key type. keys are stored inline in the nodes  *
+ * and compared with a macro, so a search step costs neither an       *
+ * indirect call nor a dereference of the stored value. typed_trees.h *
+ * instantiates them for int64_t, uint32_t and double                 *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef TYPED_TREE_H
+#define TYPED_TREE_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+/*
+ * TYPED_COMPARE
+ *
+ * three-way comparison of two arithmetic keys, usable as the compare
+ * argument of the generators below. a compare macro takes two keys and
+ * returns an int that is negative, zero or positive, like strcmp
+ */
+#define TYPED_COMPARE(a, b) (((a) > (b)) - ((a) < (b)))
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * TYPED_TREE_DECLARE(Type, prefix, key_t)
+ *
+ * declares the handle Type and the functions below for a tree generated
+ * with one of the TYPED_*_GENERATE macros under the same prefix. they
+ * follow the contracts of the void * engines, with a key_t in place of
+ * the value pointer; pointers returned to stored keys stay valid until
+ * that key is deleted
+ *
+ * prefix_new                   empty tree
+ * prefix_free                  deallocates the tree
+ * prefix_is_empty              true if the tree holds no keys
+ * prefix_insert_value          inserts key; duplicates are kept. returns 0
+ * prefix_search                stored key equal to key, or NULL
+ * prefix_delete_value          deletes one instance of key, if present
+ * prefix_tree_minimum,
+ * prefix_tree_maximum          least / greatest key, or NULL if empty
+ * prefix_successor_of_value,
+ * prefix_predecessor_of_value  least key greater than key / greatest key
+ *                              less than key, or NULL. key need not be
+ *                              in the tree
+ * prefix_map_inorder           applies func_to_apply to every key with its
+ *                              depth, in ascending order
+ *
+ * CREs         tree == NULL, func_to_apply == NULL
+ * UREs         system out of memory
+ *              keys that compare unordered, such as NaN
+ */
+#define TYPED_TREE_DECLARE(Type, prefix, key_t)                                 \
+typedef struct prefix *Type;                                                    \
+Type prefix##_new(void);                                                        \
+void prefix##_free(Type tree);                                                  \
+bool prefix##_is_empty(Type tree);                                              \
+int prefix##_insert_value(Type tree, key_t key);                                \
+const key_t *prefix##_search(Type tree, key_t key);                             \
+void prefix##_delete_value(Type tree, key_t key);                               \
+const key_t *prefix##_tree_minimum(Type tree);                                  \
+const key_t *prefix##_tree_maximum(Type tree);                                  \
+const key_t *prefix##_successor_of_value(Type tree, key_t key);                 \
+const key_t *prefix##_predecessor_of_value(Type tree, key_t key);               \
+void prefix##_map_inorder(Type tree,                                            \
+                          void func_to_apply(key_t key, int depth, void *cl),   \
+                          void *cl);
+
+/*
+ * TYPED_BST_GENERATE(Type, prefix, key_t, compare)
+ *
+ * defines an unbalanced binary search tree, like basic_bst.c
+ */
+#define TYPED_BST_GENERATE(Type, prefix, key_t, compare)                        \
+struct prefix##_node {                                                          \
+        key_t key;                                                              \
+        struct prefix##_node *left;                                             \
+        struct prefix##_node *right;                                            \
+};                                                                              \
+struct prefix {                                                                 \
+        struct prefix##_node *root;                                             \
+};                                                                              \
+TYPED_TREE_PRIVATE_COMMON(Type, prefix, key_t, compare)                         \
+                                                                                \
+int prefix##_insert_value(Type tree, key_t key)                                 \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node **link = &tree->root;                              \
+                                                                                \
+        while (*link != NULL)                                                   \
+                link = (compare(key, (*link)->key) < 0) ? &(*link)->left        \
+                                                        : &(*link)->right;      \
+                                                                                \
+        *link = private_##prefix##_construct_node(key);                         \
+                                                                                \
+        return 0;                                                               \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_search(Type tree, key_t key)                              \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *n = private_##prefix##_find(tree->root, key);     \
+                                                                                \
+        return (n == NULL) ? NULL : &n->key;                                    \
+}                                                                               \
+                                                                                \
+void prefix##_delete_value(Type tree, key_t key)                                \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node **link = &tree->root;                              \
+        int c;                                                                  \
+                                                                                \
+        while (*link != NULL && (c = compare(key, (*link)->key)) != 0)          \
+                link = (c < 0) ? &(*link)->left : &(*link)->right;              \
+                                                                                \
+        struct prefix##_node *n = *link;                                        \
+                                                                                \
+        if (n == NULL)                                                          \
+                return;                                                         \
+                                                                                \
+        if (n->left == NULL || n->right == NULL) {                              \
+                *link = (n->left != NULL) ? n->left : n->right;                 \
+                free(n);                                                        \
+                return;                                                         \
+        }                                                                       \
+                                                                                \
+        /* two children: unlink the successor and move its node into n's */    \
+        /* place, so pointers to the successor's key stay valid           */    \
+        struct prefix##_node **successor = &n->right;                           \
+                                                                                \
+        while ((*successor)->left != NULL)                                      \
+                successor = &(*successor)->left;                                \
+                                                                                \
+        struct prefix##_node *s = *successor;                                   \
+                                                                                \
+        *successor = s->right;                                                  \
+        s->left = n->left;                                                      \
+        s->right = n->right;                                                    \
+        *link = s;                                                              \
+        free(n);                                                                \
+}                                                                               \
+                                                                                \
+TYPED_TREE_PLAIN_NEIGHBOURS(Type, prefix, key_t)
+
+/*
+ * TYPED_SPLAY_GENERATE(Type, prefix, key_t, compare)
+ *
+ * defines a splay tree. like splay_tree.c, searches, successor and
+ * predecessor queries splay the node they return, but the splaying is
+ * done top-down, so nodes need no parent pointer
+ */
+#define TYPED_SPLAY_GENERATE(Type, prefix, key_t, compare)                      \
+struct prefix##_node {                                                          \
+        key_t key;                                                              \
+        struct prefix##_node *left;                                             \
+        struct prefix##_node *right;                                            \
+};                                                                              \
+struct prefix {                                                                 \
+        struct prefix##_node *root;                                             \
+};                                                                              \
+TYPED_TREE_PRIVATE_COMMON(Type, prefix, key_t, compare)                         \
+                                                                                \
+/* Sleator's top-down splay: brings key, or the last node on its path, up */    \
+struct prefix##_node *private_##prefix##_splay(struct prefix##_node *t,         \
+                                               key_t key)                       \
+{                                                                               \
+        struct prefix##_node header;                                            \
+        struct prefix##_node *l = &header;                                      \
+        struct prefix##_node *r = &header;                                      \
+        struct prefix##_node *y;                                                \
+                                                                                \
+        if (t == NULL)                                                          \
+                return NULL;                                                    \
+                                                                                \
+        header.left = header.right = NULL;                                      \
+                                                                                \
+        for (;;) {                                                              \
+                int c = compare(key, t->key);                                   \
+                                                                                \
+                if (c < 0) {                                                    \
+                        if (t->left == NULL)                                    \
+                                break;                                          \
+                        if (compare(key, t->left->key) < 0) {                   \
+                                y = t->left;                                    \
+                                t->left = y->right;                             \
+                                y->right = t;                                   \
+                                t = y;                                          \
+                                if (t->left == NULL)                            \
+                                        break;                                  \
+                        }                                                       \
+                        r->left = t;                                            \
+                        r = t;                                                  \
+                        t = t->left;                                            \
+                } else if (c > 0) {                                             \
+                        if (t->right == NULL)                                   \
+                                break;                                          \
+                        if (compare(key, t->right->key) > 0) {                  \
+                                y = t->right;                                   \
+                                t->right = y->left;                             \
+                                y->left = t;                                    \
+                                t = y;                                          \
+                                if (t->right == NULL)                           \
+                                        break;                                  \
+                        }                                                       \
+                        l->right = t;                                           \
+                        l = t;                                                  \
+                        t = t->right;                                           \
+                } else {                                                        \
+                        break;                                                  \
+                }                                                               \
+        }                                                                       \
+                                                                                \
+        l->right = t->left;                                                     \
+        r->left = t->right;                                                     \
+        t->left = header.right;                                                 \
+        t->right = header.left;                                                 \
+                                                                                \
+        return t;                                                               \
+}                                                                               \
+                                                                                \
+int prefix##_insert_value(Type tree, key_t key)                                 \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *n = private_##prefix##_construct_node(key);       \
+        struct prefix##_node *t = private_##prefix##_splay(tree->root, key);    \
+                                                                                \
+        if (t != NULL && compare(key, t->key) < 0) {                            \
+                n->left = t->left;                                              \
+                n->right = t;                                                   \
+                t->left = NULL;                                                 \
+        } else if (t != NULL) {                                                 \
+                n->right = t->right;                                            \
+                n->left = t;                                                    \
+                t->right = NULL;                                                \
+        }                                                                       \
+                                                                                \
+        tree->root = n;                                                         \
+                                                                                \
+        return 0;                                                               \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_search(Type tree, key_t key)                              \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        tree->root = private_##prefix##_splay(tree->root, key);                 \
+                                                                                \
+        if (tree->root == NULL || compare(key, tree->root->key) != 0)           \
+                return NULL;                                                    \
+                                                                                \
+        return &tree->root->key;                                                \
+}                                                                               \
+                                                                                \
+void prefix##_delete_value(Type tree, key_t key)                                \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *t = private_##prefix##_splay(tree->root, key);    \
+                                                                                \
+        tree->root = t;                                                         \
+                                                                                \
+        if (t == NULL || compare(key, t->key) != 0)                             \
+                return;                                                         \
+                                                                                \
+        if (t->left == NULL) {                                                  \
+                tree->root = t->right;                                          \
+        } else {                                                                \
+                /* without duplicates this splays up the left maximum, */       \
+                /* which has no right child. an equal key may have one, */      \
+                /* so the right side goes under the rightmost node      */      \
+                struct prefix##_node *last;                                     \
+                                                                                \
+                last = private_##prefix##_splay(t->left, key);                  \
+                tree->root = last;                                              \
+                while (last->right != NULL)                                     \
+                        last = last->right;                                     \
+                last->right = t->right;                                         \
+        }                                                                       \
+                                                                                \
+        free(t);                                                                \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_successor_of_value(Type tree, key_t key)                  \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        const key_t *successor = private_##prefix##_successor(tree->root, key); \
+                                                                                \
+        if (successor == NULL)                                                  \
+                return NULL;                                                    \
+                                                                                \
+        tree->root = private_##prefix##_splay(tree->root, *successor);          \
+                                                                                \
+        return &tree->root->key;                                                \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_predecessor_of_value(Type tree, key_t key)                \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        const key_t *predecessor = private_##prefix##_predecessor(tree->root,   \
+                                                                  key);         \
+                                                                                \
+        if (predecessor == NULL)                                                \
+                return NULL;                                                    \
+                                                                                \
+        tree->root = private_##prefix##_splay(tree->root, *predecessor);        \
+                                                                                \
+        return &tree->root->key;                                                \
+}
+
+/*
+ * TYPED_RB_GENERATE(Type, prefix, key_t, compare)
+ *
+ * defines a red-black tree, with the insertion and deletion fixups of
+ * rb_tree.c
+ */
+#define TYPED_RB_GENERATE(Type, prefix, key_t, compare)                         \
+struct prefix##_node {                                                          \
+        key_t key;                                                              \
+        struct prefix##_node *left;                                             \
+        struct prefix##_node *right;                                            \
+        struct prefix##_node *parent;                                           \
+        bool red;                                                               \
+};                                                                              \
+struct prefix {                                                                 \
+        struct prefix##_node *root;                                             \
+};                                                                              \
+TYPED_TREE_PRIVATE_COMMON(Type, prefix, key_t, compare)                         \
+                                                                                \
+void private_##prefix##_rotate_left(Type tree, struct prefix##_node *n)         \
+{                                                                               \
+        struct prefix##_node *r = n->right;                                     \
+                                                                                \
+        n->right = r->left;                                                     \
+        if (r->left != NULL)                                                    \
+                r->left->parent = n;                                            \
+        r->parent = n->parent;                                                  \
+                                                                                \
+        if (n->parent == NULL) {                                                \
+                tree->root = r;                                                 \
+        } else if (n == n->parent->left) {                                      \
+                n->parent->left = r;                                            \
+        } else {                                                                \
+                n->parent->right = r;                                           \
+        }                                                                       \
+                                                                                \
+        r->left = n;                                                            \
+        n->parent = r;                                                          \
+}                                                                               \
+                                                                                \
+void private_##prefix##_rotate_right(Type tree, struct prefix##_node *n)        \
+{                                                                               \
+        struct prefix##_node *l = n->left;                                      \
+                                                                                \
+        n->left = l->right;                                                     \
+        if (l->right != NULL)                                                   \
+                l->right->parent = n;                                           \
+        l->parent = n->parent;                                                  \
+                                                                                \
+        if (n->parent == NULL) {                                                \
+                tree->root = l;                                                 \
+        } else if (n == n->parent->left) {                                      \
+                n->parent->left = l;                                            \
+        } else {                                                                \
+                n->parent->right = l;                                           \
+        }                                                                       \
+                                                                                \
+        l->right = n;                                                           \
+        n->parent = l;                                                          \
+}                                                                               \
+                                                                                \
+bool private_##prefix##_is_black(struct prefix##_node *n)                       \
+{                                                                               \
+        return n == NULL || !n->red;                                            \
+}                                                                               \
+                                                                                \
+int prefix##_insert_value(Type tree, key_t key)                                 \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *parent = NULL;                                    \
+        struct prefix##_node **link = &tree->root;                              \
+                                                                                \
+        while (*link != NULL) {                                                 \
+                parent = *link;                                                 \
+                link = (compare(key, parent->key) < 0) ? &parent->left          \
+                                                       : &parent->right;        \
+        }                                                                       \
+                                                                                \
+        struct prefix##_node *n = private_##prefix##_construct_node(key);       \
+                                                                                \
+        n->parent = parent;                                                     \
+        n->red = true;                                                          \
+        *link = n;                                                              \
+                                                                                \
+        while (n != tree->root && n->parent->red) {                             \
+                struct prefix##_node *p = n->parent;                            \
+                struct prefix##_node *g = p->parent;                            \
+                                                                                \
+                if (p == g->left) {                                             \
+                        struct prefix##_node *uncle = g->right;                 \
+                                                                                \
+                        if (uncle != NULL && uncle->red) {                      \
+                                p->red = false;                                 \
+                                uncle->red = false;                             \
+                                g->red = true;                                  \
+                                n = g;                                          \
+                        } else {                                                \
+                                if (n == p->right) {                            \
+                                        private_##prefix##_rotate_left(tree, p); \
+                                        n = p;                                  \
+                                        p = n->parent;                          \
+                                }                                               \
+                                p->red = false;                                 \
+                                g->red = true;                                  \
+                                private_##prefix##_rotate_right(tree, g);       \
+                        }                                                       \
+                } else {                                                        \
+                        struct prefix##_node *uncle = g->left;                  \
+                                                                                \
+                        if (uncle != NULL && uncle->red) {                      \
+                                p->red = false;                                 \
+                                uncle->red = false;                             \
+                                g->red = true;                                  \
+                                n = g;                                          \
+                        } else {                                                \
+                                if (n == p->left) {                             \
+                                        private_##prefix##_rotate_right(tree, p); \
+                                        n = p;                                  \
+                                        p = n->parent;                          \
+                                }                                               \
+                                p->red = false;                                 \
+                                g->red = true;                                  \
+                                private_##prefix##_rotate_left(tree, g);        \
+                        }                                                       \
+                }                                                               \
+        }                                                                       \
+                                                                                \
+        tree->root->red = false;                                                \
+                                                                                \
+        return 0;                                                               \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_search(Type tree, key_t key)                              \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *n = private_##prefix##_find(tree->root, key);     \
+                                                                                \
+        return (n == NULL) ? NULL : &n->key;                                    \
+}                                                                               \
+                                                                                \
+void private_##prefix##_transplant(Type tree, struct prefix##_node *u,          \
+                                   struct prefix##_node *v)                     \
+{                                                                               \
+        if (u->parent == NULL) {                                                \
+                tree->root = v;                                                 \
+        } else if (u == u->parent->left) {                                      \
+                u->parent->left = v;                                            \
+        } else {                                                                \
+                u->parent->right = v;                                           \
+        }                                                                       \
+                                                                                \
+        if (v != NULL)                                                          \
+                v->parent = u->parent;                                          \
+}                                                                               \
+                                                                                \
+void private_##prefix##_delete_fixup(Type tree, struct prefix##_node *x,        \
+                                     struct prefix##_node *parent)              \
+{                                                                               \
+        while (x != tree->root && private_##prefix##_is_black(x)) {             \
+                if (x == parent->left) {                                        \
+                        struct prefix##_node *s = parent->right;                \
+                                                                                \
+                        if (s->red) {                                           \
+                                s->red = false;                                 \
+                                parent->red = true;                             \
+                                private_##prefix##_rotate_left(tree, parent);   \
+                                s = parent->right;                              \
+                        }                                                       \
+                                                                                \
+                        if (private_##prefix##_is_black(s->left) &&             \
+                            private_##prefix##_is_black(s->right)) {            \
+                                s->red = true;                                  \
+                                x = parent;                                     \
+                                parent = x->parent;                             \
+                        } else {                                                \
+                                if (private_##prefix##_is_black(s->right)) {    \
+                                        s->left->red = false;                   \
+                                        s->red = true;                          \
+                                        private_##prefix##_rotate_right(tree, s); \
+                                        s = parent->right;                      \
+                                }                                               \
+                                s->red = parent->red;                           \
+                                parent->red = false;                            \
+                                s->right->red = false;                          \
+                                private_##prefix##_rotate_left(tree, parent);   \
+                                x = tree->root;                                 \
+                        }                                                       \
+                } else {                                                        \
+                        struct prefix##_node *s = parent->left;                 \
+                                                                                \
+                        if (s->red) {                                           \
+                                s->red = false;                                 \
+                                parent->red = true;                             \
+                                private_##prefix##_rotate_right(tree, parent);  \
+                                s = parent->left;                               \
+                        }                                                       \
+                                                                                \
+                        if (private_##prefix##_is_black(s->right) &&            \
+                            private_##prefix##_is_black(s->left)) {             \
+                                s->red = true;                                  \
+                                x = parent;                                     \
+                                parent = x->parent;                             \
+                        } else {                                                \
+                                if (private_##prefix##_is_black(s->left)) {     \
+                                        s->right->red = false;                  \
+                                        s->red = true;                          \
+                                        private_##prefix##_rotate_left(tree, s); \
+                                        s = parent->left;                       \
+                                }                                               \
+                                s->red = parent->red;                           \
+                                parent->red = false;                            \
+                                s->left->red = false;                           \
+                                private_##prefix##_rotate_right(tree, parent);  \
+                                x = tree->root;                                 \
+                        }                                                       \
+                }                                                               \
+        }                                                                       \
+                                                                                \
+        if (x != NULL)                                                          \
+                x->red = false;                                                 \
+}                                                                               \
+                                                                                \
+void prefix##_delete_value(Type tree, key_t key)                                \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *z = private_##prefix##_find(tree->root, key);     \
+                                                                                \
+        if (z == NULL)                                                          \
+                return;                                                         \
+                                                                                \
+        struct prefix##_node *y = z;                                            \
+        struct prefix##_node *x;                                                \
+        struct prefix##_node *x_parent;                                         \
+        bool y_was_red = y->red;                                                \
+                                                                                \
+        if (z->left == NULL) {                                                  \
+                x = z->right;                                                   \
+                x_parent = z->parent;                                           \
+                private_##prefix##_transplant(tree, z, z->right);               \
+        } else if (z->right == NULL) {                                          \
+                x = z->left;                                                    \
+                x_parent = z->parent;                                           \
+                private_##prefix##_transplant(tree, z, z->left);                \
+        } else {                                                                \
+                y = z->right;                                                   \
+                while (y->left != NULL)                                         \
+                        y = y->left;                                            \
+                y_was_red = y->red;                                             \
+                x = y->right;                                                   \
+                                                                                \
+                if (y->parent == z) {                                           \
+                        x_parent = y;                                           \
+                } else {                                                        \
+                        x_parent = y->parent;                                   \
+                        private_##prefix##_transplant(tree, y, y->right);       \
+                        y->right = z->right;                                    \
+                        y->right->parent = y;                                   \
+                }                                                               \
+                                                                                \
+                private_##prefix##_transplant(tree, z, y);                      \
+                y->left = z->left;                                              \
+                y->left->parent = y;                                            \
+                y->red = z->red;                                                \
+        }                                                                       \
+                                                                                \
+        free(z);                                                                \
+                                                                                \
+        if (!y_was_red)                                                         \
+                private_##prefix##_delete_fixup(tree, x, x_parent);             \
+}                                                                               \
+                                                                                \
+TYPED_TREE_PLAIN_NEIGHBOURS(Type, prefix, key_t)
+
+/*
+ * TYPED_TREE_PLAIN_NEIGHBOURS(Type, prefix, key_t)
+ *
+ * successor and predecessor queries that leave the shape alone, for the
+ * basic and red-black trees
+ */
+#define TYPED_TREE_PLAIN_NEIGHBOURS(Type, prefix, key_t)                        \
+const key_t *prefix##_successor_of_value(Type tree, key_t key)                  \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        return private_##prefix##_successor(tree->root, key);                   \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_predecessor_of_value(Type tree, key_t key)                \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        return private_##prefix##_predecessor(tree->root, key);                 \
+}
+
+/*
+ * TYPED_TREE_PRIVATE_COMMON(Type, prefix, key_t, compare)
+ *
+ * the parts every generated tree shares: it expects struct prefix with a
+ * root, and struct prefix##_node with key, left and right
+ */
+#define TYPED_TREE_PRIVATE_COMMON(Type, prefix, key_t, compare)                 \
+struct prefix##_node *private_##prefix##_construct_node(key_t key)              \
+{                                                                               \
+        struct prefix##_node *n = calloc(1, sizeof(struct prefix##_node));      \
+                                                                                \
+        n->key = key;                                                           \
+                                                                                \
+        return n;                                                               \
+}                                                                               \
+                                                                                \
+void private_##prefix##_free_nodes(struct prefix##_node *n)                     \
+{                                                                               \
+        while (n != NULL) {                                                     \
+                struct prefix##_node *right = n->right;                         \
+                                                                                \
+                private_##prefix##_free_nodes(n->left);                         \
+                free(n);                                                        \
+                n = right;                                                      \
+        }                                                                       \
+}                                                                               \
+                                                                                \
+struct prefix##_node *private_##prefix##_find(struct prefix##_node *n,          \
+                                              key_t key)                        \
+{                                                                               \
+        while (n != NULL) {                                                     \
+                int c = compare(key, n->key);                                   \
+                                                                                \
+                if (c == 0)                                                     \
+                        return n;                                               \
+                n = (c < 0) ? n->left : n->right;                               \
+        }                                                                       \
+                                                                                \
+        return NULL;                                                            \
+}                                                                               \
+                                                                                \
+const key_t *private_##prefix##_successor(struct prefix##_node *n, key_t key)   \
+{                                                                               \
+        struct prefix##_node *successor = NULL;                                 \
+                                                                                \
+        while (n != NULL) {                                                     \
+                if (compare(key, n->key) < 0) {                                 \
+                        successor = n;                                          \
+                        n = n->left;                                            \
+                } else {                                                        \
+                        n = n->right;                                           \
+                }                                                               \
+        }                                                                       \
+                                                                                \
+        return (successor == NULL) ? NULL : &successor->key;                    \
+}                                                                               \
+                                                                                \
+const key_t *private_##prefix##_predecessor(struct prefix##_node *n, key_t key) \
+{                                                                               \
+        struct prefix##_node *predecessor = NULL;                               \
+                                                                                \
+        while (n != NULL) {                                                     \
+                if (compare(key, n->key) > 0) {                                 \
+                        predecessor = n;                                        \
+                        n = n->right;                                           \
+                } else {                                                        \
+                        n = n->left;                                            \
+                }                                                               \
+        }                                                                       \
+                                                                                \
+        return (predecessor == NULL) ? NULL : &predecessor->key;                \
+}                                                                               \
+                                                                                \
+void private_##prefix##_map_inorder(struct prefix##_node *n, int depth,         \
+                                    void func_to_apply(key_t key, int depth,    \
+                                                       void *cl),               \
+                                    void *cl)                                   \
+{                                                                               \
+        if (n == NULL)                                                          \
+                return;                                                         \
+                                                                                \
+        private_##prefix##_map_inorder(n->left, depth + 1, func_to_apply, cl);  \
+        func_to_apply(n->key, depth, cl);                                       \
+        private_##prefix##_map_inorder(n->right, depth + 1, func_to_apply, cl); \
+}                                                                               \
+                                                                                \
+Type prefix##_new(void)                                                         \
+{                                                                               \
+        Type tree = malloc(sizeof(struct prefix));                              \
+                                                                                \
+        tree->root = NULL;                                                      \
+                                                                                \
+        return tree;                                                            \
+}                                                                               \
+                                                                                \
+void prefix##_free(Type tree)                                                   \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        private_##prefix##_free_nodes(tree->root);                              \
+        free(tree);                                                             \
+}                                                                               \
+                                                                                \
+bool prefix##_is_empty(Type tree)                                               \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        return tree->root == NULL;                                              \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_tree_minimum(Type tree)                                   \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *n = tree->root;                                   \
+                                                                                \
+        if (n == NULL)                                                          \
+                return NULL;                                                    \
+        while (n->left != NULL)                                                 \
+                n = n->left;                                                    \
+                                                                                \
+        return &n->key;                                                         \
+}                                                                               \
+                                                                                \
+const key_t *prefix##_tree_maximum(Type tree)                                   \
+{                                                                               \
+        assert(tree != NULL);                                                   \
+                                                                                \
+        struct prefix##_node *n = tree->root;                                   \
+                                                                                \
+        if (n == NULL)                                                          \
+                return NULL;                                                    \
+        while (n->right != NULL)                                                \
+                n = n->right;                                                   \
+                                                                                \
+        return &n->key;                                                         \
+}                                                                               \
+                                                                                \
+void prefix##_map_inorder(Type tree,                                            \
+                          void func_to_apply(key_t key, int depth, void *cl),   \
+                          void *cl)                                             \
+{                                                                               \
+        assert(tree != NULL && func_to_apply != NULL);                          \
+                                                                                \
+        private_##prefix##_map_inorder(tree->root, 0, func_to_apply, cl);       \
+}
+
+#endif
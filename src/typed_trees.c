@@ -0,0 +1,17 @@
+#include "typed_trees.h"
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+TYPED_BST_GENERATE(BSTree_i64_T, bst_i64, int64_t, TYPED_COMPARE)
+TYPED_BST_GENERATE(BSTree_u32_T, bst_u32, uint32_t, TYPED_COMPARE)
+TYPED_BST_GENERATE(BSTree_f64_T, bst_f64, double, TYPED_COMPARE)
+
+TYPED_SPLAY_GENERATE(Splay_i64_T, splay_i64, int64_t, TYPED_COMPARE)
+TYPED_SPLAY_GENERATE(Splay_u32_T, splay_u32, uint32_t, TYPED_COMPARE)
+TYPED_SPLAY_GENERATE(Splay_f64_T, splay_f64, double, TYPED_COMPARE)
+
+TYPED_RB_GENERATE(RedBlack_i64_T, rb_i64, int64_t, TYPED_COMPARE)
+TYPED_RB_GENERATE(RedBlack_u32_T, rb_u32, uint32_t, TYPED_COMPARE)
+TYPED_RB_GENERATE(RedBlack_f64_T, rb_f64, double, TYPED_COMPARE)
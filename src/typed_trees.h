@@ -0,0 +1,38 @@
+/**********************************************************************
+ * typed_trees.h                                                      *
+ *                                                                    *
+ * The basic, splay and red-black trees of typed_tree.h generated     *
+ * for int64_t, uint32_t and double keys. each has the functions      *
+ * listed at TYPED_TREE_DECLARE, under the prefix shown below         *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef TYPED_TREES_H
+#define TYPED_TREES_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdint.h>
+#include "typed_tree.h"
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+TYPED_TREE_DECLARE(BSTree_i64_T, bst_i64, int64_t)
+TYPED_TREE_DECLARE(BSTree_u32_T, bst_u32, uint32_t)
+TYPED_TREE_DECLARE(BSTree_f64_T, bst_f64, double)
+
+TYPED_TREE_DECLARE(Splay_i64_T, splay_i64, int64_t)
+TYPED_TREE_DECLARE(Splay_u32_T, splay_u32, uint32_t)
+TYPED_TREE_DECLARE(Splay_f64_T, splay_f64, double)
+
+TYPED_TREE_DECLARE(RedBlack_i64_T, rb_i64, int64_t)
+TYPED_TREE_DECLARE(RedBlack_u32_T, rb_u32, uint32_t)
+TYPED_TREE_DECLARE(RedBlack_f64_T, rb_f64, double)
+
+#endif
@@ -0,0 +1,201 @@
+#include "wilber.h"
+#include <stdint.h>
+
+/*** MACRO DEFINITIONS ***/
+
+#define WILBER_NIL SIZE_MAX
+
+typedef enum Side { SIDE_NONE, SIDE_LEFT, SIDE_RIGHT } Side;
+
+/*
+ * Funnel_Tree
+ *
+ * the move-to-root tree behind the funnel bound, over the keys 0..n - 1,
+ * of which only the keys accessed so far are linked in
+ */
+typedef struct Funnel_Tree {
+        size_t *parent;
+        size_t *left;
+        size_t *right;
+        bool *present;
+        size_t root;
+} Funnel_Tree;
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_wilber_insert
+ *
+ * links key x into the tree as a leaf, where a search for it would end
+ */
+void private_wilber_insert(Funnel_Tree *tree, size_t x);
+
+/*
+ * private_wilber_count_switches
+ *
+ * walks from x up to the root, returning the number of times the
+ * ancestors change from lying on one side of x to the other
+ */
+size_t private_wilber_count_switches(Funnel_Tree *tree, size_t x);
+
+/*
+ * private_wilber_rotate_up
+ *
+ * rotates x above its parent
+ */
+void private_wilber_rotate_up(Funnel_Tree *tree, size_t x);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+size_t wilber_interleave_bound(const size_t *keys, size_t m, size_t n)
+{
+        assert(keys != NULL || m == 0); 
+
+        /* the reference tree is implicit: the node over [lo, hi) is its midpoint */
+        unsigned char *last = calloc(n > 0 ? n : 1, sizeof(unsigned char)); 
+        size_t interleaves = 0; 
+
+        for (size_t i = 0; i < m; i++) {
+                size_t x = keys[i]; 
+                size_t lo = 0; 
+                size_t hi = n; 
+
+                assert(x < n); 
+
+                while (lo < hi) {
+                        size_t mid = lo + (hi - lo) / 2; 
+                        unsigned char side = (x <= mid) ? SIDE_LEFT : SIDE_RIGHT; 
+
+                        if (last[mid] != SIDE_NONE && last[mid] != side)
+                                interleaves++; 
+                        last[mid] = side; 
+
+                        if (x == mid)
+                                break; 
+
+                        if (x < mid) {
+                                hi = mid; 
+                        } else {
+                                lo = mid + 1; 
+                        }
+                }
+        }
+
+        free(last); 
+
+        return interleaves; 
+}
+
+size_t wilber_funnel_bound(const size_t *keys, size_t m, size_t n)
+{
+        assert(keys != NULL || m == 0); 
+
+        Funnel_Tree tree; 
+        size_t slots = (n > 0) ? n : 1; 
+        size_t switches = 0; 
+
+        tree.parent = malloc(slots * sizeof(size_t)); 
+        tree.left = malloc(slots * sizeof(size_t)); 
+        tree.right = malloc(slots * sizeof(size_t)); 
+        tree.present = calloc(slots, sizeof(bool)); 
+        tree.root = WILBER_NIL; 
+
+        for (size_t i = 0; i < m; i++) {
+                size_t x = keys[i]; 
+
+                assert(x < n); 
+
+                /*
+                 * a key not accessed before has as funnel the path a search
+                 * for it takes, so it is linked in as a leaf first
+                 */
+                if (!tree.present[x])
+                        private_wilber_insert(&tree, x); 
+
+                switches += private_wilber_count_switches(&tree, x); 
+
+                /* x is now the most recent access, so it becomes the root */
+                while (tree.parent[x] != WILBER_NIL)
+                        private_wilber_rotate_up(&tree, x); 
+        }
+
+        free(tree.parent); 
+        free(tree.left); 
+        free(tree.right); 
+        free(tree.present); 
+
+        return switches; 
+}
+
+void private_wilber_insert(Funnel_Tree *tree, size_t x)
+{
+        size_t parent = WILBER_NIL; 
+        size_t n = tree->root; 
+
+        while (n != WILBER_NIL) {
+                parent = n; 
+                n = (x < n) ? tree->left[n] : tree->right[n]; 
+        }
+
+        tree->parent[x] = parent; 
+        tree->left[x] = WILBER_NIL; 
+        tree->right[x] = WILBER_NIL; 
+        tree->present[x] = true; 
+
+        if (parent == WILBER_NIL) {
+                tree->root = x; 
+        } else if (x < parent) {
+                tree->left[parent] = x; 
+        } else {
+                tree->right[parent] = x; 
+        }
+}
+
+size_t private_wilber_count_switches(Funnel_Tree *tree, size_t x)
+{
+        size_t switches = 0; 
+        Side previous = SIDE_NONE; 
+
+        for (size_t z = tree->parent[x]; z != WILBER_NIL; z = tree->parent[z]) {
+                Side side = (z < x) ? SIDE_LEFT : SIDE_RIGHT; 
+
+                if (previous != SIDE_NONE && side != previous)
+                        switches++; 
+                previous = side; 
+        }
+
+        return switches; 
+}
+
+void private_wilber_rotate_up(Funnel_Tree *tree, size_t x)
+{
+        size_t p = tree->parent[x]; 
+        size_t g = tree->parent[p]; 
+
+        if (x == tree->left[p]) {
+                tree->left[p] = tree->right[x]; 
+                if (tree->right[x] != WILBER_NIL)
+                        tree->parent[tree->right[x]] = p; 
+                tree->right[x] = p; 
+        } else {
+                tree->right[p] = tree->left[x]; 
+                if (tree->left[x] != WILBER_NIL)
+                        tree->parent[tree->left[x]] = p; 
+                tree->left[x] = p; 
+        }
+
+        tree->parent[p] = x; 
+        tree->parent[x] = g; 
+
+        if (g == WILBER_NIL) {
+                tree->root = x; 
+        } else if (tree->left[g] == p) {
+                tree->left[g] = x; 
+        } else {
+                tree->right[g] = x; 
+        }
+}
@@ -0,0 +1,74 @@
+/**********************************************************************
+ * wilber.h                                                           *
+ *                                                                    *
+ * Wilber's lower bounds on the cost of serving an access sequence    *
+ * with any binary search tree: the interleave bound and the funnel   *
+ * (second) bound. keys are given as ranks 0..n - 1                   *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef WILBER_H
+#define WILBER_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * wilber_interleave_bound
+ *
+ * returns Wilber's first bound for the access sequence, without the m
+ * term: the perfectly balanced BST over 0..n - 1 is taken as reference
+ * tree, and for every node the accesses falling in its subtree are
+ * labelled left (left subtree or the node itself) or right. the bound is
+ * the total number of label changes over all nodes. any BST serving the
+ * sequence touches at least bound / 2 - n nodes (and at least m). runs
+ * in O(m log n) time and O(n) space
+ *
+ * CREs         keys == NULL and m > 0
+ * UREs         a key is not less than n
+ *
+ * @param       const size_t * - the accessed keys, in access order
+ * @param       size_t - number of accesses m
+ * @param       size_t - number of keys n
+ * @return      size_t - the number of interleaves
+ */
+size_t wilber_interleave_bound(const size_t *keys, size_t m, size_t n);
+
+/*
+ * wilber_funnel_bound
+ *
+ * returns Wilber's second bound for the access sequence, without the m
+ * term. the funnel of an access to x is the set of keys z, accessed
+ * earlier, such that no key between x and z (inclusive) was accessed
+ * after z; the bound is the total number of times the funnel switches
+ * between the left and the right of x, taken in access order.
+ *
+ * the funnel of x is the path from x to the root of a treap over the
+ * keys accessed so far, prioritized by their last access time, so the
+ * bound is computed by simulating that move-to-root tree. this takes
+ * O(m log n) time on typical traces, but the tree is not balanced and
+ * adversarial sequences can take O(mn)
+ *
+ * CREs         keys == NULL and m > 0
+ * UREs         a key is not less than n
+ *
+ * @param       const size_t * - the accessed keys, in access order
+ * @param       size_t - number of accesses m
+ * @param       size_t - number of keys n
+ * @return      size_t - the number of funnel switches
+ */
+size_t wilber_funnel_bound(const size_t *keys, size_t m, size_t n);
+
+#endif
@@ -0,0 +1,219 @@
+#include "word_split.h"
+#include <stdint.h>
+#include <assert.h>
+
+#ifdef CPU_FEATURES_X86
+#include <immintrin.h>
+#endif
+
+typedef size_t (*Split_Func)(char *text, size_t length, char **words);
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/
+
+/*
+ * private_word_split_*
+ *
+ * the kernels behind word_split. each vector kernel handles whole blocks
+ * and leaves the last partial block to private_word_split_tail
+ */
+size_t private_word_split_scalar(char *text, size_t length, char **words);
+
+#ifdef CPU_FEATURES_X86
+size_t private_word_split_sse2(char *text, size_t length, char **words);
+size_t private_word_split_avx2(char *text, size_t length, char **words);
+#endif
+
+/*
+ * private_word_split_tail
+ *
+ * splits text[from, length) one byte at a time, appending to the count
+ * words found so far. in_word tells whether text[from - 1] was part of a
+ * word. returns the new count
+ */
+size_t private_word_split_tail(char *text, size_t from, size_t length, char **words,
+                               size_t count, bool in_word);
+
+void private_word_split_resolve(void);
+
+/*** DISPATCH STATE ***/
+
+static SIMD_Level current_level = SIMD_SCALAR; 
+static Split_Func split_func = NULL; 
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/
+
+size_t word_split(char *text, size_t length, char **words)
+{
+        assert(text != NULL || length == 0); 
+        assert(words != NULL); 
+
+        if (split_func == NULL)
+                private_word_split_resolve(); 
+
+        return split_func(text, length, words); 
+}
+
+bool word_split_is_word_byte(unsigned char c)
+{
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || 
+               (c >= '0' && c <= '9') || c >= 0x80; 
+}
+
+SIMD_Level word_split_level(void)
+{
+        if (split_func == NULL)
+                private_word_split_resolve(); 
+
+        return current_level; 
+}
+
+SIMD_Level word_split_set_level(SIMD_Level level)
+{
+        SIMD_Level supported = cpu_simd_level(); 
+
+        if (level > supported)
+                level = supported; 
+
+        switch (level) {
+#ifdef CPU_FEATURES_X86
+        case SIMD_AVX2:
+                split_func = &private_word_split_avx2; 
+                break; 
+        case SIMD_SSE2:
+                split_func = &private_word_split_sse2; 
+                break; 
+#endif
+        default:
+                level = SIMD_SCALAR; 
+                split_func = &private_word_split_scalar; 
+                break; 
+        }
+
+        current_level = level; 
+
+        return level; 
+}
+
+void private_word_split_resolve(void)
+{
+        word_split_set_level(cpu_simd_level()); 
+}
+
+size_t private_word_split_scalar(char *text, size_t length, char **words)
+{
+        return private_word_split_tail(text, 0, length, words, 0, false); 
+}
+
+size_t private_word_split_tail(char *text, size_t from, size_t length, char **words,
+                               size_t count, bool in_word)
+{
+        for (size_t i = from; i < length; i++) {
+                unsigned char c = (unsigned char) text[i]; 
+
+                if (c >= 'A' && c <= 'Z')
+                        c += 'a' - 'A'; 
+
+                bool word = word_split_is_word_byte(c); 
+
+                text[i] = word ? (char) c : '\0'; 
+                if (word && !in_word)
+                        words[count++] = text + i; 
+                in_word = word; 
+        }
+
+        return count; 
+}
+
+#ifdef CPU_FEATURES_X86
+
+/*
+ * x86 only has signed byte compares, so lo <= v < lo + n is tested as
+ * v - lo < n unsigned, by shifting both sides down by 128
+ */
+static inline __m128i private_word_split_in_range_sse2(__m128i v, char lo, char n)
+{
+        __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((char) (-128 - lo))); 
+
+        return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char) (-128 + n))); 
+}
+
+size_t private_word_split_sse2(char *text, size_t length, char **words)
+{
+        const __m128i case_bit = _mm_set1_epi8(0x20); 
+        const __m128i zero = _mm_setzero_si128(); 
+        uint32_t carry = 0; 
+        size_t count = 0; 
+        size_t i = 0; 
+
+        for (; i + 16 <= length; i += 16) {
+                __m128i v = _mm_loadu_si128((const __m128i *) (text + i)); 
+                __m128i upper = private_word_split_in_range_sse2(v, 'A', 26); 
+
+                v = _mm_or_si128(v, _mm_and_si128(upper, case_bit)); 
+
+                __m128i word = _mm_or_si128(private_word_split_in_range_sse2(v, 'a', 26),
+                                            private_word_split_in_range_sse2(v, '0', 10)); 
+                word = _mm_or_si128(word, _mm_cmplt_epi8(v, zero)); 
+
+                _mm_storeu_si128((__m128i *) (text + i), _mm_and_si128(v, word)); 
+
+                uint32_t mask = (uint32_t) _mm_movemask_epi8(word); 
+                uint32_t starts = mask & ~((mask << 1) | carry); 
+
+                carry = mask >> 15; 
+                while (starts != 0) {
+                        words[count++] = text + i + __builtin_ctz(starts); 
+                        starts &= starts - 1; 
+                }
+        }
+
+        return private_word_split_tail(text, i, length, words, count, carry != 0); 
+}
+
+__attribute__((target("avx2")))
+static inline __m256i private_word_split_in_range_avx2(__m256i v, char lo, char n)
+{
+        __m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8((char) (-128 - lo))); 
+
+        return _mm256_cmpgt_epi8(_mm256_set1_epi8((char) (-128 + n)), shifted); 
+}
+
+__attribute__((target("avx2")))
+size_t private_word_split_avx2(char *text, size_t length, char **words)
+{
+        const __m256i case_bit = _mm256_set1_epi8(0x20); 
+        const __m256i zero = _mm256_setzero_si256(); 
+        uint32_t carry = 0; 
+        size_t count = 0; 
+        size_t i = 0; 
+
+        for (; i + 32 <= length; i += 32) {
+                __m256i v = _mm256_loadu_si256((const __m256i *) (text + i)); 
+                __m256i upper = private_word_split_in_range_avx2(v, 'A', 26); 
+
+                v = _mm256_or_si256(v, _mm256_and_si256(upper, case_bit)); 
+
+                __m256i word = _mm256_or_si256(private_word_split_in_range_avx2(v, 'a', 26),
+                                               private_word_split_in_range_avx2(v, '0', 10)); 
+                word = _mm256_or_si256(word, _mm256_cmpgt_epi8(zero, v)); 
+
+                _mm256_storeu_si256((__m256i *) (text + i), _mm256_and_si256(v, word)); 
+
+                uint32_t mask = (uint32_t) _mm256_movemask_epi8(word); 
+                uint32_t starts = mask & ~((mask << 1) | carry); 
+
+                carry = mask >> 31; 
+                while (starts != 0) {
+                        words[count++] = text + i + __builtin_ctz(starts); 
+                        starts &= starts - 1; 
+                }
+        }
+
+        return private_word_split_tail(text, i, length, words, count, carry != 0); 
+}
+
+#endif
@@ -0,0 +1,88 @@
+/**********************************************************************
+ * word_split.h                                                       *
+ *                                                                    *
+ * Interface for the vectorized word splitter that turns mapped       *
+ * corpus text into words: every byte is classified as part of a      *
+ * word or not, upper case letters are lowered, and every other byte  *
+ * (white space and punctuation) is overwritten with a nul, 16 or 32  *
+ * bytes per instruction. word starts are then read off the class     *
+ * bitmasks. the kernel (AVX2, SSE2 or scalar) is chosen at run time  *
+ * from cpu_features.h                                                *
+ **********************************************************************/
+
+#ifndef WORD_SPLIT_H
+#define WORD_SPLIT_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include "cpu_features.h"
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * word_split
+ *
+ * splits length bytes of text into words in place. a word is a maximal
+ * run of ASCII letters, digits and bytes of 0x80 and above (so UTF-8
+ * letters stay whole); ASCII upper case letters in it are lowered. every
+ * other byte is overwritten with a nul, which terminates the word before
+ * it, and a pointer to the first byte of each word is stored in words,
+ * in text order
+ *
+ * CREs         text == NULL && length > 0
+ *              words == NULL
+ * UREs         words has room for fewer than length / 2 + 1 pointers
+ *              text[length] is not a nul
+ *
+ * @param       char * - the text, rewritten in place
+ * @param       size_t - number of bytes of text
+ * @param       char ** - where to store the words
+ * @return      size_t - number of words
+ */
+size_t word_split(char *text, size_t length, char **words);
+
+/*
+ * word_split_is_word_byte
+ *
+ * returns true if word_split counts the byte as part of a word: an ASCII
+ * letter of either case, a digit, or a byte of 0x80 and above
+ *
+ * CREs         n/a
+ * UREs         n/a
+ *
+ * @param       unsigned char - the byte
+ * @return      bool - true for word bytes
+ */
+bool word_split_is_word_byte(unsigned char c);
+
+/*
+ * word_split_level
+ *
+ * returns the kernel level word_split currently dispatches to. defaults
+ * to cpu_simd_level()
+ *
+ * @return      SIMD_Level - level in use
+ */
+SIMD_Level word_split_level(void);
+
+/*
+ * word_split_set_level
+ *
+ * switches word_split to a narrower kernel, so that tests and benchmarks
+ * can exercise and compare every level on one machine. requests beyond
+ * what the CPU supports are clamped to cpu_simd_level()
+ *
+ * CREs         n/a
+ * UREs         called while another thread is splitting
+ *
+ * @param       SIMD_Level - requested level
+ * @return      SIMD_Level - level actually in use afterwards
+ */
+SIMD_Level word_split_set_level(SIMD_Level level);
+
+#endif
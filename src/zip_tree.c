@@ -0,0 +1,487 @@
+#include "zip_tree.h"
+#include "prng.h"
+#include <string.h>
+#include <stdint.h>
+
+typedef struct Node {
+        void *value; 
+        struct Node *left; 
+        struct Node *right; 
+        unsigned char rank; 
+        uint32_t count;         /* occurrences of value, in a multiset */
+} Node; 
+
+struct zip_tree {
+        Node *root; 
+        Compare compare; 
+        uint64_t prng_state; 
+        bool multiset; 
+};
+
+typedef ZipTree_T T; 
+
+/*********************************
+ * PRIVATE FUNCTION DECLARATIONS *
+ *********************************/ 
+
+void private_zip_deallocate_all_tree_nodes(Node *n); 
+Node *zip_construct_node(T tree, void *value); 
+
+/*
+ * private_zip_unzip
+ * 
+ * splits the subtree rooted at cur around new_node's value. nodes whose 
+ * value is smaller than (or equal to) new_node's become new_node's left 
+ * subtree and all others its right subtree, each side keeping the 
+ * relative structure of the search path. equal values go left so that 
+ * new_node lands after them in order, as in the other engines
+ * 
+ * @param       Node * - the node being inserted
+ * @param       Node * - root of the subtree displaced by new_node
+ * @param       Compare - comparator of the tree
+ * @return      n/a
+ */
+void private_zip_unzip(Node *new_node, Node *cur, Compare compare); 
+
+/*
+ * private_zip_zip
+ * 
+ * inverse of private_zip_unzip: merges the subtrees left and right (every 
+ * value in left ordered before every value in right) into one tree by 
+ * walking down the right spine of left and the left spine of right, taking 
+ * the higher ranked node at each step. ties go to left, which holds the 
+ * smaller values
+ * 
+ * @param       Node * - former left subtree of a deleted node
+ * @param       Node * - former right subtree of a deleted node
+ * @return      Node * - root of the merged tree
+ */
+Node *private_zip_zip(Node *left, Node *right); 
+
+Node *private_zip_find_in_tree(T tree, void *value, Compare compare);
+
+/*
+ * private_zip_count
+ * 
+ * sums the counts of the nodes equal to value in the subtree rooted at 
+ * root. zips can leave equal values on both sides of one another, so 
+ * both children of an equal node are searched
+ * 
+ * @param       Node * - root of the current subtree
+ * @param       void * - value to count
+ * @param       Compare - comparator of the tree
+ * @return      size_t - number of occurrences of value
+ */
+size_t private_zip_count(Node *root, void *value, Compare compare);
+
+Node *private_zip_minimum(Node *x);
+Node *private_zip_maximum(Node *x); 
+void private_zip_map_inorder(Node *root, 
+                             int depth, 
+                             void func_to_apply(void *value, int depth, void *cl), 
+                             void *cl);
+void private_zip_map_preorder(Node *root, 
+                              int depth, 
+                              void func_to_apply(void *value, int depth, void *cl), 
+                              void *cl);
+void private_zip_map_postorder(Node *root, 
+                               int depth, 
+                               void func_to_apply(void *value, int depth, void *cl), 
+                               void *cl);
+
+/************************
+ * FUNCTION DEFINITIONS *
+ ************************/ 
+
+T zip_new(void *comparison_func)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return zip_new_seeded_r(compare.func, compare.ctx, PRNG_DEFAULT_SEED); 
+}
+
+T zip_new_seeded(void *comparison_func, uint64_t seed)
+{
+        Compare compare = comparator_from_legacy(comparison_func); 
+
+        return zip_new_seeded_r(compare.func, compare.ctx, seed); 
+}
+
+T zip_new_r(Comparator compare, void *ctx)
+{
+        return zip_new_seeded_r(compare, ctx, PRNG_DEFAULT_SEED); 
+}
+
+T zip_new_seeded_r(Comparator compare, void *ctx, uint64_t seed)
+{
+        assert(compare != NULL); 
+
+        T tree = malloc(sizeof(struct zip_tree)); 
+
+        tree->root = NULL; 
+        tree->prng_state = seed; 
+
+        tree->compare.func = compare; 
+        tree->compare.ctx = ctx; 
+        tree->multiset = false; 
+
+        return tree; 
+}
+
+T zip_new_multiset(Comparator compare, void *ctx)
+{
+        T tree = zip_new_r(compare, ctx); 
+
+        tree->multiset = true; 
+
+        return tree; 
+}
+
+void zip_free(T tree)
+{
+        assert(tree != NULL);
+
+        private_zip_deallocate_all_tree_nodes(tree->root); 
+        free(tree); 
+}
+
+void private_zip_deallocate_all_tree_nodes(Node *n) 
+{
+        if (n == NULL)
+                return; 
+
+        private_zip_deallocate_all_tree_nodes(n->left);
+        private_zip_deallocate_all_tree_nodes(n->right); 
+
+        free(n); 
+}
+
+bool zip_is_empty(T tree)
+{
+        assert(tree != NULL); 
+
+        return tree->root == NULL;
+}
+
+Node *zip_construct_node(T tree, void *value)
+{
+        Node *new_node = (Node *) malloc(sizeof(Node)); 
+
+        new_node->left = NULL; 
+        new_node->right = NULL; 
+        new_node->value = value; 
+        new_node->rank = (unsigned char) prng_geometric(&tree->prng_state); 
+        new_node->count = 1; 
+
+        return new_node; 
+}
+
+int zip_insert_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        if (tree->multiset) {
+                Node *n = private_zip_find_in_tree(tree, value, tree->compare); 
+
+                if (n != NULL) {
+                        n->count++; 
+                        return 0; 
+                }
+        }
+
+        Compare compare = tree->compare; 
+        Node *new_node = zip_construct_node(tree, value); 
+        Node **link = &tree->root; 
+        Node *cur = tree->root; 
+        int c; 
+
+        /* 
+         * walk down while the current node outranks the new one; rank ties 
+         * are broken in favour of the smaller value 
+         */
+        while (cur != NULL && cur->rank >= new_node->rank) {
+                c = compare.func(value, cur->value, compare.ctx); 
+
+                if (cur->rank == new_node->rank && c < 0)
+                        break; 
+
+                link = (c < 0) ? &cur->left : &cur->right; 
+                cur = *link; 
+        }
+
+        *link = new_node; 
+        private_zip_unzip(new_node, cur, compare); 
+
+        return 0; 
+}
+
+void private_zip_unzip(Node *new_node, Node *cur, Compare compare)
+{
+        Node **left_tail = &new_node->left; 
+        Node **right_tail = &new_node->right; 
+
+        while (cur != NULL) {
+                if (compare.func(new_node->value, cur->value, compare.ctx) < 0) {
+                        *right_tail = cur; 
+                        right_tail = &cur->left; 
+                        cur = cur->left; 
+                } else {
+                        *left_tail = cur; 
+                        left_tail = &cur->right; 
+                        cur = cur->right; 
+                }
+        }
+
+        *left_tail = NULL; 
+        *right_tail = NULL; 
+}
+
+void *zip_search(T tree, void *value)
+{
+        assert(tree != NULL); 
+
+        Node *result = private_zip_find_in_tree(tree, value, tree->compare); 
+
+        if (result != NULL) 
+                return result->value; 
+
+        return NULL; 
+}
+
+Node *private_zip_find_in_tree(T tree, void *value, Compare compare)
+{
+        Node *curr = tree->root; 
+        int c; 
+
+        while (curr != NULL) {
+                c = compare.func(value, curr->value, compare.ctx); 
+
+                if (c == 0) 
+                        return curr; 
+                else if (c < 0) 
+                        curr = curr->left; 
+                else 
+                        curr = curr->right; 
+        }
+
+        return NULL; 
+}
+
+void zip_delete_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node **link = &tree->root; 
+        Node *cur = tree->root; 
+        int c; 
+
+        while (cur != NULL) {
+                c = compare.func(value, cur->value, compare.ctx); 
+
+                if (c == 0)
+                        break; 
+
+                link = (c < 0) ? &cur->left : &cur->right; 
+                cur = *link; 
+        }
+
+        if (cur == NULL || --cur->count > 0)
+                return; 
+
+        *link = private_zip_zip(cur->left, cur->right); 
+        free(cur); 
+}
+
+size_t zip_count(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        return private_zip_count(tree->root, value, tree->compare); 
+}
+
+size_t private_zip_count(Node *root, void *value, Compare compare)
+{
+        if (root == NULL)
+                return 0; 
+
+        int c = compare.func(value, root->value, compare.ctx); 
+
+        if (c < 0) 
+                return private_zip_count(root->left, value, compare); 
+        else if (c > 0) 
+                return private_zip_count(root->right, value, compare); 
+
+        return root->count + private_zip_count(root->left, value, compare) 
+                           + private_zip_count(root->right, value, compare); 
+}
+
+Node *private_zip_zip(Node *left, Node *right)
+{
+        Node *root = NULL; 
+        Node **tail = &root; 
+
+        while (left != NULL && right != NULL) {
+                if (left->rank >= right->rank) {
+                        *tail = left; 
+                        tail = &left->right; 
+                        left = left->right; 
+                } else {
+                        *tail = right; 
+                        tail = &right->left; 
+                        right = right->left; 
+                }
+        }
+
+        *tail = (left != NULL) ? left : right; 
+
+        return root; 
+}
+
+void *zip_tree_minimum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        return private_zip_minimum(tree->root)->value; 
+}
+
+void *zip_tree_maximum(T tree)
+{
+        assert(tree != NULL); 
+
+        if (tree->root == NULL)
+                return NULL; 
+
+        return private_zip_maximum(tree->root)->value; 
+}
+
+Node *private_zip_minimum(Node *x) 
+{
+        while (x->left != NULL) 
+                x = x->left; 
+
+        return x; 
+}
+
+Node *private_zip_maximum(Node *x) 
+{
+        while (x->right != NULL) 
+                x = x->right; 
+
+        return x; 
+}
+
+void *zip_successor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *curr_node = tree->root; 
+        Node *successor = NULL; 
+
+        while (curr_node != NULL) {
+                if (compare.func(value, curr_node->value, compare.ctx) < 0) {
+                        successor = curr_node; 
+                        curr_node = curr_node->left; 
+                } else {
+                        curr_node = curr_node->right; 
+                }
+        }
+
+        if (successor == NULL) 
+                return NULL; 
+        else
+                return successor->value; 
+}
+
+void *zip_predecessor_of_value(T tree, void *value)
+{
+        assert(tree != NULL && value != NULL); 
+
+        Compare compare = tree->compare; 
+        Node *curr_node = tree->root; 
+        Node *predecessor = NULL; 
+
+        while (curr_node != NULL) {
+                if (compare.func(value, curr_node->value, compare.ctx) > 0) {
+                        predecessor = curr_node; 
+                        curr_node = curr_node->right; 
+                } else {
+                        curr_node = curr_node->left; 
+                }
+        }
+
+        if (predecessor == NULL) 
+                return NULL; 
+        else
+                return predecessor->value; 
+}
+
+void zip_map_inorder(T tree, 
+                     void func_to_apply(void *value, int depth, void *cl), 
+                     void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_zip_map_inorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_zip_map_inorder(Node *root, 
+                             int depth, 
+                             void func_to_apply(void *value, int depth, void *cl), 
+                             void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        private_zip_map_inorder(root->left, depth + 1, func_to_apply, cl); 
+        func_to_apply(root->value, depth, cl); 
+        private_zip_map_inorder(root->right, depth + 1, func_to_apply, cl); 
+}
+
+void zip_map_preorder(T tree, 
+                      void func_to_apply(void *value, int depth, void *cl), 
+                      void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_zip_map_preorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_zip_map_preorder(Node *root, 
+                              int depth, 
+                              void func_to_apply(void *value, int depth, void *cl), 
+                              void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        func_to_apply(root->value, depth, cl); 
+        private_zip_map_preorder(root->left, depth + 1, func_to_apply, cl); 
+        private_zip_map_preorder(root->right, depth + 1, func_to_apply, cl); 
+}
+
+void zip_map_postorder(T tree, 
+                       void func_to_apply(void *value, int depth, void *cl), 
+                       void *cl)
+{
+        assert(tree != NULL && func_to_apply != NULL); 
+
+        private_zip_map_postorder(tree->root, 0, func_to_apply, cl); 
+}
+
+void private_zip_map_postorder(Node *root, 
+                               int depth, 
+                               void func_to_apply(void *value, int depth, void *cl), 
+                               void *cl)
+{
+        if (root == NULL)
+                return; 
+
+        private_zip_map_postorder(root->left, depth + 1, func_to_apply, cl); 
+        private_zip_map_postorder(root->right, depth + 1, func_to_apply, cl); 
+        func_to_apply(root->value, depth, cl); 
+}
@@ -0,0 +1,355 @@
+/**********************************************************************
+ * zip_tree.h                                                         *
+ *                                                                    *
+ * Interface for a polymorphic zip tree (Tarjan, Levy and Timmel):    *
+ * a randomized binary search tree whose nodes carry a geometric      *
+ * rank. insertion "unzips" the search path below the new node and    *
+ * deletion "zips" the two spines back together, so neither ever      *
+ * performs a rotation                                                *
+ **********************************************************************/
+
+/***************************
+ * PREPROCESSOR DIRECTIVES *
+ ***************************/
+
+#ifndef ZIP_TREE_H
+#define ZIP_TREE_H
+
+/*** INCLUDED FILES ***/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "comparator.h"
+
+/*** DEFINITIONS AND TYPEDEFS ***/
+
+typedef struct zip_tree *ZipTree_T;
+
+/**********************
+ * FUNCTION CONTRACTS *
+ * AND DECLARATIONS   *
+ **********************/
+
+/*
+ * zip_new
+ * 
+ * returns a pointer to a new, empty zip tree
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ *              
+ * 
+ * @param       void * - pointer to a comparison function. if NULL is passed 
+ *                              as argument, strcmp is assumed. 
+ *              
+ *              comparison_function
+ *              @param          item being inserted (val1)
+ *              @param          item from tree which we are comparing (val2)
+ *              @return         int 
+ *                               - zero (0) if val1 == val2
+ *                               - positive value (n > 0) if val1 > val2
+ *                               - negative value (n < 0) if val1 < val2
+ *        
+ * @return      pointer to empty zip_tree
+ */
+ZipTree_T zip_new(void *comparison_func); 
+
+/*
+ * zip_new_seeded
+ * 
+ * same as zip_new, but seeds the rank generator explicitly. two zip trees 
+ * created with the same seed and fed the same operations have the same 
+ * shape, which keeps benchmark runs reproducible. zip_new uses 
+ * PRNG_DEFAULT_SEED
+ * 
+ * CREs         n/a
+ * UREs         system out of memory
+ * 
+ * @param       void * - pointer to a comparison function (see zip_new)
+ * @param       uint64_t - seed for the rank generator
+ * @return      pointer to empty zip tree
+ */
+ZipTree_T zip_new_seeded(void *comparison_func, uint64_t seed); 
+
+/*
+ * zip_new_r, zip_new_seeded_r
+ * 
+ * same as zip_new and zip_new_seeded, but take a typed comparator and a
+ * context that is passed to every call of it, as for qsort_r
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @param       uint64_t - seed for the rank generator (_seeded_r only)
+ * @return      pointer to empty zip_tree
+ */
+ZipTree_T zip_new_r(Comparator compare, void *ctx); 
+ZipTree_T zip_new_seeded_r(Comparator compare, void *ctx, uint64_t seed); 
+
+/*
+ * zip_new_multiset
+ * 
+ * same as zip_new_r, but the zip tree keeps a single node per distinct 
+ * value, with a count of its occurrences. inserting a value equal to one
+ * already in the zip tree bumps that node's count (the pointer stored first
+ * is the one kept), and deleting it takes one off the count, only 
+ * unlinking the node once the count reaches zero. the maps visit each 
+ * distinct value once
+ * 
+ * CREs         compare == NULL
+ * UREs         system out of memory
+ *              a value is inserted more than 2^32 - 1 times
+ * 
+ * @param       Comparator - comparison function (see comparator.h)
+ * @param       void * - context passed as the third argument to it
+ * @return      pointer to empty zip_tree
+ */
+ZipTree_T zip_new_multiset(Comparator compare, void *ctx); 
+
+/*
+ * zip_free
+ * 
+ * given a pointer to a zip tree, deallocates the tree and all nodes
+ * contained within it
+ *
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - the tree to be freed
+ * @return      n/a
+ */
+void zip_free(ZipTree_T tree); 
+
+/*
+ * zip_is_empty
+ * 
+ * returns true if the tree is empty, and false otherwise
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - tree to be checked if empty
+ * @return      bool - true if empty, false otherwise
+ */ 
+bool zip_is_empty(ZipTree_T tree); 
+
+/*
+ * zip_insert_value
+ * 
+ * given a value (cast to void), inserts the value into the given tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * 
+ * UREs         system out of memory
+ *              attempting to pass in a value which cannot be compared with 
+ *                      your comparison function
+ * 
+ * @param       ZipTree_T - tree in which to insert value
+ * @param       void * - a pointer to any item to be inserted
+ * @return      int - 0 on success
+ */
+int zip_insert_value(ZipTree_T tree, void *value);
+
+/*
+ * zip_search
+ * 
+ * given a tree and a value to search for, returns a pointer to the stored 
+ * value, or NULL if the value is not found. If duplicates are in the tree, 
+ * returns the first one found
+ * 
+ * @param       ZipTree_T - tree in which to search
+ * @param       void * - value to search for
+ * @return      void * - pointer to the value that was found
+ */
+void *zip_search(ZipTree_T tree, void *value); 
+
+/*
+ * zip_delete_value
+ * 
+ * given a value, deletes the first instance of it that is found in the tree
+ * if a value is given that is not in the tree, this function has no effect
+ * in a multiset, takes one off the count of its node instead, and only
+ * deletes the node when that reaches zero
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - tree to find the value in
+ * @param       void * - pointer to the value to be deleted
+ * @return      n/a
+ */
+void zip_delete_value(ZipTree_T tree, void *value); 
+
+/*
+ * zip_count
+ * 
+ * given a zip tree and a value, returns how many times the value is stored:
+ * the count of its node in a multiset, or the number of equal nodes 
+ * otherwise. returns 0 if the value is not in the zip tree
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - tree to be searched
+ * @param       void * - value to count
+ * @return      size_t - number of occurrences of value
+ */
+size_t zip_count(ZipTree_T tree, void *value); 
+
+/*
+ * zip_tree_minimum
+ * 
+ * given a tree, returns the minimum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - tree to be searched
+ * @return      void * - pointer to min value
+ */
+void *zip_tree_minimum(ZipTree_T tree); 
+
+/*
+ * zip_tree_maximum
+ * 
+ * given a tree, returns the maximum value stored in the tree, or NULL if 
+ * the tree is empty
+ * 
+ * CREs         tree == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - tree to be searched
+ * @return      void * - pointer to max value
+ */
+void *zip_tree_maximum(ZipTree_T tree); 
+
+/*
+ * zip_successor_of_value
+ * 
+ * given a tree and a value, returns the first successor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no successor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - tree to be searched
+ * @param       void * - value to find the successor of
+ * @return      void * - value of the successor
+ */
+void *zip_successor_of_value(ZipTree_T tree, void *value); 
+
+/*
+ * zip_predecessor_of_value
+ * 
+ * given a tree and a value, returns the first predecessor of that value
+ * returned value will always be distinct from value, even if there are 
+ * duplicates; returns NULL if no predecessor
+ * 
+ * CREs         tree == NULL
+ *              value == NULL
+ * UREs         n/a
+ * 
+ * @param       ZipTree_T - tree to be searched
+ * @param       void * - value to find the predecessor of
+ * @return      void * - value of the predecessor
+ */
+void *zip_predecessor_of_value(ZipTree_T tree, void *value); 
+
+/*
+ * zip_map_inorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via an inorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       ZipTree_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void zip_map_inorder(ZipTree_T tree, 
+                     void func_to_apply(void *value, int depth, void *cl), 
+                     void *cl); 
+
+/*
+ * zip_map_preorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a preorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       ZipTree_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void zip_map_preorder(ZipTree_T tree, 
+                      void func_to_apply(void *value, int depth, void *cl), 
+                      void *cl); 
+
+/*
+ * zip_map_postorder
+ * 
+ * given a tree and a pointer to a function, applies the function to every
+ * element stored in the tree via a postorder walk
+ * example valid operations include: 
+ *              - print every value
+ *              - increment every stored value by one
+ *              - store every element in an array (stored in closure)
+ * 
+ * CREs         tree == NULL
+ *              func_to_apply == NULL
+ * UREs         func_to_apply modifies tree structure by performing different
+ *                      operations on each node. (for instance, subtracting 1 
+ *                      from the first node, 2 from the second, 3 from the 
+ *                      third...and n from the nth could result in the BST 
+ *                      property being invalidated)
+ *                              
+ * 
+ * @param       ZipTree_T - tree to apply function to
+ * @param       void * - pointer to a function
+ * @param       void * - a closure item; can be anything you would like to 
+ *                              make use of when evaluating your function
+ * @return      n/a
+ */
+void zip_map_postorder(ZipTree_T tree, 
+                       void func_to_apply(void *value, int depth, void *cl), 
+                       void *cl); 
+
+#endif
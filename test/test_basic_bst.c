@@ -454,6 +454,216 @@ void test_bst_predecessor_of_value(void)
         bst_free(test_tree); 
 }
 
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void function_to_apply_record_order(void *value, int depth, void *cl)
+{
+        int **next = (int **) cl; 
+
+        (void) depth; 
+        *(*next)++ = *(int *) value; 
+}
+
+void test_bst_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        int order[100]; 
+        int *next = order; 
+        BSTree_T test_tree = bst_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                bst_insert_value(test_tree, &a[i]); 
+        }
+
+        bst_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(100, next - order); 
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, order[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) bst_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) bst_successor_of_value(test_tree, &key)); 
+
+        bst_free(test_tree); 
+}
+
+void test_bst_multiset_counts(void)
+{
+        int direction = 1; 
+        int a[10]; 
+        int order[10]; 
+        int *next = order; 
+        int key; 
+        BSTree_T test_tree = bst_new_multiset(&directed_comparison, &direction); 
+        BSTree_T plain_tree = bst_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 10; i++) {
+                a[i] = i / 3; 
+                bst_insert_value(test_tree, &a[i]); 
+                bst_insert_value(plain_tree, &a[i]); 
+        }
+
+        bst_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(4, next - order); 
+        for (int i = 0; i < 4; i++) 
+                TEST_ASSERT_EQUAL(i, order[i]); 
+
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, bst_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(3, bst_count(plain_tree, &key)); 
+        TEST_ASSERT_EQUAL_PTR(&a[3], bst_search(test_tree, &key)); 
+        key = 3; 
+        TEST_ASSERT_EQUAL(1, bst_count(test_tree, &key)); 
+        key = 7; 
+        TEST_ASSERT_EQUAL(0, bst_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(0, bst_count(plain_tree, &key)); 
+
+        key = 0; 
+        bst_delete_value(test_tree, &key); 
+        bst_delete_value(test_tree, &key); 
+        bst_delete_value(plain_tree, &key); 
+        TEST_ASSERT_EQUAL(1, bst_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(2, bst_count(plain_tree, &key)); 
+        TEST_ASSERT_NOT_NULL(bst_search(test_tree, &key)); 
+
+        bst_delete_value(test_tree, &key); 
+        TEST_ASSERT_EQUAL(0, bst_count(test_tree, &key)); 
+        TEST_ASSERT_NULL(bst_search(test_tree, &key)); 
+        bst_delete_value(test_tree, &key); 
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, bst_count(test_tree, &key)); 
+
+        bst_free(test_tree); 
+        bst_free(plain_tree); 
+}
+
+void *merge_count_and_replace(void *stored, void *value, void *cl)
+{
+        (void) stored; 
+        (*(int *) cl)++; 
+
+        return value; 
+}
+
+void test_bst_insert_unique_and_upsert(void)
+{
+        int direction = 1; 
+        int a[5] = { 3, 1, 4, 1, 5 }; 
+        int b = 4, c = 9; 
+        int merges = 0; 
+        int order[6]; 
+        int *next = order; 
+        BSTree_T test_tree = bst_new_r(&directed_comparison, &direction); 
+
+        TEST_ASSERT_NULL(bst_insert_unique(test_tree, &a[0])); 
+        TEST_ASSERT_NULL(bst_insert_unique(test_tree, &a[1])); 
+        TEST_ASSERT_NULL(bst_insert_unique(test_tree, &a[2])); 
+        TEST_ASSERT_EQUAL_PTR(&a[1], bst_insert_unique(test_tree, &a[3])); 
+        TEST_ASSERT_NULL(bst_insert_unique(test_tree, &a[4])); 
+        TEST_ASSERT_EQUAL(1, bst_count(test_tree, &a[3])); 
+
+        TEST_ASSERT_EQUAL_PTR(&b, bst_upsert(test_tree, &b, &merge_count_and_replace, &merges)); 
+        TEST_ASSERT_EQUAL(1, merges); 
+        TEST_ASSERT_EQUAL_PTR(&b, bst_search(test_tree, &a[2])); 
+        TEST_ASSERT_EQUAL_PTR(&c, bst_upsert(test_tree, &c, &merge_count_and_replace, &merges)); 
+        TEST_ASSERT_EQUAL(1, merges); 
+        TEST_ASSERT_EQUAL_PTR(&c, bst_search(test_tree, &c)); 
+
+        bst_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(5, next - order); 
+        TEST_ASSERT_EQUAL(1, order[0]); 
+        TEST_ASSERT_EQUAL(3, order[1]); 
+        TEST_ASSERT_EQUAL(4, order[2]); 
+        TEST_ASSERT_EQUAL(5, order[3]); 
+        TEST_ASSERT_EQUAL(9, order[4]); 
+
+        bst_free(test_tree); 
+}
+
+/* records values until its budget runs out */
+typedef struct Recorder {
+        int *next; 
+        int budget; 
+} Recorder; 
+
+bool function_to_apply_record_some(void *value, void *cl)
+{
+        Recorder *recorder = cl; 
+
+        *recorder->next++ = *(int *) value; 
+        return --recorder->budget > 0; 
+}
+
+void test_bst_map_range(void)
+{
+        int direction = 1; 
+        int a[1000], seen[1000]; 
+        int lo, hi; 
+        Recorder recorder; 
+        BSTree_T test_tree = bst_new_r(&directed_comparison, &direction); 
+
+        /* the even values 0..1998, in a scattered order */
+        for (int i = 0; i < 1000; i++) {
+                a[i] = 2 * ((i * 7919) % 1000); 
+                bst_insert_value(test_tree, &a[i]); 
+        }
+
+        lo = 101; 
+        hi = 300; 
+        recorder = (Recorder) { seen, 1000 }; 
+        bst_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(100, recorder.next - seen); 
+        for (int i = 0; i < 100; i++)
+                TEST_ASSERT_EQUAL(102 + 2 * i, seen[i]); 
+
+        /* the walk stops as soon as the function says so */
+        lo = 100; 
+        recorder = (Recorder) { seen, 5 }; 
+        bst_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(5, recorder.next - seen); 
+        for (int i = 0; i < 5; i++)
+                TEST_ASSERT_EQUAL(100 + 2 * i, seen[i]); 
+
+        /* bounds past either end, and empty ranges */
+        lo = -50; 
+        hi = 4; 
+        recorder = (Recorder) { seen, 1000 }; 
+        bst_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(3, recorder.next - seen); 
+        TEST_ASSERT_EQUAL(4, seen[2]); 
+        lo = 1997; 
+        hi = 5000; 
+        recorder = (Recorder) { seen, 1000 }; 
+        bst_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(1, recorder.next - seen); 
+        TEST_ASSERT_EQUAL(1998, seen[0]); 
+        lo = 501; 
+        hi = 501; 
+        recorder = (Recorder) { seen, 1000 }; 
+        bst_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        lo = 600; 
+        hi = 500; 
+        bst_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(0, recorder.next - seen); 
+
+        for (int v = 0; v < 2000; v += 2)
+                TEST_ASSERT_EQUAL(v, *(int *) bst_search(test_tree, &v)); 
+
+        bst_free(test_tree); 
+}
+
 int main(void)
 {
         UnityBegin("test/test_basic_bst.c");
@@ -479,6 +689,10 @@ int main(void)
         RUN_TEST(test_bst_tree_maximum); 
         RUN_TEST(test_bst_successor_of_value); 
         RUN_TEST(test_bst_predecessor_of_value); 
+        RUN_TEST(test_bst_new_r_passes_context); 
+        RUN_TEST(test_bst_multiset_counts); 
+        RUN_TEST(test_bst_insert_unique_and_upsert); 
+        RUN_TEST(test_bst_map_range); 
 
         UnityEnd();
         return 0;
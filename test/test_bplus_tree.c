@@ -0,0 +1,613 @@
+#include "vendor/unity.h"
+#include "../src/bplus_tree.h"
+#include "../src/simd_search.h"
+#include <stdint.h>
+#include <stdio.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int integer_comparison(void *val_one, void *val_two)
+{
+        if (*(int *) val_one == *(int *) val_two) {
+                return 0; 
+        } else if (*(int *) val_one > *(int *) val_two) {
+                return 1; 
+        } else {
+                return -1; 
+        }
+}
+
+struct int_closure {
+        int index; 
+        int max_depth; 
+        int values[1000]; 
+        int depths[1000]; 
+};
+
+void function_to_apply_record_ints(void *value, int depth, void *cl)
+{
+        struct int_closure *closure = (struct int_closure *) cl; 
+
+        closure->values[closure->index] = *(int *) value; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+
+        if (depth > closure->max_depth)
+                closure->max_depth = depth; 
+}
+
+struct string_closure_size_six {
+        int index; 
+        char *word_ray[6]; 
+};
+
+void function_to_apply_test_map_string(void *value, int depth, void *cl)
+{
+        struct string_closure_size_six *closure = (struct string_closure_size_six *) cl; 
+
+        (void) depth; 
+        closure->word_ray[closure->index] = value; 
+        closure->index++; 
+}
+
+void test_bpt_new(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL);
+        TEST_ASSERT_NOT_NULL(test_tree);
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_insert_string(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL);
+        TEST_ASSERT_EQUAL(0, bpt_insert_value(test_tree, "Hello")); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_tree_is_empty(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL);
+        TEST_ASSERT_TRUE(bpt_tree_is_empty(test_tree));
+
+        bpt_insert_value(test_tree, "hello");
+        TEST_ASSERT_FALSE(bpt_tree_is_empty(test_tree)); 
+
+        bpt_delete_value(test_tree, "hello");
+        TEST_ASSERT_TRUE(bpt_tree_is_empty(test_tree)); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_search(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL); 
+
+        bpt_insert_value(test_tree, "a"); 
+        TEST_ASSERT_EQUAL_STRING("a", bpt_search(test_tree, "a")); 
+
+        TEST_ASSERT_NULL(bpt_search(test_tree, "b")); 
+        bpt_insert_value(test_tree, "b"); 
+        TEST_ASSERT_EQUAL_STRING("b", bpt_search(test_tree, "b")); 
+
+        TEST_ASSERT_NULL(bpt_search(test_tree, "hello")); 
+        bpt_insert_value(test_tree, "hello"); 
+        TEST_ASSERT_EQUAL_STRING("hello", bpt_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("a", bpt_search(test_tree, "a")); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_search_for_ints(void)
+{
+        BPlusTree_T test_tree = bpt_new(&integer_comparison);
+
+        int a[] = { 214, 25, 64, 4, 7, 729, 34, 28, 9, 11};
+
+        for (int i = 0; i < 10; i++) 
+                bpt_insert_value(test_tree, &a[i]); 
+
+        int x = 4; 
+        int y = 9; 
+        int z = 70000000; 
+
+        TEST_ASSERT_EQUAL(x, *(int *) bpt_search(test_tree, &x)); 
+        TEST_ASSERT_EQUAL(y, *(int *) bpt_search(test_tree, &y)); 
+        TEST_ASSERT_NULL(bpt_search(test_tree, &z)); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_map_inorder_string(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL); 
+
+        char *expected_words[] = {"earth", "hello", "hello", "says", "the", "world"};
+        char *word_ray[] = {"hello", "world", "the", "earth", "says", "hello"}; 
+
+        for (int i = 0; i < 6; i++) 
+                bpt_insert_value(test_tree, word_ray[i]); 
+
+        struct string_closure_size_six cl; 
+        cl.index = 0; 
+        
+        bpt_map_inorder(test_tree, &function_to_apply_test_map_string, &cl);
+
+        TEST_ASSERT_EQUAL(6, cl.index); 
+        for (int i = 0; i < 6; i++) 
+                TEST_ASSERT_EQUAL_STRING(expected_words[i], cl.word_ray[i]);  
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_delete_value(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL); 
+        bpt_insert_value(test_tree, "hello"); 
+        bpt_insert_value(test_tree, "world");
+        bpt_insert_value(test_tree, "the");
+        bpt_insert_value(test_tree, "earth");
+        bpt_insert_value(test_tree, "says");
+
+        bpt_delete_value(test_tree, "hello"); 
+        TEST_ASSERT_NULL(bpt_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("world", bpt_search(test_tree, "world"));
+        TEST_ASSERT_EQUAL_STRING("the", bpt_search(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("earth", bpt_search(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("says", bpt_search(test_tree, "says"));
+
+        bpt_delete_value(test_tree, "not_in_tree"); 
+        TEST_ASSERT_EQUAL_STRING("world", bpt_search(test_tree, "world"));
+
+        bpt_delete_value(test_tree, "the"); 
+        bpt_delete_value(test_tree, "earth"); 
+        bpt_delete_value(test_tree, "world"); 
+        TEST_ASSERT_EQUAL_STRING("says", bpt_search(test_tree, "says"));
+
+        bpt_delete_value(test_tree, "says"); 
+        TEST_ASSERT_TRUE(bpt_tree_is_empty(test_tree)); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_delete_many_ints(void)
+{
+        BPlusTree_T test_tree = bpt_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 389) % 1000; 
+                bpt_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 1000; i += 2) 
+                bpt_delete_value(test_tree, &i); 
+
+        for (int i = 0; i < 1000; i++) {
+                if (i % 2 == 0) {
+                        TEST_ASSERT_NULL(bpt_search(test_tree, &i)); 
+                } else {
+                        TEST_ASSERT_EQUAL(i, *(int *) bpt_search(test_tree, &i)); 
+                }
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        bpt_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(500, cl.index); 
+        for (int i = 0; i < 500; i++) 
+                TEST_ASSERT_EQUAL(2 * i + 1, cl.values[i]); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_tree_minimum_and_maximum(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL); 
+        TEST_ASSERT_NULL(bpt_tree_minimum(test_tree)); 
+        TEST_ASSERT_NULL(bpt_tree_maximum(test_tree)); 
+
+        bpt_insert_value(test_tree, "hello"); 
+        bpt_insert_value(test_tree, "world");
+        bpt_insert_value(test_tree, "the");
+        bpt_insert_value(test_tree, "earth");
+        bpt_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("earth", bpt_tree_minimum(test_tree)); 
+        TEST_ASSERT_EQUAL_STRING("world", bpt_tree_maximum(test_tree)); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_successor_of_value(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL); 
+        bpt_insert_value(test_tree, "hello"); 
+        bpt_insert_value(test_tree, "world");
+        bpt_insert_value(test_tree, "the");
+        bpt_insert_value(test_tree, "earth");
+        bpt_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("world", bpt_successor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", bpt_successor_of_value(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("the", bpt_successor_of_value(test_tree, "says")); 
+        TEST_ASSERT_EQUAL_STRING("says", bpt_successor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(bpt_successor_of_value(test_tree, "world"));
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_predecessor_of_value(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL); 
+        bpt_insert_value(test_tree, "hello"); 
+        bpt_insert_value(test_tree, "world");
+        bpt_insert_value(test_tree, "the");
+        bpt_insert_value(test_tree, "earth");
+        bpt_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("says", bpt_predecessor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", bpt_predecessor_of_value(test_tree, "says"));
+        TEST_ASSERT_EQUAL_STRING("earth", bpt_predecessor_of_value(test_tree, "hello"));  
+        TEST_ASSERT_EQUAL_STRING("hello", bpt_predecessor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(bpt_predecessor_of_value(test_tree, "earth"));
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_sorted_inserts_stay_shallow(void)
+{
+        BPlusTree_T test_tree = bpt_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = i; 
+                bpt_insert_value(test_tree, &a[i]); 
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        bpt_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(1000, cl.index); 
+        for (int i = 0; i < 1000; i++) {
+                TEST_ASSERT_EQUAL(i, cl.values[i]); 
+                TEST_ASSERT_EQUAL(cl.max_depth, cl.depths[i]); 
+        }
+
+        /* half-full leaves and internal nodes still cover 1000 values in 
+         * three levels */
+        TEST_ASSERT_TRUE(cl.max_depth <= 2); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_duplicates_across_leaves(void)
+{
+        BPlusTree_T test_tree = bpt_new(&integer_comparison); 
+
+        /* enough copies of one value to fill several leaves, with smaller 
+         * and larger neighbours on either side */
+        int a[300]; 
+        for (int i = 0; i < 300; i++) {
+                a[i] = (i < 100) ? 1 : (i < 200) ? 5 : 9; 
+                bpt_insert_value(test_tree, &a[i]); 
+        }
+
+        int one = 1; 
+        int five = 5; 
+        int nine = 9; 
+        TEST_ASSERT_EQUAL(9, *(int *) bpt_successor_of_value(test_tree, &five)); 
+        TEST_ASSERT_EQUAL(1, *(int *) bpt_predecessor_of_value(test_tree, &five)); 
+        TEST_ASSERT_EQUAL(5, *(int *) bpt_successor_of_value(test_tree, &one)); 
+        TEST_ASSERT_EQUAL(5, *(int *) bpt_predecessor_of_value(test_tree, &nine)); 
+
+        for (int i = 0; i < 100; i++) {
+                TEST_ASSERT_EQUAL(5, *(int *) bpt_search(test_tree, &five)); 
+                bpt_delete_value(test_tree, &five); 
+        }
+        TEST_ASSERT_NULL(bpt_search(test_tree, &five)); 
+        TEST_ASSERT_EQUAL(9, *(int *) bpt_successor_of_value(test_tree, &one)); 
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        bpt_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(200, cl.index); 
+        for (int i = 0; i < 200; i++) 
+                TEST_ASSERT_EQUAL((i < 100) ? 1 : 9, cl.values[i]); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_delete_until_empty(void)
+{
+        BPlusTree_T test_tree = bpt_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 617) % 1000; 
+                bpt_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 1000; i++) {
+                int victim = (i * 251) % 1000; 
+
+                bpt_delete_value(test_tree, &victim); 
+                TEST_ASSERT_NULL(bpt_search(test_tree, &victim)); 
+
+                if (i + 1 < 1000) {
+                        int survivor = ((i + 1) * 251) % 1000; 
+                        TEST_ASSERT_EQUAL(survivor, *(int *) bpt_search(test_tree, &survivor)); 
+                }
+
+                if (i == 499) {
+                        struct int_closure cl = { 0, 0, {0}, {0} }; 
+                        bpt_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+                        TEST_ASSERT_EQUAL(500, cl.index); 
+                        for (int j = 1; j < 500; j++) 
+                                TEST_ASSERT_TRUE(cl.values[j - 1] < cl.values[j]); 
+                }
+        }
+
+        TEST_ASSERT_TRUE(bpt_tree_is_empty(test_tree)); 
+        TEST_ASSERT_NULL(bpt_tree_minimum(test_tree)); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_delete_freed_strings(void)
+{
+        BPlusTree_T test_tree = bpt_new(NULL); 
+        char *words[200]; 
+        char key[4]; 
+
+        for (int i = 0; i < 200; i++) {
+                words[i] = malloc(4); 
+                sprintf(words[i], "%03d", (i * 67) % 200); 
+                bpt_insert_value(test_tree, words[i]); 
+        }
+
+        /* 
+         * every deleted string is freed straight away, so a separator 
+         * left pointing at one would be read after free by the next 
+         * descent (caught under valgrind or ASan)
+         */
+        for (int i = 0; i < 200; i++) {
+                int victim = (i * 89) % 200; 
+                char *stored; 
+
+                sprintf(key, "%03d", victim); 
+                stored = bpt_search(test_tree, key); 
+                TEST_ASSERT_EQUAL_STRING(key, stored); 
+                bpt_delete_value(test_tree, key); 
+                free(stored); 
+                TEST_ASSERT_NULL(bpt_search(test_tree, key)); 
+
+                for (int j = i + 1; j < 200; j++) {
+                        sprintf(key, "%03d", (j * 89) % 200); 
+                        TEST_ASSERT_EQUAL_STRING(key, bpt_search(test_tree, key)); 
+                }
+        }
+
+        TEST_ASSERT_TRUE(bpt_tree_is_empty(test_tree)); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void check_integer_tree(void)
+{
+        BPlusTree_T test_tree = bpt_new_integer(); 
+
+        /* odd values from -999 to 999, inserted out of order */
+        for (int i = 0; i < 1000; i++) {
+                intptr_t v = 2 * ((i * 389) % 1000) - 999; 
+                bpt_insert_value(test_tree, (void *) v); 
+        }
+
+        TEST_ASSERT_EQUAL(-999, (intptr_t) bpt_tree_minimum(test_tree)); 
+        TEST_ASSERT_EQUAL(999, (intptr_t) bpt_tree_maximum(test_tree)); 
+
+        for (intptr_t v = -999; v <= 999; v += 2) {
+                TEST_ASSERT_EQUAL(v, (intptr_t) bpt_search(test_tree, (void *) v)); 
+                TEST_ASSERT_NULL(bpt_search(test_tree, (void *) (v + 1))); 
+                TEST_ASSERT_EQUAL(v, (intptr_t) bpt_successor_of_value(test_tree, (void *) (v - 1))); 
+                TEST_ASSERT_EQUAL(v, (intptr_t) bpt_predecessor_of_value(test_tree, (void *) (v + 1))); 
+        }
+        TEST_ASSERT_NULL(bpt_successor_of_value(test_tree, (void *) 999)); 
+        TEST_ASSERT_NULL(bpt_predecessor_of_value(test_tree, (void *) -999)); 
+
+        for (intptr_t v = -999; v <= 999; v += 4) 
+                bpt_delete_value(test_tree, (void *) v); 
+
+        for (intptr_t v = -999; v <= 999; v += 2) {
+                if ((v + 999) % 4 == 0) {
+                        TEST_ASSERT_NULL(bpt_search(test_tree, (void *) v)); 
+                } else {
+                        TEST_ASSERT_EQUAL(v, (intptr_t) bpt_search(test_tree, (void *) v)); 
+                }
+        }
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_integer_keys_every_simd_level(void)
+{
+        SIMD_Level best = cpu_simd_level(); 
+
+        for (int level = SIMD_SCALAR; level <= (int) best; level++) {
+                TEST_ASSERT_EQUAL(level, simd_search_set_level((SIMD_Level) level)); 
+                check_integer_tree(); 
+        }
+
+        simd_search_set_level(best); 
+}
+
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void function_to_apply_record_order(void *value, int depth, void *cl)
+{
+        int **next = (int **) cl; 
+
+        (void) depth; 
+        *(*next)++ = *(int *) value; 
+}
+
+void test_bpt_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        int order[100]; 
+        int *next = order; 
+        BPlusTree_T test_tree = bpt_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                bpt_insert_value(test_tree, &a[i]); 
+        }
+
+        bpt_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(100, next - order); 
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, order[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) bpt_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) bpt_successor_of_value(test_tree, &key)); 
+
+        bpt_tree_free(test_tree); 
+}
+
+void test_bpt_multiset_counts(void)
+{
+        int direction = 1; 
+        int a[10]; 
+        int order[10]; 
+        int *next = order; 
+        int key; 
+        BPlusTree_T test_tree = bpt_new_multiset(&directed_comparison, &direction); 
+        BPlusTree_T plain_tree = bpt_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 10; i++) {
+                a[i] = i / 3; 
+                bpt_insert_value(test_tree, &a[i]); 
+                bpt_insert_value(plain_tree, &a[i]); 
+        }
+
+        bpt_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(4, next - order); 
+        for (int i = 0; i < 4; i++) 
+                TEST_ASSERT_EQUAL(i, order[i]); 
+
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, bpt_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(3, bpt_count(plain_tree, &key)); 
+        TEST_ASSERT_EQUAL_PTR(&a[3], bpt_search(test_tree, &key)); 
+        key = 3; 
+        TEST_ASSERT_EQUAL(1, bpt_count(test_tree, &key)); 
+        key = 7; 
+        TEST_ASSERT_EQUAL(0, bpt_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(0, bpt_count(plain_tree, &key)); 
+
+        key = 0; 
+        bpt_delete_value(test_tree, &key); 
+        bpt_delete_value(test_tree, &key); 
+        bpt_delete_value(plain_tree, &key); 
+        TEST_ASSERT_EQUAL(1, bpt_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(2, bpt_count(plain_tree, &key)); 
+        TEST_ASSERT_NOT_NULL(bpt_search(test_tree, &key)); 
+
+        bpt_delete_value(test_tree, &key); 
+        TEST_ASSERT_EQUAL(0, bpt_count(test_tree, &key)); 
+        TEST_ASSERT_NULL(bpt_search(test_tree, &key)); 
+        bpt_delete_value(test_tree, &key); 
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, bpt_count(test_tree, &key)); 
+
+        bpt_tree_free(test_tree); 
+        bpt_tree_free(plain_tree); 
+}
+
+void test_bpt_multiset_across_leaves(void)
+{
+        int direction = 1; 
+        int a[400]; 
+        int order[400]; 
+        int *next = order; 
+        BPlusTree_T test_tree = bpt_new_multiset(&directed_comparison, &direction); 
+
+        /* enough distinct values to split leaves, each stored 1 to 3 times,
+         * inserted in an order that interleaves the copies */
+        for (int i = 0; i < 400; i++) 
+                a[i] = (i * 37) % 400; 
+        for (int copy = 0; copy < 3; copy++) {
+                for (int i = 0; i < 400; i++) {
+                        if (a[i] % 3 >= copy)
+                                bpt_insert_value(test_tree, &a[i]); 
+                }
+        }
+
+        for (int v = 0; v < 400; v++) 
+                TEST_ASSERT_EQUAL(v % 3 + 1, bpt_count(test_tree, &v)); 
+
+        /* delete once more than every count, so half the values empty their
+         * slots and the leaves have to borrow and merge */
+        for (int v = 0; v < 400; v += 2) {
+                for (int copy = 0; copy <= v % 3 + 1; copy++) 
+                        bpt_delete_value(test_tree, &v); 
+        }
+
+        for (int v = 0; v < 400; v++) 
+                TEST_ASSERT_EQUAL((v % 2 == 0) ? 0 : v % 3 + 1, bpt_count(test_tree, &v)); 
+
+        bpt_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(200, next - order); 
+        for (int i = 0; i < 200; i++) 
+                TEST_ASSERT_EQUAL(2 * i + 1, order[i]); 
+
+        bpt_tree_free(test_tree); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_bplus_tree.c");
+
+        RUN_TEST(test_bpt_new); 
+        RUN_TEST(test_bpt_insert_string); 
+        RUN_TEST(test_bpt_tree_is_empty); 
+        RUN_TEST(test_bpt_search); 
+        RUN_TEST(test_bpt_search_for_ints); 
+        RUN_TEST(test_bpt_map_inorder_string); 
+        RUN_TEST(test_bpt_sorted_inserts_stay_shallow); 
+        RUN_TEST(test_bpt_duplicates_across_leaves); 
+        RUN_TEST(test_bpt_delete_until_empty); 
+        RUN_TEST(test_bpt_delete_freed_strings); 
+        RUN_TEST(test_bpt_delete_value); 
+        RUN_TEST(test_bpt_integer_keys_every_simd_level); 
+        RUN_TEST(test_bpt_delete_many_ints); 
+        RUN_TEST(test_bpt_tree_minimum_and_maximum); 
+        RUN_TEST(test_bpt_successor_of_value); 
+        RUN_TEST(test_bpt_predecessor_of_value); 
+        RUN_TEST(test_bpt_new_r_passes_context); 
+        RUN_TEST(test_bpt_multiset_counts); 
+        RUN_TEST(test_bpt_multiset_across_leaves); 
+
+        UnityEnd();
+        return 0;
+}
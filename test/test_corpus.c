@@ -0,0 +1,200 @@
+#include "vendor/unity.h"
+#include "../src/corpus.h"
+#include <string.h>
+
+#define SCRATCH_FILE "corpus_tests.tmp"
+#define WAR_AND_PEACE "txt/war_and_peace.txt"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+        remove(SCRATCH_FILE); 
+}
+
+void write_test_file(const char *text, size_t length)
+{
+        FILE *fp = fopen(SCRATCH_FILE, "wb"); 
+
+        fwrite(text, 1, length, fp); 
+        fclose(fp); 
+}
+
+void test_corpus_open_missing_file(void)
+{
+        TEST_ASSERT_NULL(corpus_open("txt/no_such_file.txt", false)); 
+}
+
+void test_corpus_slices_point_into_mapping(void)
+{
+        const char *text = "  the quick\tbrown\n\nfox\r\n"; 
+        Word word; 
+
+        write_test_file(text, strlen(text)); 
+        Corpus_T corpus = corpus_open(SCRATCH_FILE, false); 
+        TEST_ASSERT_NOT_NULL(corpus); 
+        TEST_ASSERT_EQUAL(strlen(text), corpus_size(corpus)); 
+
+        const char *base = corpus_text(corpus); 
+        TEST_ASSERT_EQUAL_STRING(text, base); 
+
+        TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+        TEST_ASSERT_EQUAL_PTR(base + 2, word.start); 
+        TEST_ASSERT_EQUAL(3, word.length); 
+
+        TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+        TEST_ASSERT_EQUAL_PTR(base + 6, word.start); 
+        TEST_ASSERT_EQUAL(5, word.length); 
+
+        TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+        TEST_ASSERT_EQUAL(0, strncmp("brown", word.start, word.length)); 
+
+        TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+        TEST_ASSERT_EQUAL(0, strncmp("fox", word.start, word.length)); 
+        TEST_ASSERT_EQUAL(3, word.length); 
+
+        TEST_ASSERT_FALSE(corpus_next(corpus, &word)); 
+        TEST_ASSERT_FALSE(corpus_next(corpus, &word)); 
+
+        /* without terminate the text is left alone */
+        TEST_ASSERT_EQUAL_STRING(text, base); 
+
+        corpus_close(corpus); 
+}
+
+void test_corpus_terminate_leaves_file_alone(void)
+{
+        const char *text = "hello world\nlast"; 
+        char *words[] = { "hello", "world", "last" }; 
+        Word word; 
+
+        write_test_file(text, strlen(text)); 
+        Corpus_T corpus = corpus_open(SCRATCH_FILE, true); 
+
+        for (int pass = 0; pass < 2; pass++) {
+                for (int i = 0; i < 3; i++) {
+                        TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+                        TEST_ASSERT_EQUAL_STRING(words[i], word.start); 
+                        TEST_ASSERT_EQUAL(strlen(words[i]), word.length); 
+                }
+                TEST_ASSERT_FALSE(corpus_next(corpus, &word)); 
+                corpus_rewind(corpus); 
+        }
+
+        corpus_close(corpus); 
+
+        /* the nuls went to private pages only */
+        char buffer[32] = { 0 }; 
+        FILE *fp = fopen(SCRATCH_FILE, "rb"); 
+        size_t bytes = fread(buffer, 1, sizeof(buffer) - 1, fp); 
+        fclose(fp); 
+
+        TEST_ASSERT_EQUAL(strlen(text), bytes); 
+        TEST_ASSERT_EQUAL_STRING(text, buffer); 
+}
+
+void test_corpus_empty_and_page_sized_files(void)
+{
+        Word word; 
+
+        write_test_file("", 0); 
+        Corpus_T corpus = corpus_open(SCRATCH_FILE, true); 
+        TEST_ASSERT_NOT_NULL(corpus); 
+        TEST_ASSERT_EQUAL(0, corpus_size(corpus)); 
+        TEST_ASSERT_FALSE(corpus_next(corpus, &word)); 
+        corpus_close(corpus); 
+
+        /* a word running to the end of a page sized file is still terminated */
+        size_t length = 4096 * 2; 
+        char *text = malloc(length); 
+        memset(text, 'a', length); 
+        text[0] = ' '; 
+        write_test_file(text, length); 
+
+        corpus = corpus_open(SCRATCH_FILE, true); 
+        TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+        TEST_ASSERT_EQUAL(length - 1, word.length); 
+        TEST_ASSERT_EQUAL(length - 1, strlen(word.start)); 
+        TEST_ASSERT_FALSE(corpus_next(corpus, &word)); 
+        corpus_close(corpus); 
+
+        free(text); 
+}
+
+void test_corpus_matches_strtok_on_war_and_peace(void)
+{
+        FILE *fp = fopen(WAR_AND_PEACE, "rb"); 
+        TEST_ASSERT_NOT_NULL(fp); 
+
+        fseek(fp, 0, SEEK_END); 
+        long size = ftell(fp); 
+        fseek(fp, 0, SEEK_SET); 
+
+        char *buffer = malloc(size + 1); 
+        size_t bytes = fread(buffer, 1, size, fp); 
+        buffer[bytes] = '\0'; 
+        fclose(fp); 
+
+        Corpus_T corpus = corpus_open(WAR_AND_PEACE, true); 
+        TEST_ASSERT_EQUAL(bytes, corpus_size(corpus)); 
+
+        Word word; 
+        size_t count = 0; 
+
+        for (char *expected = strtok(buffer, " \t\r\n\v\f"); expected != NULL; 
+             expected = strtok(NULL, " \t\r\n\v\f")) {
+                TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+                TEST_ASSERT_EQUAL_STRING(expected, word.start); 
+                count++; 
+        }
+
+        TEST_ASSERT_FALSE(corpus_next(corpus, &word)); 
+        TEST_ASSERT_TRUE(count > 500000); 
+
+        corpus_close(corpus); 
+        free(buffer); 
+}
+
+void test_corpus_split_words_agrees_with_next(void)
+{
+        Corpus_T corpus = corpus_open(WAR_AND_PEACE, true); 
+        char **words = malloc((corpus_size(corpus) / 2 + 1) * sizeof(char *)); 
+        size_t count = corpus_split_words(corpus, words); 
+        Word word; 
+
+        TEST_ASSERT_TRUE(count > 500000); 
+
+        corpus_rewind(corpus); 
+        for (size_t i = 0; i < count; i++) {
+                TEST_ASSERT_TRUE(corpus_next(corpus, &word)); 
+                TEST_ASSERT_EQUAL_PTR(words[i], word.start); 
+                TEST_ASSERT_EQUAL(strlen(words[i]), word.length); 
+
+                for (size_t j = 0; j < word.length; j++) {
+                        unsigned char c = (unsigned char) word.start[j]; 
+                        TEST_ASSERT_TRUE((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || 
+                                         c >= 0x80); 
+                }
+        }
+        TEST_ASSERT_FALSE(corpus_next(corpus, &word)); 
+
+        free(words); 
+        corpus_close(corpus); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_corpus.c");
+
+        RUN_TEST(test_corpus_open_missing_file); 
+        RUN_TEST(test_corpus_slices_point_into_mapping); 
+        RUN_TEST(test_corpus_terminate_leaves_file_alone); 
+        RUN_TEST(test_corpus_empty_and_page_sized_files); 
+        RUN_TEST(test_corpus_matches_strtok_on_war_and_peace); 
+        RUN_TEST(test_corpus_split_words_agrees_with_next); 
+
+        UnityEnd();
+        return 0;
+}
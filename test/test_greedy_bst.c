@@ -0,0 +1,137 @@
+#include "vendor/unity.h"
+#include "../src/greedy_bst.h"
+#include "../src/wilber.h"
+#include "../src/prng.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*
+ * reference implementation straight from the geometric definition: a
+ * point (y, t) is added whenever the rectangle it spans with the access
+ * point holds no other point. quadratic in the number of points, but
+ * obviously right
+ */
+size_t naive_greedy(const size_t *keys, size_t m, size_t n)
+{
+        bool *points = calloc(m * n, sizeof(bool)); 
+        size_t cost = 0; 
+
+        for (size_t t = 0; t < m; t++) {
+                size_t x = keys[t]; 
+                bool *row = &points[t * n]; 
+
+                row[x] = true; 
+                cost++; 
+
+                for (size_t y = 0; y < n; y++) {
+                        if (y == x)
+                                continue; 
+
+                        size_t lo = (y < x) ? y : x; 
+                        size_t hi = (y < x) ? x : y; 
+
+                        /* the latest earlier point in column y is the other corner */
+                        size_t s = t; 
+                        while (s > 0 && !points[(s - 1) * n + y]) 
+                                s--; 
+                        if (s == 0)
+                                continue; 
+                        s--; 
+
+                        bool empty = true; 
+                        for (size_t r = s; r < t && empty; r++) {
+                                for (size_t z = lo; z <= hi && empty; z++) {
+                                        if ((r != s || z != y) && points[r * n + z])
+                                                empty = false; 
+                                }
+                        }
+
+                        if (empty) {
+                                row[y] = true; 
+                                cost++; 
+                        }
+                }
+        }
+
+        free(points); 
+
+        return cost; 
+}
+
+void test_greedy_empty_sequence(void)
+{
+        TEST_ASSERT_EQUAL(0, greedy_bst_cost(NULL, 0, 10)); 
+}
+
+void test_greedy_repeated_key(void)
+{
+        size_t keys[50]; 
+        for (int i = 0; i < 50; i++) 
+                keys[i] = 5; 
+
+        TEST_ASSERT_EQUAL(50, greedy_bst_cost(keys, 50, 16)); 
+}
+
+void test_greedy_sequential(void)
+{
+        /* each access touches only itself and the key before it */
+        size_t keys[1000]; 
+        for (int i = 0; i < 1000; i++) 
+                keys[i] = i; 
+
+        TEST_ASSERT_EQUAL(2 * 1000 - 1, greedy_bst_cost(keys, 1000, 1000)); 
+        TEST_ASSERT_EQUAL(naive_greedy(keys, 100, 100), greedy_bst_cost(keys, 100, 100)); 
+}
+
+void test_greedy_above_lower_bounds(void)
+{
+        size_t keys[1024]; 
+        for (size_t i = 0; i < 1024; i++) {
+                size_t r = 0; 
+                for (int b = 0; b < 10; b++) 
+                        r |= ((i >> b) & 1) << (9 - b); 
+                keys[i] = r; 
+        }
+
+        size_t cost = greedy_bst_cost(keys, 1024, 1024); 
+
+        /* any BST pays at least half the interleaves, less n */
+        TEST_ASSERT_TRUE(cost >= wilber_interleave_bound(keys, 1024, 1024) / 2); 
+        TEST_ASSERT_TRUE(cost >= wilber_funnel_bound(keys, 1024, 1024) / 2); 
+        TEST_ASSERT_TRUE(cost > 1024 * 4); 
+}
+
+void test_greedy_matches_definition(void)
+{
+        uint64_t state = PRNG_DEFAULT_SEED; 
+        size_t keys[200]; 
+
+        for (int round = 0; round < 20; round++) {
+                size_t n = 1 + prng_next(&state) % 40; 
+
+                for (int i = 0; i < 200; i++) 
+                        keys[i] = prng_next(&state) % n; 
+
+                TEST_ASSERT_EQUAL(naive_greedy(keys, 200, n), greedy_bst_cost(keys, 200, n)); 
+        }
+}
+
+int main(void)
+{
+        UnityBegin("test/test_greedy_bst.c");
+
+        RUN_TEST(test_greedy_empty_sequence); 
+        RUN_TEST(test_greedy_repeated_key); 
+        RUN_TEST(test_greedy_sequential); 
+        RUN_TEST(test_greedy_above_lower_bounds); 
+        RUN_TEST(test_greedy_matches_definition); 
+
+        UnityEnd();
+        return 0;
+}
@@ -0,0 +1,170 @@
+#include "vendor/unity.h"
+#include "../src/ingest.h"
+#include "../src/spsc_ring.h"
+#include "../src/corpus.h"
+#include "../src/rb_tree.h"
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define WAR_AND_PEACE "txt/war_and_peace.txt"
+#define TRANSFERS 100000
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int insert_rb(void *tree, void *value)
+{
+        return rb_insert_value((RedBlack_T) tree, value); 
+}
+
+void function_to_apply_record_string(void *value, int depth, void *cl)
+{
+        char ***next = (char ***) cl; 
+
+        (void) depth; 
+        *(*next)++ = value; 
+}
+
+void test_spsc_push_pop_in_order(void)
+{
+        SPSC_Ring_T ring = spsc_new(5); 
+        void *item; 
+
+        TEST_ASSERT_EQUAL(8, spsc_capacity(ring)); 
+        TEST_ASSERT_FALSE(spsc_pop(ring, &item)); 
+
+        for (int round = 0; round < 3; round++) {
+                for (uintptr_t i = 0; i < 8; i++)
+                        TEST_ASSERT_TRUE(spsc_push(ring, (void *) i)); 
+                TEST_ASSERT_FALSE(spsc_push(ring, (void *) 8)); 
+
+                for (uintptr_t i = 0; i < 8; i++) {
+                        TEST_ASSERT_TRUE(spsc_pop(ring, &item)); 
+                        TEST_ASSERT_EQUAL_PTR((void *) i, item); 
+                }
+                TEST_ASSERT_FALSE(spsc_pop(ring, &item)); 
+        }
+
+        spsc_free(ring); 
+}
+
+void *producer(void *ring)
+{
+        for (uintptr_t i = 1; i <= TRANSFERS; i++) {
+                while (!spsc_push(ring, (void *) i))
+                        sched_yield(); 
+        }
+
+        return NULL; 
+}
+
+void test_spsc_between_threads(void)
+{
+        SPSC_Ring_T ring = spsc_new(16); 
+        pthread_t thread; 
+        uintptr_t expected = 1; 
+        void *item; 
+
+        TEST_ASSERT_EQUAL(0, pthread_create(&thread, NULL, producer, ring)); 
+
+        while (expected <= TRANSFERS) {
+                if (!spsc_pop(ring, &item)) {
+                        sched_yield(); 
+                } else if ((uintptr_t) item != expected) {
+                        break; 
+                } else {
+                        expected++; 
+                }
+        }
+
+        pthread_join(thread, NULL); 
+        TEST_ASSERT_EQUAL(TRANSFERS + 1, expected); 
+        TEST_ASSERT_FALSE(spsc_pop(ring, &item)); 
+
+        spsc_free(ring); 
+}
+
+void test_ingest_missing_corpus(void)
+{
+        InternPool_T pool = intern_new(); 
+        RedBlack_T tree = rb_new(NULL); 
+        Ingest_Result result; 
+
+        TEST_ASSERT_FALSE(ingest_corpus("txt/no_such_file.txt", pool, insert_rb, tree, 
+                                        INGEST_PIPELINED, &result)); 
+
+        rb_tree_free(tree); 
+        intern_free(pool); 
+}
+
+void test_ingest_pipelined_matches_sequential(void)
+{
+        Ingest_Mode modes[] = { INGEST_SEQUENTIAL, INGEST_PIPELINED }; 
+        InternPool_T pools[2]; 
+        RedBlack_T trees[2]; 
+        Ingest_Result results[2]; 
+
+        for (int m = 0; m < 2; m++) {
+                pools[m] = intern_new(); 
+                trees[m] = rb_new(NULL); 
+                TEST_ASSERT_TRUE(ingest_corpus(WAR_AND_PEACE, pools[m], insert_rb, trees[m], 
+                                               modes[m], &results[m])); 
+        }
+
+        /* the same words as splitting the whole corpus at once */
+        Corpus_T corpus = corpus_open(WAR_AND_PEACE, true); 
+        char **words = malloc((corpus_size(corpus) / 2 + 1) * sizeof(char *)); 
+        size_t count = corpus_split_words(corpus, words); 
+
+        TEST_ASSERT_TRUE(results[0].batches > 1); 
+        TEST_ASSERT_EQUAL(results[0].batches, results[1].batches); 
+        TEST_ASSERT_EQUAL(count, results[0].count); 
+        TEST_ASSERT_EQUAL(count, results[1].count); 
+        TEST_ASSERT_EQUAL(intern_count(pools[0]), intern_count(pools[1])); 
+
+        for (size_t i = 0; i < count; i++) {
+                TEST_ASSERT_EQUAL_STRING(words[i], results[0].words[i]); 
+                TEST_ASSERT_EQUAL_STRING(words[i], results[1].words[i]); 
+                TEST_ASSERT_EQUAL_PTR(results[1].words[i], 
+                                      intern_lookup(pools[1], words[i], strlen(words[i]))); 
+        }
+
+        /* and both trees hold them in the same order */
+        char **sorted[2]; 
+        for (int m = 0; m < 2; m++) {
+                char **next = sorted[m] = malloc(count * sizeof(char *)); 
+                rb_map_inorder(trees[m], function_to_apply_record_string, &next); 
+                TEST_ASSERT_EQUAL(count, (size_t) (next - sorted[m])); 
+        }
+        for (size_t i = 0; i < count; i++)
+                TEST_ASSERT_EQUAL_STRING(sorted[0][i], sorted[1][i]); 
+
+        for (int m = 0; m < 2; m++) {
+                free(sorted[m]); 
+                free(results[m].words); 
+                rb_tree_free(trees[m]); 
+                intern_free(pools[m]); 
+        }
+        free(words); 
+        corpus_close(corpus); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_ingest.c");
+
+        RUN_TEST(test_spsc_push_pop_in_order); 
+        RUN_TEST(test_spsc_between_threads); 
+        RUN_TEST(test_ingest_missing_corpus); 
+        RUN_TEST(test_ingest_pipelined_matches_sequential); 
+
+        UnityEnd();
+        return 0;
+}
@@ -0,0 +1,185 @@
+#include "vendor/unity.h"
+#include "../src/intern_pool.h"
+#include "../src/rb_tree.h"
+#include <string.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_intern_new(void)
+{
+        InternPool_T pool = intern_new(); 
+        TEST_ASSERT_NOT_NULL(pool); 
+        TEST_ASSERT_EQUAL(0, intern_count(pool)); 
+
+        intern_free(pool); 
+}
+
+void test_intern_equal_strings_share_a_pointer(void)
+{
+        InternPool_T pool = intern_new(); 
+        char buffer[] = "hello world hello"; 
+
+        const char *first = intern_string(pool, buffer, 5); 
+        const char *second = intern_string(pool, buffer + 12, 5); 
+        const char *other = intern_string(pool, buffer + 6, 5); 
+
+        TEST_ASSERT_EQUAL_PTR(first, second); 
+        TEST_ASSERT_TRUE(first != other); 
+        TEST_ASSERT_EQUAL_STRING("hello", first); 
+        TEST_ASSERT_EQUAL_STRING("world", other); 
+        TEST_ASSERT_TRUE(first != buffer); 
+        TEST_ASSERT_EQUAL(2, intern_count(pool)); 
+
+        TEST_ASSERT_EQUAL_PTR(first, intern_lookup(pool, "hello", 5)); 
+        TEST_ASSERT_NULL(intern_lookup(pool, "hell", 4)); 
+        TEST_ASSERT_EQUAL(2, intern_count(pool)); 
+
+        intern_free(pool); 
+}
+
+void test_intern_empty_and_long_strings(void)
+{
+        InternPool_T pool = intern_new(); 
+        size_t length = 200 * 1024; 
+        char *big = malloc(length); 
+
+        memset(big, 'x', length); 
+
+        const char *empty = intern_string(pool, NULL, 0); 
+        const char *a = intern_string(pool, "a", 1); 
+        const char *huge = intern_string(pool, big, length); 
+        const char *b = intern_string(pool, "b", 1); 
+
+        TEST_ASSERT_EQUAL_STRING("", empty); 
+        TEST_ASSERT_EQUAL_PTR(empty, intern_string(pool, "", 0)); 
+        TEST_ASSERT_EQUAL(length, strlen(huge)); 
+        TEST_ASSERT_EQUAL_PTR(huge, intern_string(pool, big, length)); 
+        TEST_ASSERT_EQUAL_STRING("a", a); 
+        TEST_ASSERT_EQUAL_STRING("b", b); 
+        TEST_ASSERT_TRUE(intern_bytes(pool) > length); 
+
+        free(big); 
+        intern_free(pool); 
+}
+
+void test_intern_pointers_stable_across_growth(void)
+{
+        InternPool_T pool = intern_new(); 
+        const char *interned[20000]; 
+        char word[16]; 
+
+        for (int i = 0; i < 20000; i++) {
+                sprintf(word, "w%d", i); 
+                interned[i] = intern_string(pool, word, strlen(word)); 
+        }
+
+        TEST_ASSERT_EQUAL(20000, intern_count(pool)); 
+
+        for (int i = 0; i < 20000; i++) {
+                sprintf(word, "w%d", i); 
+                TEST_ASSERT_EQUAL_PTR(interned[i], intern_string(pool, word, strlen(word))); 
+                TEST_ASSERT_EQUAL_STRING(word, interned[i]); 
+        }
+
+        TEST_ASSERT_EQUAL(20000, intern_count(pool)); 
+
+        intern_free(pool); 
+}
+
+void test_intern_ids_follow_strcmp(void)
+{
+        InternPool_T pool = intern_new(); 
+        char *words[] = { "pear", "apple", "zoo", "", "apples", "Zebra", "app" }; 
+        size_t count = sizeof(words) / sizeof(words[0]); 
+        const char *interned[7]; 
+
+        for (size_t i = 0; i < count; i++)
+                interned[i] = intern_string(pool, words[i], strlen(words[i])); 
+
+        TEST_ASSERT_EQUAL_UINT32(INTERN_NO_ID, intern_id(interned[0])); 
+
+        intern_assign_ids(pool); 
+
+        for (size_t i = 0; i < count; i++) {
+                TEST_ASSERT_TRUE(intern_id(interned[i]) < count); 
+                for (size_t j = 0; j < count; j++) {
+                        int expected = strcmp(words[i], words[j]); 
+                        int actual = intern_id_comparison(interned[i], interned[j], NULL); 
+
+                        TEST_ASSERT_EQUAL((expected > 0) - (expected < 0), actual); 
+                }
+        }
+
+        /* strings interned later have no id until the next assignment */
+        const char *late = intern_string(pool, "banana", 6); 
+        TEST_ASSERT_EQUAL_UINT32(INTERN_NO_ID, intern_id(late)); 
+
+        intern_assign_ids(pool); 
+        TEST_ASSERT_EQUAL_UINT32(5, intern_id(late)); 
+        TEST_ASSERT_EQUAL_UINT32(7, intern_id(intern_lookup(pool, "zoo", 3))); 
+
+        intern_free(pool); 
+}
+
+void function_to_apply_record_string(void *value, int depth, void *cl)
+{
+        const char ***next = (const char ***) cl; 
+
+        (void) depth; 
+        *(*next)++ = value; 
+}
+
+void test_intern_ids_order_a_tree(void)
+{
+        InternPool_T pool = intern_new(); 
+        char text[] = "the cat sat on the mat and the dog sat on the cat"; 
+        const char *sorted[16]; 
+        const char **next = sorted; 
+        RedBlack_T tree = rb_new_r(intern_id_comparison, NULL); 
+
+        for (char *word = strtok(text, " "); word != NULL; word = strtok(NULL, " "))
+                intern_string(pool, word, strlen(word)); 
+        intern_assign_ids(pool); 
+
+        char *words[] = { "on", "the", "cat", "sat", "mat", "and", "dog" }; 
+        for (size_t i = 0; i < 7; i++)
+                rb_insert_value(tree, (void *) intern_lookup(pool, words[i], strlen(words[i]))); 
+
+        rb_map_inorder(tree, function_to_apply_record_string, &next); 
+
+        TEST_ASSERT_EQUAL(7, next - sorted); 
+        TEST_ASSERT_EQUAL_STRING("and", sorted[0]); 
+        TEST_ASSERT_EQUAL_STRING("cat", sorted[1]); 
+        TEST_ASSERT_EQUAL_STRING("dog", sorted[2]); 
+        TEST_ASSERT_EQUAL_STRING("mat", sorted[3]); 
+        TEST_ASSERT_EQUAL_STRING("on", sorted[4]); 
+        TEST_ASSERT_EQUAL_STRING("sat", sorted[5]); 
+        TEST_ASSERT_EQUAL_STRING("the", sorted[6]); 
+
+        const char *cat = intern_lookup(pool, "cat", 3); 
+        TEST_ASSERT_EQUAL_PTR(cat, rb_search(tree, (void *) cat)); 
+
+        rb_tree_free(tree); 
+        intern_free(pool); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_intern_pool.c");
+
+        RUN_TEST(test_intern_new); 
+        RUN_TEST(test_intern_equal_strings_share_a_pointer); 
+        RUN_TEST(test_intern_empty_and_long_strings); 
+        RUN_TEST(test_intern_pointers_stable_across_growth); 
+        RUN_TEST(test_intern_ids_follow_strcmp); 
+        RUN_TEST(test_intern_ids_order_a_tree); 
+
+        UnityEnd();
+        return 0;
+}
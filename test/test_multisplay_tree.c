@@ -0,0 +1,466 @@
+#include "vendor/unity.h"
+#include "../src/multisplay_tree.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int integer_comparison(void *val_one, void *val_two)
+{
+        if (*(int *) val_one == *(int *) val_two) {
+                return 0; 
+        } else if (*(int *) val_one > *(int *) val_two) {
+                return 1; 
+        } else {
+                return -1; 
+        }
+}
+
+struct int_closure {
+        int index; 
+        int max_depth; 
+        int values[1000]; 
+        int depths[1000]; 
+};
+
+void function_to_apply_record_ints(void *value, int depth, void *cl)
+{
+        struct int_closure *closure = (struct int_closure *) cl; 
+
+        closure->values[closure->index] = *(int *) value; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+
+        if (depth > closure->max_depth)
+                closure->max_depth = depth; 
+}
+
+struct string_closure_size_six {
+        int index; 
+        char *word_ray[6]; 
+};
+
+void function_to_apply_test_map_string(void *value, int depth, void *cl)
+{
+        struct string_closure_size_six *closure = (struct string_closure_size_six *) cl; 
+
+        (void) depth; 
+        closure->word_ray[closure->index] = value; 
+        closure->index++; 
+}
+
+void test_multisplay_new(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL);
+        TEST_ASSERT_NOT_NULL(test_tree);
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_insert_string(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL);
+        TEST_ASSERT_EQUAL(0, multisplay_insert_value(test_tree, "Hello")); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_is_empty(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL);
+        TEST_ASSERT_TRUE(multisplay_is_empty(test_tree));
+
+        multisplay_insert_value(test_tree, "hello");
+        TEST_ASSERT_FALSE(multisplay_is_empty(test_tree)); 
+
+        multisplay_delete_value(test_tree, "hello");
+        TEST_ASSERT_TRUE(multisplay_is_empty(test_tree)); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_search(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL); 
+
+        multisplay_insert_value(test_tree, "a"); 
+        TEST_ASSERT_EQUAL_STRING("a", multisplay_search(test_tree, "a")); 
+
+        TEST_ASSERT_NULL(multisplay_search(test_tree, "b")); 
+        multisplay_insert_value(test_tree, "b"); 
+        TEST_ASSERT_EQUAL_STRING("b", multisplay_search(test_tree, "b")); 
+
+        TEST_ASSERT_NULL(multisplay_search(test_tree, "hello")); 
+        multisplay_insert_value(test_tree, "hello"); 
+        TEST_ASSERT_EQUAL_STRING("hello", multisplay_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("a", multisplay_search(test_tree, "a")); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_search_for_ints(void)
+{
+        MultiSplay_T test_tree = multisplay_new(&integer_comparison);
+
+        int a[] = { 214, 25, 64, 4, 7, 729, 34, 28, 9, 11};
+
+        for (int i = 0; i < 10; i++) 
+                multisplay_insert_value(test_tree, &a[i]); 
+
+        int x = 4; 
+        int y = 9; 
+        int z = 70000000; 
+
+        TEST_ASSERT_EQUAL(x, *(int *) multisplay_search(test_tree, &x)); 
+        TEST_ASSERT_EQUAL(y, *(int *) multisplay_search(test_tree, &y)); 
+        TEST_ASSERT_NULL(multisplay_search(test_tree, &z)); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_map_inorder_string(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL); 
+
+        char *expected_words[] = {"earth", "hello", "hello", "says", "the", "world"};
+        char *word_ray[] = {"hello", "world", "the", "earth", "says", "hello"}; 
+
+        for (int i = 0; i < 6; i++) 
+                multisplay_insert_value(test_tree, word_ray[i]); 
+
+        struct string_closure_size_six cl; 
+        cl.index = 0; 
+        
+        multisplay_map_inorder(test_tree, &function_to_apply_test_map_string, &cl);
+
+        TEST_ASSERT_EQUAL(6, cl.index); 
+        for (int i = 0; i < 6; i++) 
+                TEST_ASSERT_EQUAL_STRING(expected_words[i], cl.word_ray[i]);  
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_access_moves_to_root(void)
+{
+        MultiSplay_T test_tree = multisplay_new(&integer_comparison); 
+
+        int a[100]; 
+        for (int i = 0; i < 100; i++) {
+                a[i] = (i * 37) % 100; 
+                multisplay_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 100; i += 9) {
+                struct int_closure cl = { 0, 0, {0}, {0} }; 
+
+                TEST_ASSERT_EQUAL(i, *(int *) multisplay_search(test_tree, &i)); 
+                multisplay_map_preorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+                TEST_ASSERT_EQUAL(100, cl.index); 
+                TEST_ASSERT_EQUAL(i, cl.values[0]); 
+                TEST_ASSERT_EQUAL(0, cl.depths[0]); 
+        }
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_rebalance(void)
+{
+        MultiSplay_T test_tree = multisplay_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = i; 
+                multisplay_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 1000; i += 3) 
+                multisplay_delete_value(test_tree, &i); 
+
+        multisplay_rebalance(test_tree); 
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        multisplay_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(666, cl.index); 
+        for (int i = 0; i < 666; i++) 
+                TEST_ASSERT_EQUAL(3 * (i / 2) + 1 + i % 2, cl.values[i]); 
+
+        /* perfectly balanced over 666 values */
+        TEST_ASSERT_EQUAL(9, cl.max_depth); 
+
+        for (int i = 1; i < 1000; i += 3) 
+                TEST_ASSERT_EQUAL(i, *(int *) multisplay_search(test_tree, &i)); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_delete_value(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL); 
+        multisplay_insert_value(test_tree, "hello"); 
+        multisplay_insert_value(test_tree, "world");
+        multisplay_insert_value(test_tree, "the");
+        multisplay_insert_value(test_tree, "earth");
+        multisplay_insert_value(test_tree, "says");
+
+        multisplay_delete_value(test_tree, "hello"); 
+        TEST_ASSERT_NULL(multisplay_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("world", multisplay_search(test_tree, "world"));
+        TEST_ASSERT_EQUAL_STRING("the", multisplay_search(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("earth", multisplay_search(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("says", multisplay_search(test_tree, "says"));
+
+        multisplay_delete_value(test_tree, "not_in_tree"); 
+        TEST_ASSERT_EQUAL_STRING("world", multisplay_search(test_tree, "world"));
+
+        multisplay_delete_value(test_tree, "the"); 
+        multisplay_delete_value(test_tree, "earth"); 
+        multisplay_delete_value(test_tree, "world"); 
+        TEST_ASSERT_EQUAL_STRING("says", multisplay_search(test_tree, "says"));
+
+        multisplay_delete_value(test_tree, "says"); 
+        TEST_ASSERT_TRUE(multisplay_is_empty(test_tree)); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_delete_many_ints(void)
+{
+        MultiSplay_T test_tree = multisplay_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 389) % 1000; 
+                multisplay_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 1000; i += 2) 
+                multisplay_delete_value(test_tree, &i); 
+
+        for (int i = 0; i < 1000; i++) {
+                if (i % 2 == 0) {
+                        TEST_ASSERT_NULL(multisplay_search(test_tree, &i)); 
+                } else {
+                        TEST_ASSERT_EQUAL(i, *(int *) multisplay_search(test_tree, &i)); 
+                }
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        multisplay_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(500, cl.index); 
+        for (int i = 0; i < 500; i++) 
+                TEST_ASSERT_EQUAL(2 * i + 1, cl.values[i]); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_tree_minimum_and_maximum(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL); 
+        TEST_ASSERT_NULL(multisplay_tree_minimum(test_tree)); 
+        TEST_ASSERT_NULL(multisplay_tree_maximum(test_tree)); 
+
+        multisplay_insert_value(test_tree, "hello"); 
+        multisplay_insert_value(test_tree, "world");
+        multisplay_insert_value(test_tree, "the");
+        multisplay_insert_value(test_tree, "earth");
+        multisplay_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("earth", multisplay_tree_minimum(test_tree)); 
+        TEST_ASSERT_EQUAL_STRING("world", multisplay_tree_maximum(test_tree)); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_successor_of_value(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL); 
+        multisplay_insert_value(test_tree, "hello"); 
+        multisplay_insert_value(test_tree, "world");
+        multisplay_insert_value(test_tree, "the");
+        multisplay_insert_value(test_tree, "earth");
+        multisplay_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("world", multisplay_successor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", multisplay_successor_of_value(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("the", multisplay_successor_of_value(test_tree, "says")); 
+        TEST_ASSERT_EQUAL_STRING("says", multisplay_successor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(multisplay_successor_of_value(test_tree, "world"));
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_predecessor_of_value(void)
+{
+        MultiSplay_T test_tree = multisplay_new(NULL); 
+        multisplay_insert_value(test_tree, "hello"); 
+        multisplay_insert_value(test_tree, "world");
+        multisplay_insert_value(test_tree, "the");
+        multisplay_insert_value(test_tree, "earth");
+        multisplay_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("says", multisplay_predecessor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", multisplay_predecessor_of_value(test_tree, "says"));
+        TEST_ASSERT_EQUAL_STRING("earth", multisplay_predecessor_of_value(test_tree, "hello"));  
+        TEST_ASSERT_EQUAL_STRING("hello", multisplay_predecessor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(multisplay_predecessor_of_value(test_tree, "earth"));
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_duplicates(void)
+{
+        MultiSplay_T test_tree = multisplay_new(&integer_comparison); 
+
+        int a[30]; 
+        for (int i = 0; i < 30; i++) {
+                a[i] = (i / 10) * 5; 
+                multisplay_insert_value(test_tree, &a[i]); 
+        }
+
+        int five = 5; 
+        TEST_ASSERT_EQUAL(10, *(int *) multisplay_successor_of_value(test_tree, &five)); 
+        TEST_ASSERT_EQUAL(0, *(int *) multisplay_predecessor_of_value(test_tree, &five)); 
+
+        for (int i = 0; i < 10; i++) {
+                TEST_ASSERT_EQUAL(5, *(int *) multisplay_search(test_tree, &five)); 
+                multisplay_delete_value(test_tree, &five); 
+        }
+        TEST_ASSERT_NULL(multisplay_search(test_tree, &five)); 
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        multisplay_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(20, cl.index); 
+        for (int i = 0; i < 20; i++) 
+                TEST_ASSERT_EQUAL((i < 10) ? 0 : 10, cl.values[i]); 
+
+        multisplay_free(test_tree); 
+}
+
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void function_to_apply_record_order(void *value, int depth, void *cl)
+{
+        int **next = (int **) cl; 
+
+        (void) depth; 
+        *(*next)++ = *(int *) value; 
+}
+
+void test_multisplay_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        int order[100]; 
+        int *next = order; 
+        MultiSplay_T test_tree = multisplay_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                multisplay_insert_value(test_tree, &a[i]); 
+        }
+
+        multisplay_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(100, next - order); 
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, order[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) multisplay_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) multisplay_successor_of_value(test_tree, &key)); 
+
+        multisplay_free(test_tree); 
+}
+
+void test_multisplay_multiset_counts(void)
+{
+        int direction = 1; 
+        int a[10]; 
+        int order[10]; 
+        int *next = order; 
+        int key; 
+        MultiSplay_T test_tree = multisplay_new_multiset(&directed_comparison, &direction); 
+        MultiSplay_T plain_tree = multisplay_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 10; i++) {
+                a[i] = i / 3; 
+                multisplay_insert_value(test_tree, &a[i]); 
+                multisplay_insert_value(plain_tree, &a[i]); 
+        }
+
+        /* the rebuild keeps each node's count */
+        multisplay_rebalance(test_tree); 
+        multisplay_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(4, next - order); 
+        for (int i = 0; i < 4; i++) 
+                TEST_ASSERT_EQUAL(i, order[i]); 
+
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, multisplay_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(3, multisplay_count(plain_tree, &key)); 
+        TEST_ASSERT_EQUAL_PTR(&a[3], multisplay_search(test_tree, &key)); 
+        key = 3; 
+        TEST_ASSERT_EQUAL(1, multisplay_count(test_tree, &key)); 
+        key = 7; 
+        TEST_ASSERT_EQUAL(0, multisplay_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(0, multisplay_count(plain_tree, &key)); 
+
+        key = 0; 
+        multisplay_delete_value(test_tree, &key); 
+        multisplay_delete_value(test_tree, &key); 
+        multisplay_delete_value(plain_tree, &key); 
+        TEST_ASSERT_EQUAL(1, multisplay_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(2, multisplay_count(plain_tree, &key)); 
+        TEST_ASSERT_NOT_NULL(multisplay_search(test_tree, &key)); 
+
+        multisplay_delete_value(test_tree, &key); 
+        TEST_ASSERT_EQUAL(0, multisplay_count(test_tree, &key)); 
+        TEST_ASSERT_NULL(multisplay_search(test_tree, &key)); 
+        multisplay_delete_value(test_tree, &key); 
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, multisplay_count(test_tree, &key)); 
+
+        multisplay_free(test_tree); 
+        multisplay_free(plain_tree); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_multisplay_tree.c");
+
+        RUN_TEST(test_multisplay_new); 
+        RUN_TEST(test_multisplay_insert_string); 
+        RUN_TEST(test_multisplay_is_empty); 
+        RUN_TEST(test_multisplay_search); 
+        RUN_TEST(test_multisplay_search_for_ints); 
+        RUN_TEST(test_multisplay_map_inorder_string); 
+        RUN_TEST(test_multisplay_access_moves_to_root); 
+        RUN_TEST(test_multisplay_rebalance); 
+        RUN_TEST(test_multisplay_delete_value); 
+        RUN_TEST(test_multisplay_delete_many_ints); 
+        RUN_TEST(test_multisplay_duplicates); 
+        RUN_TEST(test_multisplay_tree_minimum_and_maximum); 
+        RUN_TEST(test_multisplay_successor_of_value); 
+        RUN_TEST(test_multisplay_predecessor_of_value); 
+        RUN_TEST(test_multisplay_new_r_passes_context); 
+        RUN_TEST(test_multisplay_multiset_counts); 
+
+        UnityEnd();
+        return 0;
+}
@@ -0,0 +1,295 @@
+#include "vendor/unity.h"
+#include "../src/optimal_bst.h"
+#include "../src/prng.h"
+#include <math.h>
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int integer_comparison(void *val_one, void *val_two)
+{
+        if (*(int *) val_one == *(int *) val_two) {
+                return 0; 
+        } else if (*(int *) val_one > *(int *) val_two) {
+                return 1; 
+        } else {
+                return -1; 
+        }
+}
+
+struct int_closure {
+        int index; 
+        int max_depth; 
+        int values[1000]; 
+        int depths[1000]; 
+};
+
+void function_to_apply_record_ints(void *value, int depth, void *cl)
+{
+        struct int_closure *closure = (struct int_closure *) cl; 
+
+        closure->values[closure->index] = *(int *) value; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+
+        if (depth > closure->max_depth)
+                closure->max_depth = depth; 
+}
+
+/* weighted depth + 1 of the best tree over [lo, hi), by trying every root */
+double brute_force_cost(const double *weights, int lo, int hi)
+{
+        if (lo >= hi)
+                return 0; 
+
+        double total = 0; 
+        for (int i = lo; i < hi; i++) 
+                total += weights[i]; 
+
+        double best = -1; 
+        for (int r = lo; r < hi; r++) {
+                double c = brute_force_cost(weights, lo, r) + 
+                           brute_force_cost(weights, r + 1, hi); 
+                if (best < 0 || c < best)
+                        best = c; 
+        }
+
+        return best + total; 
+}
+
+void test_optimal_bst_empty(void)
+{
+        OptimalBST_T test_tree = optimal_bst_new(NULL, NULL, 0, NULL, OPTIMAL_AUTO); 
+        TEST_ASSERT_NOT_NULL(test_tree); 
+
+        TEST_ASSERT_EQUAL(0, optimal_bst_size(test_tree)); 
+        TEST_ASSERT_NULL(optimal_bst_search(test_tree, "a")); 
+        TEST_ASSERT_NULL(optimal_bst_tree_minimum(test_tree)); 
+        TEST_ASSERT_NULL(optimal_bst_successor_of_value(test_tree, "a")); 
+
+        optimal_bst_free(test_tree); 
+}
+
+void test_optimal_bst_search_strings(void)
+{
+        char *words[] = {"earth", "hello", "says", "the", "world"}; 
+        double weights[] = {1, 10, 1, 30, 2}; 
+
+        for (int method = OPTIMAL_KNUTH; method <= OPTIMAL_MEHLHORN; method++) {
+                OptimalBST_T test_tree = optimal_bst_new((void **) words, weights, 5, NULL, 
+                                                         (Optimal_Method) method); 
+
+                for (int i = 0; i < 5; i++) 
+                        TEST_ASSERT_EQUAL_STRING(words[i], optimal_bst_search(test_tree, words[i])); 
+
+                TEST_ASSERT_NULL(optimal_bst_search(test_tree, "not_in_tree")); 
+                TEST_ASSERT_EQUAL_STRING("earth", optimal_bst_tree_minimum(test_tree)); 
+                TEST_ASSERT_EQUAL_STRING("world", optimal_bst_tree_maximum(test_tree)); 
+                TEST_ASSERT_EQUAL_STRING("the", optimal_bst_successor_of_value(test_tree, "says")); 
+                TEST_ASSERT_EQUAL_STRING("says", optimal_bst_successor_of_value(test_tree, "not_in_tree")); 
+                TEST_ASSERT_NULL(optimal_bst_successor_of_value(test_tree, "world")); 
+                TEST_ASSERT_EQUAL_STRING("hello", optimal_bst_predecessor_of_value(test_tree, "says")); 
+                TEST_ASSERT_NULL(optimal_bst_predecessor_of_value(test_tree, "earth")); 
+
+                optimal_bst_free(test_tree); 
+        }
+}
+
+void test_optimal_bst_heaviest_key_at_root(void)
+{
+        int a[100]; 
+        void *values[100]; 
+        double weights[100]; 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                values[i] = &a[i]; 
+                weights[i] = (i == 17) ? 1000 : 1; 
+        }
+
+        for (int method = OPTIMAL_KNUTH; method <= OPTIMAL_MEHLHORN; method++) {
+                OptimalBST_T test_tree = optimal_bst_new(values, weights, 100, &integer_comparison, 
+                                                         (Optimal_Method) method); 
+                struct int_closure cl = { 0, 0, {0}, {0} }; 
+
+                optimal_bst_map_preorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+                TEST_ASSERT_EQUAL(100, cl.index); 
+                TEST_ASSERT_EQUAL(17, cl.values[0]); 
+                TEST_ASSERT_EQUAL(0, cl.depths[0]); 
+
+                optimal_bst_free(test_tree); 
+        }
+}
+
+void test_optimal_bst_knuth_is_optimal(void)
+{
+        uint64_t state = PRNG_DEFAULT_SEED; 
+        int a[9]; 
+        void *values[9]; 
+        double weights[9]; 
+
+        for (int i = 0; i < 9; i++) {
+                a[i] = i; 
+                values[i] = &a[i]; 
+        }
+
+        for (int round = 0; round < 50; round++) {
+                int n = 1 + prng_next(&state) % 9; 
+                double total = 0; 
+
+                for (int i = 0; i < n; i++) {
+                        weights[i] = (double) (prng_next(&state) % 100); 
+                        total += weights[i]; 
+                }
+
+                OptimalBST_T knuth = optimal_bst_new(values, weights, n, &integer_comparison, 
+                                                     OPTIMAL_KNUTH); 
+                OptimalBST_T mehlhorn = optimal_bst_new(values, weights, n, &integer_comparison, 
+                                                        OPTIMAL_MEHLHORN); 
+
+                if (total > 0) {
+                        double best = brute_force_cost(weights, 0, n) / total; 
+
+                        TEST_ASSERT_TRUE(fabs(optimal_bst_cost(knuth) - best) < 1e-9); 
+                        TEST_ASSERT_TRUE(optimal_bst_cost(mehlhorn) >= best - 1e-9); 
+                }
+
+                optimal_bst_free(knuth); 
+                optimal_bst_free(mehlhorn); 
+        }
+}
+
+void test_optimal_bst_mehlhorn_within_entropy_bound(void)
+{
+        /* Zipf weights over 1000 keys, the shape of word frequencies */
+        int a[1000]; 
+        void *values[1000]; 
+        double weights[1000]; 
+        double total = 0; 
+        double entropy = 0; 
+
+        for (int i = 0; i < 1000; i++) {
+                a[i] = i; 
+                values[i] = &a[i]; 
+                weights[i] = 1.0 / (1 + (i * 7919) % 1000); 
+                total += weights[i]; 
+        }
+
+        for (int i = 0; i < 1000; i++) 
+                entropy -= (weights[i] / total) * log2(weights[i] / total); 
+
+        OptimalBST_T knuth = optimal_bst_new(values, weights, 1000, &integer_comparison, 
+                                             OPTIMAL_KNUTH); 
+        OptimalBST_T mehlhorn = optimal_bst_new(values, weights, 1000, &integer_comparison, 
+                                                OPTIMAL_MEHLHORN); 
+
+        TEST_ASSERT_TRUE(optimal_bst_cost(mehlhorn) >= optimal_bst_cost(knuth)); 
+        TEST_ASSERT_TRUE(optimal_bst_cost(mehlhorn) <= entropy + 2); 
+
+        /* a balanced tree over 1000 keys costs about 9 */
+        TEST_ASSERT_TRUE(optimal_bst_cost(knuth) < 8); 
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        optimal_bst_map_inorder(mehlhorn, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(1000, cl.index); 
+        for (int i = 0; i < 1000; i++) {
+                TEST_ASSERT_EQUAL(i, cl.values[i]); 
+                TEST_ASSERT_EQUAL(i, *(int *) optimal_bst_search(knuth, &i)); 
+                TEST_ASSERT_EQUAL(i, *(int *) optimal_bst_search(mehlhorn, &i)); 
+        }
+
+        optimal_bst_free(knuth); 
+        optimal_bst_free(mehlhorn); 
+}
+
+void test_optimal_bst_uniform_weights_balance(void)
+{
+        int a[1000]; 
+        void *values[1000]; 
+        double weights[1000]; 
+
+        for (int i = 0; i < 1000; i++) {
+                a[i] = 2 * i; 
+                values[i] = &a[i]; 
+                weights[i] = 1; 
+        }
+
+        OptimalBST_T test_tree = optimal_bst_new(values, weights, 1000, &integer_comparison, 
+                                                 OPTIMAL_AUTO); 
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+
+        optimal_bst_map_postorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(1000, cl.index); 
+        TEST_ASSERT_EQUAL(9, cl.max_depth); 
+        TEST_ASSERT_EQUAL(0, cl.depths[999]); 
+
+        int odd = 501; 
+        TEST_ASSERT_NULL(optimal_bst_search(test_tree, &odd)); 
+        TEST_ASSERT_EQUAL(502, *(int *) optimal_bst_successor_of_value(test_tree, &odd)); 
+        TEST_ASSERT_EQUAL(500, *(int *) optimal_bst_predecessor_of_value(test_tree, &odd)); 
+
+        optimal_bst_free(test_tree); 
+}
+
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void test_optimal_bst_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        void *values[100]; 
+        double weights[100]; 
+
+        /* ascending in the reversed order */
+        for (int i = 0; i < 100; i++) {
+                a[i] = 99 - i; 
+                values[i] = &a[i]; 
+                weights[i] = 1; 
+        }
+
+        OptimalBST_T test_tree = optimal_bst_new_r(values, weights, 100, &directed_comparison, 
+                                                   &direction, OPTIMAL_AUTO); 
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+
+        optimal_bst_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, cl.values[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) optimal_bst_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) optimal_bst_successor_of_value(test_tree, &key)); 
+
+        optimal_bst_free(test_tree); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_optimal_bst.c");
+
+        RUN_TEST(test_optimal_bst_empty); 
+        RUN_TEST(test_optimal_bst_search_strings); 
+        RUN_TEST(test_optimal_bst_heaviest_key_at_root); 
+        RUN_TEST(test_optimal_bst_knuth_is_optimal); 
+        RUN_TEST(test_optimal_bst_mehlhorn_within_entropy_bound); 
+        RUN_TEST(test_optimal_bst_uniform_weights_balance); 
+        RUN_TEST(test_optimal_bst_new_r_passes_context); 
+
+        UnityEnd();
+        return 0;
+}
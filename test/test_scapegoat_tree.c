@@ -0,0 +1,437 @@
+#include "vendor/unity.h"
+#include "../src/scapegoat_tree.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int integer_comparison(void *val_one, void *val_two)
+{
+        if (*(int *) val_one == *(int *) val_two) {
+                return 0; 
+        } else if (*(int *) val_one > *(int *) val_two) {
+                return 1; 
+        } else {
+                return -1; 
+        }
+}
+
+struct int_closure {
+        int index; 
+        int max_depth; 
+        int values[1000]; 
+        int depths[1000]; 
+};
+
+void function_to_apply_record_ints(void *value, int depth, void *cl)
+{
+        struct int_closure *closure = (struct int_closure *) cl; 
+
+        closure->values[closure->index] = *(int *) value; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+
+        if (depth > closure->max_depth)
+                closure->max_depth = depth; 
+}
+
+struct string_closure_size_six {
+        int index; 
+        char *word_ray[6]; 
+};
+
+void function_to_apply_test_map_string(void *value, int depth, void *cl)
+{
+        struct string_closure_size_six *closure = (struct string_closure_size_six *) cl; 
+
+        (void) depth; 
+        closure->word_ray[closure->index] = value; 
+        closure->index++; 
+}
+
+void test_scapegoat_new(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL);
+        TEST_ASSERT_NOT_NULL(test_tree);
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_insert_string(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL);
+        TEST_ASSERT_EQUAL(0, scapegoat_insert_value(test_tree, "Hello")); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_is_empty(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL);
+        TEST_ASSERT_TRUE(scapegoat_is_empty(test_tree));
+
+        scapegoat_insert_value(test_tree, "hello");
+        TEST_ASSERT_FALSE(scapegoat_is_empty(test_tree)); 
+
+        scapegoat_delete_value(test_tree, "hello");
+        TEST_ASSERT_TRUE(scapegoat_is_empty(test_tree)); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_search(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL); 
+
+        scapegoat_insert_value(test_tree, "a"); 
+        TEST_ASSERT_EQUAL_STRING("a", scapegoat_search(test_tree, "a")); 
+
+        TEST_ASSERT_NULL(scapegoat_search(test_tree, "b")); 
+        scapegoat_insert_value(test_tree, "b"); 
+        TEST_ASSERT_EQUAL_STRING("b", scapegoat_search(test_tree, "b")); 
+
+        TEST_ASSERT_NULL(scapegoat_search(test_tree, "hello")); 
+        scapegoat_insert_value(test_tree, "hello"); 
+        TEST_ASSERT_EQUAL_STRING("hello", scapegoat_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("a", scapegoat_search(test_tree, "a")); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_search_for_ints(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(&integer_comparison);
+
+        int a[] = { 214, 25, 64, 4, 7, 729, 34, 28, 9, 11};
+
+        for (int i = 0; i < 10; i++) 
+                scapegoat_insert_value(test_tree, &a[i]); 
+
+        int x = 4; 
+        int y = 9; 
+        int z = 70000000; 
+
+        TEST_ASSERT_EQUAL(x, *(int *) scapegoat_search(test_tree, &x)); 
+        TEST_ASSERT_EQUAL(y, *(int *) scapegoat_search(test_tree, &y)); 
+        TEST_ASSERT_NULL(scapegoat_search(test_tree, &z)); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_map_inorder_string(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL); 
+
+        char *expected_words[] = {"earth", "hello", "hello", "says", "the", "world"};
+        char *word_ray[] = {"hello", "world", "the", "earth", "says", "hello"}; 
+
+        for (int i = 0; i < 6; i++) 
+                scapegoat_insert_value(test_tree, word_ray[i]); 
+
+        struct string_closure_size_six cl; 
+        cl.index = 0; 
+        
+        scapegoat_map_inorder(test_tree, &function_to_apply_test_map_string, &cl);
+
+        TEST_ASSERT_EQUAL(6, cl.index); 
+        for (int i = 0; i < 6; i++) 
+                TEST_ASSERT_EQUAL_STRING(expected_words[i], cl.word_ray[i]);  
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_alpha(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL); 
+        TEST_ASSERT_EQUAL_FLOAT(SCAPEGOAT_DEFAULT_ALPHA, scapegoat_get_alpha(test_tree)); 
+
+        scapegoat_set_alpha(test_tree, 0.6); 
+        TEST_ASSERT_EQUAL_FLOAT(0.6, scapegoat_get_alpha(test_tree)); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_tight_alpha_sorted_inserts(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(&integer_comparison); 
+        scapegoat_set_alpha(test_tree, 0.55); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = i; 
+                scapegoat_insert_value(test_tree, &a[i]); 
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        scapegoat_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(1000, cl.index); 
+        for (int i = 0; i < 1000; i++) 
+                TEST_ASSERT_EQUAL(i, cl.values[i]); 
+
+        /* log base 1/0.55 of 1000 is 11.55 */
+        TEST_ASSERT_TRUE(cl.max_depth <= 11); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_sorted_inserts_stay_shallow(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = i; 
+                scapegoat_insert_value(test_tree, &a[i]); 
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        scapegoat_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(1000, cl.index); 
+        for (int i = 0; i < 1000; i++) 
+                TEST_ASSERT_EQUAL(i, cl.values[i]); 
+
+        /* log base 1/0.7 of 1000 is 19.37; a plain BST would reach 999 */
+        TEST_ASSERT_TRUE(cl.max_depth <= 19); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_delete_value(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL); 
+        scapegoat_insert_value(test_tree, "hello"); 
+        scapegoat_insert_value(test_tree, "world");
+        scapegoat_insert_value(test_tree, "the");
+        scapegoat_insert_value(test_tree, "earth");
+        scapegoat_insert_value(test_tree, "says");
+
+        scapegoat_delete_value(test_tree, "hello"); 
+        TEST_ASSERT_NULL(scapegoat_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("world", scapegoat_search(test_tree, "world"));
+        TEST_ASSERT_EQUAL_STRING("the", scapegoat_search(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("earth", scapegoat_search(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("says", scapegoat_search(test_tree, "says"));
+
+        scapegoat_delete_value(test_tree, "not_in_tree"); 
+        TEST_ASSERT_EQUAL_STRING("world", scapegoat_search(test_tree, "world"));
+
+        scapegoat_delete_value(test_tree, "the"); 
+        scapegoat_delete_value(test_tree, "earth"); 
+        scapegoat_delete_value(test_tree, "world"); 
+        TEST_ASSERT_EQUAL_STRING("says", scapegoat_search(test_tree, "says"));
+
+        scapegoat_delete_value(test_tree, "says"); 
+        TEST_ASSERT_TRUE(scapegoat_is_empty(test_tree)); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_delete_many_ints(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 389) % 1000; 
+                scapegoat_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 1000; i += 2) 
+                scapegoat_delete_value(test_tree, &i); 
+
+        for (int i = 0; i < 1000; i++) {
+                if (i % 2 == 0) {
+                        TEST_ASSERT_NULL(scapegoat_search(test_tree, &i)); 
+                } else {
+                        TEST_ASSERT_EQUAL(i, *(int *) scapegoat_search(test_tree, &i)); 
+                }
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        scapegoat_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(500, cl.index); 
+        for (int i = 0; i < 500; i++) 
+                TEST_ASSERT_EQUAL(2 * i + 1, cl.values[i]); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_tree_minimum_and_maximum(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL); 
+        TEST_ASSERT_NULL(scapegoat_tree_minimum(test_tree)); 
+        TEST_ASSERT_NULL(scapegoat_tree_maximum(test_tree)); 
+
+        scapegoat_insert_value(test_tree, "hello"); 
+        scapegoat_insert_value(test_tree, "world");
+        scapegoat_insert_value(test_tree, "the");
+        scapegoat_insert_value(test_tree, "earth");
+        scapegoat_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("earth", scapegoat_tree_minimum(test_tree)); 
+        TEST_ASSERT_EQUAL_STRING("world", scapegoat_tree_maximum(test_tree)); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_successor_of_value(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL); 
+        scapegoat_insert_value(test_tree, "hello"); 
+        scapegoat_insert_value(test_tree, "world");
+        scapegoat_insert_value(test_tree, "the");
+        scapegoat_insert_value(test_tree, "earth");
+        scapegoat_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("world", scapegoat_successor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", scapegoat_successor_of_value(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("the", scapegoat_successor_of_value(test_tree, "says")); 
+        TEST_ASSERT_EQUAL_STRING("says", scapegoat_successor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(scapegoat_successor_of_value(test_tree, "world"));
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_predecessor_of_value(void)
+{
+        Scapegoat_T test_tree = scapegoat_new(NULL); 
+        scapegoat_insert_value(test_tree, "hello"); 
+        scapegoat_insert_value(test_tree, "world");
+        scapegoat_insert_value(test_tree, "the");
+        scapegoat_insert_value(test_tree, "earth");
+        scapegoat_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("says", scapegoat_predecessor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", scapegoat_predecessor_of_value(test_tree, "says"));
+        TEST_ASSERT_EQUAL_STRING("earth", scapegoat_predecessor_of_value(test_tree, "hello"));  
+        TEST_ASSERT_EQUAL_STRING("hello", scapegoat_predecessor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(scapegoat_predecessor_of_value(test_tree, "earth"));
+
+        scapegoat_free(test_tree); 
+}
+
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void function_to_apply_record_order(void *value, int depth, void *cl)
+{
+        int **next = (int **) cl; 
+
+        (void) depth; 
+        *(*next)++ = *(int *) value; 
+}
+
+void test_scapegoat_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        int order[100]; 
+        int *next = order; 
+        Scapegoat_T test_tree = scapegoat_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                scapegoat_insert_value(test_tree, &a[i]); 
+        }
+
+        scapegoat_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(100, next - order); 
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, order[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) scapegoat_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) scapegoat_successor_of_value(test_tree, &key)); 
+
+        scapegoat_free(test_tree); 
+}
+
+void test_scapegoat_multiset_counts(void)
+{
+        int direction = 1; 
+        int a[10]; 
+        int order[10]; 
+        int *next = order; 
+        int key; 
+        Scapegoat_T test_tree = scapegoat_new_multiset(&directed_comparison, &direction); 
+        Scapegoat_T plain_tree = scapegoat_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 10; i++) {
+                a[i] = i / 3; 
+                scapegoat_insert_value(test_tree, &a[i]); 
+                scapegoat_insert_value(plain_tree, &a[i]); 
+        }
+
+        scapegoat_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(4, next - order); 
+        for (int i = 0; i < 4; i++) 
+                TEST_ASSERT_EQUAL(i, order[i]); 
+
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, scapegoat_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(3, scapegoat_count(plain_tree, &key)); 
+        TEST_ASSERT_EQUAL_PTR(&a[3], scapegoat_search(test_tree, &key)); 
+        key = 3; 
+        TEST_ASSERT_EQUAL(1, scapegoat_count(test_tree, &key)); 
+        key = 7; 
+        TEST_ASSERT_EQUAL(0, scapegoat_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(0, scapegoat_count(plain_tree, &key)); 
+
+        key = 0; 
+        scapegoat_delete_value(test_tree, &key); 
+        scapegoat_delete_value(test_tree, &key); 
+        scapegoat_delete_value(plain_tree, &key); 
+        TEST_ASSERT_EQUAL(1, scapegoat_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(2, scapegoat_count(plain_tree, &key)); 
+        TEST_ASSERT_NOT_NULL(scapegoat_search(test_tree, &key)); 
+
+        scapegoat_delete_value(test_tree, &key); 
+        TEST_ASSERT_EQUAL(0, scapegoat_count(test_tree, &key)); 
+        TEST_ASSERT_NULL(scapegoat_search(test_tree, &key)); 
+        scapegoat_delete_value(test_tree, &key); 
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, scapegoat_count(test_tree, &key)); 
+
+        scapegoat_free(test_tree); 
+        scapegoat_free(plain_tree); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_scapegoat_tree.c");
+
+        RUN_TEST(test_scapegoat_new); 
+        RUN_TEST(test_scapegoat_insert_string); 
+        RUN_TEST(test_scapegoat_is_empty); 
+        RUN_TEST(test_scapegoat_search); 
+        RUN_TEST(test_scapegoat_search_for_ints); 
+        RUN_TEST(test_scapegoat_map_inorder_string); 
+        RUN_TEST(test_scapegoat_alpha); 
+        RUN_TEST(test_scapegoat_tight_alpha_sorted_inserts); 
+        RUN_TEST(test_scapegoat_sorted_inserts_stay_shallow); 
+        RUN_TEST(test_scapegoat_delete_value); 
+        RUN_TEST(test_scapegoat_delete_many_ints); 
+        RUN_TEST(test_scapegoat_tree_minimum_and_maximum); 
+        RUN_TEST(test_scapegoat_successor_of_value); 
+        RUN_TEST(test_scapegoat_predecessor_of_value); 
+        RUN_TEST(test_scapegoat_new_r_passes_context); 
+        RUN_TEST(test_scapegoat_multiset_counts); 
+
+        UnityEnd();
+        return 0;
+}
@@ -0,0 +1,136 @@
+#include "vendor/unity.h"
+#include "../src/simd_search.h"
+#include "../src/prng.h"
+
+void setUp(void)
+{
+        simd_search_set_level(cpu_simd_level()); 
+}
+
+void tearDown(void)
+{
+        simd_search_set_level(cpu_simd_level()); 
+}
+
+int reference_lower_bound(void **keys, int count, intptr_t probe)
+{
+        int i = 0; 
+
+        while (i < count && (intptr_t) keys[i] < probe)
+                i++; 
+
+        return i; 
+}
+
+int reference_upper_bound(void **keys, int count, intptr_t probe)
+{
+        int i = 0; 
+
+        while (i < count && (intptr_t) keys[i] <= probe)
+                i++; 
+
+        return i; 
+}
+
+/*
+ * builds sorted arrays of every length up to 40 from a handful of distinct 
+ * values (so there are plenty of duplicates), and checks both bounds at 
+ * the current level for probes between, on and outside the keys
+ */
+void check_current_level(void)
+{
+        void *keys[40]; 
+        intptr_t spread[] = { INTPTR_MIN, -5000000000, -7, -1, 0, 1, 3, 
+                              4294967296, 4294967297, INTPTR_MAX }; 
+
+        for (int count = 0; count <= 40; count++) {
+                for (int i = 0; i < count; i++)
+                        keys[i] = (void *) spread[(i * 10) / (count + 1)]; 
+
+                for (int j = 0; j < 10; j++) {
+                        for (intptr_t d = -1; d <= 1; d++) {
+                                intptr_t probe = spread[j]; 
+
+                                if ((d < 0 && probe == INTPTR_MIN) || 
+                                    (d > 0 && probe == INTPTR_MAX))
+                                        continue; 
+                                probe += d; 
+
+                                TEST_ASSERT_EQUAL(reference_lower_bound(keys, count, probe), 
+                                                  simd_lower_bound(keys, count, probe)); 
+                                TEST_ASSERT_EQUAL(reference_upper_bound(keys, count, probe), 
+                                                  simd_upper_bound(keys, count, probe)); 
+                        }
+                }
+        }
+}
+
+void test_simd_default_level_is_detected(void)
+{
+        TEST_ASSERT_EQUAL(cpu_simd_level(), simd_search_level()); 
+        TEST_ASSERT_NOT_NULL(cpu_simd_level_name(simd_search_level())); 
+}
+
+void test_simd_set_level_clamps(void)
+{
+        TEST_ASSERT_EQUAL(SIMD_SCALAR, simd_search_set_level(SIMD_SCALAR)); 
+        TEST_ASSERT_EQUAL(cpu_simd_level(), simd_search_set_level(SIMD_AVX2)); 
+}
+
+void test_simd_scalar_bounds(void)
+{
+        simd_search_set_level(SIMD_SCALAR); 
+        check_current_level(); 
+}
+
+void test_simd_sse2_bounds(void)
+{
+        simd_search_set_level(SIMD_SSE2); 
+        check_current_level(); 
+}
+
+void test_simd_avx2_bounds(void)
+{
+        simd_search_set_level(SIMD_AVX2); 
+        check_current_level(); 
+}
+
+void test_simd_random_bounds(void)
+{
+        uint64_t state = PRNG_DEFAULT_SEED; 
+        void *keys[29]; 
+
+        for (int level = SIMD_SCALAR; level <= SIMD_AVX2; level++) {
+                simd_search_set_level((SIMD_Level) level); 
+
+                for (int round = 0; round < 200; round++) {
+                        intptr_t value = (intptr_t) prng_next(&state) >> 8; 
+
+                        for (int i = 0; i < 29; i++) {
+                                keys[i] = (void *) value; 
+                                value += (intptr_t) (prng_next(&state) % 3); 
+                        }
+
+                        intptr_t probe = (intptr_t) keys[prng_next(&state) % 29]; 
+                        TEST_ASSERT_EQUAL(reference_lower_bound(keys, 29, probe), 
+                                          simd_lower_bound(keys, 29, probe)); 
+                        TEST_ASSERT_EQUAL(reference_upper_bound(keys, 29, probe), 
+                                          simd_upper_bound(keys, 29, probe)); 
+                }
+        }
+}
+
+int main(void)
+{
+        UnityBegin("test/test_simd_search.c");
+
+        RUN_TEST(test_simd_default_level_is_detected); 
+        RUN_TEST(test_simd_set_level_clamps); 
+        RUN_TEST(test_simd_scalar_bounds); 
+        RUN_TEST(test_simd_sse2_bounds); 
+        RUN_TEST(test_simd_avx2_bounds); 
+        RUN_TEST(test_simd_random_bounds); 
+
+        UnityEnd();
+        return 0;
+}
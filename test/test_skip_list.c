@@ -0,0 +1,457 @@
+#include "vendor/unity.h"
+#include "../src/skip_list.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int integer_comparison(void *val_one, void *val_two)
+{
+        if (*(int *) val_one == *(int *) val_two) {
+                return 0; 
+        } else if (*(int *) val_one > *(int *) val_two) {
+                return 1; 
+        } else {
+                return -1; 
+        }
+}
+
+struct int_closure {
+        int index; 
+        int max_depth; 
+        int values[1000]; 
+        int depths[1000]; 
+};
+
+void function_to_apply_record_ints(void *value, int depth, void *cl)
+{
+        struct int_closure *closure = (struct int_closure *) cl; 
+
+        closure->values[closure->index] = *(int *) value; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+
+        if (depth > closure->max_depth)
+                closure->max_depth = depth; 
+}
+
+struct string_closure_size_six {
+        int index; 
+        char *word_ray[6]; 
+};
+
+void function_to_apply_test_map_string(void *value, int depth, void *cl)
+{
+        struct string_closure_size_six *closure = (struct string_closure_size_six *) cl; 
+
+        (void) depth; 
+        closure->word_ray[closure->index] = value; 
+        closure->index++; 
+}
+
+void test_skip_new(void)
+{
+        SkipList_T test_tree = skip_new(NULL);
+        TEST_ASSERT_NOT_NULL(test_tree);
+
+        skip_free(test_tree); 
+}
+
+void test_skip_insert_string(void)
+{
+        SkipList_T test_tree = skip_new(NULL);
+        TEST_ASSERT_EQUAL(0, skip_insert_value(test_tree, "Hello")); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_is_empty(void)
+{
+        SkipList_T test_tree = skip_new(NULL);
+        TEST_ASSERT_TRUE(skip_is_empty(test_tree));
+
+        skip_insert_value(test_tree, "hello");
+        TEST_ASSERT_FALSE(skip_is_empty(test_tree)); 
+
+        skip_delete_value(test_tree, "hello");
+        TEST_ASSERT_TRUE(skip_is_empty(test_tree)); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_search(void)
+{
+        SkipList_T test_tree = skip_new(NULL); 
+
+        skip_insert_value(test_tree, "a"); 
+        TEST_ASSERT_EQUAL_STRING("a", skip_search(test_tree, "a")); 
+
+        TEST_ASSERT_NULL(skip_search(test_tree, "b")); 
+        skip_insert_value(test_tree, "b"); 
+        TEST_ASSERT_EQUAL_STRING("b", skip_search(test_tree, "b")); 
+
+        TEST_ASSERT_NULL(skip_search(test_tree, "hello")); 
+        skip_insert_value(test_tree, "hello"); 
+        TEST_ASSERT_EQUAL_STRING("hello", skip_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("a", skip_search(test_tree, "a")); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_search_for_ints(void)
+{
+        SkipList_T test_tree = skip_new(&integer_comparison);
+
+        int a[] = { 214, 25, 64, 4, 7, 729, 34, 28, 9, 11};
+
+        for (int i = 0; i < 10; i++) 
+                skip_insert_value(test_tree, &a[i]); 
+
+        int x = 4; 
+        int y = 9; 
+        int z = 70000000; 
+
+        TEST_ASSERT_EQUAL(x, *(int *) skip_search(test_tree, &x)); 
+        TEST_ASSERT_EQUAL(y, *(int *) skip_search(test_tree, &y)); 
+        TEST_ASSERT_NULL(skip_search(test_tree, &z)); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_map_inorder_string(void)
+{
+        SkipList_T test_tree = skip_new(NULL); 
+
+        char *expected_words[] = {"earth", "hello", "hello", "says", "the", "world"};
+        char *word_ray[] = {"hello", "world", "the", "earth", "says", "hello"}; 
+
+        for (int i = 0; i < 6; i++) 
+                skip_insert_value(test_tree, word_ray[i]); 
+
+        struct string_closure_size_six cl; 
+        cl.index = 0; 
+        
+        skip_map_inorder(test_tree, &function_to_apply_test_map_string, &cl);
+
+        TEST_ASSERT_EQUAL(6, cl.index); 
+        for (int i = 0; i < 6; i++) 
+                TEST_ASSERT_EQUAL_STRING(expected_words[i], cl.word_ray[i]);  
+
+        skip_free(test_tree); 
+}
+
+void test_skip_same_seed_same_shape(void)
+{
+        SkipList_T first = skip_new_seeded(&integer_comparison, 42); 
+        SkipList_T second = skip_new_seeded(&integer_comparison, 42); 
+
+        int a[100]; 
+        for (int i = 0; i < 100; i++) {
+                a[i] = (i * 37) % 100; 
+                skip_insert_value(first, &a[i]); 
+                skip_insert_value(second, &a[i]); 
+        }
+
+        struct int_closure cl_one = { 0, 0, {0}, {0} }; 
+        struct int_closure cl_two = { 0, 0, {0}, {0} }; 
+
+        skip_map_preorder(first, &function_to_apply_record_ints, &cl_one); 
+        skip_map_preorder(second, &function_to_apply_record_ints, &cl_two); 
+
+        TEST_ASSERT_EQUAL_INT_ARRAY(cl_one.values, cl_two.values, 100); 
+        TEST_ASSERT_EQUAL_INT_ARRAY(cl_one.depths, cl_two.depths, 100); 
+
+        skip_free(first); 
+        skip_free(second); 
+}
+
+void test_skip_sorted_inserts_build_lanes(void)
+{
+        SkipList_T test_tree = skip_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = i; 
+                skip_insert_value(test_tree, &a[i]); 
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        skip_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(1000, cl.index); 
+        for (int i = 0; i < 1000; i++) 
+                TEST_ASSERT_EQUAL(i, cl.values[i]); 
+
+        /* the top lane is expected around log2 n ~ 10 */
+        TEST_ASSERT_TRUE(cl.max_depth > 0 && cl.max_depth < 31); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_delete_value(void)
+{
+        SkipList_T test_tree = skip_new(NULL); 
+        skip_insert_value(test_tree, "hello"); 
+        skip_insert_value(test_tree, "world");
+        skip_insert_value(test_tree, "the");
+        skip_insert_value(test_tree, "earth");
+        skip_insert_value(test_tree, "says");
+
+        skip_delete_value(test_tree, "hello"); 
+        TEST_ASSERT_NULL(skip_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("world", skip_search(test_tree, "world"));
+        TEST_ASSERT_EQUAL_STRING("the", skip_search(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("earth", skip_search(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("says", skip_search(test_tree, "says"));
+
+        skip_delete_value(test_tree, "not_in_tree"); 
+        TEST_ASSERT_EQUAL_STRING("world", skip_search(test_tree, "world"));
+
+        skip_delete_value(test_tree, "the"); 
+        skip_delete_value(test_tree, "earth"); 
+        skip_delete_value(test_tree, "world"); 
+        TEST_ASSERT_EQUAL_STRING("says", skip_search(test_tree, "says"));
+
+        skip_delete_value(test_tree, "says"); 
+        TEST_ASSERT_TRUE(skip_is_empty(test_tree)); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_delete_many_ints(void)
+{
+        SkipList_T test_tree = skip_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 389) % 1000; 
+                skip_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 1000; i += 2) 
+                skip_delete_value(test_tree, &i); 
+
+        for (int i = 0; i < 1000; i++) {
+                if (i % 2 == 0) {
+                        TEST_ASSERT_NULL(skip_search(test_tree, &i)); 
+                } else {
+                        TEST_ASSERT_EQUAL(i, *(int *) skip_search(test_tree, &i)); 
+                }
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        skip_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(500, cl.index); 
+        for (int i = 0; i < 500; i++) 
+                TEST_ASSERT_EQUAL(2 * i + 1, cl.values[i]); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_tree_minimum_and_maximum(void)
+{
+        SkipList_T test_tree = skip_new(NULL); 
+        TEST_ASSERT_NULL(skip_tree_minimum(test_tree)); 
+        TEST_ASSERT_NULL(skip_tree_maximum(test_tree)); 
+
+        skip_insert_value(test_tree, "hello"); 
+        skip_insert_value(test_tree, "world");
+        skip_insert_value(test_tree, "the");
+        skip_insert_value(test_tree, "earth");
+        skip_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("earth", skip_tree_minimum(test_tree)); 
+        TEST_ASSERT_EQUAL_STRING("world", skip_tree_maximum(test_tree)); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_successor_of_value(void)
+{
+        SkipList_T test_tree = skip_new(NULL); 
+        skip_insert_value(test_tree, "hello"); 
+        skip_insert_value(test_tree, "world");
+        skip_insert_value(test_tree, "the");
+        skip_insert_value(test_tree, "earth");
+        skip_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("world", skip_successor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", skip_successor_of_value(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("the", skip_successor_of_value(test_tree, "says")); 
+        TEST_ASSERT_EQUAL_STRING("says", skip_successor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(skip_successor_of_value(test_tree, "world"));
+
+        skip_free(test_tree); 
+}
+
+void test_skip_predecessor_of_value(void)
+{
+        SkipList_T test_tree = skip_new(NULL); 
+        skip_insert_value(test_tree, "hello"); 
+        skip_insert_value(test_tree, "world");
+        skip_insert_value(test_tree, "the");
+        skip_insert_value(test_tree, "earth");
+        skip_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("says", skip_predecessor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", skip_predecessor_of_value(test_tree, "says"));
+        TEST_ASSERT_EQUAL_STRING("earth", skip_predecessor_of_value(test_tree, "hello"));  
+        TEST_ASSERT_EQUAL_STRING("hello", skip_predecessor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(skip_predecessor_of_value(test_tree, "earth"));
+
+        skip_free(test_tree); 
+}
+
+void test_skip_duplicates(void)
+{
+        SkipList_T test_tree = skip_new(&integer_comparison); 
+
+        int a[30]; 
+        for (int i = 0; i < 30; i++) {
+                a[i] = (i / 10) * 5; 
+                skip_insert_value(test_tree, &a[i]); 
+        }
+
+        int five = 5; 
+        TEST_ASSERT_EQUAL(10, *(int *) skip_successor_of_value(test_tree, &five)); 
+        TEST_ASSERT_EQUAL(0, *(int *) skip_predecessor_of_value(test_tree, &five)); 
+
+        for (int i = 0; i < 10; i++) {
+                TEST_ASSERT_EQUAL(5, *(int *) skip_search(test_tree, &five)); 
+                skip_delete_value(test_tree, &five); 
+        }
+        TEST_ASSERT_NULL(skip_search(test_tree, &five)); 
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        skip_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(20, cl.index); 
+        for (int i = 0; i < 20; i++) 
+                TEST_ASSERT_EQUAL((i < 10) ? 0 : 10, cl.values[i]); 
+
+        skip_free(test_tree); 
+}
+
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void function_to_apply_record_order(void *value, int depth, void *cl)
+{
+        int **next = (int **) cl; 
+
+        (void) depth; 
+        *(*next)++ = *(int *) value; 
+}
+
+void test_skip_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        int order[100]; 
+        int *next = order; 
+        SkipList_T test_tree = skip_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                skip_insert_value(test_tree, &a[i]); 
+        }
+
+        skip_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(100, next - order); 
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, order[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) skip_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) skip_successor_of_value(test_tree, &key)); 
+
+        skip_free(test_tree); 
+}
+
+void test_skip_multiset_counts(void)
+{
+        int direction = 1; 
+        int a[10]; 
+        int order[10]; 
+        int *next = order; 
+        int key; 
+        SkipList_T test_tree = skip_new_multiset(&directed_comparison, &direction); 
+        SkipList_T plain_tree = skip_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 10; i++) {
+                a[i] = i / 3; 
+                skip_insert_value(test_tree, &a[i]); 
+                skip_insert_value(plain_tree, &a[i]); 
+        }
+
+        skip_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(4, next - order); 
+        for (int i = 0; i < 4; i++) 
+                TEST_ASSERT_EQUAL(i, order[i]); 
+
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, skip_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(3, skip_count(plain_tree, &key)); 
+        TEST_ASSERT_EQUAL_PTR(&a[3], skip_search(test_tree, &key)); 
+        key = 3; 
+        TEST_ASSERT_EQUAL(1, skip_count(test_tree, &key)); 
+        key = 7; 
+        TEST_ASSERT_EQUAL(0, skip_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(0, skip_count(plain_tree, &key)); 
+
+        key = 0; 
+        skip_delete_value(test_tree, &key); 
+        skip_delete_value(test_tree, &key); 
+        skip_delete_value(plain_tree, &key); 
+        TEST_ASSERT_EQUAL(1, skip_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(2, skip_count(plain_tree, &key)); 
+        TEST_ASSERT_NOT_NULL(skip_search(test_tree, &key)); 
+
+        skip_delete_value(test_tree, &key); 
+        TEST_ASSERT_EQUAL(0, skip_count(test_tree, &key)); 
+        TEST_ASSERT_NULL(skip_search(test_tree, &key)); 
+        skip_delete_value(test_tree, &key); 
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, skip_count(test_tree, &key)); 
+
+        skip_free(test_tree); 
+        skip_free(plain_tree); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_skip_list.c");
+
+        RUN_TEST(test_skip_new); 
+        RUN_TEST(test_skip_insert_string); 
+        RUN_TEST(test_skip_is_empty); 
+        RUN_TEST(test_skip_search); 
+        RUN_TEST(test_skip_search_for_ints); 
+        RUN_TEST(test_skip_map_inorder_string); 
+        RUN_TEST(test_skip_same_seed_same_shape); 
+        RUN_TEST(test_skip_sorted_inserts_build_lanes); 
+        RUN_TEST(test_skip_delete_value); 
+        RUN_TEST(test_skip_delete_many_ints); 
+        RUN_TEST(test_skip_duplicates); 
+        RUN_TEST(test_skip_tree_minimum_and_maximum); 
+        RUN_TEST(test_skip_successor_of_value); 
+        RUN_TEST(test_skip_predecessor_of_value); 
+        RUN_TEST(test_skip_new_r_passes_context); 
+        RUN_TEST(test_skip_multiset_counts); 
+
+        UnityEnd();
+        return 0;
+}
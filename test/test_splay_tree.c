@@ -409,6 +409,569 @@ void test_splay_predecessor_of_value(void)
         splay_free(test_tree); 
 }
 
+void check_splay_freeze_ints(Frozen_Layout layout)
+{
+        Splay_T test_tree = splay_new(&integer_comparison); 
+
+        /* even values 0..1998, inserted out of order */
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = 2 * ((i * 389) % 1000); 
+                splay_insert_value(test_tree, &a[i]); 
+        }
+
+        Frozen_T frozen = splay_freeze(test_tree, layout); 
+        TEST_ASSERT_EQUAL(1000, frozen_size(frozen)); 
+        TEST_ASSERT_EQUAL(layout, frozen_layout(frozen)); 
+        TEST_ASSERT_EQUAL(0, *(int *) frozen_tree_minimum(frozen)); 
+        TEST_ASSERT_EQUAL(1998, *(int *) frozen_tree_maximum(frozen)); 
+
+        for (int probe = -1; probe <= 1999; probe++) {
+                int *found = frozen_search(frozen, &probe); 
+                int *successor = frozen_successor_of_value(frozen, &probe); 
+                int *predecessor = frozen_predecessor_of_value(frozen, &probe); 
+
+                if (probe % 2 == 0 && probe >= 0) {
+                        TEST_ASSERT_TRUE(found == splay_search(test_tree, &probe)); 
+                } else {
+                        TEST_ASSERT_NULL(found); 
+                }
+
+                int next = (probe < 0) ? 0 : (probe / 2) * 2 + 2; 
+                int previous = (probe % 2 == 0) ? probe - 2 : probe - 1; 
+
+                if (next > 1998) {
+                        TEST_ASSERT_NULL(successor); 
+                } else {
+                        TEST_ASSERT_EQUAL(next, *successor); 
+                }
+
+                if (previous < 0) {
+                        TEST_ASSERT_NULL(predecessor); 
+                } else {
+                        TEST_ASSERT_EQUAL(previous, *predecessor); 
+                }
+        }
+
+        frozen_free(frozen); 
+        splay_free(test_tree); 
+}
+
+void test_splay_freeze_eytzinger(void)
+{
+        check_splay_freeze_ints(FROZEN_EYTZINGER); 
+}
+
+void test_splay_freeze_veb(void)
+{
+        check_splay_freeze_ints(FROZEN_VEB); 
+}
+
+void test_splay_freeze_strings_and_empty(void)
+{
+        Splay_T test_tree = splay_new(NULL); 
+
+        Frozen_T frozen = splay_freeze(test_tree, FROZEN_VEB); 
+        TEST_ASSERT_EQUAL(0, frozen_size(frozen)); 
+        TEST_ASSERT_NULL(frozen_search(frozen, "hello")); 
+        TEST_ASSERT_NULL(frozen_successor_of_value(frozen, "hello")); 
+        frozen_free(frozen); 
+
+        char *word_ray[] = {"hello", "world", "the", "earth", "says"}; 
+        for (int i = 0; i < 5; i++) 
+                splay_insert_value(test_tree, word_ray[i]); 
+
+        for (int layout = FROZEN_EYTZINGER; layout <= FROZEN_VEB; layout++) {
+                frozen = splay_freeze(test_tree, (Frozen_Layout) layout); 
+
+                for (int i = 0; i < 5; i++) 
+                        TEST_ASSERT_EQUAL_PTR(word_ray[i], frozen_search(frozen, word_ray[i])); 
+                TEST_ASSERT_NULL(frozen_search(frozen, "not_in_tree")); 
+                TEST_ASSERT_EQUAL_STRING("says", frozen_successor_of_value(frozen, "not_in_tree")); 
+                TEST_ASSERT_EQUAL_STRING("hello", frozen_predecessor_of_value(frozen, "not_in_tree")); 
+                TEST_ASSERT_EQUAL_STRING("earth", frozen_tree_minimum(frozen)); 
+                TEST_ASSERT_EQUAL_STRING("world", frozen_tree_maximum(frozen)); 
+
+                frozen_free(frozen); 
+        }
+
+        splay_free(test_tree); 
+}
+
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void function_to_apply_record_order(void *value, int depth, void *cl)
+{
+        int **next = (int **) cl; 
+
+        (void) depth; 
+        *(*next)++ = *(int *) value; 
+}
+
+void test_splay_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        int order[100]; 
+        int *next = order; 
+        Splay_T test_tree = splay_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                splay_insert_value(test_tree, &a[i]); 
+        }
+
+        splay_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(100, next - order); 
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, order[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) splay_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) splay_successor_of_value(test_tree, &key)); 
+
+        splay_free(test_tree); 
+}
+
+void test_splay_multiset_counts(void)
+{
+        int direction = 1; 
+        int a[10]; 
+        int order[10]; 
+        int *next = order; 
+        int key; 
+        Splay_T test_tree = splay_new_multiset(&directed_comparison, &direction); 
+        Splay_T plain_tree = splay_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 10; i++) {
+                a[i] = i / 3; 
+                splay_insert_value(test_tree, &a[i]); 
+                splay_insert_value(plain_tree, &a[i]); 
+        }
+
+        splay_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(4, next - order); 
+        for (int i = 0; i < 4; i++) 
+                TEST_ASSERT_EQUAL(i, order[i]); 
+
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, splay_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(3, splay_count(plain_tree, &key)); 
+        TEST_ASSERT_EQUAL_PTR(&a[3], splay_search(test_tree, &key)); 
+        key = 3; 
+        TEST_ASSERT_EQUAL(1, splay_count(test_tree, &key)); 
+        key = 7; 
+        TEST_ASSERT_EQUAL(0, splay_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(0, splay_count(plain_tree, &key)); 
+
+        key = 0; 
+        splay_delete_value(test_tree, &key); 
+        splay_delete_value(test_tree, &key); 
+        splay_delete_value(plain_tree, &key); 
+        TEST_ASSERT_EQUAL(1, splay_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(2, splay_count(plain_tree, &key)); 
+        TEST_ASSERT_NOT_NULL(splay_search(test_tree, &key)); 
+
+        splay_delete_value(test_tree, &key); 
+        TEST_ASSERT_EQUAL(0, splay_count(test_tree, &key)); 
+        TEST_ASSERT_NULL(splay_search(test_tree, &key)); 
+        splay_delete_value(test_tree, &key); 
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, splay_count(test_tree, &key)); 
+
+        splay_free(test_tree); 
+        splay_free(plain_tree); 
+}
+
+void *merge_count_and_replace(void *stored, void *value, void *cl)
+{
+        (void) stored; 
+        (*(int *) cl)++; 
+
+        return value; 
+}
+
+void test_splay_insert_unique_and_upsert(void)
+{
+        int direction = 1; 
+        int a[5] = { 3, 1, 4, 1, 5 }; 
+        int b = 4, c = 9; 
+        int merges = 0; 
+        int order[6]; 
+        int *next = order; 
+        Splay_T test_tree = splay_new_r(&directed_comparison, &direction); 
+
+        TEST_ASSERT_NULL(splay_insert_unique(test_tree, &a[0])); 
+        TEST_ASSERT_NULL(splay_insert_unique(test_tree, &a[1])); 
+        TEST_ASSERT_NULL(splay_insert_unique(test_tree, &a[2])); 
+        TEST_ASSERT_EQUAL_PTR(&a[1], splay_insert_unique(test_tree, &a[3])); 
+        TEST_ASSERT_EQUAL_PTR(&a[1], splay_get_value_at_root(test_tree)); 
+        TEST_ASSERT_NULL(splay_insert_unique(test_tree, &a[4])); 
+        TEST_ASSERT_EQUAL(1, splay_count(test_tree, &a[3])); 
+
+        TEST_ASSERT_EQUAL_PTR(&b, splay_upsert(test_tree, &b, &merge_count_and_replace, &merges)); 
+        TEST_ASSERT_EQUAL(1, merges); 
+        TEST_ASSERT_EQUAL_PTR(&b, splay_search(test_tree, &a[2])); 
+        TEST_ASSERT_EQUAL_PTR(&c, splay_upsert(test_tree, &c, &merge_count_and_replace, &merges)); 
+        TEST_ASSERT_EQUAL(1, merges); 
+        TEST_ASSERT_EQUAL_PTR(&c, splay_search(test_tree, &c)); 
+
+        splay_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(5, next - order); 
+        TEST_ASSERT_EQUAL(1, order[0]); 
+        TEST_ASSERT_EQUAL(3, order[1]); 
+        TEST_ASSERT_EQUAL(4, order[2]); 
+        TEST_ASSERT_EQUAL(5, order[3]); 
+        TEST_ASSERT_EQUAL(9, order[4]); 
+
+        splay_free(test_tree); 
+}
+
+void test_splay_rank_select_count_range(void)
+{
+        int direction = 1; 
+        int a[1000]; 
+        int lo, hi; 
+        Splay_T test_tree = splay_new_ranked(&directed_comparison, &direction); 
+
+        /* 0..499, each twice, in a scattered order */
+        for (int i = 0; i < 1000; i++) {
+                a[i] = ((i * 7919) % 1000) / 2; 
+                splay_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int v = 0; v < 500; v++) {
+                TEST_ASSERT_EQUAL(2 * v, splay_rank(test_tree, &v)); 
+                TEST_ASSERT_EQUAL(v, *(int *) splay_select(test_tree, 2 * v)); 
+                TEST_ASSERT_EQUAL(v, *(int *) splay_select(test_tree, 2 * v + 1)); 
+        }
+        TEST_ASSERT_NULL(splay_select(test_tree, 1000)); 
+
+        lo = 10; 
+        hi = 19; 
+        TEST_ASSERT_EQUAL(20, splay_count_range(test_tree, &lo, &hi)); 
+        TEST_ASSERT_EQUAL(0, splay_count_range(test_tree, &hi, &lo)); 
+        lo = -5; 
+        hi = 1000; 
+        TEST_ASSERT_EQUAL(1000, splay_count_range(test_tree, &lo, &hi)); 
+
+        /* one copy of every even value, and both of 0..99, go */
+        for (int v = 0; v < 500; v += 2) 
+                splay_delete_value(test_tree, &v); 
+        for (int v = 0; v < 100; v++) 
+                splay_delete_value(test_tree, &v); 
+        for (int v = 1; v < 100; v += 2) 
+                splay_delete_value(test_tree, &v); 
+
+        /* 100..499 remain, odd ones twice */
+        for (int v = 100, rank = 0; v < 500; v++) {
+                TEST_ASSERT_EQUAL(rank, splay_rank(test_tree, &v)); 
+                TEST_ASSERT_EQUAL(v, *(int *) splay_select(test_tree, rank)); 
+                rank += (v % 2 == 0) ? 1 : 2; 
+        }
+        lo = 0; 
+        hi = 101; 
+        TEST_ASSERT_EQUAL(3, splay_count_range(test_tree, &lo, &hi)); 
+        lo = 100; 
+        hi = 499; 
+        TEST_ASSERT_EQUAL(600, splay_count_range(test_tree, &lo, &hi)); 
+
+        splay_free(test_tree); 
+}
+
+void test_splay_ranked_multiset(void)
+{
+        int direction = 1; 
+        int a[1500]; 
+        int lo, hi; 
+        Splay_T test_tree = splay_new_ranked_multiset(&directed_comparison, &direction); 
+
+        /* 0..499 twice each, and the multiples of 3 a third time */
+        for (int i = 0; i < 1000; i++) {
+                a[i] = ((i * 7919) % 1000) / 2; 
+                splay_insert_value(test_tree, &a[i]); 
+        }
+        for (int i = 1000; i < 1500; i++) {
+                a[i] = i - 1000; 
+                if (a[i] % 3 == 0)
+                        splay_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int v = 0, rank = 0; v < 500; v++) {
+                int copies = (v % 3 == 0) ? 3 : 2; 
+
+                TEST_ASSERT_EQUAL(copies, (int) splay_count(test_tree, &v)); 
+                TEST_ASSERT_EQUAL(rank, (int) splay_rank(test_tree, &v)); 
+                for (int k = 0; k < copies; k++)
+                        TEST_ASSERT_EQUAL(v, *(int *) splay_select(test_tree, rank + k)); 
+                TEST_ASSERT_EQUAL(copies, (int) splay_count_range(test_tree, &v, &v)); 
+                rank += copies; 
+        }
+        TEST_ASSERT_NULL(splay_select(test_tree, 1167)); 
+
+        /* one copy off each multiple of 3, then one off each even value */
+        for (int v = 0; v < 500; v += 3)
+                splay_delete_value(test_tree, &v); 
+        for (int v = 0; v < 500; v += 2)
+                splay_delete_value(test_tree, &v); 
+
+        lo = 0; 
+        hi = 499; 
+        TEST_ASSERT_EQUAL(750, (int) splay_count_range(test_tree, &lo, &hi)); 
+        for (int v = 0, rank = 0; v < 500; v++) {
+                int copies = (v % 2 == 0) ? 1 : 2; 
+
+                TEST_ASSERT_EQUAL(copies, (int) splay_count(test_tree, &v)); 
+                TEST_ASSERT_EQUAL(rank, (int) splay_rank(test_tree, &v)); 
+                TEST_ASSERT_EQUAL(v, *(int *) splay_select(test_tree, rank + copies - 1)); 
+                rank += copies; 
+        }
+
+        splay_free(test_tree); 
+}
+
+/* the measure of an int value is the int */
+double measure_int(const void *value, void *ctx)
+{
+        (void) ctx; 
+        return *(const int *) value; 
+}
+
+/* keeps the leftmost of two measures, so the order of the fold shows */
+double combine_first(double left, double right, void *ctx)
+{
+        (void) ctx; 
+        return (left < 0) ? right : left; 
+}
+
+void test_splay_aggregate_range(void)
+{
+        int direction = 1; 
+        int a[1000]; 
+        bool present[1000]; 
+        Monoid first = { measure_int, combine_first, -1, NULL }; 
+        Splay_T trees[4] = { 
+                splay_new_aggregated(&directed_comparison, &direction, monoid_sum(measure_int, NULL)), 
+                splay_new_aggregated(&directed_comparison, &direction, monoid_min(measure_int, NULL)), 
+                splay_new_aggregated(&directed_comparison, &direction, monoid_max(measure_int, NULL)), 
+                splay_new_aggregated(&directed_comparison, &direction, first) 
+        }; 
+
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 7919) % 1000; 
+                present[i] = true; 
+        }
+        for (int t = 0; t < 4; t++) {
+                for (int i = 0; i < 1000; i++)
+                        splay_insert_value(trees[t], &a[i]); 
+        }
+
+        for (int round = 0; round < 2; round++) {
+                for (int lo = -3; lo < 1003; lo += 37) {
+                        for (int hi = lo - 1; hi < 1003; hi += 53) {
+                                int sum = 0, least = -1, greatest = -1; 
+
+                                for (int v = (lo < 0 ? 0 : lo); v <= hi && v < 1000; v++) {
+                                        if (!present[v])
+                                                continue; 
+                                        sum += v; 
+                                        if (least < 0)
+                                                least = v; 
+                                        greatest = v; 
+                                }
+
+                                TEST_ASSERT_EQUAL(sum, (int) splay_aggregate_range(trees[0], &lo, &hi)); 
+                                TEST_ASSERT_EQUAL(least, (int) splay_aggregate_range(trees[3], &lo, &hi)); 
+                                if (least < 0) {
+                                        TEST_ASSERT_TRUE(splay_aggregate_range(trees[1], &lo, &hi) > 1e300); 
+                                        TEST_ASSERT_TRUE(splay_aggregate_range(trees[2], &lo, &hi) < -1e300); 
+                                } else {
+                                        TEST_ASSERT_EQUAL(least, (int) splay_aggregate_range(trees[1], &lo, &hi)); 
+                                        TEST_ASSERT_EQUAL(greatest, (int) splay_aggregate_range(trees[2], &lo, &hi)); 
+                                }
+                        }
+                }
+
+                /* the deletes have to keep the aggregates too */
+                for (int v = 0; v < 1000; v += 3) {
+                        present[v] = false; 
+                        for (int t = 0; t < 4; t++)
+                                splay_delete_value(trees[t], &v); 
+                }
+        }
+
+        for (int t = 0; t < 4; t++)
+                splay_free(trees[t]); 
+}
+
+/* records values until its budget runs out */
+typedef struct Recorder {
+        int *next; 
+        int budget; 
+} Recorder; 
+
+bool function_to_apply_record_some(void *value, void *cl)
+{
+        Recorder *recorder = cl; 
+
+        *recorder->next++ = *(int *) value; 
+        return --recorder->budget > 0; 
+}
+
+void test_splay_map_range(void)
+{
+        int direction = 1; 
+        int a[1000], seen[1000]; 
+        int lo, hi; 
+        Recorder recorder; 
+        Splay_T test_tree = splay_new_r(&directed_comparison, &direction); 
+
+        /* the even values 0..1998, in a scattered order */
+        for (int i = 0; i < 1000; i++) {
+                a[i] = 2 * ((i * 7919) % 1000); 
+                splay_insert_value(test_tree, &a[i]); 
+        }
+
+        lo = 101; 
+        hi = 300; 
+        recorder = (Recorder) { seen, 1000 }; 
+        splay_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(100, recorder.next - seen); 
+        for (int i = 0; i < 100; i++)
+                TEST_ASSERT_EQUAL(102 + 2 * i, seen[i]); 
+
+        /* the walk stops as soon as the function says so */
+        lo = 100; 
+        recorder = (Recorder) { seen, 5 }; 
+        splay_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(5, recorder.next - seen); 
+        for (int i = 0; i < 5; i++)
+                TEST_ASSERT_EQUAL(100 + 2 * i, seen[i]); 
+
+        /* bounds past either end, and empty ranges */
+        lo = -50; 
+        hi = 4; 
+        recorder = (Recorder) { seen, 1000 }; 
+        splay_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(3, recorder.next - seen); 
+        TEST_ASSERT_EQUAL(4, seen[2]); 
+        lo = 1997; 
+        hi = 5000; 
+        recorder = (Recorder) { seen, 1000 }; 
+        splay_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(1, recorder.next - seen); 
+        TEST_ASSERT_EQUAL(1998, seen[0]); 
+        lo = 501; 
+        hi = 501; 
+        recorder = (Recorder) { seen, 1000 }; 
+        splay_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        lo = 600; 
+        hi = 500; 
+        splay_map_range(test_tree, &lo, &hi, &function_to_apply_record_some, &recorder); 
+        TEST_ASSERT_EQUAL(0, recorder.next - seen); 
+
+        for (int v = 0; v < 2000; v += 2)
+                TEST_ASSERT_EQUAL(v, *(int *) splay_search(test_tree, &v)); 
+
+        splay_free(test_tree); 
+}
+
+/* checks that the tree holds exactly lo..hi, by position */
+void check_splay_holds(Splay_T tree, int lo, int hi)
+{
+        TEST_ASSERT_EQUAL(hi - lo + 1, (int) splay_count_range(tree, &lo, &hi)); 
+        for (int v = lo; v <= hi; v++) {
+                TEST_ASSERT_EQUAL(v - lo, (int) splay_rank(tree, &v)); 
+                TEST_ASSERT_EQUAL(v, *(int *) splay_select(tree, v - lo)); 
+        }
+        TEST_ASSERT_NULL(splay_select(tree, hi - lo + 1)); 
+}
+
+void test_splay_split_and_join(void)
+{
+        int direction = 1; 
+        int a[1000]; 
+        int key, lo = 0, hi = 999; 
+        Splay_T left = splay_new_ranked(&directed_comparison, &direction); 
+        Splay_T right; 
+
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 7919) % 1000; 
+                splay_insert_value(left, &a[i]); 
+        }
+
+        key = 500; 
+        right = splay_split(left, &key); 
+        check_splay_holds(left, 0, 499); 
+        check_splay_holds(right, 500, 999); 
+        splay_join(left, right); 
+        TEST_ASSERT_TRUE(splay_is_empty(right)); 
+        check_splay_holds(left, 0, 999); 
+        splay_free(right); 
+
+        /* splits at every kind of key, each joined back */
+        for (int k = -1; k <= 1000; k += 37) {
+                right = splay_split(left, &k); 
+                if (k > 0)
+                        check_splay_holds(left, 0, (k < 1000 ? k : 1000) - 1); 
+                else
+                        TEST_ASSERT_TRUE(splay_is_empty(left)); 
+                if (k < 1000)
+                        check_splay_holds(right, (k > 0 ? k : 0), 999); 
+                else
+                        TEST_ASSERT_TRUE(splay_is_empty(right)); 
+                splay_join(left, right); 
+                splay_free(right); 
+        }
+        check_splay_holds(left, 0, 999); 
+
+        /* a split off middle, joined into an empty tree and then deleted */
+        key = 300; 
+        right = splay_split(left, &key); 
+        key = 700; 
+        Splay_T far = splay_split(right, &key); 
+        Splay_T middle = splay_new_ranked(&directed_comparison, &direction); 
+
+        splay_join(middle, right); 
+        check_splay_holds(middle, 300, 699); 
+        splay_join(left, far); 
+        TEST_ASSERT_EQUAL(600, (int) splay_count_range(left, &lo, &hi)); 
+        for (int v = 300; v < 700; v++)
+                splay_delete_value(middle, &v); 
+        TEST_ASSERT_TRUE(splay_is_empty(middle)); 
+
+        splay_free(far); 
+        splay_free(middle); 
+        splay_free(right); 
+        splay_free(left); 
+
+        /* the aggregates survive both */
+        Splay_T sums = splay_new_aggregated(&directed_comparison, &direction, 
+                                     monoid_sum(measure_int, NULL)); 
+
+        for (int i = 0; i < 1000; i++)
+                splay_insert_value(sums, &a[i]); 
+        key = 400; 
+        right = splay_split(sums, &key); 
+        TEST_ASSERT_EQUAL(399 * 400 / 2, (int) splay_aggregate_range(sums, &lo, &hi)); 
+        TEST_ASSERT_EQUAL(999 * 1000 / 2 - 399 * 400 / 2, (int) splay_aggregate_range(right, &lo, &hi)); 
+        splay_join(sums, right); 
+        TEST_ASSERT_EQUAL(999 * 1000 / 2, (int) splay_aggregate_range(sums, &lo, &hi)); 
+
+        splay_free(right); 
+        splay_free(sums); 
+}
+
 int main(void)
 {
         UnityBegin("test/test_splay_tree.c");
@@ -433,6 +996,17 @@ int main(void)
         RUN_TEST(test_splay_tree_maximum); 
         RUN_TEST(test_splay_successor_of_value); 
         RUN_TEST(test_splay_predecessor_of_value); 
+        RUN_TEST(test_splay_freeze_eytzinger); 
+        RUN_TEST(test_splay_freeze_veb); 
+        RUN_TEST(test_splay_freeze_strings_and_empty); 
+        RUN_TEST(test_splay_new_r_passes_context); 
+        RUN_TEST(test_splay_multiset_counts); 
+        RUN_TEST(test_splay_insert_unique_and_upsert); 
+        RUN_TEST(test_splay_rank_select_count_range); 
+        RUN_TEST(test_splay_ranked_multiset); 
+        RUN_TEST(test_splay_aggregate_range); 
+        RUN_TEST(test_splay_map_range); 
+        RUN_TEST(test_splay_split_and_join); 
 
         UnityEnd();
         return 0;
@@ -0,0 +1,244 @@
+#include "vendor/unity.h"
+#include "../src/typed_trees.h"
+#include "../src/prng.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+struct key_closure {
+        int index; 
+        int max_depth; 
+        double keys[1000]; 
+        int depths[1000]; 
+};
+
+void record_i64(int64_t key, int depth, void *cl)
+{
+        struct key_closure *closure = (struct key_closure *) cl; 
+
+        closure->keys[closure->index] = (double) key; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+
+        if (depth > closure->max_depth)
+                closure->max_depth = depth; 
+}
+
+void record_f64(double key, int depth, void *cl)
+{
+        struct key_closure *closure = (struct key_closure *) cl; 
+
+        closure->keys[closure->index] = key; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+}
+
+/*
+ * MODEL_TEST
+ *
+ * inserts 1000 keys drawn from a small range, so that many repeat, into
+ * the tree and into a table of counts, deletes some of them, and checks
+ * every query against the table after each phase
+ */
+#define MODEL_TEST(prefix, key_t)                                               \
+void test_##prefix##_matches_model(void)                                        \
+{                                                                               \
+        uint64_t state = PRNG_DEFAULT_SEED;                                     \
+        int counts[200] = {0};                                                  \
+        struct prefix *tree = prefix##_new();                                   \
+                                                                                \
+        TEST_ASSERT_TRUE(prefix##_is_empty(tree));                              \
+        TEST_ASSERT_NULL(prefix##_tree_minimum(tree));                          \
+        TEST_ASSERT_NULL(prefix##_successor_of_value(tree, 3));                 \
+                                                                                \
+        for (int i = 0; i < 1000; i++) {                                        \
+                int k = prng_next(&state) % 200;                                \
+                prefix##_insert_value(tree, (key_t) k);                         \
+                counts[k]++;                                                    \
+        }                                                                       \
+                                                                                \
+        for (int round = 0; round < 2; round++) {                               \
+                int lo = -1;                                                    \
+                int hi = -1;                                                    \
+                                                                                \
+                for (int k = 0; k < 200; k++) {                                 \
+                        const key_t *found = prefix##_search(tree, (key_t) k);  \
+                        if (counts[k] > 0) {                                    \
+                                TEST_ASSERT_NOT_NULL(found);                    \
+                                TEST_ASSERT_TRUE(*found == (key_t) k);          \
+                                if (lo < 0)                                     \
+                                        lo = k;                                 \
+                                hi = k;                                         \
+                        } else {                                                \
+                                TEST_ASSERT_NULL(found);                        \
+                        }                                                       \
+                }                                                               \
+                                                                                \
+                TEST_ASSERT_TRUE(*prefix##_tree_minimum(tree) == (key_t) lo);   \
+                TEST_ASSERT_TRUE(*prefix##_tree_maximum(tree) == (key_t) hi);   \
+                                                                                \
+                /* walk up with successors and down with predecessors */       \
+                const key_t *v = prefix##_tree_minimum(tree);                   \
+                for (int k = lo + 1; k <= hi; k++) {                            \
+                        if (counts[k] > 0) {                                    \
+                                v = prefix##_successor_of_value(tree, *v);      \
+                                TEST_ASSERT_TRUE(*v == (key_t) k);              \
+                        }                                                       \
+                }                                                               \
+                TEST_ASSERT_NULL(prefix##_successor_of_value(tree, *v));        \
+                                                                                \
+                for (int k = hi - 1; k >= lo; k--) {                            \
+                        if (counts[k] > 0) {                                    \
+                                v = prefix##_predecessor_of_value(tree, *v);    \
+                                TEST_ASSERT_TRUE(*v == (key_t) k);              \
+                        }                                                       \
+                }                                                               \
+                TEST_ASSERT_NULL(prefix##_predecessor_of_value(tree, *v));      \
+                                                                                \
+                /* delete one copy of every key, and every copy of the evens */ \
+                for (int k = 0; k < 200; k++) {                                 \
+                        int copies = (k % 2 == 0) ? counts[k] : 1;              \
+                        for (int c = 0; c < copies; c++)                        \
+                                prefix##_delete_value(tree, (key_t) k);         \
+                        counts[k] -= (copies < counts[k]) ? copies : counts[k]; \
+                }                                                               \
+        }                                                                       \
+                                                                                \
+        for (int k = 0; k < 200; k++) {                                         \
+                while (counts[k]-- > 0)                                         \
+                        prefix##_delete_value(tree, (key_t) k);                 \
+        }                                                                       \
+        TEST_ASSERT_TRUE(prefix##_is_empty(tree));                              \
+                                                                                \
+        prefix##_free(tree);                                                    \
+}
+
+MODEL_TEST(bst_i64, int64_t)
+MODEL_TEST(bst_u32, uint32_t)
+MODEL_TEST(bst_f64, double)
+MODEL_TEST(splay_i64, int64_t)
+MODEL_TEST(splay_u32, uint32_t)
+MODEL_TEST(splay_f64, double)
+MODEL_TEST(rb_i64, int64_t)
+MODEL_TEST(rb_u32, uint32_t)
+MODEL_TEST(rb_f64, double)
+
+/*
+ * KEY_POINTER_TEST
+ *
+ * holds a pointer to a stored key while another key, whose node has two
+ * children and the held key as its successor, is deleted
+ */
+#define KEY_POINTER_TEST(prefix)                                                \
+void test_##prefix##_key_pointer_survives_other_delete(void)                    \
+{                                                                               \
+        struct prefix *tree = prefix##_new();                                   \
+        int64_t keys[] = {5, 3, 8, 7};                                          \
+                                                                                \
+        for (int i = 0; i < 4; i++)                                             \
+                prefix##_insert_value(tree, keys[i]);                           \
+                                                                                \
+        const int64_t *held = prefix##_search(tree, 7);                         \
+                                                                                \
+        prefix##_delete_value(tree, 5);                                         \
+                                                                                \
+        TEST_ASSERT_EQUAL(7, *held);                                            \
+        TEST_ASSERT_NULL(prefix##_search(tree, 5));                             \
+        TEST_ASSERT_TRUE(held == prefix##_search(tree, 7));                     \
+                                                                                \
+        prefix##_free(tree);                                                    \
+}
+
+KEY_POINTER_TEST(bst_i64)
+KEY_POINTER_TEST(splay_i64)
+KEY_POINTER_TEST(rb_i64)
+
+void test_rb_i64_stays_balanced(void)
+{
+        RedBlack_i64_T tree = rb_i64_new(); 
+        struct key_closure cl = { 0, 0, {0}, {0} }; 
+
+        for (int64_t i = 0; i < 1000; i++) 
+                rb_i64_insert_value(tree, i); 
+        for (int64_t i = 0; i < 1000; i += 3) 
+                rb_i64_delete_value(tree, i); 
+
+        rb_i64_map_inorder(tree, &record_i64, &cl); 
+
+        TEST_ASSERT_EQUAL(666, cl.index); 
+        TEST_ASSERT_TRUE(cl.max_depth < 2 * 10); 
+        for (int i = 1; i < cl.index; i++) 
+                TEST_ASSERT_TRUE(cl.keys[i - 1] < cl.keys[i]); 
+
+        rb_i64_free(tree); 
+}
+
+void test_splay_i64_search_moves_to_root(void)
+{
+        Splay_i64_T tree = splay_i64_new(); 
+
+        for (int64_t i = 0; i < 100; i++) 
+                splay_i64_insert_value(tree, i); 
+
+        for (int64_t i = 0; i < 100; i += 7) {
+                struct key_closure cl = { 0, 0, {0}, {0} }; 
+
+                TEST_ASSERT_EQUAL(i, *splay_i64_search(tree, i)); 
+                splay_i64_map_inorder(tree, &record_i64, &cl); 
+                TEST_ASSERT_EQUAL(0, cl.depths[i]); 
+        }
+
+        splay_i64_free(tree); 
+}
+
+void test_f64_keys_keep_sign_and_fraction(void)
+{
+        double keys[] = {2.5, -1.25, 0.0, 2.25, -1e9, 1e-9}; 
+        double sorted[] = {-1e9, -1.25, 0.0, 1e-9, 2.25, 2.5}; 
+        RedBlack_f64_T tree = rb_f64_new(); 
+        struct key_closure cl = { 0, 0, {0}, {0} }; 
+
+        for (int i = 0; i < 6; i++) 
+                rb_f64_insert_value(tree, keys[i]); 
+
+        rb_f64_map_inorder(tree, &record_f64, &cl); 
+
+        TEST_ASSERT_EQUAL(6, cl.index); 
+        for (int i = 0; i < 6; i++) 
+                TEST_ASSERT_TRUE(cl.keys[i] == sorted[i]); 
+
+        TEST_ASSERT_TRUE(*rb_f64_successor_of_value(tree, 0.0) == 1e-9); 
+        TEST_ASSERT_TRUE(*rb_f64_predecessor_of_value(tree, 2.3) == 2.25); 
+        TEST_ASSERT_NULL(rb_f64_search(tree, 2.3)); 
+
+        rb_f64_free(tree); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_typed_trees.c");
+
+        RUN_TEST(test_bst_i64_matches_model); 
+        RUN_TEST(test_bst_u32_matches_model); 
+        RUN_TEST(test_bst_f64_matches_model); 
+        RUN_TEST(test_splay_i64_matches_model); 
+        RUN_TEST(test_splay_u32_matches_model); 
+        RUN_TEST(test_splay_f64_matches_model); 
+        RUN_TEST(test_rb_i64_matches_model); 
+        RUN_TEST(test_rb_u32_matches_model); 
+        RUN_TEST(test_rb_f64_matches_model); 
+        RUN_TEST(test_bst_i64_key_pointer_survives_other_delete); 
+        RUN_TEST(test_splay_i64_key_pointer_survives_other_delete); 
+        RUN_TEST(test_rb_i64_key_pointer_survives_other_delete); 
+        RUN_TEST(test_rb_i64_stays_balanced); 
+        RUN_TEST(test_splay_i64_search_moves_to_root); 
+        RUN_TEST(test_f64_keys_keep_sign_and_fraction); 
+
+        UnityEnd();
+        return 0;
+}
@@ -0,0 +1,165 @@
+#include "vendor/unity.h"
+#include "../src/wilber.h"
+#include "../src/prng.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*
+ * reference implementations straight from the definitions, quadratic but
+ * obviously right
+ */
+size_t naive_interleaves(const size_t *keys, size_t m, size_t lo, size_t hi)
+{
+        if (lo >= hi)
+                return 0; 
+
+        size_t mid = lo + (hi - lo) / 2; 
+        size_t count = 0; 
+        int previous = 0; 
+
+        for (size_t i = 0; i < m; i++) {
+                if (keys[i] < lo || keys[i] >= hi)
+                        continue; 
+
+                int side = (keys[i] <= mid) ? 1 : 2; 
+
+                if (previous != 0 && side != previous)
+                        count++; 
+                previous = side; 
+        }
+
+        return count + naive_interleaves(keys, m, lo, mid) 
+                     + naive_interleaves(keys, m, mid + 1, hi); 
+}
+
+size_t naive_funnel(const size_t *keys, size_t m)
+{
+        size_t count = 0; 
+
+        for (size_t i = 0; i < m; i++) {
+                size_t x = keys[i]; 
+                long lower = -1; 
+                long upper = -1; 
+                int previous = 0; 
+
+                for (size_t j = i; j-- > 0; ) {
+                        long z = (long) keys[j]; 
+                        int side = 0; 
+
+                        if (keys[j] == x) {
+                                break; 
+                        } else if (keys[j] < x && (lower == -1 || z > lower)) {
+                                lower = z; 
+                                side = 1; 
+                        } else if (keys[j] > x && (upper == -1 || z < upper)) {
+                                upper = z; 
+                                side = 2; 
+                        }
+
+                        if (side != 0) {
+                                if (previous != 0 && side != previous)
+                                        count++; 
+                                previous = side; 
+                        }
+                }
+        }
+
+        return count; 
+}
+
+void test_wilber_empty_sequence(void)
+{
+        TEST_ASSERT_EQUAL(0, wilber_interleave_bound(NULL, 0, 10)); 
+        TEST_ASSERT_EQUAL(0, wilber_funnel_bound(NULL, 0, 10)); 
+}
+
+void test_wilber_repeated_key(void)
+{
+        size_t keys[50]; 
+        for (int i = 0; i < 50; i++) 
+                keys[i] = 5; 
+
+        TEST_ASSERT_EQUAL(0, wilber_interleave_bound(keys, 50, 16)); 
+        TEST_ASSERT_EQUAL(0, wilber_funnel_bound(keys, 50, 16)); 
+}
+
+void test_wilber_alternating_extremes(void)
+{
+        size_t keys[20]; 
+        for (int i = 0; i < 20; i++) 
+                keys[i] = (i % 2 == 0) ? 0 : 7; 
+
+        /* only the root of the reference tree sees both sides */
+        TEST_ASSERT_EQUAL(19, wilber_interleave_bound(keys, 20, 8)); 
+
+        /* each funnel holds only the other extreme */
+        TEST_ASSERT_EQUAL(0, wilber_funnel_bound(keys, 20, 8)); 
+}
+
+void test_wilber_sequential_funnel_is_empty(void)
+{
+        size_t keys[100]; 
+        for (int i = 0; i < 100; i++) 
+                keys[i] = i; 
+
+        TEST_ASSERT_EQUAL(0, wilber_funnel_bound(keys, 100, 100)); 
+        TEST_ASSERT_EQUAL(naive_interleaves(keys, 100, 0, 100), 
+                          wilber_interleave_bound(keys, 100, 100)); 
+}
+
+void test_wilber_bit_reversal(void)
+{
+        /* the classic sequence on which every BST pays Theta(log n) per access */
+        size_t keys[1024]; 
+        for (size_t i = 0; i < 1024; i++) {
+                size_t r = 0; 
+                for (int b = 0; b < 10; b++) 
+                        r |= ((i >> b) & 1) << (9 - b); 
+                keys[i] = r; 
+        }
+
+        size_t bound = wilber_interleave_bound(keys, 1024, 1024); 
+
+        TEST_ASSERT_EQUAL(naive_interleaves(keys, 1024, 0, 1024), bound); 
+        TEST_ASSERT_TRUE(bound > 1024 * 4); 
+        TEST_ASSERT_EQUAL(naive_funnel(keys, 1024), wilber_funnel_bound(keys, 1024, 1024)); 
+}
+
+void test_wilber_matches_definitions(void)
+{
+        uint64_t state = PRNG_DEFAULT_SEED; 
+        size_t keys[400]; 
+
+        for (int round = 0; round < 20; round++) {
+                size_t n = 1 + prng_next(&state) % 60; 
+
+                for (int i = 0; i < 400; i++) 
+                        keys[i] = prng_next(&state) % n; 
+
+                TEST_ASSERT_EQUAL(naive_interleaves(keys, 400, 0, n), 
+                                  wilber_interleave_bound(keys, 400, n)); 
+                TEST_ASSERT_EQUAL(naive_funnel(keys, 400), 
+                                  wilber_funnel_bound(keys, 400, n)); 
+        }
+}
+
+int main(void)
+{
+        UnityBegin("test/test_wilber.c");
+
+        RUN_TEST(test_wilber_empty_sequence); 
+        RUN_TEST(test_wilber_repeated_key); 
+        RUN_TEST(test_wilber_alternating_extremes); 
+        RUN_TEST(test_wilber_sequential_funnel_is_empty); 
+        RUN_TEST(test_wilber_bit_reversal); 
+        RUN_TEST(test_wilber_matches_definitions); 
+
+        UnityEnd();
+        return 0;
+}
@@ -0,0 +1,136 @@
+#include "vendor/unity.h"
+#include "../src/word_split.h"
+#include "../src/prng.h"
+#include <string.h>
+#include <stdbool.h>
+
+void setUp(void)
+{
+        word_split_set_level(cpu_simd_level()); 
+}
+
+void tearDown(void)
+{
+        word_split_set_level(cpu_simd_level()); 
+}
+
+bool isalnum_ascii(unsigned char c)
+{
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'); 
+}
+
+unsigned char lower_ascii(unsigned char c)
+{
+        return (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c; 
+}
+
+/* splits a copy byte by byte, straight from the definition */
+size_t reference_split(const char *text, size_t length, char *out, size_t *starts)
+{
+        size_t count = 0; 
+        bool in_word = false; 
+
+        for (size_t i = 0; i < length; i++) {
+                unsigned char c = (unsigned char) text[i]; 
+                bool word = isalnum_ascii(c) || c >= 0x80; 
+
+                out[i] = word ? (char) lower_ascii(c) : '\0'; 
+                if (word && !in_word)
+                        starts[count++] = i; 
+                in_word = word; 
+        }
+
+        return count; 
+}
+
+void check_current_level(void)
+{
+        uint64_t state = 7; 
+        const char alphabet[] = "aZ9 ,.'-\n\t\xc3\xa9Mq0"; 
+
+        for (size_t length = 0; length < 300; length += 1 + length / 8) {
+                for (int round = 0; round < 20; round++) {
+                        char *text = malloc(length + 1); 
+                        char *expected = malloc(length + 1); 
+                        size_t *starts = malloc((length / 2 + 1) * sizeof(size_t)); 
+                        char **words = malloc((length / 2 + 1) * sizeof(char *)); 
+
+                        for (size_t i = 0; i < length; i++)
+                                text[i] = alphabet[prng_next(&state) % (sizeof(alphabet) - 1)]; 
+                        text[length] = '\0'; 
+
+                        size_t count = reference_split(text, length, expected, starts); 
+
+                        TEST_ASSERT_EQUAL(count, word_split(text, length, words)); 
+                        if (length > 0)
+                                TEST_ASSERT_EQUAL_MEMORY(expected, text, length); 
+                        for (size_t i = 0; i < count; i++)
+                                TEST_ASSERT_EQUAL_PTR(text + starts[i], words[i]); 
+
+                        free(text); 
+                        free(expected); 
+                        free(starts); 
+                        free(words); 
+                }
+        }
+}
+
+void test_word_split_default_level_is_detected(void)
+{
+        TEST_ASSERT_EQUAL(cpu_simd_level(), word_split_level()); 
+}
+
+void test_word_split_set_level_clamps(void)
+{
+        TEST_ASSERT_EQUAL(SIMD_SCALAR, word_split_set_level(SIMD_SCALAR)); 
+        TEST_ASSERT_EQUAL(SIMD_SCALAR, word_split_level()); 
+        TEST_ASSERT_EQUAL(cpu_simd_level(), word_split_set_level(SIMD_AVX2)); 
+}
+
+void test_word_split_lowers_and_strips(void)
+{
+        char text[] = "\"Well, Prince, so Genoa and Lucca are now just family estates of the\n"
+                      "Buonapartes. 1805--it's NOT\xc3\xa9 over!\""; 
+        char *expected[] = { "well", "prince", "so", "genoa", "and", "lucca", "are", 
+                             "now", "just", "family", "estates", "of", "the", 
+                             "buonapartes", "1805", "it", "s", "not\xc3\xa9", "over" }; 
+        size_t count = sizeof(expected) / sizeof(expected[0]); 
+        char *words[64]; 
+
+        TEST_ASSERT_EQUAL(count, word_split(text, strlen(text), words)); 
+        for (size_t i = 0; i < count; i++)
+                TEST_ASSERT_EQUAL_STRING(expected[i], words[i]); 
+}
+
+void test_word_split_scalar(void)
+{
+        word_split_set_level(SIMD_SCALAR); 
+        check_current_level(); 
+}
+
+void test_word_split_sse2(void)
+{
+        word_split_set_level(SIMD_SSE2); 
+        check_current_level(); 
+}
+
+void test_word_split_avx2(void)
+{
+        word_split_set_level(SIMD_AVX2); 
+        check_current_level(); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_word_split.c");
+
+        RUN_TEST(test_word_split_default_level_is_detected); 
+        RUN_TEST(test_word_split_set_level_clamps); 
+        RUN_TEST(test_word_split_lowers_and_strips); 
+        RUN_TEST(test_word_split_scalar); 
+        RUN_TEST(test_word_split_sse2); 
+        RUN_TEST(test_word_split_avx2); 
+
+        UnityEnd();
+        return 0;
+}
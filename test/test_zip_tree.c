@@ -0,0 +1,426 @@
+#include "vendor/unity.h"
+#include "../src/zip_tree.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int integer_comparison(void *val_one, void *val_two)
+{
+        if (*(int *) val_one == *(int *) val_two) {
+                return 0; 
+        } else if (*(int *) val_one > *(int *) val_two) {
+                return 1; 
+        } else {
+                return -1; 
+        }
+}
+
+struct int_closure {
+        int index; 
+        int max_depth; 
+        int values[1000]; 
+        int depths[1000]; 
+};
+
+void function_to_apply_record_ints(void *value, int depth, void *cl)
+{
+        struct int_closure *closure = (struct int_closure *) cl; 
+
+        closure->values[closure->index] = *(int *) value; 
+        closure->depths[closure->index] = depth; 
+        closure->index++; 
+
+        if (depth > closure->max_depth)
+                closure->max_depth = depth; 
+}
+
+struct string_closure_size_six {
+        int index; 
+        char *word_ray[6]; 
+};
+
+void function_to_apply_test_map_string(void *value, int depth, void *cl)
+{
+        struct string_closure_size_six *closure = (struct string_closure_size_six *) cl; 
+
+        (void) depth; 
+        closure->word_ray[closure->index] = value; 
+        closure->index++; 
+}
+
+void test_zip_new(void)
+{
+        ZipTree_T test_tree = zip_new(NULL);
+        TEST_ASSERT_NOT_NULL(test_tree);
+
+        zip_free(test_tree); 
+}
+
+void test_zip_insert_string(void)
+{
+        ZipTree_T test_tree = zip_new(NULL);
+        TEST_ASSERT_EQUAL(0, zip_insert_value(test_tree, "Hello")); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_is_empty(void)
+{
+        ZipTree_T test_tree = zip_new(NULL);
+        TEST_ASSERT_TRUE(zip_is_empty(test_tree));
+
+        zip_insert_value(test_tree, "hello");
+        TEST_ASSERT_FALSE(zip_is_empty(test_tree)); 
+
+        zip_delete_value(test_tree, "hello");
+        TEST_ASSERT_TRUE(zip_is_empty(test_tree)); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_search(void)
+{
+        ZipTree_T test_tree = zip_new(NULL); 
+
+        zip_insert_value(test_tree, "a"); 
+        TEST_ASSERT_EQUAL_STRING("a", zip_search(test_tree, "a")); 
+
+        TEST_ASSERT_NULL(zip_search(test_tree, "b")); 
+        zip_insert_value(test_tree, "b"); 
+        TEST_ASSERT_EQUAL_STRING("b", zip_search(test_tree, "b")); 
+
+        TEST_ASSERT_NULL(zip_search(test_tree, "hello")); 
+        zip_insert_value(test_tree, "hello"); 
+        TEST_ASSERT_EQUAL_STRING("hello", zip_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("a", zip_search(test_tree, "a")); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_search_for_ints(void)
+{
+        ZipTree_T test_tree = zip_new(&integer_comparison);
+
+        int a[] = { 214, 25, 64, 4, 7, 729, 34, 28, 9, 11};
+
+        for (int i = 0; i < 10; i++) 
+                zip_insert_value(test_tree, &a[i]); 
+
+        int x = 4; 
+        int y = 9; 
+        int z = 70000000; 
+
+        TEST_ASSERT_EQUAL(x, *(int *) zip_search(test_tree, &x)); 
+        TEST_ASSERT_EQUAL(y, *(int *) zip_search(test_tree, &y)); 
+        TEST_ASSERT_NULL(zip_search(test_tree, &z)); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_map_inorder_string(void)
+{
+        ZipTree_T test_tree = zip_new(NULL); 
+
+        char *expected_words[] = {"earth", "hello", "hello", "says", "the", "world"};
+        char *word_ray[] = {"hello", "world", "the", "earth", "says", "hello"}; 
+
+        for (int i = 0; i < 6; i++) 
+                zip_insert_value(test_tree, word_ray[i]); 
+
+        struct string_closure_size_six cl; 
+        cl.index = 0; 
+        
+        zip_map_inorder(test_tree, &function_to_apply_test_map_string, &cl);
+
+        TEST_ASSERT_EQUAL(6, cl.index); 
+        for (int i = 0; i < 6; i++) 
+                TEST_ASSERT_EQUAL_STRING(expected_words[i], cl.word_ray[i]);  
+
+        zip_free(test_tree); 
+}
+
+void test_zip_same_seed_same_shape(void)
+{
+        ZipTree_T first = zip_new_seeded(&integer_comparison, 42); 
+        ZipTree_T second = zip_new_seeded(&integer_comparison, 42); 
+
+        int a[100]; 
+        for (int i = 0; i < 100; i++) {
+                a[i] = (i * 37) % 100; 
+                zip_insert_value(first, &a[i]); 
+                zip_insert_value(second, &a[i]); 
+        }
+
+        struct int_closure cl_one = { 0, 0, {0}, {0} }; 
+        struct int_closure cl_two = { 0, 0, {0}, {0} }; 
+
+        zip_map_preorder(first, &function_to_apply_record_ints, &cl_one); 
+        zip_map_preorder(second, &function_to_apply_record_ints, &cl_two); 
+
+        TEST_ASSERT_EQUAL_INT_ARRAY(cl_one.values, cl_two.values, 100); 
+        TEST_ASSERT_EQUAL_INT_ARRAY(cl_one.depths, cl_two.depths, 100); 
+
+        zip_free(first); 
+        zip_free(second); 
+}
+
+void test_zip_sorted_inserts_stay_shallow(void)
+{
+        ZipTree_T test_tree = zip_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = i; 
+                zip_insert_value(test_tree, &a[i]); 
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        zip_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(1000, cl.index); 
+        for (int i = 0; i < 1000; i++) 
+                TEST_ASSERT_EQUAL(i, cl.values[i]); 
+
+        /* expected depth is about 1.5 lg n ~ 15; a plain BST would reach 999 */
+        TEST_ASSERT_TRUE(cl.max_depth < 50); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_delete_value(void)
+{
+        ZipTree_T test_tree = zip_new(NULL); 
+        zip_insert_value(test_tree, "hello"); 
+        zip_insert_value(test_tree, "world");
+        zip_insert_value(test_tree, "the");
+        zip_insert_value(test_tree, "earth");
+        zip_insert_value(test_tree, "says");
+
+        zip_delete_value(test_tree, "hello"); 
+        TEST_ASSERT_NULL(zip_search(test_tree, "hello")); 
+        TEST_ASSERT_EQUAL_STRING("world", zip_search(test_tree, "world"));
+        TEST_ASSERT_EQUAL_STRING("the", zip_search(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("earth", zip_search(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("says", zip_search(test_tree, "says"));
+
+        zip_delete_value(test_tree, "not_in_tree"); 
+        TEST_ASSERT_EQUAL_STRING("world", zip_search(test_tree, "world"));
+
+        zip_delete_value(test_tree, "the"); 
+        zip_delete_value(test_tree, "earth"); 
+        zip_delete_value(test_tree, "world"); 
+        TEST_ASSERT_EQUAL_STRING("says", zip_search(test_tree, "says"));
+
+        zip_delete_value(test_tree, "says"); 
+        TEST_ASSERT_TRUE(zip_is_empty(test_tree)); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_delete_many_ints(void)
+{
+        ZipTree_T test_tree = zip_new(&integer_comparison); 
+
+        int a[1000]; 
+        for (int i = 0; i < 1000; i++) {
+                a[i] = (i * 389) % 1000; 
+                zip_insert_value(test_tree, &a[i]); 
+        }
+
+        for (int i = 0; i < 1000; i += 2) 
+                zip_delete_value(test_tree, &i); 
+
+        for (int i = 0; i < 1000; i++) {
+                if (i % 2 == 0) {
+                        TEST_ASSERT_NULL(zip_search(test_tree, &i)); 
+                } else {
+                        TEST_ASSERT_EQUAL(i, *(int *) zip_search(test_tree, &i)); 
+                }
+        }
+
+        struct int_closure cl = { 0, 0, {0}, {0} }; 
+        zip_map_inorder(test_tree, &function_to_apply_record_ints, &cl); 
+
+        TEST_ASSERT_EQUAL(500, cl.index); 
+        for (int i = 0; i < 500; i++) 
+                TEST_ASSERT_EQUAL(2 * i + 1, cl.values[i]); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_tree_minimum_and_maximum(void)
+{
+        ZipTree_T test_tree = zip_new(NULL); 
+        TEST_ASSERT_NULL(zip_tree_minimum(test_tree)); 
+        TEST_ASSERT_NULL(zip_tree_maximum(test_tree)); 
+
+        zip_insert_value(test_tree, "hello"); 
+        zip_insert_value(test_tree, "world");
+        zip_insert_value(test_tree, "the");
+        zip_insert_value(test_tree, "earth");
+        zip_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("earth", zip_tree_minimum(test_tree)); 
+        TEST_ASSERT_EQUAL_STRING("world", zip_tree_maximum(test_tree)); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_successor_of_value(void)
+{
+        ZipTree_T test_tree = zip_new(NULL); 
+        zip_insert_value(test_tree, "hello"); 
+        zip_insert_value(test_tree, "world");
+        zip_insert_value(test_tree, "the");
+        zip_insert_value(test_tree, "earth");
+        zip_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("world", zip_successor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", zip_successor_of_value(test_tree, "earth"));
+        TEST_ASSERT_EQUAL_STRING("the", zip_successor_of_value(test_tree, "says")); 
+        TEST_ASSERT_EQUAL_STRING("says", zip_successor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(zip_successor_of_value(test_tree, "world"));
+
+        zip_free(test_tree); 
+}
+
+void test_zip_predecessor_of_value(void)
+{
+        ZipTree_T test_tree = zip_new(NULL); 
+        zip_insert_value(test_tree, "hello"); 
+        zip_insert_value(test_tree, "world");
+        zip_insert_value(test_tree, "the");
+        zip_insert_value(test_tree, "earth");
+        zip_insert_value(test_tree, "says");
+
+        TEST_ASSERT_EQUAL_STRING("says", zip_predecessor_of_value(test_tree, "the"));
+        TEST_ASSERT_EQUAL_STRING("hello", zip_predecessor_of_value(test_tree, "says"));
+        TEST_ASSERT_EQUAL_STRING("earth", zip_predecessor_of_value(test_tree, "hello"));  
+        TEST_ASSERT_EQUAL_STRING("hello", zip_predecessor_of_value(test_tree, "not_in_tree"));
+        TEST_ASSERT_NULL(zip_predecessor_of_value(test_tree, "earth"));
+
+        zip_free(test_tree); 
+}
+
+/* compares ints, in the direction the context points to */
+int directed_comparison(const void *val_one, const void *val_two, void *ctx)
+{
+        int a = *(const int *) val_one; 
+        int b = *(const int *) val_two; 
+
+        return *(int *) ctx * ((a > b) - (a < b)); 
+}
+
+void function_to_apply_record_order(void *value, int depth, void *cl)
+{
+        int **next = (int **) cl; 
+
+        (void) depth; 
+        *(*next)++ = *(int *) value; 
+}
+
+void test_zip_new_r_passes_context(void)
+{
+        int direction = -1; 
+        int a[100]; 
+        int order[100]; 
+        int *next = order; 
+        ZipTree_T test_tree = zip_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 100; i++) {
+                a[i] = i; 
+                zip_insert_value(test_tree, &a[i]); 
+        }
+
+        zip_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(100, next - order); 
+        for (int i = 0; i < 100; i++) 
+                TEST_ASSERT_EQUAL(99 - i, order[i]); 
+
+        int key = 42; 
+        TEST_ASSERT_EQUAL(42, *(int *) zip_search(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(41, *(int *) zip_successor_of_value(test_tree, &key)); 
+
+        zip_free(test_tree); 
+}
+
+void test_zip_multiset_counts(void)
+{
+        int direction = 1; 
+        int a[10]; 
+        int order[10]; 
+        int *next = order; 
+        int key; 
+        ZipTree_T test_tree = zip_new_multiset(&directed_comparison, &direction); 
+        ZipTree_T plain_tree = zip_new_r(&directed_comparison, &direction); 
+
+        for (int i = 0; i < 10; i++) {
+                a[i] = i / 3; 
+                zip_insert_value(test_tree, &a[i]); 
+                zip_insert_value(plain_tree, &a[i]); 
+        }
+
+        zip_map_inorder(test_tree, &function_to_apply_record_order, &next); 
+
+        TEST_ASSERT_EQUAL(4, next - order); 
+        for (int i = 0; i < 4; i++) 
+                TEST_ASSERT_EQUAL(i, order[i]); 
+
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, zip_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(3, zip_count(plain_tree, &key)); 
+        TEST_ASSERT_EQUAL_PTR(&a[3], zip_search(test_tree, &key)); 
+        key = 3; 
+        TEST_ASSERT_EQUAL(1, zip_count(test_tree, &key)); 
+        key = 7; 
+        TEST_ASSERT_EQUAL(0, zip_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(0, zip_count(plain_tree, &key)); 
+
+        key = 0; 
+        zip_delete_value(test_tree, &key); 
+        zip_delete_value(test_tree, &key); 
+        zip_delete_value(plain_tree, &key); 
+        TEST_ASSERT_EQUAL(1, zip_count(test_tree, &key)); 
+        TEST_ASSERT_EQUAL(2, zip_count(plain_tree, &key)); 
+        TEST_ASSERT_NOT_NULL(zip_search(test_tree, &key)); 
+
+        zip_delete_value(test_tree, &key); 
+        TEST_ASSERT_EQUAL(0, zip_count(test_tree, &key)); 
+        TEST_ASSERT_NULL(zip_search(test_tree, &key)); 
+        zip_delete_value(test_tree, &key); 
+        key = 1; 
+        TEST_ASSERT_EQUAL(3, zip_count(test_tree, &key)); 
+
+        zip_free(test_tree); 
+        zip_free(plain_tree); 
+}
+
+int main(void)
+{
+        UnityBegin("test/test_zip_tree.c");
+
+        RUN_TEST(test_zip_new); 
+        RUN_TEST(test_zip_insert_string); 
+        RUN_TEST(test_zip_is_empty); 
+        RUN_TEST(test_zip_search); 
+        RUN_TEST(test_zip_search_for_ints); 
+        RUN_TEST(test_zip_map_inorder_string); 
+        RUN_TEST(test_zip_same_seed_same_shape); 
+        RUN_TEST(test_zip_sorted_inserts_stay_shallow); 
+        RUN_TEST(test_zip_delete_value); 
+        RUN_TEST(test_zip_delete_many_ints); 
+        RUN_TEST(test_zip_tree_minimum_and_maximum); 
+        RUN_TEST(test_zip_successor_of_value); 
+        RUN_TEST(test_zip_predecessor_of_value); 
+        RUN_TEST(test_zip_new_r_passes_context); 
+        RUN_TEST(test_zip_multiset_counts); 
+
+        UnityEnd();
+        return 0;
+}